@@ -1,5 +1,7 @@
 #pragma once
 
+#include "flux/AST/ASTContext.h"
+#include "flux/AST/SmallList.h"
 #include "flux/Common/SourceLocation.h"
 #include "flux/Lexer/Token.h"
 
@@ -19,16 +21,21 @@ class Expr;
 class TypeNode;
 class Pattern;
 
-// Convenience aliases
-using DeclPtr = std::unique_ptr<Decl>;
-using StmtPtr = std::unique_ptr<Stmt>;
-using ExprPtr = std::unique_ptr<Expr>;
-using TypeNodePtr = std::unique_ptr<TypeNode>;
-using PatternPtr = std::unique_ptr<Pattern>;
+// Convenience aliases. Nodes are arena-allocated: they are owned by the
+// Module's ASTContext, not by the pointers that reference them.
+using DeclPtr = Decl *;
+using StmtPtr = Stmt *;
+using ExprPtr = Expr *;
+using TypeNodePtr = TypeNode *;
+using PatternPtr = Pattern *;
 
 using DeclList = std::vector<DeclPtr>;
-using StmtList = std::vector<StmtPtr>;
-using ExprList = std::vector<ExprPtr>;
+
+// Statement and expression child lists carry inline storage for the
+// common small case (median block: 3 statements; median call: 2 args),
+// so they cost no heap allocation and walk contiguously.
+using StmtList = SmallList<StmtPtr, 4>;
+using ExprList = SmallList<ExprPtr, 4>;
 
 // ============================================================================
 // AST Node base class
@@ -52,6 +59,10 @@ protected:
 
 /// Represents a complete Flux source file / module.
 struct Module {
+  /// Arena owning every AST node below. Declared first so the raw node
+  /// pointers in the fields that follow stay valid for their lifetime.
+  std::unique_ptr<ASTContext> context;
+
   std::string name; // e.g., "my_project::services::user_service"
   std::vector<std::string> imports; // fully qualified import paths
   DeclList declarations;            // top-level declarations
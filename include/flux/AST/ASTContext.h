@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Bump-pointer arena that owns all AST nodes for a module.
+
+namespace flux {
+namespace ast {
+
+/// Arena allocator for AST nodes.
+///
+/// All nodes produced by Parser::parseModule live in one ASTContext and are
+/// freed together when the context is destroyed. Allocation is a bump of a
+/// cursor within page-sized chunks, so building a module performs no
+/// per-node heap traffic, and teardown is a flat sweep instead of a
+/// recursive destructor walk through the node graph.
+///
+/// Nodes holding non-trivial members (std::string, std::vector) register a
+/// destructor that runs during the sweep; trivially destructible nodes cost
+/// nothing at teardown.
+class ASTContext {
+public:
+  ASTContext() = default;
+  ~ASTContext();
+
+  ASTContext(const ASTContext &) = delete;
+  ASTContext &operator=(const ASTContext &) = delete;
+  ASTContext(ASTContext &&) = default;
+  ASTContext &operator=(ASTContext &&) = default;
+
+  /// Allocate and construct a node in the arena.
+  template <typename T, typename... Args> T *create(Args &&...args) {
+    void *mem = allocate(sizeof(T), alignof(T));
+    T *node = new (mem) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      cleanups_.push_back({node, [](void *p) { static_cast<T *>(p)->~T(); }});
+    }
+    return node;
+  }
+
+  /// Raw aligned allocation from the current page (grows as needed).
+  void *allocate(size_t size, size_t align);
+
+  // --- Statistics (for --stats / memory profiling) ---
+  size_t bytesAllocated() const { return bytesAllocated_; }
+  size_t bytesReserved() const { return bytesReserved_; }
+  size_t nodeCount() const { return nodeCount_; }
+
+private:
+  static constexpr size_t kPageSize = 64 * 1024;
+
+  void addPage(size_t minSize);
+
+  struct Cleanup {
+    void *object;
+    void (*destroy)(void *);
+  };
+
+  std::vector<std::unique_ptr<char[]>> pages_;
+  char *cursor_ = nullptr;
+  char *end_ = nullptr;
+
+  std::vector<Cleanup> cleanups_;
+  size_t bytesAllocated_ = 0;
+  size_t bytesReserved_ = 0;
+  size_t nodeCount_ = 0;
+};
+
+} // namespace ast
+} // namespace flux
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "flux/AST/AST.h"
+#include "flux/Lexer/Token.h"
+
+#include <ostream>
+#include <vector>
+
+namespace flux {
+
+/// Compact binary serializations of the token stream and the AST for
+/// tooling consumers (--dump-tokens=binary / --dump-ast=binary).
+///
+/// Both formats are little-endian streams of fixed-width records behind
+/// a 4-byte magic + record-count header, so an indexer can mmap a dump
+/// and address records directly:
+///
+///   tokens: "FTK\1", u32 count, then per token
+///           { u16 kind, u16 textLength, u32 symbolID, u32 offset }
+///   ast:    "FAS\1", u32 count, then per node in pre-order
+///           { u16 depth, u8 nodeClass, u8 kind, u32 location }
+///           nodeClass: 0 = Decl, 1 = Stmt, 2 = Expr, 3 = Pattern
+class BinaryDump {
+public:
+  static void writeTokens(std::ostream &out,
+                          const std::vector<Token> &tokens);
+  static void writeModule(std::ostream &out, ast::Module &module);
+};
+
+} // namespace flux
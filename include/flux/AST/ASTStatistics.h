@@ -0,0 +1,33 @@
+#pragma once
+
+#include "flux/AST/AST.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace flux {
+
+/// Node-count and footprint statistics over a parsed module, the data
+/// source for the driver's --mem-stats report.
+struct ASTStatistics {
+  /// Concrete node counts, keyed by a stable kind name ("FuncDecl",
+  /// "BinaryExpr", ...). std::map so reports are deterministically
+  /// ordered.
+  std::map<std::string, uint64_t> nodeCounts;
+
+  /// Shallow bytes per node class (sizeof of the concrete types times
+  /// their counts; excludes out-of-line strings and vectors).
+  uint64_t declBytes = 0;
+  uint64_t stmtBytes = 0;
+  uint64_t exprBytes = 0;
+  uint64_t patternBytes = 0;
+  uint64_t typeBytes = 0;
+
+  uint64_t totalNodes = 0;
+
+  /// Walk `module` and tally every node.
+  static ASTStatistics collect(ast::Module &module);
+};
+
+} // namespace flux
@@ -0,0 +1,498 @@
+#pragma once
+
+#include "flux/AST/Decl.h"
+#include "flux/AST/Expr.h"
+#include "flux/AST/Pattern.h"
+#include "flux/AST/Stmt.h"
+#include "flux/AST/Type.h"
+
+namespace flux {
+namespace ast {
+
+/// CRTP traversal with static dispatch on the node-kind enums.
+///
+/// Derive as `class MyPass : public ASTWalker<MyPass>` and override the
+/// visit methods you care about; every dispatch resolves at compile time
+/// (a switch on the kind tag plus a direct call), so passes pay no
+/// virtual-call indirections per node. The default visit methods walk
+/// into the node's children, so overriding nothing yields a full
+/// traversal; an override that still wants its children visited calls
+/// the corresponding walk method itself.
+///
+/// ASTVisitor remains for passes that need runtime polymorphism.
+template <typename Derived> class ASTWalker {
+public:
+  Derived &derived() { return *static_cast<Derived *>(this); }
+
+  // ---- Dispatch (static; one switch per node) ----
+
+  void walkDecl(Decl &decl) {
+    switch (decl.kind) {
+    case Decl::Kind::Module:
+      derived().visitModuleDecl(static_cast<ModuleDecl &>(decl));
+      break;
+    case Decl::Kind::Import:
+      derived().visitImportDecl(static_cast<ImportDecl &>(decl));
+      break;
+    case Decl::Kind::Func:
+      derived().visitFuncDecl(static_cast<FuncDecl &>(decl));
+      break;
+    case Decl::Kind::Struct:
+      derived().visitStructDecl(static_cast<StructDecl &>(decl));
+      break;
+    case Decl::Kind::Class:
+      derived().visitClassDecl(static_cast<ClassDecl &>(decl));
+      break;
+    case Decl::Kind::Enum:
+      derived().visitEnumDecl(static_cast<EnumDecl &>(decl));
+      break;
+    case Decl::Kind::Trait:
+      derived().visitTraitDecl(static_cast<TraitDecl &>(decl));
+      break;
+    case Decl::Kind::Impl:
+      derived().visitImplDecl(static_cast<ImplDecl &>(decl));
+      break;
+    case Decl::Kind::TypeAlias:
+      derived().visitTypeAliasDecl(static_cast<TypeAliasDecl &>(decl));
+      break;
+    }
+  }
+
+  void walkStmt(Stmt &stmt) {
+    switch (stmt.kind) {
+    case Stmt::Kind::Let:
+      derived().visitLetStmt(static_cast<LetStmt &>(stmt));
+      break;
+    case Stmt::Kind::Const:
+      derived().visitConstStmt(static_cast<ConstStmt &>(stmt));
+      break;
+    case Stmt::Kind::Return:
+      derived().visitReturnStmt(static_cast<ReturnStmt &>(stmt));
+      break;
+    case Stmt::Kind::If:
+      derived().visitIfStmt(static_cast<IfStmt &>(stmt));
+      break;
+    case Stmt::Kind::Match:
+      derived().visitMatchStmt(static_cast<MatchStmt &>(stmt));
+      break;
+    case Stmt::Kind::For:
+      derived().visitForStmt(static_cast<ForStmt &>(stmt));
+      break;
+    case Stmt::Kind::While:
+      derived().visitWhileStmt(static_cast<WhileStmt &>(stmt));
+      break;
+    case Stmt::Kind::Loop:
+      derived().visitLoopStmt(static_cast<LoopStmt &>(stmt));
+      break;
+    case Stmt::Kind::Break:
+      derived().visitBreakStmt(static_cast<BreakStmt &>(stmt));
+      break;
+    case Stmt::Kind::Continue:
+      derived().visitContinueStmt(static_cast<ContinueStmt &>(stmt));
+      break;
+    case Stmt::Kind::Block:
+      derived().visitBlockStmt(static_cast<BlockStmt &>(stmt));
+      break;
+    case Stmt::Kind::Expr:
+      derived().visitExprStmt(static_cast<ExprStmt &>(stmt));
+      break;
+    case Stmt::Kind::Assignment:
+      break; // handled via ExprStmt with AssignExpr
+    }
+  }
+
+  void walkExpr(Expr &expr) {
+    switch (expr.kind) {
+    case Expr::Kind::IntLiteral:
+      derived().visitIntLiteralExpr(static_cast<IntLiteralExpr &>(expr));
+      break;
+    case Expr::Kind::FloatLiteral:
+      derived().visitFloatLiteralExpr(static_cast<FloatLiteralExpr &>(expr));
+      break;
+    case Expr::Kind::StringLiteral:
+      derived().visitStringLiteralExpr(
+          static_cast<StringLiteralExpr &>(expr));
+      break;
+    case Expr::Kind::CharLiteral:
+      derived().visitCharLiteralExpr(static_cast<CharLiteralExpr &>(expr));
+      break;
+    case Expr::Kind::BoolLiteral:
+      derived().visitBoolLiteralExpr(static_cast<BoolLiteralExpr &>(expr));
+      break;
+    case Expr::Kind::Ident:
+      derived().visitIdentExpr(static_cast<IdentExpr &>(expr));
+      break;
+    case Expr::Kind::Path:
+      derived().visitPathExpr(static_cast<PathExpr &>(expr));
+      break;
+    case Expr::Kind::Binary:
+      derived().visitBinaryExpr(static_cast<BinaryExpr &>(expr));
+      break;
+    case Expr::Kind::Unary:
+      derived().visitUnaryExpr(static_cast<UnaryExpr &>(expr));
+      break;
+    case Expr::Kind::Call:
+      derived().visitCallExpr(static_cast<CallExpr &>(expr));
+      break;
+    case Expr::Kind::MethodCall:
+      derived().visitMethodCallExpr(static_cast<MethodCallExpr &>(expr));
+      break;
+    case Expr::Kind::MemberAccess:
+      derived().visitMemberAccessExpr(
+          static_cast<MemberAccessExpr &>(expr));
+      break;
+    case Expr::Kind::Index:
+      derived().visitIndexExpr(static_cast<IndexExpr &>(expr));
+      break;
+    case Expr::Kind::Cast:
+      derived().visitCastExpr(static_cast<CastExpr &>(expr));
+      break;
+    case Expr::Kind::Block:
+      derived().visitBlockExpr(static_cast<BlockExpr &>(expr));
+      break;
+    case Expr::Kind::If:
+      derived().visitIfExpr(static_cast<IfExpr &>(expr));
+      break;
+    case Expr::Kind::Match:
+      derived().visitMatchExpr(static_cast<MatchExpr &>(expr));
+      break;
+    case Expr::Kind::Closure:
+      derived().visitClosureExpr(static_cast<ClosureExpr &>(expr));
+      break;
+    case Expr::Kind::Construct:
+      derived().visitConstructExpr(static_cast<ConstructExpr &>(expr));
+      break;
+    case Expr::Kind::StructLiteral:
+      derived().visitStructLiteralExpr(
+          static_cast<StructLiteralExpr &>(expr));
+      break;
+    case Expr::Kind::Tuple:
+      derived().visitTupleExpr(static_cast<TupleExpr &>(expr));
+      break;
+    case Expr::Kind::Array:
+      derived().visitArrayExpr(static_cast<ArrayExpr &>(expr));
+      break;
+    case Expr::Kind::Range:
+      derived().visitRangeExpr(static_cast<RangeExpr &>(expr));
+      break;
+    case Expr::Kind::Ref:
+      derived().visitRefExpr(static_cast<RefExpr &>(expr));
+      break;
+    case Expr::Kind::MutRef:
+      derived().visitMutRefExpr(static_cast<MutRefExpr &>(expr));
+      break;
+    case Expr::Kind::Move:
+      derived().visitMoveExpr(static_cast<MoveExpr &>(expr));
+      break;
+    case Expr::Kind::Await:
+      derived().visitAwaitExpr(static_cast<AwaitExpr &>(expr));
+      break;
+    case Expr::Kind::Try:
+      derived().visitTryExpr(static_cast<TryExpr &>(expr));
+      break;
+    case Expr::Kind::Assign:
+      derived().visitAssignExpr(static_cast<AssignExpr &>(expr));
+      break;
+    case Expr::Kind::CompoundAssign:
+      derived().visitCompoundAssignExpr(
+          static_cast<CompoundAssignExpr &>(expr));
+      break;
+    }
+  }
+
+  void walkPattern(Pattern &pattern) {
+    switch (pattern.kind) {
+    case Pattern::Kind::Wildcard:
+      derived().visitWildcardPattern(static_cast<WildcardPattern &>(pattern));
+      break;
+    case Pattern::Kind::Identifier:
+      derived().visitIdentPattern(static_cast<IdentPattern &>(pattern));
+      break;
+    case Pattern::Kind::Literal:
+      derived().visitLiteralPattern(static_cast<LiteralPattern &>(pattern));
+      break;
+    case Pattern::Kind::Tuple:
+      derived().visitTuplePattern(static_cast<TuplePattern &>(pattern));
+      break;
+    case Pattern::Kind::Constructor:
+      derived().visitConstructorPattern(
+          static_cast<ConstructorPattern &>(pattern));
+      break;
+    case Pattern::Kind::Or:
+      derived().visitOrPattern(static_cast<OrPattern &>(pattern));
+      break;
+    }
+  }
+
+  // ---- Default handlers: descend into children ----
+  // Declarations
+
+  void visitModuleDecl(ModuleDecl &) {}
+  void visitImportDecl(ImportDecl &) {}
+
+  void visitFuncDecl(FuncDecl &node) {
+    if (node.body) {
+      derived().walkStmt(*node.body);
+    }
+  }
+
+  void visitStructDecl(StructDecl &) {}
+
+  void visitClassDecl(ClassDecl &node) {
+    for (auto &method : node.methods) {
+      derived().walkDecl(*method);
+    }
+  }
+
+  void visitEnumDecl(EnumDecl &) {}
+
+  void visitTraitDecl(TraitDecl &node) {
+    for (auto &method : node.methods) {
+      derived().walkDecl(*method);
+    }
+  }
+
+  void visitImplDecl(ImplDecl &node) {
+    for (auto &method : node.methods) {
+      derived().walkDecl(*method);
+    }
+  }
+
+  void visitTypeAliasDecl(TypeAliasDecl &) {}
+
+  // Statements
+
+  void visitLetStmt(LetStmt &node) {
+    if (node.initializer) {
+      derived().walkExpr(*node.initializer);
+    }
+  }
+
+  void visitConstStmt(ConstStmt &node) {
+    if (node.value) {
+      derived().walkExpr(*node.value);
+    }
+  }
+
+  void visitReturnStmt(ReturnStmt &node) {
+    if (node.value) {
+      derived().walkExpr(*node.value);
+    }
+  }
+
+  void visitIfStmt(IfStmt &node) {
+    derived().walkExpr(*node.condition);
+    derived().walkStmt(*node.thenBranch);
+    if (node.elseBranch) {
+      derived().walkStmt(*node.elseBranch);
+    }
+  }
+
+  void visitMatchStmt(MatchStmt &node) {
+    derived().walkExpr(*node.scrutinee);
+    for (auto &arm : node.arms) {
+      if (arm.pattern) {
+        derived().walkPattern(*arm.pattern);
+      }
+      if (arm.guard) {
+        derived().walkExpr(*arm.guard);
+      }
+      if (arm.body) {
+        derived().walkExpr(*arm.body);
+      }
+    }
+  }
+
+  void visitForStmt(ForStmt &node) {
+    derived().walkExpr(*node.iterable);
+    derived().walkStmt(*node.body);
+  }
+
+  void visitWhileStmt(WhileStmt &node) {
+    derived().walkExpr(*node.condition);
+    derived().walkStmt(*node.body);
+  }
+
+  void visitLoopStmt(LoopStmt &node) { derived().walkStmt(*node.body); }
+
+  void visitBreakStmt(BreakStmt &) {}
+  void visitContinueStmt(ContinueStmt &) {}
+
+  void visitBlockStmt(BlockStmt &node) {
+    for (auto &stmt : node.statements) {
+      derived().walkStmt(*stmt);
+    }
+  }
+
+  void visitExprStmt(ExprStmt &node) { derived().walkExpr(*node.expression); }
+
+  // Expressions
+
+  void visitIntLiteralExpr(IntLiteralExpr &) {}
+  void visitFloatLiteralExpr(FloatLiteralExpr &) {}
+  void visitStringLiteralExpr(StringLiteralExpr &) {}
+  void visitCharLiteralExpr(CharLiteralExpr &) {}
+  void visitBoolLiteralExpr(BoolLiteralExpr &) {}
+  void visitIdentExpr(IdentExpr &) {}
+  void visitPathExpr(PathExpr &) {}
+
+  void visitBinaryExpr(BinaryExpr &node) {
+    derived().walkExpr(*node.lhs);
+    derived().walkExpr(*node.rhs);
+  }
+
+  void visitUnaryExpr(UnaryExpr &node) { derived().walkExpr(*node.operand); }
+
+  void visitCallExpr(CallExpr &node) {
+    derived().walkExpr(*node.callee);
+    for (auto &arg : node.arguments) {
+      derived().walkExpr(*arg);
+    }
+  }
+
+  void visitMethodCallExpr(MethodCallExpr &node) {
+    derived().walkExpr(*node.object);
+    for (auto &arg : node.arguments) {
+      derived().walkExpr(*arg);
+    }
+  }
+
+  void visitMemberAccessExpr(MemberAccessExpr &node) {
+    derived().walkExpr(*node.object);
+  }
+
+  void visitIndexExpr(IndexExpr &node) {
+    derived().walkExpr(*node.object);
+    derived().walkExpr(*node.index);
+  }
+
+  void visitCastExpr(CastExpr &node) { derived().walkExpr(*node.expr); }
+
+  void visitBlockExpr(BlockExpr &node) {
+    for (auto &stmt : node.statements) {
+      derived().walkStmt(*stmt);
+    }
+    if (node.finalExpr) {
+      derived().walkExpr(*node.finalExpr);
+    }
+  }
+
+  void visitIfExpr(IfExpr &node) {
+    derived().walkExpr(*node.condition);
+    derived().walkExpr(*node.thenExpr);
+    if (node.elseExpr) {
+      derived().walkExpr(*node.elseExpr);
+    }
+  }
+
+  void visitMatchExpr(MatchExpr &node) {
+    derived().walkExpr(*node.scrutinee);
+    for (auto &arm : node.arms) {
+      if (arm.pattern) {
+        derived().walkPattern(*arm.pattern);
+      }
+      if (arm.guard) {
+        derived().walkExpr(*arm.guard);
+      }
+      if (arm.body) {
+        derived().walkExpr(*arm.body);
+      }
+    }
+  }
+
+  void visitClosureExpr(ClosureExpr &node) {
+    if (node.body) {
+      derived().walkExpr(*node.body);
+    }
+  }
+
+  void visitConstructExpr(ConstructExpr &node) {
+    derived().walkExpr(*node.typePath);
+    for (auto &field : node.fields) {
+      derived().walkExpr(*field.value);
+    }
+  }
+
+  void visitStructLiteralExpr(StructLiteralExpr &node) {
+    for (auto &[name, value] : node.fields) {
+      derived().walkExpr(*value);
+    }
+  }
+
+  void visitTupleExpr(TupleExpr &node) {
+    for (auto &element : node.elements) {
+      derived().walkExpr(*element);
+    }
+  }
+
+  void visitArrayExpr(ArrayExpr &node) {
+    for (auto &element : node.elements) {
+      derived().walkExpr(*element);
+    }
+  }
+
+  void visitRangeExpr(RangeExpr &node) {
+    if (node.start) {
+      derived().walkExpr(*node.start);
+    }
+    if (node.end) {
+      derived().walkExpr(*node.end);
+    }
+  }
+
+  void visitRefExpr(RefExpr &node) { derived().walkExpr(*node.operand); }
+  void visitMutRefExpr(MutRefExpr &node) { derived().walkExpr(*node.operand); }
+  void visitMoveExpr(MoveExpr &node) { derived().walkExpr(*node.operand); }
+  void visitAwaitExpr(AwaitExpr &node) { derived().walkExpr(*node.operand); }
+  void visitTryExpr(TryExpr &node) { derived().walkExpr(*node.operand); }
+
+  void visitAssignExpr(AssignExpr &node) {
+    derived().walkExpr(*node.target);
+    derived().walkExpr(*node.value);
+  }
+
+  void visitCompoundAssignExpr(CompoundAssignExpr &node) {
+    derived().walkExpr(*node.target);
+    derived().walkExpr(*node.value);
+  }
+
+  // Patterns
+
+  void visitWildcardPattern(WildcardPattern &) {}
+  void visitIdentPattern(IdentPattern &) {}
+
+  void visitLiteralPattern(LiteralPattern &node) {
+    if (node.literal) {
+      derived().walkExpr(*node.literal);
+    }
+  }
+
+  void visitTuplePattern(TuplePattern &node) {
+    for (auto &element : node.elements) {
+      derived().walkPattern(*element);
+    }
+  }
+
+  void visitConstructorPattern(ConstructorPattern &node) {
+    for (auto &field : node.positionalFields) {
+      derived().walkPattern(*field);
+    }
+    for (auto &field : node.namedFields) {
+      if (field.pattern) {
+        derived().walkPattern(*field.pattern);
+      }
+    }
+  }
+
+  void visitOrPattern(OrPattern &node) {
+    for (auto &alternative : node.alternatives) {
+      derived().walkPattern(*alternative);
+    }
+  }
+
+protected:
+  ASTWalker() = default;
+};
+
+} // namespace ast
+} // namespace flux
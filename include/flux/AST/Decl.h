@@ -90,16 +90,21 @@ struct FuncParam {
 // func name<T: Bound>(params) -> ReturnType { body }
 class FuncDecl : public Decl {
 public:
+    enum class InlineHint { None, Always, Never };
+
     std::string name;
     std::vector<GenericParam> genericParams;
     std::vector<FuncParam> params;
     TypeNodePtr returnType;      // nullptr for Void
-    std::unique_ptr<BlockStmt> body;  // nullptr for trait method declarations
+    BlockStmt *body;  // nullptr for trait method declarations
     bool isAsync = false;
     bool isUnsafe = false;
+    InlineHint inlineHint = InlineHint::None; // @inline(always|never)
+    bool fastMath = false; // @fastmath: relaxed FP semantics here only
+    uint32_t bodySize = 0; // node count, filled in by Sema
 
     FuncDecl(std::string name, std::vector<FuncParam> params,
-             TypeNodePtr returnType, std::unique_ptr<BlockStmt> body,
+             TypeNodePtr returnType, BlockStmt *body,
              SourceLocation loc = {})
         : Decl(Kind::Func, loc), name(std::move(name)),
           params(std::move(params)), returnType(std::move(returnType)),
@@ -121,6 +126,7 @@ public:
     std::string name;
     std::vector<GenericParam> genericParams;
     std::vector<FieldDecl> fields;
+    bool optimizeLayout = false; // @layout(optimize): reorder by alignment
 
     StructDecl(std::string name, std::vector<FieldDecl> fields,
                SourceLocation loc = {})
@@ -135,7 +141,7 @@ public:
     std::string name;
     std::vector<GenericParam> genericParams;
     std::vector<FieldDecl> fields;
-    std::vector<std::unique_ptr<FuncDecl>> methods;
+    std::vector<FuncDecl *> methods;
 
     ClassDecl(std::string name, std::vector<FieldDecl> fields,
               SourceLocation loc = {})
@@ -181,10 +187,10 @@ public:
     std::string name;
     std::vector<GenericParam> genericParams;
     std::vector<std::string> superTraits; // trait bounds this trait extends
-    std::vector<std::unique_ptr<FuncDecl>> methods;
+    std::vector<FuncDecl *> methods;
 
     TraitDecl(std::string name,
-              std::vector<std::unique_ptr<FuncDecl>> methods,
+              std::vector<FuncDecl *> methods,
               SourceLocation loc = {})
         : Decl(Kind::Trait, loc), name(std::move(name)),
           methods(std::move(methods)) {}
@@ -198,11 +204,11 @@ public:
     TypeNodePtr targetType;                         // The type being implemented
     std::optional<std::string> traitName;           // For trait implementations
     std::vector<GenericParam> genericParams;
-    std::vector<std::unique_ptr<FuncDecl>> methods;
+    std::vector<FuncDecl *> methods;
 
     ImplDecl(TypeNodePtr targetType,
              std::optional<std::string> traitName,
-             std::vector<std::unique_ptr<FuncDecl>> methods,
+             std::vector<FuncDecl *> methods,
              SourceLocation loc = {})
         : Decl(Kind::Impl, loc), targetType(std::move(targetType)),
           traitName(std::move(traitName)),
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace flux {
+namespace ast {
+
+/// Vector-like container with inline storage for the small case.
+///
+/// AST censuses show the median call has 2 arguments and the median
+/// block has 3 statements; SmallList keeps up to N elements in the node
+/// itself, so the common case costs zero heap allocations and iterating
+/// children stays on the same cache lines as the node. Larger lists
+/// spill to a single heap block with doubling growth.
+template <typename T, size_t N> class SmallList {
+public:
+  SmallList() = default;
+
+  SmallList(const SmallList &) = delete;
+  SmallList &operator=(const SmallList &) = delete;
+
+  SmallList(SmallList &&other) noexcept { moveFrom(std::move(other)); }
+
+  SmallList &operator=(SmallList &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      moveFrom(std::move(other));
+    }
+    return *this;
+  }
+
+  ~SmallList() { destroy(); }
+
+  void push_back(T value) {
+    if (size_ == capacity_) {
+      grow(capacity_ * 2);
+    }
+    new (data_ + size_) T(std::move(value));
+    ++size_;
+  }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      grow(capacity_ * 2);
+    }
+    T *slot = new (data_ + size_) T(std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) {
+      grow(capacity);
+    }
+  }
+
+  void clear() {
+    for (size_t i = 0; i < size_; ++i) {
+      data_[i].~T();
+    }
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  T &operator[](size_t index) { return data_[index]; }
+  const T &operator[](size_t index) const { return data_[index]; }
+
+  T &back() { return data_[size_ - 1]; }
+  const T &back() const { return data_[size_ - 1]; }
+  T &front() { return data_[0]; }
+  const T &front() const { return data_[0]; }
+
+  T *begin() { return data_; }
+  T *end() { return data_ + size_; }
+  const T *begin() const { return data_; }
+  const T *end() const { return data_ + size_; }
+
+private:
+  bool isInline() const {
+    return data_ == reinterpret_cast<const T *>(inline_);
+  }
+
+  void grow(size_t newCapacity) {
+    if (newCapacity < N * 2) {
+      newCapacity = N * 2;
+    }
+    T *newData = static_cast<T *>(
+        ::operator new(newCapacity * sizeof(T), std::align_val_t(alignof(T))));
+    for (size_t i = 0; i < size_; ++i) {
+      new (newData + i) T(std::move(data_[i]));
+      data_[i].~T();
+    }
+    if (!isInline()) {
+      ::operator delete(data_, std::align_val_t(alignof(T)));
+    }
+    data_ = newData;
+    capacity_ = newCapacity;
+  }
+
+  void destroy() {
+    clear();
+    if (!isInline()) {
+      ::operator delete(data_, std::align_val_t(alignof(T)));
+    }
+    data_ = reinterpret_cast<T *>(inline_);
+    capacity_ = N;
+  }
+
+  void moveFrom(SmallList &&other) {
+    if (other.isInline()) {
+      data_ = reinterpret_cast<T *>(inline_);
+      capacity_ = N;
+      size_ = other.size_;
+      for (size_t i = 0; i < size_; ++i) {
+        new (data_ + i) T(std::move(other.data_[i]));
+        other.data_[i].~T();
+      }
+      other.size_ = 0;
+    } else {
+      // Steal the heap block outright
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.data_ = reinterpret_cast<T *>(other.inline_);
+      other.capacity_ = N;
+      other.size_ = 0;
+    }
+  }
+
+  alignas(T) unsigned char inline_[N * sizeof(T)];
+  T *data_ = reinterpret_cast<T *>(inline_);
+  size_t capacity_ = N;
+  size_t size_ = 0;
+};
+
+} // namespace ast
+} // namespace flux
@@ -54,10 +54,10 @@ public:
 /// A generic type like Array<Int32>, HashMap<String, Int32>
 class GenericType : public TypeNode {
 public:
-  std::unique_ptr<NamedType> base;        // The base type name
+  NamedType *base;        // The base type name
   std::vector<TypeNodePtr> typeArguments; // Type parameters
 
-  GenericType(std::unique_ptr<NamedType> base, std::vector<TypeNodePtr> args,
+  GenericType(NamedType *base, std::vector<TypeNodePtr> args,
               SourceLocation loc = {})
       : TypeNode(Kind::Generic, loc), base(std::move(base)),
         typeArguments(std::move(args)) {}
@@ -3,13 +3,17 @@
 #include "flux/AST/AST.h"
 #include "flux/CodeGen/IREmitter.h"
 #include "flux/Common/Diagnostics.h"
+#include "flux/Common/Stats.h"
 
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Target/TargetMachine.h>
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace flux {
 
@@ -27,9 +31,56 @@ struct CodeGenOptions {
   std::string targetTriple; // e.g. "x86_64-pc-windows-msvc"
   std::string cpu = "generic";
   std::string features;
+  bool nativeCPU = false; // --native: detect host CPU and features
   OutputFormat outputFormat = OutputFormat::Object;
   int optimizationLevel = 0; // 0-3
   bool debugInfo = false;
+  bool warnPadding = false; // report bytes lost to struct padding
+
+  // Fast-debug tier (-Odebug): configure the backend for compile speed
+  // over code quality — FastISel everywhere, fast register allocation,
+  // no scheduling effort.
+  bool fastDebug = false;
+
+  // --vectorize-report: surface LLVM loop-vectorize remarks (applied
+  // and missed) through the DiagnosticEngine.
+  bool vectorizeReport = false;
+
+  // --deterministic: bit-identical outputs for content-addressed
+  // caches — stable module identifiers (no absolute paths) and no
+  // environment-dependent strings in the object.
+  bool deterministic = false;
+
+  // --runtime=gc: heap allocations go through the managed young
+  // generation (flux_gc_alloc) instead of flux_alloc.
+  bool managedHeap = false;
+
+  // --instrument-functions: emit entry/exit probes into the runtime's
+  // per-thread trace ring.
+  bool instrumentFunctions = false;
+
+  // Floating-point semantics: --ffast-math relaxes everything,
+  // --ffp-contract=fast allows FMA contraction only.
+  bool fastMath = false;
+  bool fpContractFast = false;
+
+  // --report-checks: summarize bounds checks eliminated vs retained.
+  bool reportChecks = false;
+
+  // --strip-dead: emit only declarations reachable from main (plus
+  // public roots when there is no main); linker gc-sections backstop.
+  bool stripDead = false;
+
+  // Functions flux-order classified cold: marked cold + optsize so the
+  // backend splits them away from hot text.
+  std::vector<std::string> coldFunctions;
+  CheckTier checks = CheckTier::Full;
+
+  // Instrumentation-based PGO: generate emits profile counters into the
+  // binary (written out via the compiler-rt profile runtime); use feeds
+  // an indexed .profdata back into the pass pipeline as branch weights.
+  bool profileGenerate = false;
+  std::string profileUse; // path to .profdata (empty = off)
 };
 
 /// Top-level code generation driver.
@@ -44,26 +95,75 @@ public:
   /// Returns true on success.
   bool generate(ast::Module &module);
 
+  /// Sharded generation: declare everything, but emit bodies only for
+  /// declarations `shouldEmit` accepts. Used by generateParallel.
+  bool generate(ast::Module &module,
+                const std::function<bool(const ast::Decl &)> &shouldEmit);
+
+  /// Parallel function-level codegen: partition top-level functions
+  /// round-robin across `shards` worker threads, each with a private
+  /// CodeGen (own LLVMContext and llvm::Module), run optimization and
+  /// instruction selection per shard concurrently, and write shard
+  /// objects named <objFileBase>.<N>.o into `objFiles`. Cross-shard
+  /// calls resolve at link time because every shard declares every
+  /// function.
+  static bool generateParallel(ast::Module &module, DiagnosticEngine &diag,
+                               const CodeGenOptions &opts, unsigned shards,
+                               const std::string &objFileBase,
+                               std::vector<std::string> &objFiles);
+
   /// Write the generated output to a file.
   bool writeOutput(const std::string &filename);
 
+  /// Cross-module LTO: load the given bitcode files, link them into one
+  /// module, and run the optimization pipeline over the combined IR so
+  /// inlining crosses Flux module boundaries. The result is ready for
+  /// writeOutput(). Returns false on parse/link failure.
+  bool linkAndOptimizeBitcode(const std::vector<std::string> &paths);
+
+  /// Execute the generated module in-process via ORC (lazy per-function
+  /// materialization). Runtime symbols from flux_runtime.h are resolved
+  /// against this process. Consumes the module; returns the program's
+  /// exit code, or 255 if the JIT could not be set up.
+  int runJIT();
+
+  /// Create a persistent JIT session (REPL): runtime symbols registered,
+  /// process symbols resolvable. Returns nullptr on failure.
+  static std::unique_ptr<llvm::orc::LLJIT>
+  createJITSession(DiagnosticEngine &diag);
+
+  /// Hand this CodeGen's generated module (and its context) to an
+  /// existing session. Each module is added exactly once; earlier lines
+  /// are never recompiled.
+  bool addToJIT(llvm::orc::LLJIT &jit);
+
   /// Get the LLVM module (for inspection/testing).
   llvm::Module *getLLVMModule() { return llvmModule_.get(); }
 
   /// Get the code generation options.
   CodeGenOptions &getOptions() { return opts_; }
 
+  /// Attribute per-declaration emission time and instruction counts to
+  /// `timer` (--time-per-decl). Not owned; may be null.
+  void setDeclTimer(DeclTimer *timer) { declTimer_ = timer; }
+
 private:
   bool initializeTarget();
   bool runOptimizationPasses();
+
+  /// True when generate() should run the pass pipeline (any -O level,
+  /// or PGO instrumentation/use, which need their passes even at -O0).
+  bool runsOptimizationPipeline() const;
   bool emitToFile(const std::string &filename);
 
   DiagnosticEngine &diag_;
   CodeGenOptions opts_;
 
-  llvm::LLVMContext context_;
+  // unique_ptr so the context can be handed to ORC as a ThreadSafeModule
+  std::unique_ptr<llvm::LLVMContext> context_;
   std::unique_ptr<llvm::Module> llvmModule_;
   llvm::TargetMachine *targetMachine_ = nullptr;
+  DeclTimer *declTimer_ = nullptr;
 };
 
 } // namespace flux
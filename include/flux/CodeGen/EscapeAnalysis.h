@@ -0,0 +1,52 @@
+#pragma once
+
+#include "flux/AST/ASTWalker.h"
+#include "flux/AST/Decl.h"
+
+#include <string>
+#include <unordered_set>
+
+namespace flux {
+
+/// Conservative AST-level escape analysis over one function.
+///
+/// A let-bound value "escapes" when it may outlive the function frame:
+/// it is returned, passed as a call or method argument, stored through
+/// an assignment, captured by ref / mut ref / move, or embedded in an
+/// aggregate. IREmitter promotes the allocation of any constructed
+/// value that does NOT escape from flux_alloc to a stack alloca.
+///
+/// The analysis only ever errs towards "escapes": an identifier in any
+/// escaping position taints the whole variable.
+class EscapeAnalysis : public ast::ASTWalker<EscapeAnalysis> {
+  friend class ast::ASTWalker<EscapeAnalysis>;
+
+public:
+  /// Names of let-bound variables in `func` whose values may escape.
+  static std::unordered_set<std::string> escapingVars(ast::FuncDecl &func);
+
+private:
+  EscapeAnalysis() = default;
+
+  /// Mark every identifier reachable from `expr` as escaping.
+  void markEscaping(ast::Expr &expr);
+
+  // Escaping positions
+  void visitLetStmt(ast::LetStmt &stmt);
+  void visitReturnStmt(ast::ReturnStmt &stmt);
+  void visitCallExpr(ast::CallExpr &expr);
+  void visitMethodCallExpr(ast::MethodCallExpr &expr);
+  void visitAssignExpr(ast::AssignExpr &expr);
+  void visitRefExpr(ast::RefExpr &expr);
+  void visitMutRefExpr(ast::MutRefExpr &expr);
+  void visitMoveExpr(ast::MoveExpr &expr);
+  void visitConstructExpr(ast::ConstructExpr &expr);
+  void visitStructLiteralExpr(ast::StructLiteralExpr &expr);
+  void visitTupleExpr(ast::TupleExpr &expr);
+  void visitArrayExpr(ast::ArrayExpr &expr);
+  void visitClosureExpr(ast::ClosureExpr &expr);
+
+  std::unordered_set<std::string> escaping_;
+};
+
+} // namespace flux
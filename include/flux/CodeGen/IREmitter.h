@@ -1,6 +1,7 @@
 #pragma once
 
 #include "flux/AST/AST.h"
+#include "flux/AST/ASTWalker.h"
 #include "flux/AST/Decl.h"
 #include "flux/AST/Expr.h"
 #include "flux/AST/Stmt.h"
@@ -14,21 +15,62 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace flux {
 
+/// How runtime assertion/contract checks are lowered (CodeGenOptions).
+enum class CheckTier {
+  Full, // out-of-line flux_assert call (best diagnostics)
+  Fast, // inline branch + cold-outlined panic + llvm.assume
+  Off,  // condition evaluated, check elided, llvm.assume emitted
+};
+
 /// Emits LLVM IR from Flux AST nodes.
 ///
 /// This is the core code generation class. It traverses the AST and
-/// produces LLVM IR using the LLVM IRBuilder API.
-class IREmitter {
+/// produces LLVM IR using the LLVM IRBuilder API. Statement dispatch
+/// runs on the static-dispatch ASTWalker (no virtual calls per node);
+/// expression emission keeps its value-returning switch.
+class IREmitter : public ast::ASTWalker<IREmitter> {
+    friend class ast::ASTWalker<IREmitter>;
+
 public:
     IREmitter(llvm::LLVMContext& ctx, llvm::Module& module,
               DiagnosticEngine& diag);
 
     /// Declare prototypes for a top-level declaration (first pass).
     void declareDecl(ast::Decl& decl);
+
+    /// Report bytes lost to padding per struct (--warn-padding).
+    void setWarnPadding(bool warn) { warnPadding_ = warn; }
+
+    /// Select how assert() checks are lowered (--checks=).
+    void setCheckTier(CheckTier tier) { checkTier_ = tier; }
+
+    /// Route heap allocations through the managed GC heap
+    /// (--runtime=gc).
+    void setManagedHeap(bool managed) { managedHeap_ = managed; }
+
+    /// Emit entry/exit trace probes (--instrument-functions).
+    void setInstrumentFunctions(bool on) { instrumentFunctions_ = on; }
+
+    /// Module-wide FP semantics (--ffast-math / --ffp-contract=fast);
+    /// @fastmath widens this per function.
+    void setFPSemantics(bool fastMath, bool contractFast) {
+        moduleFastMath_ = fastMath;
+        moduleFPContract_ = contractFast;
+    }
+
+    /// Bounds checks elided / retained so far (--report-checks).
+    uint64_t checksElided() const { return checksElided_; }
+    uint64_t checksRetained() const { return checksRetained_; }
+
+    /// Mark these functions cold (trace-driven, --cold-functions=).
+    void setColdFunctions(const std::vector<std::string>& names) {
+        coldFunctions_.insert(names.begin(), names.end());
+    }
     void emitDecl(ast::Decl& decl);
     void emitStmt(ast::Stmt& stmt);
     llvm::Value* emitExpr(ast::Expr& expr);
@@ -41,7 +83,21 @@ private:
     void emitStructDecl(ast::StructDecl& decl);
     void emitEnumDecl(ast::EnumDecl& decl);
 
-    // Statement emission
+    // Statement emission (visit handlers invoked by the walker)
+    void visitLetStmt(ast::LetStmt& stmt) { emitLetStmt(stmt); }
+    void visitReturnStmt(ast::ReturnStmt& stmt) { emitReturnStmt(stmt); }
+    void visitIfStmt(ast::IfStmt& stmt) { emitIfStmt(stmt); }
+    void visitForStmt(ast::ForStmt& stmt) { emitForStmt(stmt); }
+    void visitWhileStmt(ast::WhileStmt& stmt) { emitWhileStmt(stmt); }
+    void visitLoopStmt(ast::LoopStmt& stmt) { emitLoopStmt(stmt); }
+    void visitBlockStmt(ast::BlockStmt& stmt) { emitBlockStmt(stmt); }
+    void visitExprStmt(ast::ExprStmt& stmt) { emitExprStmt(stmt); }
+    void visitBreakStmt(ast::BreakStmt& stmt);
+    void visitContinueStmt(ast::ContinueStmt& stmt);
+    void visitMatchStmt(ast::MatchStmt& stmt) { emitMatchStmt(stmt); }
+    // No codegen for const yet; keep it an explicit no-op
+    void visitConstStmt(ast::ConstStmt&) {}
+    void emitMatchStmt(ast::MatchStmt& stmt);
     void emitLetStmt(ast::LetStmt& stmt);
     void emitReturnStmt(ast::ReturnStmt& stmt);
     void emitIfStmt(ast::IfStmt& stmt);
@@ -59,16 +115,33 @@ private:
     llvm::Value* emitIdent(ast::IdentExpr& expr);
     llvm::Value* emitBinaryExpr(ast::BinaryExpr& expr);
     llvm::Value* emitUnaryExpr(ast::UnaryExpr& expr);
+
+    // Value-level operator emission shared by the recursive and the
+    // flattened post-order paths
+    llvm::Value* emitBinaryOp(ast::BinaryExpr& expr, llvm::Value* lhs,
+                              llvm::Value* rhs);
+    llvm::Value* emitUnaryOp(ast::UnaryExpr& expr, llvm::Value* operand);
+
+    /// Flatten a pure computational tree into post-order records and
+    /// emit with a linear sweep. Returns false when the tree contains a
+    /// kind the sweep can't handle (caller uses the recursive emitter);
+    /// when true, `result` holds the value (or nullptr after an error).
+    bool emitFlattenedExpr(ast::Expr& expr, llvm::Value*& result);
     llvm::Value* emitCallExpr(ast::CallExpr& expr);
     llvm::Value* emitIfExpr(ast::IfExpr& expr);
     llvm::Value* emitBlockExpr(ast::BlockExpr& expr);
     llvm::Value* emitAssignExpr(ast::AssignExpr& expr);
+    llvm::Value* emitIndexExpr(ast::IndexExpr& expr);
+    llvm::Value* emitStructLiteralExpr(ast::StructLiteralExpr& expr);
 
     // Helper to create an alloca in the entry block of a function
     llvm::AllocaInst* createEntryBlockAlloca(llvm::Function* func,
                                               const std::string& name,
                                               llvm::Type* type);
 
+    /// Attach a TBAA access tag describing `type` to a load or store.
+    void attachTBAA(llvm::Instruction* inst, llvm::Type* type);
+
     llvm::LLVMContext& ctx_;
     llvm::Module& module_;
     llvm::IRBuilder<> builder_;
@@ -78,6 +151,69 @@ private:
     // Named values in the current scope (name -> alloca)
     std::unordered_map<std::string, llvm::AllocaInst*> namedValues_;
 
+    // Uniqued string literal pool (contents -> read-only global)
+    std::unordered_map<std::string, llvm::Constant*> stringPool_;
+
+    // Field names in layout order per struct (differs from declaration
+    // order under @layout(optimize)); literals index through this
+    std::unordered_map<std::string, std::vector<std::string>>
+        structFieldOrder_;
+    bool warnPadding_ = false;
+    CheckTier checkTier_ = CheckTier::Full;
+    bool managedHeap_ = false;
+    bool instrumentFunctions_ = false;
+    bool moduleFastMath_ = false;
+    bool moduleFPContract_ = false;
+    std::unordered_set<std::string> coldFunctions_;
+
+    // Probe state for the function being emitted (exit probes fire
+    // before every return)
+    llvm::Value* currentProbeID_ = nullptr;
+    llvm::FunctionCallee currentProbeExitFn_;
+
+    // Modifier-style ref parameters of the function being emitted:
+    // name -> pointee type. Reads load through the pointer; assignments
+    // store through it, so mutations reach the caller.
+    std::unordered_map<std::string, llvm::Type*> refParamPointees_;
+
+    // GC root slots registered in the function being emitted
+    // (--runtime=gc); unregistered before every return
+    std::vector<llvm::AllocaInst*> currentGCRoots_;
+
+    /// Emit flux_gc_remove_root for every registered slot (at returns).
+    void emitGCRootRemovals();
+
+    /// Lower assert(cond[, msg]) according to checkTier_.
+    llvm::Value* emitAssertCall(ast::CallExpr& expr);
+
+    /// Address of an lvalue expression (borrow lowering).
+    llvm::Value* emitAddressOf(ast::Expr& expr);
+
+    /// Make a scratch string literal node (owned by scratch_).
+    ast::StringLiteralExpr* ctxLiteral(const std::string& text,
+                                       SourceLocation loc);
+    ast::ASTContext scratch_;
+
+    // TBAA type tree (lazily built; one scalar node per lowered type)
+    llvm::MDNode* tbaaRoot_ = nullptr;
+    std::unordered_map<llvm::Type*, llvm::MDNode*> tbaaTags_;
+
+    // Set while emitting the value of `return <call>`; emitCallExpr
+    // consumes it to mark the call tail/musttail
+    bool inTailPosition_ = false;
+
+    // Bounds-check accounting (--report-checks) and the per-function
+    // set of indexes range analysis proved safe
+    std::unordered_set<const ast::Expr*> safeIndexes_;
+    uint64_t checksElided_ = 0;
+    uint64_t checksRetained_ = 0;
+
+    // Escape analysis for the function being emitted: struct literals
+    // initializing non-escaping lets get stack storage instead of
+    // flux_alloc
+    std::unordered_set<std::string> escapingVars_;
+    bool structLiteralEscapes_ = true;
+
     // Stack of break/continue targets for loops
     struct LoopContext {
         llvm::BasicBlock* breakBlock;
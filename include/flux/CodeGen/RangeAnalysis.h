@@ -0,0 +1,61 @@
+#pragma once
+
+#include "flux/AST/ASTWalker.h"
+#include "flux/AST/Decl.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace flux {
+
+/// AST-level range analysis proving array indexes in bounds.
+///
+/// Walks one function tracking two facts: fixed-size array bindings
+/// (`let a: Array<T, N>`) and loop variables of canonical counted
+/// ranges with literal bounds (`for i in 0..n`). An index expression
+/// whose index is such a loop variable, whose array has a known static
+/// size, and whose loop upper bound cannot exceed that size is added to
+/// the safe set — IREmitter elides the bounds check for those and emits
+/// an llvm.assume fact instead.
+///
+/// Facts are name-keyed, so soundness depends on strict invalidation:
+/// blocks snapshot and restore both fact maps (an inner shadowing
+/// binding dies with its block), any `let` rebinding a tracked name
+/// drops the old fact, and an assignment to a tracked name poisons it
+/// for the rest of the function — a mutated loop variable stays
+/// untrusted even after the block that mutated it ends.
+class RangeAnalysis : public ast::ASTWalker<RangeAnalysis> {
+  friend class ast::ASTWalker<RangeAnalysis>;
+
+public:
+  /// Index expressions in `func` proven in-bounds.
+  static std::unordered_set<const ast::Expr *>
+  safeIndexes(ast::FuncDecl &func);
+
+private:
+  RangeAnalysis() = default;
+
+  struct Range {
+    int64_t min;
+    int64_t max; // inclusive
+  };
+
+  void visitLetStmt(ast::LetStmt &stmt);
+  void visitForStmt(ast::ForStmt &stmt);
+  void visitBlockStmt(ast::BlockStmt &stmt);
+  void visitAssignExpr(ast::AssignExpr &expr);
+  void visitCompoundAssignExpr(ast::CompoundAssignExpr &expr);
+  void visitIndexExpr(ast::IndexExpr &expr);
+
+  /// Drop and poison every fact about `name` (it was mutated).
+  void poison(const std::string &name);
+
+  std::unordered_map<std::string, uint64_t> arraySizes_;
+  std::unordered_map<std::string, Range> loopRanges_;
+  std::unordered_set<std::string> poisoned_;
+  std::unordered_set<const ast::Expr *> safe_;
+};
+
+} // namespace flux
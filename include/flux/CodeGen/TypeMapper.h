@@ -6,6 +6,7 @@
 #include "flux/AST/Stmt.h"
 #include "flux/AST/Type.h"
 #include "flux/Common/Diagnostics.h"
+#include "flux/Sema/TypeContext.h"
 
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LLVMContext.h>
@@ -19,6 +20,10 @@
 namespace flux {
 
 /// Maps Flux type nodes to LLVM types.
+///
+/// Lowerings are memoized on canonical type identity (TypeContext), so
+/// each distinct Flux type — however many AST nodes spell it — is
+/// lowered exactly once per CodeGen run.
 class TypeMapper {
 public:
   explicit TypeMapper(llvm::LLVMContext &ctx);
@@ -33,8 +38,15 @@ public:
   llvm::Type *getVoidType();
 
 private:
+  llvm::Type *lowerType(const ast::TypeNode &type);
+
   llvm::LLVMContext &ctx_;
   std::unordered_map<std::string, llvm::Type *> builtinTypes_;
+
+  // Canonicalizer + memoization cache (canonical type -> lowered type)
+  TypeContext typeCtx_;
+  std::unordered_map<const Type *, llvm::Type *> lowered_;
+
   void initBuiltinTypes();
 };
 
@@ -2,10 +2,15 @@
 
 #include "flux/Common/SourceLocation.h"
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <unordered_set>
 #include <vector>
 
 namespace flux {
@@ -14,11 +19,25 @@ namespace flux {
 enum class DiagnosticSeverity : uint8_t { Note, Warning, Error, Fatal };
 
 /// A single diagnostic message with source location and optional hints.
+///
+/// Messages can be carried in two forms:
+///  - eager: `message` holds the fully formatted text (legacy emit paths)
+///  - lazy:  `format` + `args` hold a "{0}"-style template and its
+///    argument pack; the text is only assembled when renderMessage() is
+///    called — i.e. when a sink actually displays the diagnostic.
 struct Diagnostic {
   DiagnosticSeverity severity;
   SourceLocation location;
   std::string message;
 
+  // Lazy payload (used when `message` is empty)
+  const char *format = nullptr;
+  std::vector<std::string> args;
+
+  /// Assemble the message text. Cheap for eager diagnostics; formats the
+  /// template on demand for lazy ones.
+  std::string renderMessage() const;
+
   // Optional: related notes and hints
   struct Note {
     SourceLocation location;
@@ -35,8 +54,19 @@ struct Diagnostic {
   std::vector<Fix> fixes;
 };
 
+/// Consumer interface for diagnostics.
+///
+/// Sinks receive unrendered diagnostics; ones that drop or filter (IDE
+/// integrations, deduplicators) never pay for message formatting.
+class DiagnosticSink {
+public:
+  virtual ~DiagnosticSink() = default;
+  virtual void handleDiagnostic(const Diagnostic &diag) = 0;
+};
+
 /// Diagnostic engine for the Flux compiler.
-/// Collects and formats error messages in Flux's rich error style.
+/// Collects diagnostics and dispatches them to a DiagnosticSink; the
+/// default sink formats in Flux's rich error style and prints to stderr.
 ///
 /// Example output:
 ///   error[E0308]: mismatched types
@@ -53,12 +83,32 @@ public:
 
   DiagnosticEngine();
 
-  /// Set a custom handler for diagnostics (default: print to stderr).
+  /// Direct the engine's output to a custom sink (not owned; must
+  /// outlive the engine). Pass nullptr to restore the default stderr
+  /// sink.
+  void setSink(DiagnosticSink *sink);
+
+  /// Convenience adapter for callback-style consumers; wraps the
+  /// callback in an internal sink.
   void setHandler(DiagnosticHandler handler);
 
   /// Set the source manager for rich error formatting.
   void setSourceManager(const SourceManager *sm);
 
+  /// Stop emitting after `limit` errors (0 = unlimited). Crossing the
+  /// limit dispatches one fatal "too many errors" diagnostic; everything
+  /// after that is counted as suppressed, not stored or formatted.
+  void setErrorLimit(uint32_t limit) { errorLimit_ = limit; }
+
+  /// Diagnostics dropped by deduplication or the error limit.
+  uint32_t suppressedCount() const {
+    return suppressedCount_.load(std::memory_order_relaxed);
+  }
+
+  bool errorLimitReached() const {
+    return limitReached_.load(std::memory_order_relaxed);
+  }
+
   // --- Emission methods ---
 
   void emitError(SourceLocation loc, const std::string &message);
@@ -66,16 +116,45 @@ public:
   void emitNote(SourceLocation loc, const std::string &message);
   void emitFatal(SourceLocation loc, const std::string &message);
 
-  /// Emit a diagnostic with full detail.
+  /// Lazy emission: `format` uses "{0}", "{1}", ... placeholders filled
+  /// from `args`. The text is not assembled unless a sink renders it, so
+  /// diagnostics that get filtered or dropped cost no formatting.
+  /// `format` must be a string literal (the engine stores the pointer).
+  void report(DiagnosticSeverity severity, SourceLocation loc,
+              const char *format, std::vector<std::string> args = {});
+
+  /// Emit a diagnostic with full detail. Thread-safe: deduplication and
+  /// counters shard/atomically update; dispatch serializes on a mutex
+  /// (or, in buffered mode, defers entirely to flush()).
   void emit(Diagnostic diag);
 
+  // --- Parallel emission ---
+
+  /// Buffered mode for parallel phases: emissions append to per-shard
+  /// buffers with only shard-local locking, and nothing reaches the
+  /// sink until flush() merges all shards ordered by source location —
+  /// deterministic output regardless of worker interleaving.
+  void setBuffered(bool buffered) { buffered_ = buffered; }
+
+  /// Dispatch buffered diagnostics in source order.
+  void flush();
+
+  /// Render a diagnostic in the engine's output style (used by sinks).
+  std::string formatDiagnostic(const Diagnostic &diag) const;
+
   // --- Query ---
 
-  bool hasErrors() const { return errorCount_ > 0; }
-  uint32_t errorCount() const { return errorCount_; }
-  uint32_t warningCount() const { return warningCount_; }
-  uint32_t getErrorCount() const { return errorCount_; }
-  uint32_t getWarningCount() const { return warningCount_; }
+  bool hasErrors() const {
+    return errorCount_.load(std::memory_order_relaxed) > 0;
+  }
+  uint32_t errorCount() const {
+    return errorCount_.load(std::memory_order_relaxed);
+  }
+  uint32_t warningCount() const {
+    return warningCount_.load(std::memory_order_relaxed);
+  }
+  uint32_t getErrorCount() const { return errorCount(); }
+  uint32_t getWarningCount() const { return warningCount(); }
 
   /// Get all collected diagnostics (when using collection mode).
   const std::vector<Diagnostic> &diagnostics() const { return diagnostics_; }
@@ -84,15 +163,67 @@ public:
   void reset();
 
 private:
-  void defaultHandler(const Diagnostic &diag);
-  std::string formatDiagnostic(const Diagnostic &diag) const;
+  /// Default sink: format and print to stderr.
+  class StderrSink : public DiagnosticSink {
+  public:
+    explicit StderrSink(const DiagnosticEngine &engine) : engine_(engine) {}
+    void handleDiagnostic(const Diagnostic &diag) override;
+
+  private:
+    const DiagnosticEngine &engine_;
+  };
+
+  /// Adapter that forwards to a std::function (setHandler compatibility).
+  class CallbackSink : public DiagnosticSink {
+  public:
+    explicit CallbackSink(DiagnosticHandler handler)
+        : handler_(std::move(handler)) {}
+    void handleDiagnostic(const Diagnostic &diag) override {
+      handler_(diag);
+    }
+
+  private:
+    DiagnosticHandler handler_;
+  };
+
   std::string severityString(DiagnosticSeverity severity) const;
 
-  DiagnosticHandler handler_;
+  /// Identity hash for deduplication: location + message payload.
+  static uint64_t dedupeKey(const Diagnostic &diag);
+
+  /// Count and (unless buffered) store + dispatch one deduped
+  /// diagnostic.
+  void dispatch(Diagnostic diag);
+
+  // Storage is bounded independently of the error limit so one bad
+  // file cannot balloon memory with distinct diagnostics either
+  static constexpr size_t kMaxStoredDiagnostics = 4096;
+
+  // Emissions shard by dedupe hash: the same diagnostic from any thread
+  // lands in the same shard, so dedup stays global while contention
+  // stays shard-local
+  static constexpr size_t kShards = 16;
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_set<uint64_t> seen;
+    std::vector<Diagnostic> pending; // buffered mode only
+  };
+
+  StderrSink defaultSink_;
+  std::unique_ptr<CallbackSink> callbackSink_; // owns setHandler adapters
+  DiagnosticSink *sink_ = nullptr;             // active sink (never null)
   const SourceManager *sourceManager_ = nullptr;
-  std::vector<Diagnostic> diagnostics_;
-  uint32_t errorCount_ = 0;
-  uint32_t warningCount_ = 0;
+  std::vector<Diagnostic> diagnostics_; // guarded by dispatchMutex_
+  std::atomic<uint32_t> errorCount_{0};
+  std::atomic<uint32_t> warningCount_{0};
+
+  // Deduplication, bounding, and parallel emission
+  std::array<Shard, kShards> shards_;
+  std::mutex dispatchMutex_; // serializes sink dispatch and storage
+  std::atomic<bool> buffered_{false};
+  uint32_t errorLimit_ = 0; // 0 = unlimited; set before parallel phases
+  std::atomic<uint32_t> suppressedCount_{0};
+  std::atomic<bool> limitReached_{false};
 };
 
 } // namespace flux
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flux {
+
+/// Background file readahead for import resolution.
+///
+/// prefetch() queues paths and returns immediately; worker threads ask
+/// the OS to pull the bytes into the page cache (posix_fadvise
+/// WILLNEED, with a read fallback), so by the time SourceManager or
+/// ModuleInterface synchronously opens the file the data is warm.
+/// Parsing of the current file overlaps the I/O for everything it
+/// imports instead of paying serial read latency per dependency.
+class FilePrefetcher {
+public:
+  explicit FilePrefetcher(unsigned workers = 2);
+  ~FilePrefetcher();
+
+  FilePrefetcher(const FilePrefetcher &) = delete;
+  FilePrefetcher &operator=(const FilePrefetcher &) = delete;
+
+  /// Queue a path for background readahead (missing files are ignored).
+  void prefetch(std::string path);
+
+  /// Block until every queued path has been touched.
+  void wait();
+
+private:
+  void workerLoop();
+  static void touchFile(const std::string &path);
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable idleCV_;
+  std::vector<std::string> queue_;
+  std::vector<std::thread> workers_;
+  unsigned inFlight_ = 0;
+  bool stopping_ = false;
+};
+
+} // namespace flux
@@ -2,25 +2,32 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace flux {
 
-/// Represents a position in a source file.
+/// Represents a position in a source file, encoded in 32 bits.
+///
+/// The value is an index into the SourceManager's global source address
+/// space: each loaded file occupies a contiguous range starting at its
+/// base offset (the first file starts at 1; 0 means "unknown"). Filename,
+/// line, and column are decoded lazily through SourceManager::decode(),
+/// so an AST node pays four bytes for its location instead of carrying
+/// the decoded fields around.
 struct SourceLocation {
-  std::string_view filename;
-  uint32_t line = 1;
-  uint32_t column = 1;
-  uint32_t offset = 0; // byte offset into the source buffer
+  uint32_t raw = 0;
 
-  static SourceLocation unknown() {
-    return SourceLocation{"<unknown>", 0, 0, 0};
-  }
+  static SourceLocation fromRaw(uint32_t raw) { return SourceLocation{raw}; }
 
-  bool isValid() const { return line > 0 && column > 0; }
+  static SourceLocation unknown() { return SourceLocation{}; }
+
+  bool isValid() const { return raw != 0; }
 
+  /// Render without a SourceManager (raw offset only). Prefer
+  /// SourceManager::decode() when a manager is available.
   std::string toString() const;
 };
 
@@ -32,10 +39,36 @@ struct SourceRange {
   bool isValid() const { return begin.isValid() && end.isValid(); }
 };
 
+/// A SourceLocation decoded back into human-readable coordinates.
+struct DecodedLocation {
+  std::string_view filename;
+  uint32_t line = 0;
+  uint32_t column = 0;
+  uint32_t offset = 0; // byte offset into the file's source buffer
+
+  bool isValid() const { return line > 0 && column > 0; }
+
+  std::string toString() const;
+};
+
 /// Manages source file content for the compiler.
 /// Owns the source text and provides location lookups.
+///
+/// Regular files are memory-mapped read-only, so source bytes are never
+/// copied and the page cache is shared between concurrent compiler
+/// processes. Pipes, stdin, and platforms without mmap fall back to
+/// reading into an owned buffer.
 class SourceManager {
 public:
+  SourceManager() = default;
+  ~SourceManager();
+
+  // File mappings are process-unique; the manager is move-only.
+  SourceManager(const SourceManager &) = delete;
+  SourceManager &operator=(const SourceManager &) = delete;
+  SourceManager(SourceManager &&) = default;
+  SourceManager &operator=(SourceManager &&) = default;
+
   /// Load a source file from disk. Returns the file ID (index).
   uint32_t loadFile(const std::string &path);
 
@@ -48,17 +81,44 @@ public:
   /// Get the filename for a file.
   std::string_view getFilename(uint32_t fileId) const;
 
-  /// Convert byte offset to line/column.
-  SourceLocation getLocation(uint32_t fileId, uint32_t offset) const;
+  /// Base of the file's range in the global source address space. Pass
+  /// this to the Lexer so the locations it encodes decode back here.
+  uint32_t fileBase(uint32_t fileId) const;
+
+  /// Encode a (file, byte offset) pair as a compact SourceLocation.
+  SourceLocation makeLocation(uint32_t fileId, uint32_t offset) const;
+
+  /// Decode a compact location back to filename/line/column.
+  DecodedLocation decode(SourceLocation loc) const;
+
+  /// Convert byte offset to line/column within a file.
+  DecodedLocation getLocation(uint32_t fileId, uint32_t offset) const;
+
+  /// Total bytes of source buffers held (mapped + owned), plus the
+  /// line tables; for --mem-stats.
+  size_t totalBufferBytes() const;
 
 private:
   struct FileEntry {
     std::string filename;
-    std::string content;
+    std::string content;        // owned bytes (loadFromString / fallback path)
+    std::string_view data;      // the source text: content or a file mapping
+    uint32_t baseOffset = 1;    // base in the global source address space
+    void *mapping = nullptr;    // mmap base when memory-mapped
+    size_t mappingSize = 0;     // mapped length (may exceed data.size())
     std::vector<uint32_t> lineOffsets; // byte offset of each line start
   };
 
-  std::vector<FileEntry> files_;
+  // Entries are heap-allocated so the string_views handed out by
+  // getSource stay valid as files_ grows.
+  std::vector<std::unique_ptr<FileEntry>> files_;
+
+  /// Register a loaded entry: assign its base offset and line table.
+  uint32_t finishEntry(std::unique_ptr<FileEntry> entry);
+
+  /// Try to memory-map `path` into `entry`. Returns false for pipes,
+  /// special files, or when mapping is unavailable.
+  bool mapFile(const std::string &path, FileEntry &entry);
 
   void computeLineOffsets(FileEntry &entry);
 };
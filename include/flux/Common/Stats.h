@@ -0,0 +1,95 @@
+#pragma once
+
+#include "flux/Common/SourceLocation.h"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace flux {
+
+/// Per-phase wall-clock timings and counters for the --stats report.
+///
+/// The driver creates one of these per compilation, wraps each pipeline
+/// phase in a PhaseTimer, and records interesting counters (token count,
+/// AST node count, arena bytes, ...) as they become available. report()
+/// prints a human-readable table including peak RSS.
+class CompilationStats {
+public:
+  /// RAII scope that records the wall time of one phase.
+  class PhaseTimer {
+  public:
+    PhaseTimer(CompilationStats &stats, std::string name)
+        : stats_(stats), name_(std::move(name)),
+          start_(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() {
+      auto end = std::chrono::steady_clock::now();
+      stats_.addPhase(name_,
+                      std::chrono::duration_cast<std::chrono::microseconds>(
+                          end - start_)
+                          .count());
+    }
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+  private:
+    CompilationStats &stats_;
+    std::string name_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  void addPhase(const std::string &name, uint64_t micros) {
+    phases_.emplace_back(name, micros);
+  }
+
+  void setCounter(const std::string &name, uint64_t value) {
+    counters_.emplace_back(name, value);
+  }
+
+  /// Print the report (phases, counters, peak RSS).
+  void report(std::ostream &out) const;
+
+  /// Peak resident set size of this process in bytes (0 if unknown).
+  static uint64_t peakRSSBytes();
+
+private:
+  std::vector<std::pair<std::string, uint64_t>> phases_;   // name, micros
+  std::vector<std::pair<std::string, uint64_t>> counters_; // name, value
+};
+
+/// Per-declaration compile-time attribution (--time-per-decl).
+///
+/// Sema and CodeGen record wall time (and CodeGen the LLVM instruction
+/// count) against each top-level declaration; report() prints the top
+/// offenders with their source locations so a single pathological
+/// function is visible without bisecting the file.
+class DeclTimer {
+public:
+  void recordSema(const std::string &name, SourceLocation loc,
+                  uint64_t micros);
+  void recordCodeGen(const std::string &name, SourceLocation loc,
+                     uint64_t micros, uint64_t instructions);
+
+  /// Print the top `count` declarations by total time.
+  void report(std::ostream &out, const SourceManager *sourceManager,
+              size_t count = 10) const;
+
+private:
+  struct Entry {
+    SourceLocation location;
+    uint64_t semaMicros = 0;
+    uint64_t codegenMicros = 0;
+    uint64_t instructions = 0;
+  };
+
+  Entry &entry(const std::string &name, SourceLocation loc);
+
+  std::vector<std::pair<std::string, Entry>> entries_;
+};
+
+} // namespace flux
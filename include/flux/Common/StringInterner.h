@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace flux {
+
+/// A 32-bit handle for an interned identifier. 0 is reserved for "none".
+using SymbolID = uint32_t;
+
+inline constexpr SymbolID kInvalidSymbolID = 0;
+
+/// Uniquing table for identifier spellings.
+///
+/// Interning is guarded by a mutex so parallel front-end workers can
+/// share one table; IDs handed out are stable and lock-free to compare.
+///
+/// Each distinct identifier is hashed exactly once — at lex time — and is
+/// represented everywhere after that by a dense 32-bit SymbolID. Symbol
+/// tables and type registries key their maps on the ID, so name lookup is
+/// an integer hash instead of a string hash plus memcmp.
+class StringInterner {
+public:
+  /// Intern a spelling, returning its stable ID. The returned ID compares
+  /// equal for equal spellings for the lifetime of the interner.
+  SymbolID intern(std::string_view text);
+
+  /// Get the spelling for an ID. The view is stable for the lifetime of
+  /// the interner.
+  std::string_view text(SymbolID id) const;
+
+  /// Number of distinct identifiers interned so far.
+  size_t size() const { return spellings_.size(); }
+
+  /// Bytes of spelling storage reserved (for --mem-stats).
+  size_t storageBytes() const;
+
+private:
+  // Spellings are copied into stable chunks so the views in map_ and
+  // spellings_ survive growth.
+  std::string_view store(std::string_view text);
+
+  static constexpr size_t kChunkSize = 16 * 1024;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string_view, SymbolID> map_;
+  std::vector<std::string_view> spellings_; // index = SymbolID - 1
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  size_t chunkUsed_ = 0;
+  size_t storageBytes_ = 0;
+};
+
+/// The process-wide interner shared by Lexer, Sema, and the AST passes.
+StringInterner &globalInterner();
+
+} // namespace flux
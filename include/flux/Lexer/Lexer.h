@@ -26,8 +26,12 @@ class Lexer {
 public:
   /// Construct a lexer for the given source text.
   /// The source text must outlive the lexer.
+  ///
+  /// `locationBase` is the file's base in the SourceManager's global
+  /// source address space (SourceManager::fileBase); the default of 1
+  /// matches a manager holding just this file.
   Lexer(std::string_view source, std::string_view filename,
-        DiagnosticEngine &diag);
+        DiagnosticEngine &diag, uint32_t locationBase = 1);
 
   /// Lex the next token from the source.
   Token nextToken();
@@ -41,19 +45,16 @@ public:
   /// Check if we've reached the end of the source.
   bool isAtEnd() const;
 
-  /// State snapshot for save/restore (used by Parser lookahead).
-  struct State {
-    uint32_t current;
-    uint32_t tokenStart;
-    uint32_t line;
-    uint32_t column;
-    uint32_t tokenLine;
-    uint32_t tokenColumn;
-    bool hasPeeked;
-    Token peekedToken;
-  };
-  State saveState() const;
-  void restoreState(const State &s);
+  // --- Token payload access (tokens themselves are 16 bytes) ---
+
+  /// The token's spelling: a view into the source buffer.
+  std::string_view tokenText(const Token &token) const;
+
+  /// Parsed value of an integer literal token.
+  int64_t intValue(const Token &token) const;
+
+  /// Parsed value of a float literal token.
+  double floatValue(const Token &token) const;
 
 private:
   // Character inspection
@@ -67,6 +68,10 @@ private:
   void skipLineComment();
   bool skipBlockComment();
 
+  /// Advance over `count` bytes known to contain no newline (used by the
+  /// SIMD run scanners in Lexer.cpp).
+  void advanceColumns(uint32_t count);
+
   // Token producers
   Token makeToken(TokenKind kind) const;
   Token makeToken(TokenKind kind, std::string_view text) const;
@@ -82,15 +87,38 @@ private:
   // Keyword lookup
   TokenKind identifierKind(std::string_view text) const;
 
+  // UTF-8 pre-pass: validate the whole buffer once (SIMD ASCII chunks,
+  // scalar multi-byte checks) and build a per-64-byte-span non-ASCII
+  // bitmap so the token paths stay ASCII-only unless a span needs more
+  void validateSource();
+  bool spanHasNonASCII(uint32_t offset) const;
+
+  /// Consume one valid multi-byte UTF-8 sequence at current_ (the
+  /// pre-pass guarantees well-formedness). Returns its byte length.
+  uint32_t consumeUTF8Sequence();
+
   // Source state
   std::string_view source_;
   std::string_view filename_;
   uint32_t current_ = 0;    // current byte position
   uint32_t tokenStart_ = 0; // start of the current token
-  uint32_t line_ = 1;
-  uint32_t column_ = 1;
-  uint32_t tokenLine_ = 1;
-  uint32_t tokenColumn_ = 1;
+  uint32_t locationBase_ = 1; // file base in the global source space
+
+  // Bit per 64-byte span that contains a non-ASCII byte
+  std::vector<uint64_t> nonAsciiSpans_;
+
+  // Literal payloads, out of band (token.symbol is a 1-based index)
+  std::vector<int64_t> intValues_;
+  std::vector<double> floatValues_;
+
+  SymbolID storeInt(int64_t value) {
+    intValues_.push_back(value);
+    return static_cast<SymbolID>(intValues_.size());
+  }
+  SymbolID storeFloat(double value) {
+    floatValues_.push_back(value);
+    return static_cast<SymbolID>(floatValues_.size());
+  }
 
   // Peeked token cache
   bool hasPeeked_ = false;
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "flux/Common/SourceLocation.h"
+#include "flux/Common/StringInterner.h"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -158,17 +161,131 @@ enum class TokenKind : uint16_t {
   Apostrophe, // ' (lifetime marker)
 };
 
-/// A token produced by the lexer.
+constexpr size_t kTokenKindCount =
+    static_cast<size_t>(TokenKind::Apostrophe) + 1;
+
+/// Per-kind token properties, precomputed into one constexpr table so
+/// the classifications the parser consults for every token — binary
+/// operator precedence, assignment-ness, can-start-expression — are
+/// single indexed loads instead of branchy switches.
+struct TokenTraits {
+  uint8_t binaryPrecedence = 0; // 0 = not a binary operator; 1 loosest
+  bool isAssignment = false;    // '=' or a compound assignment
+  bool canStartExpression = false;
+};
+
+namespace detail {
+
+constexpr uint8_t binaryPrecedenceFor(TokenKind kind) {
+  switch (kind) {
+  case TokenKind::KwOr: return 1;
+  case TokenKind::KwAnd: return 2;
+  case TokenKind::EqualEqual:
+  case TokenKind::BangEqual: return 3;
+  case TokenKind::Less:
+  case TokenKind::LessEqual:
+  case TokenKind::Greater:
+  case TokenKind::GreaterEqual: return 4;
+  case TokenKind::Pipe: return 5;
+  case TokenKind::Caret: return 6;
+  case TokenKind::Ampersand: return 7;
+  case TokenKind::ShiftLeft:
+  case TokenKind::ShiftRight: return 8;
+  case TokenKind::Plus:
+  case TokenKind::Minus: return 9;
+  case TokenKind::Star:
+  case TokenKind::Slash:
+  case TokenKind::Percent: return 10;
+  default: return 0;
+  }
+}
+
+constexpr bool isAssignmentFor(TokenKind kind) {
+  switch (kind) {
+  case TokenKind::Equal:
+  case TokenKind::PlusEqual:
+  case TokenKind::MinusEqual:
+  case TokenKind::StarEqual:
+  case TokenKind::SlashEqual:
+  case TokenKind::PercentEqual:
+  case TokenKind::AmpersandEqual:
+  case TokenKind::PipeEqual:
+  case TokenKind::CaretEqual:
+    return true;
+  default:
+    return false;
+  }
+}
+
+constexpr bool canStartExpressionFor(TokenKind kind) {
+  switch (kind) {
+  case TokenKind::IntLiteral:
+  case TokenKind::FloatLiteral:
+  case TokenKind::StringLiteral:
+  case TokenKind::CharLiteral:
+  case TokenKind::BoolLiteral:
+  case TokenKind::Identifier:
+  case TokenKind::KwTrue:
+  case TokenKind::KwFalse:
+  case TokenKind::KwSelf:
+  case TokenKind::KwIf:
+  case TokenKind::KwMatch:
+  case TokenKind::KwMove:
+  case TokenKind::KwRef:
+  case TokenKind::KwMut:
+  case TokenKind::KwNot:
+  case TokenKind::KwAwait:
+  case TokenKind::KwAssert:
+  case TokenKind::KwPanic:
+  case TokenKind::LParen:
+  case TokenKind::LBracket:
+  case TokenKind::LBrace:
+  case TokenKind::Minus:
+  case TokenKind::Tilde:
+  case TokenKind::Pipe: // closure parameter list
+  case TokenKind::Underscore:
+    return true;
+  default:
+    return false;
+  }
+}
+
+} // namespace detail
+
+/// The table itself; index with the token kind.
+inline constexpr auto kTokenTraits = [] {
+  std::array<TokenTraits, kTokenKindCount> table{};
+  for (size_t i = 0; i < kTokenKindCount; ++i) {
+    TokenKind kind = static_cast<TokenKind>(i);
+    table[i].binaryPrecedence = detail::binaryPrecedenceFor(kind);
+    table[i].isAssignment = detail::isAssignmentFor(kind);
+    table[i].canStartExpression = detail::canStartExpressionFor(kind);
+  }
+  return table;
+}();
+
+constexpr const TokenTraits &tokenTraits(TokenKind kind) {
+  return kTokenTraits[static_cast<size_t>(kind)];
+}
+
+/// A token produced by the lexer — compacted to 16 bytes.
+///
+/// The spelling is not stored: it is a (location, length) window into
+/// the source buffer, materialized on demand via Lexer::tokenText().
+/// Parsed literal payloads live in side tables owned by the Lexer
+/// (Lexer::intValue / floatValue), indexed through `symbol`, which for
+/// identifiers holds the interned SymbolID instead. `textOffset` covers
+/// tokens whose spelling starts past the token itself (string literal
+/// content after the opening quote).
 struct Token {
   TokenKind kind = TokenKind::Eof;
-  std::string_view text; // view into the source buffer
+  uint16_t textOffset = 0; // spelling starts this many bytes in
+  uint32_t length = 0;     // spelling length in bytes
   SourceLocation location;
 
-  // For numeric literals, the parsed value
-  union {
-    int64_t intValue;
-    double floatValue;
-  };
+  // Identifier: interned SymbolID. Int/Float literal: 1-based index
+  // into the lexer's value side table. Otherwise kInvalidSymbolID.
+  SymbolID symbol = kInvalidSymbolID;
 
   bool is(TokenKind k) const { return kind == k; }
   bool isNot(TokenKind k) const { return kind != k; }
@@ -195,4 +312,7 @@ struct Token {
   static const char *kindToString(TokenKind kind);
 };
 
+static_assert(sizeof(Token) == 16, "Token must stay 16 bytes — the token "
+                                   "stream bounds lexer/parser cache use");
+
 } // namespace flux
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "flux/AST/AST.h"
+#include "flux/Common/Diagnostics.h"
+#include "flux/Parser/Parser.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace flux {
+
+/// A single text edit: `removedLength` bytes at `start` are replaced by
+/// `insertedText`.
+struct SourceEdit {
+  uint32_t start = 0;
+  uint32_t removedLength = 0;
+  std::string insertedText;
+};
+
+/// Incremental front end for editor-sized edits.
+///
+/// Keeps the current source text and AST resident. applyEdit() splices
+/// the text, re-lexes and re-parses only the top-level declarations
+/// whose extent intersects the edit, and stitches the untouched
+/// DeclPtrs into the new module — a keystroke in a 5k-line file
+/// re-parses one function, not the file.
+///
+/// Reused declarations keep the arenas that own them alive (the session
+/// retires old modules instead of destroying them). Their recorded
+/// locations stay in pre-edit coordinates; diagnostics for untouched
+/// code may therefore be offset by the edit delta until the next full
+/// reparse. Call reparseAll() when exact locations matter more than
+/// latency.
+class IncrementalSession {
+public:
+  explicit IncrementalSession(DiagnosticEngine &diag) : diag_(diag) {}
+
+  /// Initial full parse of a document.
+  ast::Module *open(std::string source, std::string filename);
+
+  /// Apply one edit and reparse the damaged declaration window.
+  ast::Module *applyEdit(const SourceEdit &edit);
+
+  /// Throw away incremental state and parse the current text fresh.
+  ast::Module *reparseAll();
+
+  const std::string &source() const { return source_; }
+  ast::Module *module() { return module_.get(); }
+
+  /// Number of declarations reused (not re-parsed) by the last
+  /// applyEdit call, for instrumentation and tests.
+  size_t lastReuseCount() const { return lastReuseCount_; }
+
+private:
+  /// Byte offset of a declaration's start in the current source.
+  static uint32_t declOffset(const ast::Decl &decl) {
+    return decl.location.raw > 0 ? decl.location.raw - 1 : 0;
+  }
+
+  DiagnosticEngine &diag_;
+  std::string source_;
+  std::string filename_;
+  std::unique_ptr<ast::Module> module_;
+
+  // Arenas owning declarations still referenced by module_
+  std::vector<std::unique_ptr<ast::Module>> retired_;
+
+  size_t lastReuseCount_ = 0;
+};
+
+} // namespace flux
@@ -10,6 +10,7 @@
 #include "flux/Lexer/Lexer.h"
 #include "flux/Lexer/Token.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -44,8 +45,46 @@ public:
   /// Parse a complete module (entry point).
   std::unique_ptr<ast::Module> parseModule();
 
+  /// Parse a complete module, invoking `declReady` as each top-level
+  /// declaration finishes parsing (used by the pipelined front end to
+  /// overlap parsing with sema).
+  std::unique_ptr<ast::Module>
+  parseModule(const std::function<void(ast::DeclPtr)> &declReady);
+
+  /// One top-level declaration name found by preScanTopLevelNames().
+  /// Enum variants are reported too (keyword == Identifier with `parent`
+  /// naming the enum): they are visible across declarations, so the
+  /// pipelined front end must pre-register them like top-level names.
+  struct TopLevelName {
+    TokenKind keyword; // KwFunc/KwStruct/KwClass/KwEnum/KwTrait/KwType,
+                       // KwImport, or Identifier for an enum variant
+    std::string name;
+    SourceLocation location;
+    bool isPublic = false;
+    std::string parent; // enclosing enum, for variant entries
+  };
+
+  /// Cheap token-level scan of the whole stream for top-level
+  /// declaration names, without consuming any tokens. The pipelined
+  /// front end uses this to pre-register symbols so declaration bodies
+  /// can be resolved out of order.
+  std::vector<TopLevelName> preScanTopLevelNames();
+
+private:
+  /// Collect the variant names of an enum body starting at `index`
+  /// (token after the enum's name) for the pre-scan.
+  void scanEnumVariants(size_t index, const std::string &enumName,
+                        std::vector<TopLevelName> &names);
+
+public:
+
+  /// Number of tokens lexed into the buffer so far (for --stats).
+  size_t tokenCount() const { return tokens_.size(); }
+
 private:
   // ---- Token management ----
+  // Tokens are lexed exactly once into a growable buffer; lookahead and
+  // backtracking are index operations on that buffer.
   Token current() const { return current_; }
   Token advance();
   bool check(TokenKind kind) const;
@@ -53,17 +92,28 @@ private:
   Token expect(TokenKind kind, const std::string &message);
   Token expectSemicolon();
 
+  /// Token at an absolute buffer index, lexing on demand.
+  const Token &tokenAt(size_t index);
+
+  /// Spelling of a token (tokens store a window, not the text).
+  std::string_view text(const Token &token) const {
+    return lexer_.tokenText(token);
+  }
+
+  /// Token n positions past the current one (n == 0 is the current token).
+  const Token &peekAhead(size_t n);
+
   // ---- Top-level declarations ----
   ast::DeclPtr parseDeclaration();
-  std::unique_ptr<ast::ModuleDecl> parseModuleDecl();
-  std::unique_ptr<ast::ImportDecl> parseImportDecl();
-  std::unique_ptr<ast::FuncDecl> parseFuncDecl(bool isAsync = false);
-  std::unique_ptr<ast::StructDecl> parseStructDecl();
-  std::unique_ptr<ast::ClassDecl> parseClassDecl();
-  std::unique_ptr<ast::EnumDecl> parseEnumDecl();
-  std::unique_ptr<ast::TraitDecl> parseTraitDecl();
-  std::unique_ptr<ast::ImplDecl> parseImplDecl();
-  std::unique_ptr<ast::TypeAliasDecl> parseTypeAliasDecl();
+  ast::ModuleDecl *parseModuleDecl();
+  ast::ImportDecl *parseImportDecl();
+  ast::FuncDecl *parseFuncDecl(bool isAsync = false);
+  ast::StructDecl *parseStructDecl();
+  ast::ClassDecl *parseClassDecl();
+  ast::EnumDecl *parseEnumDecl();
+  ast::TraitDecl *parseTraitDecl();
+  ast::ImplDecl *parseImplDecl();
+  ast::TypeAliasDecl *parseTypeAliasDecl();
 
   // ---- Helpers for declarations ----
   std::vector<ast::GenericParam> parseGenericParams();
@@ -76,29 +126,24 @@ private:
 
   // ---- Statements ----
   ast::StmtPtr parseStatement();
-  std::unique_ptr<ast::LetStmt> parseLetStmt();
-  std::unique_ptr<ast::ConstStmt> parseConstStmt();
-  std::unique_ptr<ast::ReturnStmt> parseReturnStmt();
-  std::unique_ptr<ast::IfStmt> parseIfStmt();
-  std::unique_ptr<ast::MatchStmt> parseMatchStmt();
-  std::unique_ptr<ast::ForStmt> parseForStmt();
-  std::unique_ptr<ast::WhileStmt> parseWhileStmt();
-  std::unique_ptr<ast::LoopStmt> parseLoopStmt();
-  std::unique_ptr<ast::BlockStmt> parseBlock();
-
-  // ---- Expressions (Pratt parser / precedence climbing) ----
+  ast::LetStmt *parseLetStmt();
+  ast::ConstStmt *parseConstStmt();
+  ast::ReturnStmt *parseReturnStmt();
+  ast::IfStmt *parseIfStmt();
+  ast::MatchStmt *parseMatchStmt();
+  ast::ForStmt *parseForStmt();
+  ast::WhileStmt *parseWhileStmt();
+  ast::LoopStmt *parseLoopStmt();
+  ast::BlockStmt *parseBlock();
+
+  // ---- Expressions (precedence climbing) ----
   ast::ExprPtr parseExpression();
   ast::ExprPtr parseAssignment();
-  ast::ExprPtr parseOr();
-  ast::ExprPtr parseAnd();
-  ast::ExprPtr parseEquality();
-  ast::ExprPtr parseComparison();
-  ast::ExprPtr parseBitwiseOr();
-  ast::ExprPtr parseBitwiseXor();
-  ast::ExprPtr parseBitwiseAnd();
-  ast::ExprPtr parseShift();
-  ast::ExprPtr parseAdditive();
-  ast::ExprPtr parseMultiplicative();
+
+  /// Table-driven precedence climbing over every binary operator level
+  /// (or .. multiplicative); one loop instead of a recursion ladder.
+  ast::ExprPtr parseBinaryExpr(int minPrecedence = 1);
+
   ast::ExprPtr parseUnary();
   ast::ExprPtr parsePostfix(ast::ExprPtr left);
   ast::ExprPtr parsePrimary();
@@ -128,12 +173,9 @@ private:
   void synchronize();
 
   // ---- Lookahead / state snapshot ----
+  /// A snapshot is just a position in the token buffer.
   struct ParserState {
-    Token current;
-    Token previous;
-    uint32_t lexerPos;
-    uint32_t lexerLine;
-    uint32_t lexerColumn;
+    size_t pos;
   };
   ParserState saveState() const;
   void restoreState(const ParserState &state);
@@ -141,8 +183,13 @@ private:
   // ---- State ----
   Lexer &lexer_;
   DiagnosticEngine &diag_;
+  std::vector<Token> tokens_; // every token lexed so far (ends at Eof)
+  size_t pos_ = 0;            // index of current_ within tokens_
   Token current_;
   Token previous_;
+
+  /// Arena for the module being parsed; owned by the returned Module.
+  ast::ASTContext *ctx_ = nullptr;
 };
 
 } // namespace flux
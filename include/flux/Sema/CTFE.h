@@ -0,0 +1,101 @@
+#pragma once
+
+#include "flux/AST/AST.h"
+#include "flux/AST/Decl.h"
+#include "flux/AST/Expr.h"
+#include "flux/AST/Stmt.h"
+#include "flux/Sema/NameResolution.h"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+
+namespace flux {
+
+/// Compile-time function evaluation over the type-checked AST.
+///
+/// Runs after Sema (and the constant folder), before IR emission:
+/// const and let initializers whose values reduce to calls of pure
+/// module functions over constants are interpreted at compile time and
+/// replaced by literal nodes, so generated constant tables become data
+/// instead of megabytes of pasted literals.
+///
+/// The interpreter is deliberately conservative: only integer, float,
+/// bool, and string values; only functions defined in the module with
+/// bodies built from supported statements (let, const, if, while,
+/// return, blocks, expression statements with assignments). Anything
+/// else — I/O, unknown calls, unsupported nodes — aborts that one
+/// evaluation and leaves the original expression for runtime. A step
+/// budget bounds runaway compile-time loops, and results memoize per
+/// (function, arguments).
+class CTFEInterpreter {
+public:
+  using Value = std::variant<int64_t, double, bool, std::string>;
+
+  /// `declIndex`, when supplied (the resolver's), answers callee
+  /// lookups directly; without one the interpreter builds its own
+  /// function map with a module sweep.
+  explicit CTFEInterpreter(ast::Module &module,
+                           const DeclIndex *declIndex = nullptr,
+                           uint64_t stepBudget = 1u << 22);
+
+  /// Evaluate every eligible initializer in place. Returns the number
+  /// of expressions replaced by literals.
+  size_t run();
+
+private:
+  /// Environment: local bindings during one evaluation.
+  using Environment = std::unordered_map<std::string, Value>;
+
+  /// Outcome of running statements: nothing, or a returned value.
+  struct ExecResult {
+    bool returned = false;
+    std::optional<Value> value;
+  };
+
+  std::optional<Value> evalExpr(ast::Expr &expr, Environment &env);
+  std::optional<Value> evalCall(ast::CallExpr &call, Environment &env);
+  std::optional<ExecResult> execStmt(ast::Stmt &stmt, Environment &env);
+  std::optional<ExecResult> execBlock(ast::BlockStmt &block,
+                                      Environment &env);
+
+  /// Replace initializers inside one declaration.
+  void foldDecl(ast::Decl &decl);
+  void foldBlockInitializers(ast::BlockStmt &block);
+
+  /// Materialize a literal node for a computed value.
+  ast::ExprPtr literalFor(const Value &value, SourceLocation loc);
+
+  bool spendStep() {
+    if (stepsRemaining_ == 0) {
+      return false;
+    }
+    --stepsRemaining_;
+    return true;
+  }
+
+  ast::Module &module_;
+  uint64_t stepsRemaining_;
+  unsigned callDepth_ = 0;
+
+  // Deeper than this and we leave the call for runtime rather than risk
+  // the compiler's own stack on unbounded recursion
+  static constexpr unsigned kMaxCallDepth = 256;
+  size_t replaced_ = 0;
+
+  /// Callable function for `name`, or nullptr.
+  ast::FuncDecl *findFunction(const std::string &name) const;
+
+  // Name lookups go through the resolver's declaration index when one
+  // was provided; functions_ is the fallback map
+  const DeclIndex *declIndex_ = nullptr;
+  std::unordered_map<std::string, ast::FuncDecl *> functions_;
+
+  // Memoized results: function name + rendered args -> value
+  std::map<std::string, Value> memo_;
+};
+
+} // namespace flux
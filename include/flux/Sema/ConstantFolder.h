@@ -0,0 +1,45 @@
+#pragma once
+
+#include "flux/AST/AST.h"
+#include "flux/AST/Decl.h"
+#include "flux/AST/Expr.h"
+#include "flux/AST/Stmt.h"
+
+namespace flux {
+
+/// AST-level constant folding and dead-branch elimination.
+///
+/// Runs at the end of Sema, before IR emission, so -O0 builds don't
+/// carry `2 * 1024 * 1024` expression trees or both arms of an
+/// `if` on a compile-time constant into codegen. Folded nodes are
+/// allocated in the module's arena; the originals simply become
+/// unreferenced.
+class ConstantFolder {
+public:
+  /// Fold every declaration in the module in place.
+  static void run(ast::Module &module);
+
+private:
+  explicit ConstantFolder(ast::ASTContext &ctx) : ctx_(ctx) {}
+
+  void foldDecl(ast::Decl &decl);
+  void foldBlock(ast::BlockStmt &block);
+
+  /// Fold one statement. Returns the replacement (possibly the same
+  /// statement), or nullptr when the statement folds away entirely
+  /// (e.g. `if false { ... }` with no else).
+  ast::StmtPtr foldStmt(ast::StmtPtr stmt);
+
+  /// Fold one expression tree bottom-up, returning the replacement.
+  ast::ExprPtr foldExpr(ast::ExprPtr expr);
+
+  ast::ExprPtr foldBinary(ast::BinaryExpr &expr);
+  ast::ExprPtr foldUnary(ast::UnaryExpr &expr);
+
+  /// Literal inspection helpers (nullptr / no value when not a literal).
+  static bool isBoolLiteral(const ast::Expr &expr, bool &value);
+
+  ast::ASTContext &ctx_;
+};
+
+} // namespace flux
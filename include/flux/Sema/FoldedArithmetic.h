@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace flux {
+
+/// Trap- and UB-safe constant integer arithmetic, shared by the
+/// constant folder and the CTFE interpreter.
+///
+/// Signed overflow is undefined behavior in the compiler's own
+/// arithmetic and INT64_MIN / -1 (and % -1) is a hardware trap, so
+/// folding untrusted constants with raw operators can crash or
+/// miscompile the compiler itself. Add/sub/mul/negate compute in
+/// uint64_t (two's-complement wrapping, which is what the target
+/// semantics produce anyway), and division exposes a trap predicate so
+/// callers can leave the poisonous cases for runtime.
+namespace folded {
+
+constexpr int64_t add(int64_t a, int64_t b) {
+  return static_cast<int64_t>(static_cast<uint64_t>(a) +
+                              static_cast<uint64_t>(b));
+}
+
+constexpr int64_t sub(int64_t a, int64_t b) {
+  return static_cast<int64_t>(static_cast<uint64_t>(a) -
+                              static_cast<uint64_t>(b));
+}
+
+constexpr int64_t mul(int64_t a, int64_t b) {
+  return static_cast<int64_t>(static_cast<uint64_t>(a) *
+                              static_cast<uint64_t>(b));
+}
+
+constexpr int64_t negate(int64_t a) {
+  return static_cast<int64_t>(~static_cast<uint64_t>(a) + 1);
+}
+
+/// True when a / b (or a % b) would trap: division by zero, or the
+/// INT64_MIN / -1 overflow case.
+constexpr bool divTraps(int64_t a, int64_t b) {
+  return b == 0 ||
+         (a == std::numeric_limits<int64_t>::min() && b == -1);
+}
+
+} // namespace folded
+} // namespace flux
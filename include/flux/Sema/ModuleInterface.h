@@ -0,0 +1,40 @@
+#pragma once
+
+#include "flux/Sema/NameResolution.h"
+
+#include <string>
+#include <vector>
+
+namespace flux {
+
+/// Binary module interface (.fli) files.
+///
+/// A .fli file captures the public symbol signatures of a module after
+/// Sema::analyze — declaration kinds, names, type names, and function
+/// signatures — so importers can bring the module into scope without
+/// re-lexing, re-parsing, or re-checking its source. Files are loaded
+/// through a read-only mapping (SourceManager) and decoded in one pass.
+///
+/// Layout (little-endian):
+///   magic "FLI\1", format version u32, symbol count u32,
+///   then one record per symbol; strings are u32-length-prefixed.
+class ModuleInterface {
+public:
+  /// Serialize the public symbols of `globalScope` to `path`.
+  /// Returns false on I/O failure.
+  static bool write(const std::string &path, const Scope &globalScope);
+
+  /// Load an interface file and merge its symbols into `scope`.
+  /// Returns false if the file is missing, corrupt, or has a different
+  /// format version (callers fall back to compiling from source).
+  static bool load(const std::string &path, Scope &scope);
+
+  /// The interface path for a module source path (foo.fl -> foo.fli).
+  static std::string interfacePathFor(const std::string &sourcePath);
+
+  /// Search the directory of FLUX_MODULE_PATH entries (and the current
+  /// directory) for `<name>.fli`. Returns the empty string if not found.
+  static std::string findInterface(const std::string &moduleName);
+};
+
+} // namespace flux
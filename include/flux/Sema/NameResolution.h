@@ -4,6 +4,9 @@
 #include "flux/AST/Type.h"
 #include "flux/Common/Diagnostics.h"
 #include "flux/Common/SourceLocation.h"
+#include "flux/Common/StringInterner.h"
+#include "flux/Sema/ScratchArena.h"
+#include "flux/Sema/SymbolTable.h"
 
 #include <optional>
 #include <string>
@@ -48,33 +51,90 @@ struct Symbol {
 };
 
 /// A scope in the symbol table hierarchy.
+/// Symbols are keyed by interned SymbolID in a flat open-addressing
+/// table (inline storage for small scopes), so lookups hash a 32-bit
+/// integer and probe contiguous memory instead of chasing map nodes.
 struct Scope {
   std::string name;
-  std::unordered_map<std::string, Symbol> symbols;
+  FlatSymbolMap<Symbol> symbols;
   Scope *parent = nullptr;
-  std::vector<std::unique_ptr<Scope>> children;
+  // Non-owning: children are owned by the resolver's scratch arena (or
+  // its fallback storage) and die with the enclosing resolution
+  std::vector<Scope *> children;
 
   Scope() = default;
   explicit Scope(const std::string &name, Scope *parent = nullptr)
       : name(name), parent(parent) {}
 
   /// Look up a symbol in this scope and parent scopes.
+  Symbol *lookup(SymbolID id);
+  const Symbol *lookup(SymbolID id) const;
+
+  /// Convenience overloads that intern the spelling first.
   Symbol *lookup(const std::string &name);
   const Symbol *lookup(const std::string &name) const;
 
   /// Insert a symbol into this scope.
+  bool insert(SymbolID id, Symbol symbol);
   bool insert(const std::string &name, Symbol symbol);
 };
 
+/// One-sweep index from interned top-level name to declaration.
+///
+/// Built before any body is resolved, so forward references are a map
+/// lookup instead of another scan over the DeclList — resolution stays
+/// O(n) in declarations and bodies can be resolved independently (and,
+/// with the pipelined front end, in parallel).
+class DeclIndex {
+public:
+  /// Single linear sweep over the module's declarations.
+  void build(ast::Module &module);
+
+  ast::Decl *lookup(SymbolID name) const {
+    ast::Decl *const *entry = map_.find(name);
+    return entry ? *entry : nullptr;
+  }
+
+  ast::Decl *lookup(std::string_view name) const {
+    return lookup(globalInterner().intern(name));
+  }
+
+  size_t size() const { return map_.size(); }
+
+private:
+  FlatSymbolMap<ast::Decl *> map_;
+};
+
 /// Name resolution pass.
 /// Resolves all identifiers to their declarations, builds the symbol table.
 class NameResolver {
 public:
-  NameResolver(DiagnosticEngine &diag, Scope &rootScope);
+  /// `scratch`, when given, backs all local scopes created during
+  /// resolution and is rewound after every top-level declaration, so
+  /// scope push/pop is a pointer bump instead of heap traffic.
+  NameResolver(DiagnosticEngine &diag, Scope &rootScope,
+               ScratchArena *scratch = nullptr);
 
   /// Resolve names in a complete module.
   void resolve(ast::Module &module);
 
+  /// Registration half of resolve(): build the declaration index and
+  /// register every top-level symbol. Callers then drive
+  /// resolveTopLevel per declaration (pipelined or timed modes).
+  void registerAll(ast::Module &module);
+
+  /// The declaration index built by resolve(); valid afterwards for
+  /// consumers that map names back to declarations (IDE features,
+  /// per-decl attribution).
+  const DeclIndex &declIndex() const { return declIndex_; }
+
+  /// Pipelined entry point: resolve one top-level declaration whose name
+  /// (and its siblings') was already registered via a pre-scan.
+  void resolveTopLevel(ast::Decl &decl) {
+    resolveDecl(decl);
+    finishTopLevel();
+  }
+
 private:
   void registerDecl(ast::Decl &decl);
   void resolveDecl(ast::Decl &decl);
@@ -93,8 +153,18 @@ private:
   void enterScope(const std::string &name);
   void exitScope();
 
+  /// Drop per-declaration scratch state (local scopes) after a
+  /// top-level declaration finishes resolving.
+  void finishTopLevel();
+
   DiagnosticEngine &diag_;
   Scope *currentScope_ = nullptr;
+  DeclIndex declIndex_;
+
+  // Scratch space for local scopes; ownedScopes_ is the fallback when
+  // no arena was supplied
+  ScratchArena *scratch_ = nullptr;
+  std::vector<std::unique_ptr<Scope>> ownedScopes_;
 };
 
 } // namespace flux
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace flux {
+
+/// Resettable bump arena for sema's short-lived workspace.
+///
+/// Scratch structures that live no longer than one top-level
+/// declaration (local scopes, candidate lists, temporary vectors)
+/// allocate here with a pointer bump; reset() rewinds the cursor and
+/// keeps the pages, so the next declaration reuses warm memory with no
+/// allocator traffic at all. Objects registered via create<T>() have
+/// their destructors run at reset.
+class ScratchArena {
+public:
+  ScratchArena() = default;
+  ~ScratchArena() { reset(); }
+
+  ScratchArena(const ScratchArena &) = delete;
+  ScratchArena &operator=(const ScratchArena &) = delete;
+
+  /// Allocate and construct a scratch object; destroyed at reset().
+  template <typename T, typename... Args> T *create(Args &&...args) {
+    void *mem = allocate(sizeof(T), alignof(T));
+    T *object = new (mem) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      cleanups_.push_back(
+          {object, [](void *p) { static_cast<T *>(p)->~T(); }});
+    }
+    return object;
+  }
+
+  void *allocate(size_t size, size_t align) {
+    uintptr_t cursor = reinterpret_cast<uintptr_t>(cursor_);
+    uintptr_t aligned = (cursor + align - 1) & ~(uintptr_t(align) - 1);
+    char *result = reinterpret_cast<char *>(aligned);
+    if (!cursor_ || result + size > pageEnd_) {
+      addPage(size + align);
+      aligned = (reinterpret_cast<uintptr_t>(cursor_) + align - 1) &
+                ~(uintptr_t(align) - 1);
+      result = reinterpret_cast<char *>(aligned);
+    }
+    cursor_ = result + size;
+    return result;
+  }
+
+  /// Rewind to empty; pages are kept for reuse.
+  void reset() {
+    for (auto it = cleanups_.rbegin(); it != cleanups_.rend(); ++it) {
+      it->destroy(it->object);
+    }
+    cleanups_.clear();
+    currentPage_ = 0;
+    cursor_ = pages_.empty() ? nullptr : pages_.front().get();
+    pageEnd_ = pages_.empty() ? nullptr : cursor_ + kPageSize;
+  }
+
+private:
+  static constexpr size_t kPageSize = 16 * 1024;
+
+  void addPage(size_t minSize) {
+    // Reuse a retained page when one is available
+    if (currentPage_ + 1 < pages_.size() && minSize <= kPageSize) {
+      ++currentPage_;
+      cursor_ = pages_[currentPage_].get();
+      pageEnd_ = cursor_ + kPageSize;
+      return;
+    }
+    size_t pageSize = minSize > kPageSize ? minSize : kPageSize;
+    pages_.push_back(std::make_unique<char[]>(pageSize));
+    currentPage_ = pages_.size() - 1;
+    cursor_ = pages_.back().get();
+    pageEnd_ = cursor_ + pageSize;
+  }
+
+  struct Cleanup {
+    void *object;
+    void (*destroy)(void *);
+  };
+
+  std::vector<std::unique_ptr<char[]>> pages_;
+  size_t currentPage_ = 0;
+  char *cursor_ = nullptr;
+  char *pageEnd_ = nullptr;
+  std::vector<Cleanup> cleanups_;
+};
+
+} // namespace flux
@@ -2,11 +2,17 @@
 
 #include "flux/AST/AST.h"
 #include "flux/Common/Diagnostics.h"
+#include "flux/Common/Stats.h"
 #include "flux/Sema/NameResolution.h"
+#include "flux/Sema/ScratchArena.h"
 #include "flux/Sema/TypeChecker.h"
 
+#include <memory>
+
 namespace flux {
 
+class Parser;
+
 /// Top-level semantic analysis driver.
 ///
 /// Orchestrates name resolution and type checking in the correct
@@ -19,12 +25,32 @@ public:
   /// Returns true if no errors were found.
   bool analyze(ast::Module &module);
 
+  /// Pipelined front end: pre-register top-level symbols from a cheap
+  /// token scan, then resolve and type-check each declaration on worker
+  /// threads while `parser` is still producing the rest of the module.
+  /// Returns the parsed module (errors are reported through the
+  /// diagnostic engine; check it for the overall result).
+  std::unique_ptr<ast::Module> analyzePipelined(Parser &parser,
+                                                unsigned workers = 0);
+
   /// Access the global scope after analysis.
   const Scope &getGlobalScope() const { return globalScope_; }
 
+  /// Attribute per-declaration wall time to `timer` during analyze()
+  /// (--time-per-decl). Not owned; may be null.
+  void setDeclTimer(DeclTimer *timer) { declTimer_ = timer; }
+
 private:
+  /// Merge interfaces for imported modules into the global scope.
+  void loadImportedInterfaces(const std::vector<std::string> &imports);
+
   DiagnosticEngine &diag_;
   Scope globalScope_;
+
+  // Workspace for sema temporaries; rewound per top-level declaration
+  ScratchArena scratch_;
+
+  DeclTimer *declTimer_ = nullptr;
 };
 
 } // namespace flux
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "flux/Common/StringInterner.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace flux {
+
+struct Symbol;
+
+/// Flat open-addressing map from SymbolID to Symbol, tuned for scopes.
+///
+/// Storage is a contiguous slot array probed linearly, so lookups touch
+/// one cache line in the common case instead of chasing node pointers.
+/// The first eight slots live inline in the table itself — a function
+/// body with a handful of locals never allocates — and teardown frees at
+/// most one block instead of one node per symbol. Key 0
+/// (kInvalidSymbolID) is the empty-slot sentinel and never a real key.
+template <typename ValueT> class FlatSymbolMap {
+public:
+  using Slot = std::pair<SymbolID, ValueT>;
+
+  FlatSymbolMap() : slots_(inline_), capacity_(kInlineCapacity) {
+    for (size_t i = 0; i < kInlineCapacity; ++i) {
+      inline_[i].first = kInvalidSymbolID;
+    }
+  }
+
+  ~FlatSymbolMap() {
+    if (slots_ != inline_) {
+      delete[] slots_;
+    }
+  }
+
+  FlatSymbolMap(const FlatSymbolMap &) = delete;
+  FlatSymbolMap &operator=(const FlatSymbolMap &) = delete;
+
+  ValueT *find(SymbolID id) {
+    if (id == kInvalidSymbolID) {
+      return nullptr;
+    }
+    size_t index = probeStart(id);
+    for (;;) {
+      Slot &slot = slots_[index];
+      if (slot.first == id) {
+        return &slot.second;
+      }
+      if (slot.first == kInvalidSymbolID) {
+        return nullptr;
+      }
+      index = (index + 1) & (capacity_ - 1);
+    }
+  }
+
+  const ValueT *find(SymbolID id) const {
+    return const_cast<FlatSymbolMap *>(this)->find(id);
+  }
+
+  /// Insert if absent. Returns false when the key already exists.
+  bool insert(SymbolID id, ValueT value) {
+    if (id == kInvalidSymbolID) {
+      return false;
+    }
+    if ((size_ + 1) * 4 >= capacity_ * 3) { // keep load factor under 3/4
+      grow();
+    }
+    size_t index = probeStart(id);
+    for (;;) {
+      Slot &slot = slots_[index];
+      if (slot.first == id) {
+        return false;
+      }
+      if (slot.first == kInvalidSymbolID) {
+        slot.first = id;
+        slot.second = std::move(value);
+        ++size_;
+        return true;
+      }
+      index = (index + 1) & (capacity_ - 1);
+    }
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // --- Iteration (skips empty slots) ---
+
+  template <typename SlotT> class IteratorImpl {
+  public:
+    IteratorImpl(SlotT *pos, SlotT *end) : pos_(pos), end_(end) { skip(); }
+
+    SlotT &operator*() const { return *pos_; }
+    SlotT *operator->() const { return pos_; }
+
+    IteratorImpl &operator++() {
+      ++pos_;
+      skip();
+      return *this;
+    }
+
+    bool operator!=(const IteratorImpl &other) const {
+      return pos_ != other.pos_;
+    }
+
+  private:
+    void skip() {
+      while (pos_ != end_ && pos_->first == kInvalidSymbolID) {
+        ++pos_;
+      }
+    }
+
+    SlotT *pos_;
+    SlotT *end_;
+  };
+
+  using iterator = IteratorImpl<Slot>;
+  using const_iterator = IteratorImpl<const Slot>;
+
+  iterator begin() { return iterator(slots_, slots_ + capacity_); }
+  iterator end() { return iterator(slots_ + capacity_, slots_ + capacity_); }
+  const_iterator begin() const {
+    return const_iterator(slots_, slots_ + capacity_);
+  }
+  const_iterator end() const {
+    return const_iterator(slots_ + capacity_, slots_ + capacity_);
+  }
+
+private:
+  static constexpr size_t kInlineCapacity = 8;
+
+  size_t probeStart(SymbolID id) const {
+    // Fibonacci hashing spreads sequential IDs across the table
+    return (static_cast<size_t>(id) * 2654435769u) & (capacity_ - 1);
+  }
+
+  void grow() {
+    size_t newCapacity = capacity_ * 4;
+    Slot *newSlots = new Slot[newCapacity];
+    for (size_t i = 0; i < newCapacity; ++i) {
+      newSlots[i].first = kInvalidSymbolID;
+    }
+
+    Slot *oldSlots = slots_;
+    size_t oldCapacity = capacity_;
+    slots_ = newSlots;
+    capacity_ = newCapacity;
+
+    for (size_t i = 0; i < oldCapacity; ++i) {
+      if (oldSlots[i].first != kInvalidSymbolID) {
+        size_t index = probeStart(oldSlots[i].first);
+        while (slots_[index].first != kInvalidSymbolID) {
+          index = (index + 1) & (capacity_ - 1);
+        }
+        slots_[index] = std::move(oldSlots[i]);
+      }
+    }
+    if (oldSlots != inline_) {
+      delete[] oldSlots;
+    }
+  }
+
+  Slot inline_[kInlineCapacity];
+  Slot *slots_;
+  size_t capacity_;
+  size_t size_ = 0;
+};
+
+} // namespace flux
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "flux/AST/AST.h"
+#include "flux/AST/ASTWalker.h"
 #include "flux/AST/Decl.h"
 #include "flux/AST/Expr.h"
 #include "flux/AST/Stmt.h"
 #include "flux/AST/Type.h"
 #include "flux/Common/Diagnostics.h"
 #include "flux/Sema/NameResolution.h"
+#include "flux/Sema/TypeContext.h"
 
 #include <string>
 #include <unordered_map>
@@ -25,14 +27,26 @@ namespace flux {
 /// - Generic type arguments satisfy trait bounds
 /// - Assignment targets are mutable
 ///
-class TypeChecker {
+/// Types are canonicalized through a TypeContext, so every comparison is
+/// a pointer compare on interned Type instances. Statement traversal
+/// runs on the static-dispatch ASTWalker, so no virtual calls are paid
+/// per node.
+class TypeChecker : public ast::ASTWalker<TypeChecker> {
+  friend class ast::ASTWalker<TypeChecker>;
+
 public:
   TypeChecker(DiagnosticEngine &diag, const Scope &scope);
 
   /// Check types for an entire module.
   void check(ast::Module &module);
 
+  /// Pipelined entry point: pull user-defined types from the scope, then
+  /// check a single top-level declaration.
+  void checkTopLevel(ast::Decl &decl);
+
 private:
+  void registerScopeTypes();
+
   // Declaration checking
   void checkDecl(ast::Decl &decl);
   void checkFuncDecl(ast::FuncDecl &decl);
@@ -42,8 +56,17 @@ private:
   void checkTraitDecl(ast::TraitDecl &decl);
   void checkImplDecl(ast::ImplDecl &decl);
 
-  // Statement checking
+  // Statement checking (visit handlers invoked by the walker)
   void checkStmt(ast::Stmt &stmt);
+  void visitLetStmt(ast::LetStmt &stmt) { checkLetStmt(stmt); }
+  void visitReturnStmt(ast::ReturnStmt &stmt) { checkReturnStmt(stmt); }
+  void visitIfStmt(ast::IfStmt &stmt) { checkIfStmt(stmt); }
+  void visitForStmt(ast::ForStmt &stmt) { checkForStmt(stmt); }
+  void visitWhileStmt(ast::WhileStmt &stmt) { checkWhileStmt(stmt); }
+  void visitBlockStmt(ast::BlockStmt &stmt) { checkBlockStmt(stmt); }
+  void visitExprStmt(ast::ExprStmt &stmt) { checkExpr(*stmt.expression); }
+  // Match arms carry expressions, not statements; nothing to check yet
+  void visitMatchStmt(ast::MatchStmt &) {}
   void checkLetStmt(ast::LetStmt &stmt);
   void checkReturnStmt(ast::ReturnStmt &stmt);
   void checkIfStmt(ast::IfStmt &stmt);
@@ -51,17 +74,17 @@ private:
   void checkWhileStmt(ast::WhileStmt &stmt);
   void checkBlockStmt(ast::BlockStmt &stmt);
 
-  // Expression checking — returns the inferred type name
-  std::string checkExpr(ast::Expr &expr);
-  std::string checkBinaryExpr(ast::BinaryExpr &expr);
-  std::string checkCallExpr(ast::CallExpr &expr);
-  std::string checkIdentExpr(ast::IdentExpr &expr);
+  // Expression checking — returns the canonical type (nullptr = unknown)
+  const Type *checkExpr(ast::Expr &expr);
+  const Type *checkBinaryExpr(ast::BinaryExpr &expr);
+  const Type *checkCallExpr(ast::CallExpr &expr);
+  const Type *checkIdentExpr(ast::IdentExpr &expr);
 
   // Type utilities
-  bool isValidType(const std::string &typeName) const;
-  bool typesCompatible(const std::string &expected,
-                       const std::string &actual) const;
-  std::string typeToString(const ast::TypeNode &type) const;
+  const Type *canonicalType(const ast::TypeNode &node);
+  bool isValidType(const Type *type) const;
+  bool computeTypeValidity(const Type *type) const;
+  bool typesCompatible(const Type *expected, const Type *actual) const;
 
   // Built-in type registry
   void registerBuiltinTypes();
@@ -69,11 +92,32 @@ private:
   DiagnosticEngine &diag_;
   const Scope &scope_;
 
-  // Known types (built-in + user-defined)
-  std::unordered_set<std::string> knownTypes_;
+  // Canonical type storage; equality on Type* is identity
+  TypeContext typeCtx_;
+
+  // Known type head symbols (built-in + user-defined)
+  std::unordered_set<SymbolID> knownTypes_;
+
+  // Cached canonical builtins for literal typing and compatibility
+  const Type *int64Type_ = nullptr;
+  const Type *float64Type_ = nullptr;
+  const Type *float32Type_ = nullptr;
+  const Type *boolType_ = nullptr;
+  const Type *stringType_ = nullptr;
+  const Type *charType_ = nullptr;
+  const Type *voidType_ = nullptr;
+  std::unordered_set<const Type *> integerTypes_;
 
   // Current function return type (for checking return statements)
-  std::string currentReturnType_;
+  const Type *currentReturnType_ = nullptr;
+
+  // checkTopLevel() lazily pulls scope types exactly once
+  bool scopeTypesRegistered_ = false;
+
+  // Instantiation cache: each canonical type — in particular every
+  // distinct generic instantiation like Vec<Int64> — is validated
+  // exactly once per module, no matter how many sites spell it.
+  mutable std::unordered_map<const Type *, bool> instantiationCache_;
 };
 
 } // namespace flux
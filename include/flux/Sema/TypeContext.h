@@ -0,0 +1,106 @@
+#pragma once
+
+#include "flux/AST/Type.h"
+#include "flux/Common/StringInterner.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flux {
+
+/// A canonical semantic type.
+///
+/// Instances are immutable and uniqued by TypeContext: two structurally
+/// identical types are the same object, so type equality is a pointer
+/// compare instead of a structural walk.
+class Type {
+public:
+  enum class Kind : uint8_t {
+    Named,     // Int32, String, User
+    Generic,   // Array<Int32>, HashMap<String, Int32>
+    Reference, // ref T
+    MutRef,    // mut ref T
+    Tuple,     // (Int32, String)
+    Function,  // (params...) -> ret; params_ holds params then return type
+    Array,     // [T]
+  };
+
+  Kind kind() const { return kind_; }
+
+  /// The head name (Named types and Generic bases); kInvalidSymbolID
+  /// otherwise.
+  SymbolID name() const { return name_; }
+
+  /// Component types: type arguments, element types, or parameter types
+  /// followed by the return type for Function.
+  const std::vector<const Type *> &params() const { return params_; }
+
+  /// Render for diagnostics (e.g. "Array<Int32>", "&mut String").
+  std::string toString() const;
+
+private:
+  friend class TypeContext;
+
+  Type(Kind kind, SymbolID name, std::vector<const Type *> params)
+      : kind_(kind), name_(name), params_(std::move(params)) {}
+
+  Kind kind_;
+  SymbolID name_;
+  std::vector<const Type *> params_;
+};
+
+/// Hash-consing context that owns all canonical Type instances.
+///
+/// getXXX() and canonicalize() return the unique representative for a
+/// structure; repeated requests for `Array<Int32>` across a module all
+/// yield the same pointer.
+class TypeContext {
+public:
+  TypeContext() = default;
+
+  TypeContext(const TypeContext &) = delete;
+  TypeContext &operator=(const TypeContext &) = delete;
+
+  /// The canonical type for (kind, name, params).
+  const Type *get(Type::Kind kind, SymbolID name,
+                  std::vector<const Type *> params = {});
+
+  /// Canonical named type (interns the spelling).
+  const Type *getNamed(std::string_view name);
+  const Type *getNamed(SymbolID name);
+
+  /// Canonicalize an AST type annotation.
+  const Type *canonicalize(const ast::TypeNode &node);
+
+  /// Number of distinct canonical types created.
+  size_t size() const { return types_.size(); }
+
+private:
+  struct Key {
+    Type::Kind kind;
+    SymbolID name;
+    std::vector<const Type *> params;
+
+    bool operator==(const Key &other) const {
+      return kind == other.kind && name == other.name &&
+             params == other.params;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      size_t hash = static_cast<size_t>(key.kind) * 31 + key.name;
+      for (const Type *param : key.params) {
+        hash = hash * 131 + std::hash<const Type *>()(param);
+      }
+      return hash;
+    }
+  };
+
+  std::unordered_map<Key, std::unique_ptr<Type>, KeyHash> types_;
+};
+
+} // namespace flux
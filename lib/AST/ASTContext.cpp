@@ -0,0 +1,42 @@
+#include "flux/AST/ASTContext.h"
+
+namespace flux {
+namespace ast {
+
+ASTContext::~ASTContext() {
+  // Flat sweep: run registered destructors in reverse construction order,
+  // then drop the pages. No per-node free, no graph traversal.
+  for (auto it = cleanups_.rbegin(); it != cleanups_.rend(); ++it) {
+    it->destroy(it->object);
+  }
+}
+
+void *ASTContext::allocate(size_t size, size_t align) {
+  uintptr_t cur = reinterpret_cast<uintptr_t>(cursor_);
+  uintptr_t aligned = (cur + align - 1) & ~(uintptr_t(align) - 1);
+  char *result = reinterpret_cast<char *>(aligned);
+
+  if (result + size > end_) {
+    addPage(size + align);
+    cur = reinterpret_cast<uintptr_t>(cursor_);
+    aligned = (cur + align - 1) & ~(uintptr_t(align) - 1);
+    result = reinterpret_cast<char *>(aligned);
+  }
+
+  cursor_ = result + size;
+  bytesAllocated_ += size;
+  ++nodeCount_;
+  return result;
+}
+
+void ASTContext::addPage(size_t minSize) {
+  // Oversized requests get a dedicated page; normal requests share pages.
+  size_t pageSize = minSize > kPageSize ? minSize : kPageSize;
+  pages_.push_back(std::make_unique<char[]>(pageSize));
+  bytesReserved_ += pageSize;
+  cursor_ = pages_.back().get();
+  end_ = cursor_ + pageSize;
+}
+
+} // namespace ast
+} // namespace flux
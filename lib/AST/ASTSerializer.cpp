@@ -0,0 +1,119 @@
+#include "flux/AST/ASTSerializer.h"
+
+#include "flux/AST/ASTWalker.h"
+#include "flux/AST/Decl.h"
+#include "flux/AST/Expr.h"
+#include "flux/AST/Pattern.h"
+#include "flux/AST/Stmt.h"
+
+#include <cstdint>
+
+namespace flux {
+
+namespace {
+
+void writeU16(std::ostream &out, uint16_t value) {
+  char bytes[2] = {static_cast<char>(value & 0xFF),
+                   static_cast<char>((value >> 8) & 0xFF)};
+  out.write(bytes, 2);
+}
+
+void writeU32(std::ostream &out, uint32_t value) {
+  char bytes[4] = {static_cast<char>(value & 0xFF),
+                   static_cast<char>((value >> 8) & 0xFF),
+                   static_cast<char>((value >> 16) & 0xFF),
+                   static_cast<char>((value >> 24) & 0xFF)};
+  out.write(bytes, 4);
+}
+
+/// Pre-order AST walk emitting one fixed-width record per node.
+class BinaryASTWriter : public ast::ASTWalker<BinaryASTWriter> {
+  using Base = ast::ASTWalker<BinaryASTWriter>;
+
+public:
+  explicit BinaryASTWriter(std::ostream &out) : out_(out) {}
+
+  uint32_t count() const { return count_; }
+
+  void walkDecl(ast::Decl &decl) {
+    record(0, static_cast<uint8_t>(decl.kind), decl.location);
+    ++depth_;
+    Base::walkDecl(decl);
+    --depth_;
+  }
+
+  void walkStmt(ast::Stmt &stmt) {
+    record(1, static_cast<uint8_t>(stmt.kind), stmt.location);
+    ++depth_;
+    Base::walkStmt(stmt);
+    --depth_;
+  }
+
+  void walkExpr(ast::Expr &expr) {
+    record(2, static_cast<uint8_t>(expr.kind), expr.location);
+    ++depth_;
+    Base::walkExpr(expr);
+    --depth_;
+  }
+
+  void walkPattern(ast::Pattern &pattern) {
+    record(3, static_cast<uint8_t>(pattern.kind), pattern.location);
+    ++depth_;
+    Base::walkPattern(pattern);
+    --depth_;
+  }
+
+private:
+  void record(uint8_t nodeClass, uint8_t kind, SourceLocation location) {
+    writeU16(out_, depth_);
+    out_.put(static_cast<char>(nodeClass));
+    out_.put(static_cast<char>(kind));
+    writeU32(out_, location.raw);
+    ++count_;
+  }
+
+  std::ostream &out_;
+  uint16_t depth_ = 0;
+  uint32_t count_ = 0;
+};
+
+} // anonymous namespace
+
+void BinaryDump::writeTokens(std::ostream &out,
+                             const std::vector<Token> &tokens) {
+  out.write("FTK\x01", 4);
+  writeU32(out, static_cast<uint32_t>(tokens.size()));
+  for (const auto &token : tokens) {
+    writeU16(out, static_cast<uint16_t>(token.kind));
+    writeU16(out, static_cast<uint16_t>(
+                      token.length > 0xFFFF ? 0xFFFF : token.length));
+    writeU32(out, token.symbol);
+    writeU32(out, token.location.raw);
+  }
+}
+
+void BinaryDump::writeModule(std::ostream &out, ast::Module &module) {
+  // Two passes: count records first so the header is fixed-width and
+  // consumers can preallocate
+  struct Counter : ast::ASTWalker<Counter> {
+    using Base = ast::ASTWalker<Counter>;
+    uint32_t count = 0;
+    void walkDecl(ast::Decl &d) { ++count; Base::walkDecl(d); }
+    void walkStmt(ast::Stmt &s) { ++count; Base::walkStmt(s); }
+    void walkExpr(ast::Expr &e) { ++count; Base::walkExpr(e); }
+    void walkPattern(ast::Pattern &p) { ++count; Base::walkPattern(p); }
+  } counter;
+  for (auto &decl : module.declarations) {
+    counter.walkDecl(*decl);
+  }
+
+  out.write("FAS\x01", 4);
+  writeU32(out, counter.count);
+
+  BinaryASTWriter writer(out);
+  for (auto &decl : module.declarations) {
+    writer.walkDecl(*decl);
+  }
+}
+
+} // namespace flux
@@ -0,0 +1,230 @@
+#include "flux/AST/ASTStatistics.h"
+
+#include "flux/AST/ASTWalker.h"
+#include "flux/AST/Decl.h"
+#include "flux/AST/Expr.h"
+#include "flux/AST/Pattern.h"
+#include "flux/AST/Stmt.h"
+#include "flux/AST/Type.h"
+
+namespace flux {
+
+namespace {
+
+using namespace ast;
+
+const char *declKindName(Decl::Kind kind) {
+  switch (kind) {
+  case Decl::Kind::Module: return "ModuleDecl";
+  case Decl::Kind::Import: return "ImportDecl";
+  case Decl::Kind::Func: return "FuncDecl";
+  case Decl::Kind::Struct: return "StructDecl";
+  case Decl::Kind::Class: return "ClassDecl";
+  case Decl::Kind::Enum: return "EnumDecl";
+  case Decl::Kind::Trait: return "TraitDecl";
+  case Decl::Kind::Impl: return "ImplDecl";
+  case Decl::Kind::TypeAlias: return "TypeAliasDecl";
+  }
+  return "Decl";
+}
+
+uint64_t declKindSize(Decl::Kind kind) {
+  switch (kind) {
+  case Decl::Kind::Module: return sizeof(ModuleDecl);
+  case Decl::Kind::Import: return sizeof(ImportDecl);
+  case Decl::Kind::Func: return sizeof(FuncDecl);
+  case Decl::Kind::Struct: return sizeof(StructDecl);
+  case Decl::Kind::Class: return sizeof(ClassDecl);
+  case Decl::Kind::Enum: return sizeof(EnumDecl);
+  case Decl::Kind::Trait: return sizeof(TraitDecl);
+  case Decl::Kind::Impl: return sizeof(ImplDecl);
+  case Decl::Kind::TypeAlias: return sizeof(TypeAliasDecl);
+  }
+  return sizeof(Decl);
+}
+
+const char *stmtKindName(Stmt::Kind kind) {
+  switch (kind) {
+  case Stmt::Kind::Let: return "LetStmt";
+  case Stmt::Kind::Const: return "ConstStmt";
+  case Stmt::Kind::Return: return "ReturnStmt";
+  case Stmt::Kind::If: return "IfStmt";
+  case Stmt::Kind::Match: return "MatchStmt";
+  case Stmt::Kind::For: return "ForStmt";
+  case Stmt::Kind::While: return "WhileStmt";
+  case Stmt::Kind::Loop: return "LoopStmt";
+  case Stmt::Kind::Break: return "BreakStmt";
+  case Stmt::Kind::Continue: return "ContinueStmt";
+  case Stmt::Kind::Block: return "BlockStmt";
+  case Stmt::Kind::Expr: return "ExprStmt";
+  case Stmt::Kind::Assignment: return "AssignmentStmt";
+  }
+  return "Stmt";
+}
+
+uint64_t stmtKindSize(Stmt::Kind kind) {
+  switch (kind) {
+  case Stmt::Kind::Let: return sizeof(LetStmt);
+  case Stmt::Kind::Const: return sizeof(ConstStmt);
+  case Stmt::Kind::Return: return sizeof(ReturnStmt);
+  case Stmt::Kind::If: return sizeof(IfStmt);
+  case Stmt::Kind::Match: return sizeof(MatchStmt);
+  case Stmt::Kind::For: return sizeof(ForStmt);
+  case Stmt::Kind::While: return sizeof(WhileStmt);
+  case Stmt::Kind::Loop: return sizeof(LoopStmt);
+  case Stmt::Kind::Break: return sizeof(BreakStmt);
+  case Stmt::Kind::Continue: return sizeof(ContinueStmt);
+  case Stmt::Kind::Block: return sizeof(BlockStmt);
+  case Stmt::Kind::Expr: return sizeof(ExprStmt);
+  default: return sizeof(Stmt);
+  }
+}
+
+const char *exprKindName(Expr::Kind kind) {
+  switch (kind) {
+  case Expr::Kind::IntLiteral: return "IntLiteralExpr";
+  case Expr::Kind::FloatLiteral: return "FloatLiteralExpr";
+  case Expr::Kind::StringLiteral: return "StringLiteralExpr";
+  case Expr::Kind::CharLiteral: return "CharLiteralExpr";
+  case Expr::Kind::BoolLiteral: return "BoolLiteralExpr";
+  case Expr::Kind::Ident: return "IdentExpr";
+  case Expr::Kind::Path: return "PathExpr";
+  case Expr::Kind::Binary: return "BinaryExpr";
+  case Expr::Kind::Unary: return "UnaryExpr";
+  case Expr::Kind::Call: return "CallExpr";
+  case Expr::Kind::MethodCall: return "MethodCallExpr";
+  case Expr::Kind::MemberAccess: return "MemberAccessExpr";
+  case Expr::Kind::Index: return "IndexExpr";
+  case Expr::Kind::Cast: return "CastExpr";
+  case Expr::Kind::Block: return "BlockExpr";
+  case Expr::Kind::If: return "IfExpr";
+  case Expr::Kind::Match: return "MatchExpr";
+  case Expr::Kind::Closure: return "ClosureExpr";
+  case Expr::Kind::Construct: return "ConstructExpr";
+  case Expr::Kind::StructLiteral: return "StructLiteralExpr";
+  case Expr::Kind::Tuple: return "TupleExpr";
+  case Expr::Kind::Array: return "ArrayExpr";
+  case Expr::Kind::Range: return "RangeExpr";
+  case Expr::Kind::Ref: return "RefExpr";
+  case Expr::Kind::MutRef: return "MutRefExpr";
+  case Expr::Kind::Move: return "MoveExpr";
+  case Expr::Kind::Await: return "AwaitExpr";
+  case Expr::Kind::Try: return "TryExpr";
+  case Expr::Kind::Assign: return "AssignExpr";
+  case Expr::Kind::CompoundAssign: return "CompoundAssignExpr";
+  }
+  return "Expr";
+}
+
+uint64_t exprKindSize(Expr::Kind kind) {
+  switch (kind) {
+  case Expr::Kind::IntLiteral: return sizeof(IntLiteralExpr);
+  case Expr::Kind::FloatLiteral: return sizeof(FloatLiteralExpr);
+  case Expr::Kind::StringLiteral: return sizeof(StringLiteralExpr);
+  case Expr::Kind::CharLiteral: return sizeof(CharLiteralExpr);
+  case Expr::Kind::BoolLiteral: return sizeof(BoolLiteralExpr);
+  case Expr::Kind::Ident: return sizeof(IdentExpr);
+  case Expr::Kind::Path: return sizeof(PathExpr);
+  case Expr::Kind::Binary: return sizeof(BinaryExpr);
+  case Expr::Kind::Unary: return sizeof(UnaryExpr);
+  case Expr::Kind::Call: return sizeof(CallExpr);
+  case Expr::Kind::MethodCall: return sizeof(MethodCallExpr);
+  case Expr::Kind::MemberAccess: return sizeof(MemberAccessExpr);
+  case Expr::Kind::Index: return sizeof(IndexExpr);
+  case Expr::Kind::Cast: return sizeof(CastExpr);
+  case Expr::Kind::Block: return sizeof(BlockExpr);
+  case Expr::Kind::If: return sizeof(IfExpr);
+  case Expr::Kind::Match: return sizeof(MatchExpr);
+  case Expr::Kind::Closure: return sizeof(ClosureExpr);
+  case Expr::Kind::Construct: return sizeof(ConstructExpr);
+  case Expr::Kind::StructLiteral: return sizeof(StructLiteralExpr);
+  case Expr::Kind::Tuple: return sizeof(TupleExpr);
+  case Expr::Kind::Array: return sizeof(ArrayExpr);
+  case Expr::Kind::Range: return sizeof(RangeExpr);
+  case Expr::Kind::Ref: return sizeof(RefExpr);
+  case Expr::Kind::MutRef: return sizeof(MutRefExpr);
+  case Expr::Kind::Move: return sizeof(MoveExpr);
+  case Expr::Kind::Await: return sizeof(AwaitExpr);
+  case Expr::Kind::Try: return sizeof(TryExpr);
+  case Expr::Kind::Assign: return sizeof(AssignExpr);
+  case Expr::Kind::CompoundAssign: return sizeof(CompoundAssignExpr);
+  }
+  return sizeof(Expr);
+}
+
+const char *patternKindName(Pattern::Kind kind) {
+  switch (kind) {
+  case Pattern::Kind::Wildcard: return "WildcardPattern";
+  case Pattern::Kind::Identifier: return "IdentPattern";
+  case Pattern::Kind::Literal: return "LiteralPattern";
+  case Pattern::Kind::Tuple: return "TuplePattern";
+  case Pattern::Kind::Constructor: return "ConstructorPattern";
+  case Pattern::Kind::Or: return "OrPattern";
+  }
+  return "Pattern";
+}
+
+uint64_t patternKindSize(Pattern::Kind kind) {
+  switch (kind) {
+  case Pattern::Kind::Wildcard: return sizeof(WildcardPattern);
+  case Pattern::Kind::Identifier: return sizeof(IdentPattern);
+  case Pattern::Kind::Literal: return sizeof(LiteralPattern);
+  case Pattern::Kind::Tuple: return sizeof(TuplePattern);
+  case Pattern::Kind::Constructor: return sizeof(ConstructorPattern);
+  case Pattern::Kind::Or: return sizeof(OrPattern);
+  }
+  return sizeof(Pattern);
+}
+
+class StatsCollector : public ASTWalker<StatsCollector> {
+  using Base = ASTWalker<StatsCollector>;
+
+public:
+  explicit StatsCollector(ASTStatistics &stats) : stats_(stats) {}
+
+  void walkDecl(Decl &decl) {
+    tally(declKindName(decl.kind), declKindSize(decl.kind),
+          stats_.declBytes);
+    Base::walkDecl(decl);
+  }
+
+  void walkStmt(Stmt &stmt) {
+    tally(stmtKindName(stmt.kind), stmtKindSize(stmt.kind),
+          stats_.stmtBytes);
+    Base::walkStmt(stmt);
+  }
+
+  void walkExpr(Expr &expr) {
+    tally(exprKindName(expr.kind), exprKindSize(expr.kind),
+          stats_.exprBytes);
+    Base::walkExpr(expr);
+  }
+
+  void walkPattern(Pattern &pattern) {
+    tally(patternKindName(pattern.kind), patternKindSize(pattern.kind),
+          stats_.patternBytes);
+    Base::walkPattern(pattern);
+  }
+
+private:
+  void tally(const char *name, uint64_t bytes, uint64_t &classBytes) {
+    ++stats_.nodeCounts[name];
+    ++stats_.totalNodes;
+    classBytes += bytes;
+  }
+
+  ASTStatistics &stats_;
+};
+
+} // anonymous namespace
+
+ASTStatistics ASTStatistics::collect(ast::Module &module) {
+  ASTStatistics stats;
+  StatsCollector collector(stats);
+  for (auto &decl : module.declarations) {
+    collector.walkDecl(*decl);
+  }
+  return stats;
+}
+
+} // namespace flux
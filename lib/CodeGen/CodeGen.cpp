@@ -1,10 +1,25 @@
 #include "flux/CodeGen/CodeGen.h"
 
+#include "flux/AST/ASTWalker.h"
+
+#include "flux_runtime.h"
+
 #include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/DiagnosticInfo.h>
+#include <llvm/IR/DiagnosticPrinter.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/MC/SubtargetFeature.h>
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/PGOOptions.h>
+#include <llvm/Support/VirtualFileSystem.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
@@ -13,10 +28,60 @@
 #include <llvm/TargetParser/Host.h>
 #include <llvm/Config/llvm-config.h>
 
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace flux {
 
+namespace {
+
+/// Routes LLVM loop-vectorize remarks into the Flux diagnostic engine
+/// (--vectorize-report). Remarks carry no Flux source location until we
+/// emit debug info, so they surface as notes with the remark text.
+struct VectorizeRemarkHandler : llvm::DiagnosticHandler {
+    explicit VectorizeRemarkHandler(DiagnosticEngine& diag) : diag_(diag) {}
+
+    bool isAnalysisRemarkEnabled(llvm::StringRef passName) const override {
+        return passName == "loop-vectorize";
+    }
+    bool isMissedOptRemarkEnabled(llvm::StringRef passName) const override {
+        return passName == "loop-vectorize";
+    }
+    bool isPassedOptRemarkEnabled(llvm::StringRef passName) const override {
+        return passName == "loop-vectorize";
+    }
+    bool isAnyRemarkEnabled() const override { return true; }
+
+    bool handleDiagnostics(const llvm::DiagnosticInfo& info) override {
+        if (info.getSeverity() != llvm::DS_Remark) {
+            return false; // default handling for errors/warnings
+        }
+        std::string text;
+        llvm::raw_string_ostream stream(text);
+        llvm::DiagnosticPrinterRawOStream printer(stream);
+        info.print(printer);
+        diag_.emitNote({}, "vectorizer: " + stream.str());
+        return true;
+    }
+
+private:
+    DiagnosticEngine& diag_;
+};
+
+} // anonymous namespace
+
 CodeGen::CodeGen(DiagnosticEngine& diag, const CodeGenOptions& opts)
-    : diag_(diag), opts_(opts) {
+    : diag_(diag), opts_(opts),
+      context_(std::make_unique<llvm::LLVMContext>()) {
+    if (opts_.vectorizeReport) {
+        context_->setDiagnosticHandler(
+            std::make_unique<VectorizeRemarkHandler>(diag_));
+    }
     // Initialise only the LLVM targets we linked against
     LLVMInitializeX86TargetInfo();
     LLVMInitializeX86Target();
@@ -37,11 +102,206 @@ CodeGen::CodeGen(DiagnosticEngine& diag, const CodeGenOptions& opts)
     LLVMInitializeWebAssemblyAsmPrinter();
 }
 
+
+namespace {
+
+/// Register the statically linked Flux runtime entry points with a
+/// JIT dylib so generated code resolves them without -rdynamic.
+llvm::Error registerRuntimeSymbols(llvm::orc::LLJIT& jit) {
+    auto& mainDylib = jit.getMainJITDylib();
+
+    auto processGen =
+        llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+            jit.getDataLayout().getGlobalPrefix());
+    if (processGen) {
+        mainDylib.addGenerator(std::move(*processGen));
+    } else {
+        llvm::consumeError(processGen.takeError());
+    }
+
+    llvm::orc::MangleAndInterner mangle(jit.getExecutionSession(),
+                                        jit.getDataLayout());
+    llvm::orc::SymbolMap runtimeSyms;
+    auto addSym = [&](llvm::StringRef name, auto* fn) {
+#if LLVM_VERSION_MAJOR >= 17
+        runtimeSyms[mangle(name)] = llvm::orc::ExecutorSymbolDef(
+            llvm::orc::ExecutorAddr::fromPtr(fn),
+            llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+#else
+        runtimeSyms[mangle(name)] = llvm::JITEvaluatedSymbol(
+            llvm::pointerToJITTargetAddress(fn),
+            llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+#endif
+    };
+    addSym("flux_panic", &flux_panic);
+    addSym("flux_assert", &flux_assert);
+    addSym("flux_alloc", &flux_alloc);
+    addSym("flux_alloc_zeroed", &flux_alloc_zeroed);
+    addSym("flux_realloc", &flux_realloc);
+    addSym("flux_free", &flux_free);
+    addSym("flux_print", &flux_print);
+    addSym("flux_println", &flux_println);
+    addSym("flux_print_int", &flux_print_int);
+    addSym("flux_print_float", &flux_print_float);
+    addSym("flux_print_bool", &flux_print_bool);
+    addSym("flux_flush", &flux_flush);
+    addSym("flux_strlen", &flux_strlen);
+    addSym("flux_strcat", &flux_strcat);
+    addSym("flux_strcmp", &flux_strcmp);
+    addSym("flux_string_concat_cstr", &flux_string_concat_cstr);
+    return mainDylib.define(
+        llvm::orc::absoluteSymbols(std::move(runtimeSyms)));
+}
+
+} // anonymous namespace
+
+std::unique_ptr<llvm::orc::LLJIT>
+CodeGen::createJITSession(DiagnosticEngine& diag) {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    auto jitOrErr = llvm::orc::LLJITBuilder().create();
+    if (!jitOrErr) {
+        diag.emitError({}, "failed to create JIT session: " +
+                               llvm::toString(jitOrErr.takeError()));
+        return nullptr;
+    }
+    auto jit = std::move(*jitOrErr);
+    if (auto err = registerRuntimeSymbols(*jit)) {
+        diag.emitError({}, "failed to register runtime symbols: " +
+                               llvm::toString(std::move(err)));
+        return nullptr;
+    }
+    return jit;
+}
+
+bool CodeGen::addToJIT(llvm::orc::LLJIT& jit) {
+    if (!llvmModule_) {
+        diag_.emitError({}, "no module to add (call generate() first)");
+        return false;
+    }
+    if (auto err = jit.addIRModule(llvm::orc::ThreadSafeModule(
+            std::move(llvmModule_), std::move(context_)))) {
+        diag_.emitError({}, "failed to add module to JIT: " +
+                                llvm::toString(std::move(err)));
+        return false;
+    }
+    return true;
+}
+
+int CodeGen::runJIT() {
+    if (!llvmModule_) {
+        diag_.emitError({}, "no module to run (call generate() first)");
+        return 255;
+    }
+
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    auto jitOrErr = llvm::orc::LLLazyJITBuilder().create();
+    if (!jitOrErr) {
+        diag_.emitError({}, "failed to create JIT: " +
+                                llvm::toString(jitOrErr.takeError()));
+        return 255;
+    }
+    auto jit = std::move(*jitOrErr);
+    auto& mainDylib = jit->getMainJITDylib();
+
+    // Resolve libc and anything else visible in this process
+    auto processGen =
+        llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+            jit->getDataLayout().getGlobalPrefix());
+    if (processGen) {
+        mainDylib.addGenerator(std::move(*processGen));
+    } else {
+        llvm::consumeError(processGen.takeError());
+    }
+
+    // The Flux runtime is statically linked into the compiler; register
+    // its entry points explicitly so they resolve without -rdynamic.
+    llvm::orc::MangleAndInterner mangle(jit->getExecutionSession(),
+                                        jit->getDataLayout());
+    llvm::orc::SymbolMap runtimeSyms;
+    auto addSym = [&](llvm::StringRef name, auto* fn) {
+#if LLVM_VERSION_MAJOR >= 17
+        runtimeSyms[mangle(name)] = llvm::orc::ExecutorSymbolDef(
+            llvm::orc::ExecutorAddr::fromPtr(fn),
+            llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+#else
+        runtimeSyms[mangle(name)] = llvm::JITEvaluatedSymbol(
+            llvm::pointerToJITTargetAddress(fn),
+            llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+#endif
+    };
+    addSym("flux_panic", &flux_panic);
+    addSym("flux_assert", &flux_assert);
+    addSym("flux_alloc", &flux_alloc);
+    addSym("flux_alloc_zeroed", &flux_alloc_zeroed);
+    addSym("flux_realloc", &flux_realloc);
+    addSym("flux_free", &flux_free);
+    addSym("flux_print", &flux_print);
+    addSym("flux_println", &flux_println);
+    addSym("flux_print_int", &flux_print_int);
+    addSym("flux_print_float", &flux_print_float);
+    addSym("flux_print_bool", &flux_print_bool);
+    addSym("flux_strlen", &flux_strlen);
+    addSym("flux_strcat", &flux_strcat);
+    addSym("flux_strcmp", &flux_strcmp);
+    if (auto err = mainDylib.define(
+            llvm::orc::absoluteSymbols(std::move(runtimeSyms)))) {
+        diag_.emitError({}, "failed to register runtime symbols: " +
+                                llvm::toString(std::move(err)));
+        return 255;
+    }
+
+    // Hand the module over; functions materialize lazily on first call
+    if (auto err = jit->addLazyIRModule(llvm::orc::ThreadSafeModule(
+            std::move(llvmModule_), std::move(context_)))) {
+        diag_.emitError({}, "failed to add module to JIT: " +
+                                llvm::toString(std::move(err)));
+        return 255;
+    }
+
+    auto mainOrErr = jit->lookup("main");
+    if (!mainOrErr) {
+        diag_.emitError({}, "no 'main' function to run: " +
+                                llvm::toString(mainOrErr.takeError()));
+        return 255;
+    }
+
+    auto* mainFn = mainOrErr->toPtr<int (*)()>();
+    return mainFn();
+}
+
 bool CodeGen::initializeTarget() {
     std::string tripleStr = opts_.targetTriple;
     if (tripleStr.empty()) {
         tripleStr = llvm::sys::getDefaultTargetTriple();
     }
+
+    // --native: compile for exactly this host — CPU name plus every
+    // feature LLVM can detect (AVX2/AVX-512 and friends), so vector
+    // lowering sees the real ISA instead of "generic"
+    if (opts_.nativeCPU) {
+        opts_.cpu = std::string(llvm::sys::getHostCPUName());
+        llvm::SubtargetFeatures features;
+#if LLVM_VERSION_MAJOR >= 19
+        for (const auto &[name, enabled] : llvm::sys::getHostCPUFeatures()) {
+            features.AddFeature(name, enabled);
+        }
+#else
+        llvm::StringMap<bool> hostFeatures;
+        if (llvm::sys::getHostCPUFeatures(hostFeatures)) {
+            for (const auto &entry : hostFeatures) {
+                features.AddFeature(entry.first(), entry.second);
+            }
+        }
+#endif
+        if (!opts_.features.empty()) {
+            features.AddFeature(opts_.features); // user overrides last
+        }
+        opts_.features = features.getString();
+    }
     llvm::Triple triple(tripleStr);
 #if LLVM_VERSION_MAJOR >= 19
     llvmModule_->setTargetTriple(triple);
@@ -58,6 +318,11 @@ bool CodeGen::initializeTarget() {
 
     auto relocModel = llvm::Reloc::PIC_;
     llvm::TargetOptions targetOpts;
+    if (opts_.fastDebug) {
+        // Compile-speed tier: no FP contract games, skip expensive
+        // machine-level verification work
+        targetOpts.EnableFastISel = true;
+    }
 
     llvm::CodeGenOptLevel cgOptLevel;
     switch (opts_.optimizationLevel) {
@@ -82,28 +347,191 @@ bool CodeGen::initializeTarget() {
         return false;
     }
 
+    if (opts_.fastDebug) {
+        // FastISel for straight-line selection speed; the -O0 register
+        // allocator (RegAllocFast) and no scheduling come with
+        // CodeGenOptLevel::None above
+        targetMachine_->setFastISel(true);
+        targetMachine_->setO0WantsFastISel(true);
+    }
+
     llvmModule_->setDataLayout(targetMachine_->createDataLayout());
     return true;
 }
 
+namespace {
+
+/// Callee names referenced anywhere inside one declaration.
+struct CalleeCollector : ast::ASTWalker<CalleeCollector> {
+    std::vector<std::string> callees;
+
+    void visitCallExpr(ast::CallExpr& expr) {
+        if (expr.callee->kind == ast::Expr::Kind::Ident) {
+            callees.push_back(
+                static_cast<ast::IdentExpr&>(*expr.callee).name);
+        } else if (expr.callee->kind == ast::Expr::Kind::Path) {
+            auto& path = static_cast<ast::PathExpr&>(*expr.callee);
+            if (!path.segments.empty()) {
+                callees.push_back(path.segments.back());
+            }
+        }
+        for (auto& arg : expr.arguments) {
+            walkExpr(*arg);
+        }
+        walkExpr(*expr.callee);
+    }
+
+    // Taking a function by name (callbacks) keeps it live too
+    void visitIdentExpr(ast::IdentExpr& expr) {
+        callees.push_back(expr.name);
+    }
+};
+
+/// Functions reachable from main (or, without a main, from public
+/// roots). Non-function declarations are always retained.
+std::unordered_set<const ast::Decl*>
+computeReachableDecls(ast::Module& module) {
+    std::unordered_map<std::string, ast::FuncDecl*> functions;
+    for (auto& decl : module.declarations) {
+        if (decl->kind == ast::Decl::Kind::Func) {
+            functions.emplace(static_cast<ast::FuncDecl&>(*decl).name,
+                              static_cast<ast::FuncDecl*>(decl));
+        }
+    }
+
+    std::vector<ast::FuncDecl*> worklist;
+    auto hasMain = functions.find("main");
+    if (hasMain != functions.end()) {
+        worklist.push_back(hasMain->second);
+    } else {
+        // Library module: exported (public) functions are the roots
+        for (auto& [name, func] : functions) {
+            if (func->visibility == ast::Decl::Visibility::Public) {
+                worklist.push_back(func);
+            }
+        }
+        if (worklist.empty()) {
+            // No roots at all: keep everything rather than emit nothing
+            std::unordered_set<const ast::Decl*> all;
+            for (auto& decl : module.declarations) {
+                all.insert(decl);
+            }
+            return all;
+        }
+    }
+
+    std::unordered_set<const ast::Decl*> reachable;
+    while (!worklist.empty()) {
+        ast::FuncDecl* func = worklist.back();
+        worklist.pop_back();
+        if (!reachable.insert(func).second) {
+            continue;
+        }
+        CalleeCollector collector;
+        collector.walkDecl(*func);
+        for (const auto& callee : collector.callees) {
+            auto it = functions.find(callee);
+            if (it != functions.end() && !reachable.count(it->second)) {
+                worklist.push_back(it->second);
+            }
+        }
+    }
+
+    for (auto& decl : module.declarations) {
+        if (decl->kind != ast::Decl::Kind::Func) {
+            reachable.insert(decl); // types, imports, impls stay
+        }
+    }
+    return reachable;
+}
+
+} // anonymous namespace
+
 bool CodeGen::generate(ast::Module& module) {
-    llvmModule_ = std::make_unique<llvm::Module>(module.name, context_);
+    return generate(module, nullptr);
+}
+
+bool CodeGen::generate(
+    ast::Module& module,
+    const std::function<bool(const ast::Decl&)>& shouldEmit) {
+    llvmModule_ = std::make_unique<llvm::Module>(module.name, *context_);
+    if (opts_.deterministic) {
+        // Identical inputs must yield identical objects regardless of
+        // where the tree is checked out or when the compile ran
+        llvmModule_->setModuleIdentifier(module.name.empty() ? "flux-module"
+                                                             : module.name);
+        llvmModule_->setSourceFileName(llvmModule_->getModuleIdentifier());
+    }
 
     if (!initializeTarget()) {
         return false;
     }
 
     // Emit IR for all declarations
-    IREmitter emitter(context_, *llvmModule_, diag_);
+    IREmitter emitter(*context_, *llvmModule_, diag_);
+    emitter.setWarnPadding(opts_.warnPadding);
+    emitter.setCheckTier(opts_.checks);
+    emitter.setManagedHeap(opts_.managedHeap);
+    emitter.setInstrumentFunctions(opts_.instrumentFunctions);
+    emitter.setFPSemantics(opts_.fastMath, opts_.fpContractFast);
+    emitter.setColdFunctions(opts_.coldFunctions);
+
+    // Usage-driven stripping: only declarations reachable from main
+    // (or the public roots) get bodies — never-called utility code
+    // simply does not exist in the object
+    std::unordered_set<const ast::Decl*> reachable;
+    if (opts_.stripDead) {
+        reachable = computeReachableDecls(module);
+    }
+    auto isLive = [&](const ast::Decl& decl) {
+        return !opts_.stripDead || reachable.count(&decl) > 0;
+    };
 
-    // Phase 1: Declare all functions and types (prototypes)
+    // Phase 1: Declare all functions and types (prototypes). Every
+    // shard declares everything so cross-shard calls resolve at link
+    // time.
     for (auto& decl : module.declarations) {
+        if (!isLive(*decl)) {
+            continue;
+        }
         emitter.declareDecl(*decl);
     }
 
-    // Phase 2: Emit the bodies
+    // Phase 2: Emit the bodies (only this shard's share when sharded)
     for (auto& decl : module.declarations) {
-        emitter.emitDecl(*decl);
+        if (shouldEmit && !shouldEmit(*decl)) {
+            continue;
+        }
+        if (!isLive(*decl)) {
+            continue;
+        }
+        if (declTimer_ && decl->kind == ast::Decl::Kind::Func) {
+            auto& func = static_cast<ast::FuncDecl&>(*decl);
+            auto start = std::chrono::steady_clock::now();
+            emitter.emitDecl(*decl);
+            auto end = std::chrono::steady_clock::now();
+            uint64_t instructions = 0;
+            if (auto* emitted = llvmModule_->getFunction(func.name)) {
+                instructions = emitted->getInstructionCount();
+            }
+            declTimer_->recordCodeGen(
+                func.name, decl->location,
+                static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        end - start)
+                        .count()),
+                instructions);
+        } else {
+            emitter.emitDecl(*decl);
+        }
+    }
+
+    if (opts_.reportChecks) {
+        diag_.emitNote({}, "bounds checks: " +
+                               std::to_string(emitter.checksElided()) +
+                               " eliminated by range analysis, " +
+                               std::to_string(emitter.checksRetained()) +
+                               " retained");
     }
 
     // Verify the module
@@ -115,7 +543,7 @@ bool CodeGen::generate(ast::Module& module) {
     }
 
     // Run optimization passes
-    if (opts_.optimizationLevel > 0) {
+    if (runsOptimizationPipeline()) {
         if (!runOptimizationPasses()) {
             return false;
         }
@@ -124,8 +552,143 @@ bool CodeGen::generate(ast::Module& module) {
     return true;
 }
 
+bool CodeGen::generateParallel(ast::Module& module, DiagnosticEngine& diag,
+                               const CodeGenOptions& opts, unsigned shards,
+                               const std::string& objFileBase,
+                               std::vector<std::string>& objFiles) {
+    if (shards == 0) {
+        shards = std::thread::hardware_concurrency();
+    }
+    if (shards == 0) {
+        shards = 1;
+    }
+
+    // Assign every top-level function a shard round-robin; everything
+    // that is not a function body (structs, enums, impls) lands in
+    // shard 0 so types and methods are emitted exactly once.
+    std::unordered_map<const ast::Decl*, unsigned> shardOf;
+    unsigned nextShard = 0;
+    for (auto& decl : module.declarations) {
+        if (decl->kind == ast::Decl::Kind::Func) {
+            shardOf[decl] = nextShard;
+            nextShard = (nextShard + 1) % shards;
+        } else {
+            shardOf[decl] = 0;
+        }
+    }
+
+    objFiles.resize(shards);
+    std::atomic<bool> anyShardFailed{false};
+
+    // The shared engine is thread-safe; buffer so shard output merges
+    // source-ordered after the join
+    diag.setBuffered(true);
+
+    auto runShard = [&](unsigned shard) {
+        CodeGenOptions shardOpts = opts;
+        shardOpts.outputFormat = OutputFormat::Object;
+
+        CodeGen shardCodegen(diag, shardOpts);
+        bool ok = shardCodegen.generate(module, [&](const ast::Decl& decl) {
+            return shardOf[&decl] == shard;
+        });
+
+        objFiles[shard] = objFileBase + "." + std::to_string(shard) + ".o";
+        if (!ok || !shardCodegen.writeOutput(objFiles[shard])) {
+            anyShardFailed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned shard = 0; shard < shards; ++shard) {
+        pool.emplace_back(runShard, shard);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    diag.setBuffered(false);
+    diag.flush();
+
+    return !anyShardFailed.load(std::memory_order_relaxed);
+}
+
+bool CodeGen::linkAndOptimizeBitcode(const std::vector<std::string>& paths) {
+    if (paths.empty()) {
+        diag_.emitError({}, "no bitcode inputs for LTO link");
+        return false;
+    }
+
+    // Load and link everything into one module; from here on the
+    // regular pipeline sees a single translation unit, so the inliner
+    // works across what used to be module boundaries.
+    llvmModule_ = std::make_unique<llvm::Module>("flux-lto", *context_);
+    llvm::Linker linker(*llvmModule_);
+
+    for (const auto& path : paths) {
+        llvm::SMDiagnostic err;
+        auto input = llvm::parseIRFile(path, err, *context_);
+        if (!input) {
+            diag_.emitError({}, "failed to load bitcode '" + path +
+                                "': " + err.getMessage().str());
+            return false;
+        }
+        if (linker.linkInModule(std::move(input))) {
+            diag_.emitError({}, "failed to link bitcode '" + path + "'");
+            return false;
+        }
+    }
+
+    if (!initializeTarget()) {
+        return false;
+    }
+
+    if (llvm::verifyModule(*llvmModule_, &llvm::errs())) {
+        diag_.emitError({}, "combined LTO module failed verification");
+        return false;
+    }
+
+    if (runsOptimizationPipeline()) {
+        return runOptimizationPasses();
+    }
+    return true;
+}
+
 bool CodeGen::runOptimizationPasses() {
-    llvm::PassBuilder passBuilder(targetMachine_);
+    // Instrumentation-based PGO plugs into the default pipelines
+    std::optional<llvm::PGOOptions> pgoOpts;
+#if LLVM_VERSION_MAJOR >= 17
+    if (opts_.profileGenerate) {
+        pgoOpts = llvm::PGOOptions("default_%m.profraw", "", "", "",
+                                   llvm::vfs::getRealFileSystem(),
+                                   llvm::PGOOptions::IRInstr);
+    } else if (!opts_.profileUse.empty()) {
+        pgoOpts = llvm::PGOOptions(opts_.profileUse, "", "", "",
+                                   llvm::vfs::getRealFileSystem(),
+                                   llvm::PGOOptions::IRUse);
+    }
+#elif LLVM_VERSION_MAJOR >= 16
+    if (opts_.profileGenerate) {
+        pgoOpts = llvm::PGOOptions("default_%m.profraw", "", "",
+                                   llvm::vfs::getRealFileSystem(),
+                                   llvm::PGOOptions::IRInstr);
+    } else if (!opts_.profileUse.empty()) {
+        pgoOpts = llvm::PGOOptions(opts_.profileUse, "", "",
+                                   llvm::vfs::getRealFileSystem(),
+                                   llvm::PGOOptions::IRUse);
+    }
+#else
+    if (opts_.profileGenerate) {
+        pgoOpts = llvm::PGOOptions("default_%m.profraw", "", "",
+                                   llvm::PGOOptions::IRInstr);
+    } else if (!opts_.profileUse.empty()) {
+        pgoOpts = llvm::PGOOptions(opts_.profileUse, "", "",
+                                   llvm::PGOOptions::IRUse);
+    }
+#endif
+
+    llvm::PassBuilder passBuilder(targetMachine_, llvm::PipelineTuningOptions(),
+                                  pgoOpts);
 
     llvm::LoopAnalysisManager lam;
     llvm::FunctionAnalysisManager fam;
@@ -150,6 +713,11 @@ bool CodeGen::runOptimizationPasses() {
     return true;
 }
 
+bool CodeGen::runsOptimizationPipeline() const {
+    return opts_.optimizationLevel > 0 || opts_.profileGenerate ||
+           !opts_.profileUse.empty();
+}
+
 bool CodeGen::writeOutput(const std::string& filename) {
     if (opts_.outputFormat == OutputFormat::LLVMIR) {
         std::error_code ec;
@@ -0,0 +1,163 @@
+#include "flux/CodeGen/EscapeAnalysis.h"
+
+#include "flux/AST/Expr.h"
+#include "flux/AST/Stmt.h"
+
+namespace flux {
+
+std::unordered_set<std::string>
+EscapeAnalysis::escapingVars(ast::FuncDecl &func) {
+  EscapeAnalysis analysis;
+  if (func.body) {
+    analysis.walkStmt(*func.body);
+  }
+  return std::move(analysis.escaping_);
+}
+
+void EscapeAnalysis::markEscaping(ast::Expr &expr) {
+  switch (expr.kind) {
+  case ast::Expr::Kind::Ident:
+    escaping_.insert(static_cast<ast::IdentExpr &>(expr).name);
+    break;
+  case ast::Expr::Kind::MemberAccess:
+    // Letting &obj.field out lets obj out
+    markEscaping(*static_cast<ast::MemberAccessExpr &>(expr).object);
+    break;
+  case ast::Expr::Kind::Index:
+    markEscaping(*static_cast<ast::IndexExpr &>(expr).object);
+    break;
+  case ast::Expr::Kind::Ref:
+    markEscaping(*static_cast<ast::RefExpr &>(expr).operand);
+    break;
+  case ast::Expr::Kind::MutRef:
+    markEscaping(*static_cast<ast::MutRefExpr &>(expr).operand);
+    break;
+  case ast::Expr::Kind::Move:
+    markEscaping(*static_cast<ast::MoveExpr &>(expr).operand);
+    break;
+  case ast::Expr::Kind::Cast:
+    markEscaping(*static_cast<ast::CastExpr &>(expr).expr);
+    break;
+  default:
+    break; // literals, arithmetic results, etc. carry no binding
+  }
+}
+
+void EscapeAnalysis::visitLetStmt(ast::LetStmt &stmt) {
+  if (!stmt.initializer) {
+    return;
+  }
+
+  // `let b = a` aliases a's whole storage: b may later escape, and
+  // since aggregates lower as pointers the alias would then outlive
+  // a's frame slot. Escape is not propagated backwards through the
+  // single pass, so conservatively taint whole-object aliases. Field
+  // and element reads (`let n = s.x`) copy values out and do not alias
+  // the parent, so they stay exempt — otherwise every read would defeat
+  // stack promotion.
+  ast::Expr *source = stmt.initializer;
+  for (;;) {
+    if (source->kind == ast::Expr::Kind::Move) {
+      source = static_cast<ast::MoveExpr &>(*source).operand;
+    } else if (source->kind == ast::Expr::Kind::Cast) {
+      source = static_cast<ast::CastExpr &>(*source).expr;
+    } else if (source->kind == ast::Expr::Kind::Ref) {
+      source = static_cast<ast::RefExpr &>(*source).operand;
+    } else if (source->kind == ast::Expr::Kind::MutRef) {
+      source = static_cast<ast::MutRefExpr &>(*source).operand;
+    } else {
+      break;
+    }
+  }
+  if (source->kind == ast::Expr::Kind::Ident) {
+    escaping_.insert(static_cast<ast::IdentExpr &>(*source).name);
+  }
+
+  walkExpr(*stmt.initializer);
+}
+
+void EscapeAnalysis::visitReturnStmt(ast::ReturnStmt &stmt) {
+  if (stmt.value) {
+    markEscaping(*stmt.value);
+    walkExpr(*stmt.value);
+  }
+}
+
+void EscapeAnalysis::visitCallExpr(ast::CallExpr &expr) {
+  for (auto &arg : expr.arguments) {
+    markEscaping(*arg);
+    walkExpr(*arg);
+  }
+  walkExpr(*expr.callee);
+}
+
+void EscapeAnalysis::visitMethodCallExpr(ast::MethodCallExpr &expr) {
+  // The receiver may be stored by the method; stay conservative
+  markEscaping(*expr.object);
+  walkExpr(*expr.object);
+  for (auto &arg : expr.arguments) {
+    markEscaping(*arg);
+    walkExpr(*arg);
+  }
+}
+
+void EscapeAnalysis::visitAssignExpr(ast::AssignExpr &expr) {
+  // Whatever is stored may now be reachable through the target
+  markEscaping(*expr.value);
+  walkExpr(*expr.target);
+  walkExpr(*expr.value);
+}
+
+void EscapeAnalysis::visitRefExpr(ast::RefExpr &expr) {
+  markEscaping(*expr.operand);
+  walkExpr(*expr.operand);
+}
+
+void EscapeAnalysis::visitMutRefExpr(ast::MutRefExpr &expr) {
+  markEscaping(*expr.operand);
+  walkExpr(*expr.operand);
+}
+
+void EscapeAnalysis::visitMoveExpr(ast::MoveExpr &expr) {
+  markEscaping(*expr.operand);
+  walkExpr(*expr.operand);
+}
+
+void EscapeAnalysis::visitConstructExpr(ast::ConstructExpr &expr) {
+  for (auto &field : expr.fields) {
+    markEscaping(*field.value);
+    walkExpr(*field.value);
+  }
+}
+
+void EscapeAnalysis::visitStructLiteralExpr(ast::StructLiteralExpr &expr) {
+  for (auto &[name, value] : expr.fields) {
+    markEscaping(*value);
+    walkExpr(*value);
+  }
+}
+
+void EscapeAnalysis::visitTupleExpr(ast::TupleExpr &expr) {
+  for (auto &element : expr.elements) {
+    markEscaping(*element);
+    walkExpr(*element);
+  }
+}
+
+void EscapeAnalysis::visitArrayExpr(ast::ArrayExpr &expr) {
+  for (auto &element : expr.elements) {
+    markEscaping(*element);
+    walkExpr(*element);
+  }
+}
+
+void EscapeAnalysis::visitClosureExpr(ast::ClosureExpr &expr) {
+  // Captured environment may outlive the frame; taint everything the
+  // body touches
+  if (expr.body) {
+    markEscaping(*expr.body);
+    walkExpr(*expr.body);
+  }
+}
+
+} // namespace flux
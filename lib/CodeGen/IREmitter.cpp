@@ -1,4 +1,13 @@
 #include "flux/CodeGen/IREmitter.h"
+
+#include "flux/CodeGen/EscapeAnalysis.h"
+#include "flux/CodeGen/RangeAnalysis.h"
+
+#include <llvm/IR/MDBuilder.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
 #include "flux/AST/Pattern.h"
 
 #include <llvm/IR/Constants.h>
@@ -36,10 +45,15 @@ void IREmitter::declareFunc(ast::FuncDecl &decl) {
   llvm::Type *retType = decl.returnType ? typeMapper_.mapType(*decl.returnType)
                                         : typeMapper_.getVoidType();
 
-  // Determine parameter types
+  // Determine parameter types. Modifier-style borrows
+  // (`[mut] ref x: T`) pass the referent's address — without this a
+  // `mut ref Int32` would arrive by value and writes through it would
+  // be invisible to the caller.
   std::vector<llvm::Type *> paramTypes;
   for (auto &param : decl.params) {
-    if (param.type) {
+    if (param.isRef || param.isMutRef) {
+      paramTypes.push_back(llvm::PointerType::getUnqual(ctx_));
+    } else if (param.type) {
       paramTypes.push_back(typeMapper_.mapType(*param.type));
     } else {
       paramTypes.push_back(llvm::PointerType::getUnqual(ctx_));
@@ -64,14 +78,60 @@ void IREmitter::declareFunc(ast::FuncDecl &decl) {
 }
 
 void IREmitter::declareStruct(ast::StructDecl &decl) {
-  if (!llvm::StructType::getTypeByName(ctx_, decl.name)) {
-    std::vector<llvm::Type *> fieldTypes;
-    for (auto &field : decl.fields) {
-      if (field.type) {
-        fieldTypes.push_back(typeMapper_.mapType(*field.type));
-      }
+  if (llvm::StructType::getTypeByName(ctx_, decl.name)) {
+    return;
+  }
+
+  struct Field {
+    std::string name;
+    llvm::Type *type;
+  };
+  std::vector<Field> fields;
+  for (auto &field : decl.fields) {
+    if (field.type) {
+      fields.push_back({field.name, typeMapper_.mapType(*field.type)});
+    }
+  }
+
+  const llvm::DataLayout &dataLayout = module_.getDataLayout();
+
+  // @layout(optimize): order by descending alignment (then size), which
+  // eliminates interior padding for any mix of scalar fields
+  if (decl.optimizeLayout) {
+    std::stable_sort(fields.begin(), fields.end(),
+                     [&](const Field &a, const Field &b) {
+                       auto alignA = dataLayout.getABITypeAlign(a.type);
+                       auto alignB = dataLayout.getABITypeAlign(b.type);
+                       if (alignA != alignB) {
+                         return alignA > alignB;
+                       }
+                       return dataLayout.getTypeAllocSize(a.type) >
+                              dataLayout.getTypeAllocSize(b.type);
+                     });
+  }
+
+  std::vector<llvm::Type *> fieldTypes;
+  auto &order = structFieldOrder_[decl.name];
+  for (auto &field : fields) {
+    fieldTypes.push_back(field.type);
+    order.push_back(field.name);
+  }
+  auto *structType = llvm::StructType::create(ctx_, fieldTypes, decl.name);
+
+  if (warnPadding_) {
+    uint64_t allocated = dataLayout.getTypeAllocSize(structType);
+    uint64_t used = 0;
+    for (auto *fieldType : fieldTypes) {
+      used += dataLayout.getTypeAllocSize(fieldType);
+    }
+    if (allocated > used) {
+      diag_.emitWarning(decl.location,
+                        "struct '" + decl.name + "' wastes " +
+                            std::to_string(allocated - used) +
+                            " padding byte(s) (" + std::to_string(used) +
+                            " used of " + std::to_string(allocated) +
+                            "); consider @layout(optimize) or reordering");
     }
-    llvm::StructType::create(ctx_, fieldTypes, decl.name);
   }
 }
 
@@ -94,6 +154,8 @@ void IREmitter::emitDecl(ast::Decl &decl) {
 }
 
 void IREmitter::emitFuncDecl(ast::FuncDecl &decl) {
+  escapingVars_ = EscapeAnalysis::escapingVars(decl);
+  safeIndexes_ = RangeAnalysis::safeIndexes(decl);
   auto *func = module_.getFunction(decl.name);
   if (!func) {
     // Should have been declared in declareDecl pass
@@ -104,22 +166,137 @@ void IREmitter::emitFuncDecl(ast::FuncDecl &decl) {
   llvm::Type *retType = decl.returnType ? typeMapper_.mapType(*decl.returnType)
                                         : typeMapper_.getVoidType();
 
-  // Name arguments
+  // Name arguments; Flux ownership gives us aliasing facts for free:
+  // a `mut ref` is a unique mutable borrow (noalias), a `ref` is a
+  // shared immutable borrow (noalias would be wrong, readonly is not).
+  // Both are pointer-only parameter attributes, so they attach only
+  // when the lowered parameter actually is a pointer.
   size_t idx = 0;
   for (auto &arg : func->args()) {
     arg.setName(decl.params[idx].name);
+    if (arg.getType()->isPointerTy()) {
+      if (decl.params[idx].isMutRef) {
+        func->addParamAttr(static_cast<unsigned>(idx),
+                           llvm::Attribute::NoAlias);
+      } else if (decl.params[idx].isRef) {
+        func->addParamAttr(static_cast<unsigned>(idx),
+                           llvm::Attribute::ReadOnly);
+      }
+    }
     ++idx;
   }
 
+  // Trace-identified cold functions: keep them out of hot text
+  if (coldFunctions_.count(decl.name)) {
+    func->addFnAttr(llvm::Attribute::Cold);
+    func->addFnAttr(llvm::Attribute::OptimizeForSize);
+  }
+
+  // Inline cost model: explicit annotations win; otherwise trivial
+  // bodies (one-line accessors) get alwaysinline and small ones a hint,
+  // so predictable inlining doesn't wait for -O2 heuristics
+  switch (decl.inlineHint) {
+  case ast::FuncDecl::InlineHint::Always:
+    func->addFnAttr(llvm::Attribute::AlwaysInline);
+    break;
+  case ast::FuncDecl::InlineHint::Never:
+    func->addFnAttr(llvm::Attribute::NoInline);
+    break;
+  case ast::FuncDecl::InlineHint::None:
+    if (decl.body && decl.bodySize > 0 && decl.bodySize <= 4) {
+      func->addFnAttr(llvm::Attribute::AlwaysInline);
+    } else if (decl.body && decl.bodySize <= 16) {
+      func->addFnAttr(llvm::Attribute::InlineHint);
+    }
+    break;
+  }
+
   // If there's no body, it's an external declaration
   if (!decl.body) {
     return;
   }
 
+  // Floating-point semantics for this function's instructions:
+  // module-wide flags, widened by @fastmath on just this function so
+  // kernels opt in without relaxing numerics program-wide
+  llvm::FastMathFlags fmf;
+  if (moduleFastMath_ || decl.fastMath) {
+    fmf.setFast();
+  } else if (moduleFPContract_) {
+    fmf.setAllowContract(true);
+  }
+  builder_.setFastMathFlags(fmf);
+
   // Create entry block
   auto *entry = llvm::BasicBlock::Create(ctx_, "entry", func);
   builder_.SetInsertPoint(entry);
 
+  // Reference parameters: remember each pointee type so body reads and
+  // writes go through the pointer
+  refParamPointees_.clear();
+  for (auto &param : decl.params) {
+    if ((param.isRef || param.isMutRef) && param.type) {
+      refParamPointees_[param.name] = typeMapper_.mapType(*param.type);
+    }
+  }
+
+  // Managed-heap mode: the program's entry point brings the nursery up
+  // before anything can allocate
+  currentGCRoots_.clear();
+  if (managedHeap_ && decl.name == "main") {
+    auto *i64Ty = llvm::Type::getInt64Ty(ctx_);
+    auto enableFn = module_.getOrInsertFunction(
+        "flux_gc_enable",
+        llvm::FunctionType::get(llvm::Type::getVoidTy(ctx_), {i64Ty},
+                                false));
+    builder_.CreateCall(enableFn,
+                        {llvm::ConstantInt::get(i64Ty, 0)}); // default size
+  }
+
+  // Entry probe: the ID is interned once into a function-local global
+  // cache, so steady-state cost is one load plus the ring append
+  llvm::FunctionCallee probeExitFn;
+  llvm::Value *probeID = nullptr;
+  if (instrumentFunctions_) {
+    auto *i32Ty = llvm::Type::getInt32Ty(ctx_);
+    auto *ptrTy = llvm::PointerType::getUnqual(ctx_);
+    auto registerFn = module_.getOrInsertFunction(
+        "flux_probe_register", llvm::FunctionType::get(i32Ty, {ptrTy}, false));
+    auto enterFn = module_.getOrInsertFunction(
+        "flux_probe_enter",
+        llvm::FunctionType::get(llvm::Type::getVoidTy(ctx_), {i32Ty}, false));
+    probeExitFn = module_.getOrInsertFunction(
+        "flux_probe_exit",
+        llvm::FunctionType::get(llvm::Type::getVoidTy(ctx_), {i32Ty}, false));
+
+    auto *idCache = new llvm::GlobalVariable(
+        module_, i32Ty, /*isConstant=*/false,
+        llvm::GlobalValue::PrivateLinkage, llvm::ConstantInt::get(i32Ty, 0),
+        "__flux_probe_id." + decl.name);
+
+    auto *cached = builder_.CreateLoad(i32Ty, idCache, "probe.id");
+    auto *needsRegister = builder_.CreateICmpEQ(
+        cached, llvm::ConstantInt::get(i32Ty, 0), "probe.cold");
+    auto *registerBB = llvm::BasicBlock::Create(ctx_, "probe.reg", func);
+    auto *readyBB = llvm::BasicBlock::Create(ctx_, "probe.ready", func);
+    builder_.CreateCondBr(needsRegister, registerBB, readyBB);
+
+    builder_.SetInsertPoint(registerBB);
+    auto *name = builder_.CreateGlobalString(decl.name, "probe.name");
+    auto *fresh = builder_.CreateCall(registerFn, {name}, "probe.fresh");
+    builder_.CreateStore(fresh, idCache);
+    builder_.CreateBr(readyBB);
+
+    builder_.SetInsertPoint(readyBB);
+    auto *phi = builder_.CreatePHI(i32Ty, 2, "probe.id.phi");
+    phi->addIncoming(cached, entry);
+    phi->addIncoming(fresh, registerBB);
+    probeID = phi;
+    builder_.CreateCall(enterFn, {probeID});
+  }
+  currentProbeID_ = probeID;
+  currentProbeExitFn_ = probeExitFn;
+
   // Save old named values and set up new scope
   auto savedNamedValues = namedValues_;
   namedValues_.clear();
@@ -143,12 +320,17 @@ void IREmitter::emitFuncDecl(ast::FuncDecl &decl) {
 
   // If the block is not terminated, add a return
   if (!builder_.GetInsertBlock()->getTerminator()) {
+    emitGCRootRemovals();
+    if (currentProbeID_) {
+      builder_.CreateCall(currentProbeExitFn_, {currentProbeID_});
+    }
     if (retType->isVoidTy()) {
       builder_.CreateRetVoid();
     } else {
       builder_.CreateRet(llvm::Constant::getNullValue(retType));
     }
   }
+  currentProbeID_ = nullptr;
 
   // Verify the function
   if (llvm::verifyFunction(*func, &llvm::errs())) {
@@ -174,48 +356,32 @@ void IREmitter::emitEnumDecl(ast::EnumDecl & /*decl*/) {
 // Statement emission
 // -----------------------------------------------------------------------
 
-void IREmitter::emitStmt(ast::Stmt &stmt) {
-  switch (stmt.kind) {
-  case ast::Stmt::Kind::Let:
-    emitLetStmt(static_cast<ast::LetStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::Return:
-    emitReturnStmt(static_cast<ast::ReturnStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::If:
-    emitIfStmt(static_cast<ast::IfStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::For:
-    emitForStmt(static_cast<ast::ForStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::While:
-    emitWhileStmt(static_cast<ast::WhileStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::Loop:
-    emitLoopStmt(static_cast<ast::LoopStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::Block:
-    emitBlockStmt(static_cast<ast::BlockStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::Expr:
-    emitExprStmt(static_cast<ast::ExprStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::Break:
-    if (!loopStack_.empty()) {
-      builder_.CreateBr(loopStack_.back().breakBlock);
-    }
-    break;
-  case ast::Stmt::Kind::Continue:
-    if (!loopStack_.empty()) {
-      builder_.CreateBr(loopStack_.back().continueBlock);
-    }
-    break;
-  default:
-    break;
+void IREmitter::emitStmt(ast::Stmt &stmt) { walkStmt(stmt); }
+
+void IREmitter::visitBreakStmt(ast::BreakStmt &) {
+  if (!loopStack_.empty()) {
+    builder_.CreateBr(loopStack_.back().breakBlock);
+  }
+}
+
+void IREmitter::visitContinueStmt(ast::ContinueStmt &) {
+  if (!loopStack_.empty()) {
+    builder_.CreateBr(loopStack_.back().continueBlock);
   }
 }
 
 void IREmitter::emitLetStmt(ast::LetStmt &stmt) {
+  // Stack-promote struct literals bound to variables that never escape
+  bool gcAllocated = false;
+  if (stmt.initializer &&
+      stmt.initializer->kind == ast::Expr::Kind::StructLiteral) {
+    structLiteralEscapes_ = escapingVars_.count(stmt.name) > 0;
+    // Escaping literals take the heap path, which under --runtime=gc
+    // is the nursery: the local slot must be a registered root so a
+    // collection can find (and rewrite) the reference
+    gcAllocated = managedHeap_ && structLiteralEscapes_;
+  }
+
   llvm::Type *varType = nullptr;
   if (stmt.type) {
     varType = typeMapper_.mapType(*stmt.type);
@@ -240,16 +406,50 @@ void IREmitter::emitLetStmt(ast::LetStmt &stmt) {
           initVal = builder_.CreateSExt(initVal, varType, "sext");
         }
       }
-      builder_.CreateStore(initVal, alloca);
+      auto *store = builder_.CreateStore(initVal, alloca);
+      attachTBAA(store, varType);
+
+      if (gcAllocated) {
+        auto *ptrTy = llvm::PointerType::getUnqual(ctx_);
+        auto addRootFn = module_.getOrInsertFunction(
+            "flux_gc_add_root",
+            llvm::FunctionType::get(llvm::Type::getVoidTy(ctx_), {ptrTy},
+                                    false));
+        builder_.CreateCall(addRootFn, {alloca});
+        currentGCRoots_.push_back(alloca);
+      }
     }
   }
 
   namedValues_[stmt.name] = alloca;
 }
 
+void IREmitter::emitGCRootRemovals() {
+  if (currentGCRoots_.empty()) {
+    return;
+  }
+  auto *ptrTy = llvm::PointerType::getUnqual(ctx_);
+  auto removeRootFn = module_.getOrInsertFunction(
+      "flux_gc_remove_root",
+      llvm::FunctionType::get(llvm::Type::getVoidTy(ctx_), {ptrTy}, false));
+  for (llvm::AllocaInst *root : currentGCRoots_) {
+    builder_.CreateCall(removeRootFn, {root});
+  }
+}
+
 void IREmitter::emitReturnStmt(ast::ReturnStmt &stmt) {
+  emitGCRootRemovals();
+  if (currentProbeID_) {
+    builder_.CreateCall(currentProbeExitFn_, {currentProbeID_});
+  }
   if (stmt.value) {
+    // Only `return f(...)` — the returned value being exactly the call —
+    // is a recognized tail position; `return 1 + f(x)` must not mark the
+    // call, since musttail requires the ret to follow immediately
+    bool wasTail = inTailPosition_;
+    inTailPosition_ = stmt.value->kind == ast::Expr::Kind::Call;
     auto *val = emitExpr(*stmt.value);
+    inTailPosition_ = wasTail;
     if (val) {
       builder_.CreateRet(val);
     } else {
@@ -328,10 +528,82 @@ void IREmitter::emitWhileStmt(ast::WhileStmt &stmt) {
 }
 
 void IREmitter::emitForStmt(ast::ForStmt &stmt) {
-  // For now, emit as a counted loop skeleton.
-  // Full iterator protocol requires runtime support.
   auto *func = builder_.GetInsertBlock()->getParent();
 
+  // Counted range loops get the canonical rotated form the vectorizer
+  // wants: guard, body, latch with the exit test on the backedge, and
+  // llvm.loop.vectorize.enable on the loop ID
+  if (stmt.iterable->kind == ast::Expr::Kind::Range) {
+    auto &range = static_cast<ast::RangeExpr &>(*stmt.iterable);
+    llvm::Value *start = range.start ? emitExpr(*range.start) : nullptr;
+    llvm::Value *end = range.end ? emitExpr(*range.end) : nullptr;
+    if (start && end) {
+      auto *ivType = start->getType();
+      if (end->getType() != ivType && end->getType()->isIntegerTy() &&
+          ivType->isIntegerTy()) {
+        end = builder_.CreateSExtOrTrunc(end, ivType, "range.end");
+      }
+
+      auto *bodyBB = llvm::BasicBlock::Create(ctx_, "for.body", func);
+      auto *latchBB = llvm::BasicBlock::Create(ctx_, "for.latch", func);
+      auto *exitBB = llvm::BasicBlock::Create(ctx_, "for.exit", func);
+
+      auto *iv = createEntryBlockAlloca(func, stmt.varName, ivType);
+      builder_.CreateStore(start, iv);
+
+      // Rotated guard: skip the loop entirely when the range is empty
+      llvm::Value *guard =
+          range.inclusive
+              ? builder_.CreateICmpSLE(start, end, "for.guard")
+              : builder_.CreateICmpSLT(start, end, "for.guard");
+      builder_.CreateCondBr(guard, bodyBB, exitBB);
+
+      builder_.SetInsertPoint(bodyBB);
+      auto savedVar = namedValues_.find(stmt.varName);
+      auto *shadowed =
+          savedVar != namedValues_.end() ? savedVar->second : nullptr;
+      namedValues_[stmt.varName] = iv;
+
+      loopStack_.push_back({exitBB, latchBB});
+      emitStmt(*stmt.body);
+      loopStack_.pop_back();
+      if (!builder_.GetInsertBlock()->getTerminator()) {
+        builder_.CreateBr(latchBB);
+      }
+
+      // Latch: increment and test on the backedge
+      builder_.SetInsertPoint(latchBB);
+      llvm::Value *current = builder_.CreateLoad(ivType, iv, stmt.varName);
+      llvm::Value *next = builder_.CreateAdd(
+          current, llvm::ConstantInt::get(ivType, 1), "for.next");
+      builder_.CreateStore(next, iv);
+      llvm::Value *again =
+          range.inclusive ? builder_.CreateICmpSLE(next, end, "for.again")
+                          : builder_.CreateICmpSLT(next, end, "for.again");
+      auto *backedge = builder_.CreateCondBr(again, bodyBB, exitBB);
+
+      // Self-referential loop ID + vectorize.enable
+      auto *enableMD = llvm::MDNode::get(
+          ctx_,
+          {llvm::MDString::get(ctx_, "llvm.loop.vectorize.enable"),
+           llvm::ConstantAsMetadata::get(
+               llvm::ConstantInt::get(llvm::Type::getInt1Ty(ctx_), 1))});
+      auto *loopID = llvm::MDNode::getDistinct(ctx_, {nullptr, enableMD});
+      loopID->replaceOperandWith(0, loopID);
+      backedge->setMetadata(llvm::LLVMContext::MD_loop, loopID);
+
+      if (shadowed) {
+        namedValues_[stmt.varName] = shadowed;
+      } else {
+        namedValues_.erase(stmt.varName);
+      }
+      builder_.SetInsertPoint(exitBB);
+      return;
+    }
+  }
+
+  // Non-range iterables: loop skeleton until the iterator protocol has
+  // runtime support
   auto *condBB = llvm::BasicBlock::Create(ctx_, "for.cond", func);
   auto *bodyBB = llvm::BasicBlock::Create(ctx_, "for.body", func);
   auto *exitBB = llvm::BasicBlock::Create(ctx_, "for.exit", func);
@@ -372,6 +644,201 @@ void IREmitter::emitLoopStmt(ast::LoopStmt &stmt) {
   builder_.SetInsertPoint(exitBB);
 }
 
+void IREmitter::emitMatchStmt(ast::MatchStmt &stmt) {
+  llvm::Value *scrutinee = emitExpr(*stmt.scrutinee);
+  if (!scrutinee) {
+    return;
+  }
+  auto *func = builder_.GetInsertBlock()->getParent();
+  auto *mergeBB = llvm::BasicBlock::Create(ctx_, "match.end", func);
+
+  // Integer scrutinees compile to a SwitchInst: LLVM's switch lowering
+  // already builds the optimal decision tree (jump table for dense tag
+  // sets, balanced binary search for sparse ones), so a 40-arm match is
+  // O(1)/O(log n) instead of 40 sequential compares. Guards and
+  // non-literal patterns fall back to a sequential chain.
+  bool switchable = scrutinee->getType()->isIntegerTy();
+  for (const auto &arm : stmt.arms) {
+    if (arm.guard) {
+      switchable = false;
+      break;
+    }
+    if (arm.pattern->kind == ast::Pattern::Kind::Literal) {
+      auto &literal = static_cast<ast::LiteralPattern &>(*arm.pattern);
+      if (literal.literal->kind != ast::Expr::Kind::IntLiteral &&
+          literal.literal->kind != ast::Expr::Kind::BoolLiteral) {
+        switchable = false;
+        break;
+      }
+    } else if (arm.pattern->kind != ast::Pattern::Kind::Wildcard &&
+               arm.pattern->kind != ast::Pattern::Kind::Identifier) {
+      switchable = false;
+      break;
+    }
+  }
+
+  // Identifier patterns bind the scrutinee value; the binding must be
+  // live before the guard is emitted (`n if n > 3` references it), so
+  // setup and teardown are split out of the body emission.
+  struct ArmBinding {
+    llvm::AllocaInst *binding = nullptr;
+    llvm::AllocaInst *shadowed = nullptr;
+    std::string name;
+  };
+  auto bindArm = [&](const ast::MatchArm &arm) {
+    ArmBinding bound;
+    if (arm.pattern->kind == ast::Pattern::Kind::Identifier) {
+      bound.name = static_cast<ast::IdentPattern &>(*arm.pattern).name;
+      bound.binding =
+          createEntryBlockAlloca(func, bound.name, scrutinee->getType());
+      builder_.CreateStore(scrutinee, bound.binding);
+      auto it = namedValues_.find(bound.name);
+      bound.shadowed = it != namedValues_.end() ? it->second : nullptr;
+      namedValues_[bound.name] = bound.binding;
+    }
+    return bound;
+  };
+  auto unbindArm = [&](const ArmBinding &bound) {
+    if (!bound.binding) {
+      return;
+    }
+    if (bound.shadowed) {
+      namedValues_[bound.name] = bound.shadowed;
+    } else {
+      namedValues_.erase(bound.name);
+    }
+  };
+  auto emitArmBody = [&](const ast::MatchArm &arm) {
+    ArmBinding bound = bindArm(arm);
+    if (arm.body) {
+      emitExpr(*arm.body);
+    }
+    unbindArm(bound);
+    if (!builder_.GetInsertBlock()->getTerminator()) {
+      builder_.CreateBr(mergeBB);
+    }
+  };
+
+  if (switchable) {
+    // Default block: the first wildcard/identifier arm, else merge
+    llvm::BasicBlock *defaultBB = mergeBB;
+    const ast::MatchArm *defaultArm = nullptr;
+    for (const auto &arm : stmt.arms) {
+      if (arm.pattern->kind == ast::Pattern::Kind::Wildcard ||
+          arm.pattern->kind == ast::Pattern::Kind::Identifier) {
+        defaultArm = &arm;
+        defaultBB = llvm::BasicBlock::Create(ctx_, "match.default", func);
+        break;
+      }
+    }
+
+    auto *switchInst = builder_.CreateSwitch(
+        scrutinee, defaultBB, static_cast<unsigned>(stmt.arms.size()));
+
+    std::unordered_set<int64_t> seenCaseValues;
+    for (const auto &arm : stmt.arms) {
+      if (&arm == defaultArm) {
+        continue;
+      }
+      if (arm.pattern->kind != ast::Pattern::Kind::Literal) {
+        continue; // arms after the default can never match
+      }
+      auto &literal = static_cast<ast::LiteralPattern &>(*arm.pattern);
+      int64_t caseValue =
+          literal.literal->kind == ast::Expr::Kind::IntLiteral
+              ? static_cast<ast::IntLiteralExpr &>(*literal.literal).value
+              : (static_cast<ast::BoolLiteralExpr &>(*literal.literal).value
+                     ? 1
+                     : 0);
+      // A repeated literal arm is dead (the first one wins); a second
+      // addCase with the same constant would fail module verification
+      if (!seenCaseValues.insert(caseValue).second) {
+        continue;
+      }
+      auto *caseBB = llvm::BasicBlock::Create(ctx_, "match.arm", func);
+      switchInst->addCase(
+          llvm::ConstantInt::get(
+              llvm::cast<llvm::IntegerType>(scrutinee->getType()),
+              static_cast<uint64_t>(caseValue), true),
+          caseBB);
+      builder_.SetInsertPoint(caseBB);
+      emitArmBody(arm);
+    }
+
+    if (defaultArm) {
+      builder_.SetInsertPoint(defaultBB);
+      emitArmBody(*defaultArm);
+    }
+    builder_.SetInsertPoint(mergeBB);
+    return;
+  }
+
+  // Sequential fallback: test arms in order (guards, general patterns)
+  for (const auto &arm : stmt.arms) {
+    if (arm.pattern->kind == ast::Pattern::Kind::Wildcard ||
+        arm.pattern->kind == ast::Pattern::Kind::Identifier) {
+      if (arm.guard) {
+        // The binding exists before the guard runs: `n if n > 3`
+        ArmBinding bound = bindArm(arm);
+        llvm::Value *guard = emitExpr(*arm.guard);
+        if (!guard) {
+          unbindArm(bound);
+          continue;
+        }
+        auto *bodyBB = llvm::BasicBlock::Create(ctx_, "match.arm", func);
+        auto *nextBB = llvm::BasicBlock::Create(ctx_, "match.next", func);
+        builder_.CreateCondBr(guard, bodyBB, nextBB);
+        builder_.SetInsertPoint(bodyBB);
+        if (arm.body) {
+          emitExpr(*arm.body);
+        }
+        if (!builder_.GetInsertBlock()->getTerminator()) {
+          builder_.CreateBr(mergeBB);
+        }
+        unbindArm(bound);
+        builder_.SetInsertPoint(nextBB);
+        continue;
+      }
+      emitArmBody(arm);
+      builder_.SetInsertPoint(mergeBB);
+      return;
+    }
+    if (arm.pattern->kind == ast::Pattern::Kind::Literal) {
+      auto &literal = static_cast<ast::LiteralPattern &>(*arm.pattern);
+      llvm::Value *caseValue = emitExpr(*literal.literal);
+      if (!caseValue) {
+        continue;
+      }
+      llvm::Value *matches =
+          caseValue->getType()->isFloatingPointTy()
+              ? builder_.CreateFCmpOEQ(scrutinee, caseValue, "match.cmp")
+              : builder_.CreateICmpEQ(scrutinee, caseValue, "match.cmp");
+      auto *bodyBB = llvm::BasicBlock::Create(ctx_, "match.arm", func);
+      auto *nextBB = llvm::BasicBlock::Create(ctx_, "match.next", func);
+      if (arm.guard) {
+        // The guard runs only after the pattern matched: a
+        // side-effecting guard must not fire for non-matching arms
+        auto *guardBB = llvm::BasicBlock::Create(ctx_, "match.guard", func);
+        builder_.CreateCondBr(matches, guardBB, nextBB);
+        builder_.SetInsertPoint(guardBB);
+        llvm::Value *guard = emitExpr(*arm.guard);
+        if (guard) {
+          builder_.CreateCondBr(guard, bodyBB, nextBB);
+        } else {
+          builder_.CreateBr(nextBB);
+        }
+      } else {
+        builder_.CreateCondBr(matches, bodyBB, nextBB);
+      }
+      builder_.SetInsertPoint(bodyBB);
+      emitArmBody(arm);
+      builder_.SetInsertPoint(nextBB);
+    }
+  }
+  builder_.CreateBr(mergeBB);
+  builder_.SetInsertPoint(mergeBB);
+}
+
 void IREmitter::emitBlockStmt(ast::BlockStmt &stmt) {
   for (auto &s : stmt.statements) {
     emitStmt(*s);
@@ -386,7 +853,128 @@ void IREmitter::emitExprStmt(ast::ExprStmt &stmt) {
 // Expression emission
 // -----------------------------------------------------------------------
 
+// ----------------------------------------------------------------------
+// Flattened post-order emission
+// ----------------------------------------------------------------------
+//
+// Pure computational trees (literals, variable reads, unary/binary
+// operators) are flattened into a contiguous post-order record array
+// and emitted by a linear sweep with operand indices — sequential
+// memory access instead of a pointer chase per node. Trees containing
+// control flow, calls, or anything effectful fall back to the
+// recursive emitter.
+
+namespace {
+
+struct FlatExprNode {
+  ast::Expr *node;
+  uint32_t lhs = 0; // post-order index of the first operand
+  uint32_t rhs = 0; // post-order index of the second operand
+};
+
+/// Append `expr`'s subtree in post-order. Returns the node's index, or
+/// UINT32_MAX when the tree contains a kind the sweep can't handle.
+uint32_t flattenExpr(ast::Expr &expr, std::vector<FlatExprNode> &out) {
+  switch (expr.kind) {
+  case ast::Expr::Kind::IntLiteral:
+  case ast::Expr::Kind::FloatLiteral:
+  case ast::Expr::Kind::BoolLiteral:
+  case ast::Expr::Kind::StringLiteral:
+  case ast::Expr::Kind::Ident:
+    out.push_back({&expr});
+    return static_cast<uint32_t>(out.size() - 1);
+  case ast::Expr::Kind::Unary: {
+    auto &unary = static_cast<ast::UnaryExpr &>(expr);
+    uint32_t operand = flattenExpr(*unary.operand, out);
+    if (operand == UINT32_MAX) {
+      return UINT32_MAX;
+    }
+    out.push_back({&expr, operand});
+    return static_cast<uint32_t>(out.size() - 1);
+  }
+  case ast::Expr::Kind::Binary: {
+    auto &binary = static_cast<ast::BinaryExpr &>(expr);
+    uint32_t lhs = flattenExpr(*binary.lhs, out);
+    if (lhs == UINT32_MAX) {
+      return UINT32_MAX;
+    }
+    uint32_t rhs = flattenExpr(*binary.rhs, out);
+    if (rhs == UINT32_MAX) {
+      return UINT32_MAX;
+    }
+    out.push_back({&expr, lhs, rhs});
+    return static_cast<uint32_t>(out.size() - 1);
+  }
+  default:
+    return UINT32_MAX;
+  }
+}
+
+} // anonymous namespace
+
+bool IREmitter::emitFlattenedExpr(ast::Expr &expr, llvm::Value *&result) {
+  // Only worth flattening when there is an actual tree to sweep
+  if (expr.kind != ast::Expr::Kind::Binary) {
+    return false;
+  }
+
+  std::vector<FlatExprNode> nodes;
+  if (flattenExpr(expr, nodes) == UINT32_MAX) {
+    return false;
+  }
+
+  // Linear sweep: operands are already materialized behind us
+  std::vector<llvm::Value *> values(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    ast::Expr &node = *nodes[i].node;
+    switch (node.kind) {
+    case ast::Expr::Kind::IntLiteral:
+      values[i] = emitIntLiteral(static_cast<ast::IntLiteralExpr &>(node));
+      break;
+    case ast::Expr::Kind::FloatLiteral:
+      values[i] =
+          emitFloatLiteral(static_cast<ast::FloatLiteralExpr &>(node));
+      break;
+    case ast::Expr::Kind::BoolLiteral:
+      values[i] = emitBoolLiteral(static_cast<ast::BoolLiteralExpr &>(node));
+      break;
+    case ast::Expr::Kind::StringLiteral:
+      values[i] =
+          emitStringLiteral(static_cast<ast::StringLiteralExpr &>(node));
+      break;
+    case ast::Expr::Kind::Ident:
+      values[i] = emitIdent(static_cast<ast::IdentExpr &>(node));
+      break;
+    case ast::Expr::Kind::Unary:
+      values[i] = emitUnaryOp(static_cast<ast::UnaryExpr &>(node),
+                              values[nodes[i].lhs]);
+      break;
+    case ast::Expr::Kind::Binary:
+      values[i] = emitBinaryOp(static_cast<ast::BinaryExpr &>(node),
+                               values[nodes[i].lhs], values[nodes[i].rhs]);
+      break;
+    default:
+      values[i] = nullptr; // flattenExpr guarantees this is unreachable
+      break;
+    }
+    if (!values[i]) {
+      result = nullptr; // an error was reported; do not re-emit
+      return true;
+    }
+  }
+  result = values.back();
+  return true;
+}
+
 llvm::Value *IREmitter::emitExpr(ast::Expr &expr) {
+  // Computational trees take the flat post-order path
+  if (expr.kind == ast::Expr::Kind::Binary) {
+    llvm::Value *flat = nullptr;
+    if (emitFlattenedExpr(expr, flat)) {
+      return flat;
+    }
+  }
+
   switch (expr.kind) {
   case ast::Expr::Kind::IntLiteral:
     return emitIntLiteral(static_cast<ast::IntLiteralExpr &>(expr));
@@ -410,11 +998,98 @@ llvm::Value *IREmitter::emitExpr(ast::Expr &expr) {
     return emitBlockExpr(static_cast<ast::BlockExpr &>(expr));
   case ast::Expr::Kind::Assign:
     return emitAssignExpr(static_cast<ast::AssignExpr &>(expr));
+  case ast::Expr::Kind::StructLiteral:
+    return emitStructLiteralExpr(static_cast<ast::StructLiteralExpr &>(expr));
+  case ast::Expr::Kind::Index:
+    return emitIndexExpr(static_cast<ast::IndexExpr &>(expr));
+  case ast::Expr::Kind::Await:
+    // No suspend points in the emitted subset yet: the awaited value
+    // completes synchronously, so evaluate it in place. Scheduling is
+    // the runtime's job (flux_spawn / flux_block_on).
+    return emitExpr(*static_cast<ast::AwaitExpr &>(expr).operand);
+  case ast::Expr::Kind::Move:
+    // Ownership transfer is a pointer move: aggregates are lowered as
+    // pointers to in-place-constructed storage, so moving one hands the
+    // pointer over — no memcpy, and the source binding is dead after
+    return emitExpr(*static_cast<ast::MoveExpr &>(expr).operand);
+  case ast::Expr::Kind::Ref:
+    return emitAddressOf(*static_cast<ast::RefExpr &>(expr).operand);
+  case ast::Expr::Kind::MutRef:
+    return emitAddressOf(*static_cast<ast::MutRefExpr &>(expr).operand);
   default:
     return nullptr;
   }
 }
 
+llvm::Value *IREmitter::emitAddressOf(ast::Expr &expr) {
+  // Borrows of locals are the storage pointer itself, not a loaded copy
+  if (expr.kind == ast::Expr::Kind::Ident) {
+    auto &ident = static_cast<ast::IdentExpr &>(expr);
+    auto it = namedValues_.find(ident.name);
+    if (it != namedValues_.end()) {
+      return it->second;
+    }
+  }
+  // Everything else already evaluates to a pointer (aggregates) or a
+  // temporary we can pass through
+  return emitExpr(expr);
+}
+
+llvm::Value *IREmitter::emitStructLiteralExpr(ast::StructLiteralExpr &expr) {
+  // One-shot flag set by emitLetStmt; anything not directly bound to a
+  // non-escaping let stays on the heap
+  bool escapes = structLiteralEscapes_;
+  structLiteralEscapes_ = true;
+
+  auto *structTy = llvm::StructType::getTypeByName(ctx_, expr.typeName);
+  if (!structTy) {
+    diag_.emitError(expr.location, "unknown struct type '" + expr.typeName +
+                                       "' in literal");
+    return nullptr;
+  }
+
+  llvm::Value *storage = nullptr;
+  if (escapes) {
+    auto *ptrTy = llvm::PointerType::getUnqual(ctx_);
+    auto *i64Ty = llvm::Type::getInt64Ty(ctx_);
+    uint64_t size = module_.getDataLayout().getTypeAllocSize(structTy);
+    // Managed mode: the nursery bump allocator instead of the pools
+    auto allocFn = module_.getOrInsertFunction(
+        managedHeap_ ? "flux_gc_alloc" : "flux_alloc",
+        llvm::FunctionType::get(ptrTy, {i64Ty}, false));
+    storage = builder_.CreateCall(
+        allocFn, {llvm::ConstantInt::get(i64Ty, size)}, expr.typeName);
+  } else {
+    // Provably never outlives the frame: promote to the stack and skip
+    // both the runtime call and the matching free
+    auto *func = builder_.GetInsertBlock()->getParent();
+    storage = createEntryBlockAlloca(func, expr.typeName, structTy);
+  }
+
+  auto orderIt = structFieldOrder_.find(expr.typeName);
+  for (auto &[fieldName, value] : expr.fields) {
+    auto *fieldValue = emitExpr(*value);
+    if (!fieldValue) {
+      return nullptr;
+    }
+    // Layout order may differ from literal order (@layout(optimize))
+    unsigned index = 0;
+    if (orderIt != structFieldOrder_.end()) {
+      const auto &order = orderIt->second;
+      for (unsigned i = 0; i < order.size(); ++i) {
+        if (order[i] == fieldName) {
+          index = i;
+          break;
+        }
+      }
+    }
+    auto *fieldPtr =
+        builder_.CreateStructGEP(structTy, storage, index, fieldName);
+    builder_.CreateStore(fieldValue, fieldPtr);
+  }
+  return storage;
+}
+
 llvm::Value *IREmitter::emitIntLiteral(ast::IntLiteralExpr &expr) {
   return llvm::ConstantInt::get(llvm::Type::getInt64Ty(ctx_),
                                 static_cast<uint64_t>(expr.value), true);
@@ -425,7 +1100,20 @@ llvm::Value *IREmitter::emitFloatLiteral(ast::FloatLiteralExpr &expr) {
 }
 
 llvm::Value *IREmitter::emitStringLiteral(ast::StringLiteralExpr &expr) {
-  return builder_.CreateGlobalString(expr.value, "str");
+  // Dedupe identical literals into one pooled constant; unnamed_addr +
+  // constant lets the linker merge further across objects.
+  auto it = stringPool_.find(expr.value);
+  if (it != stringPool_.end()) {
+    return it->second;
+  }
+
+  auto *global = builder_.CreateGlobalString(expr.value, "str");
+  global->setConstant(true);
+  global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+  global->setLinkage(llvm::GlobalValue::PrivateLinkage);
+
+  stringPool_.emplace(expr.value, global);
+  return global;
 }
 
 llvm::Value *IREmitter::emitBoolLiteral(ast::BoolLiteralExpr &expr) {
@@ -444,16 +1132,148 @@ llvm::Value *IREmitter::emitIdent(ast::IdentExpr &expr) {
     diag_.emitError(expr.location, "unknown variable '" + expr.name + "'");
     return nullptr;
   }
-  return builder_.CreateLoad(it->second->getAllocatedType(), it->second,
-                             expr.name);
+  auto *load = builder_.CreateLoad(it->second->getAllocatedType(),
+                                   it->second, expr.name);
+  attachTBAA(load, it->second->getAllocatedType());
+
+  // A modifier-style ref parameter holds the referent's address; a read
+  // of the name means the referent's value
+  auto refIt = refParamPointees_.find(expr.name);
+  if (refIt != refParamPointees_.end()) {
+    auto *deref = builder_.CreateLoad(refIt->second, load,
+                                      expr.name + ".ref");
+    attachTBAA(deref, refIt->second);
+    return deref;
+  }
+  return load;
+}
+
+// ----------------------------------------------------------------------
+// Constexpr-dispatched arithmetic emission
+// ----------------------------------------------------------------------
+//
+// Binary arithmetic/comparison lowering is selected through a constexpr
+// table of specialized emit functions indexed by (operator, operand
+// class). The hot emit loop performs one indexed call; the chained
+// branches live at compile time inside the if-constexpr specializations.
+
+namespace {
+
+enum class OperandClass : unsigned { Int = 0, Float = 1 };
+
+using BinaryEmitFn = llvm::Value *(*)(llvm::IRBuilder<> &, llvm::Value *,
+                                      llvm::Value *);
+
+template <ast::BinaryOp Op, OperandClass Cls>
+llvm::Value *emitBinarySpecialized(llvm::IRBuilder<> &b, llvm::Value *l,
+                                   llvm::Value *r) {
+  using ast::BinaryOp;
+  constexpr bool isFloat = Cls == OperandClass::Float;
+  if constexpr (Op == BinaryOp::Add) {
+    return isFloat ? b.CreateFAdd(l, r, "addtmp") : b.CreateAdd(l, r, "addtmp");
+  } else if constexpr (Op == BinaryOp::Sub) {
+    return isFloat ? b.CreateFSub(l, r, "subtmp") : b.CreateSub(l, r, "subtmp");
+  } else if constexpr (Op == BinaryOp::Mul) {
+    return isFloat ? b.CreateFMul(l, r, "multmp") : b.CreateMul(l, r, "multmp");
+  } else if constexpr (Op == BinaryOp::Div) {
+    return isFloat ? b.CreateFDiv(l, r, "divtmp")
+                   : b.CreateSDiv(l, r, "divtmp");
+  } else if constexpr (Op == BinaryOp::Mod) {
+    return isFloat ? b.CreateFRem(l, r, "modtmp")
+                   : b.CreateSRem(l, r, "modtmp");
+  } else if constexpr (Op == BinaryOp::Equal) {
+    return isFloat ? b.CreateFCmpOEQ(l, r, "eqtmp")
+                   : b.CreateICmpEQ(l, r, "eqtmp");
+  } else if constexpr (Op == BinaryOp::NotEqual) {
+    return isFloat ? b.CreateFCmpONE(l, r, "netmp")
+                   : b.CreateICmpNE(l, r, "netmp");
+  } else if constexpr (Op == BinaryOp::Less) {
+    return isFloat ? b.CreateFCmpOLT(l, r, "lttmp")
+                   : b.CreateICmpSLT(l, r, "lttmp");
+  } else if constexpr (Op == BinaryOp::LessEqual) {
+    return isFloat ? b.CreateFCmpOLE(l, r, "letmp")
+                   : b.CreateICmpSLE(l, r, "letmp");
+  } else if constexpr (Op == BinaryOp::Greater) {
+    return isFloat ? b.CreateFCmpOGT(l, r, "gttmp")
+                   : b.CreateICmpSGT(l, r, "gttmp");
+  } else if constexpr (Op == BinaryOp::GreaterEqual) {
+    return isFloat ? b.CreateFCmpOGE(l, r, "getmp")
+                   : b.CreateICmpSGE(l, r, "getmp");
+  } else if constexpr (!isFloat && Op == BinaryOp::And) {
+    return b.CreateAnd(l, r, "andtmp");
+  } else if constexpr (!isFloat && Op == BinaryOp::Or) {
+    return b.CreateOr(l, r, "ortmp");
+  } else if constexpr (!isFloat && Op == BinaryOp::BitAnd) {
+    return b.CreateAnd(l, r, "bandtmp");
+  } else if constexpr (!isFloat && Op == BinaryOp::BitOr) {
+    return b.CreateOr(l, r, "bortmp");
+  } else if constexpr (!isFloat && Op == BinaryOp::BitXor) {
+    return b.CreateXor(l, r, "bxortmp");
+  } else if constexpr (!isFloat && Op == BinaryOp::ShiftLeft) {
+    return b.CreateShl(l, r, "shltmp");
+  } else if constexpr (!isFloat && Op == BinaryOp::ShiftRight) {
+    return b.CreateAShr(l, r, "ashrtmp");
+  } else {
+    return nullptr; // bitwise/shift on floats: no lowering
+  }
+}
+
+constexpr size_t kBinaryOpCount =
+    static_cast<size_t>(ast::BinaryOp::ShiftRight) + 1;
+
+template <size_t... Ops>
+constexpr std::array<BinaryEmitFn, kBinaryOpCount * 2>
+makeBinaryEmitTable(std::index_sequence<Ops...>) {
+  return {emitBinarySpecialized<static_cast<ast::BinaryOp>(Ops),
+                                OperandClass::Int>...,
+          emitBinarySpecialized<static_cast<ast::BinaryOp>(Ops),
+                                OperandClass::Float>...};
 }
 
+constexpr auto kBinaryEmitTable =
+    makeBinaryEmitTable(std::make_index_sequence<kBinaryOpCount>{});
+
+} // anonymous namespace
+
 llvm::Value *IREmitter::emitBinaryExpr(ast::BinaryExpr &expr) {
   auto *lhs = emitExpr(*expr.lhs);
   auto *rhs = emitExpr(*expr.rhs);
+  return emitBinaryOp(expr, lhs, rhs);
+}
+
+llvm::Value *IREmitter::emitBinaryOp(ast::BinaryExpr &expr, llvm::Value *lhs,
+                                     llvm::Value *rhs) {
   if (!lhs || !rhs)
     return nullptr;
 
+  // String operands (lowered as pointers): '+' concatenates through the
+  // runtime's length-prefixed strings; ==/!= compare contents
+  if (lhs->getType()->isPointerTy() && rhs->getType()->isPointerTy()) {
+    auto *ptrTy = llvm::PointerType::getUnqual(ctx_);
+    auto *i32Ty = llvm::Type::getInt32Ty(ctx_);
+    switch (expr.op) {
+    case ast::BinaryOp::Add: {
+      auto concat = module_.getOrInsertFunction(
+          "flux_string_concat_cstr",
+          llvm::FunctionType::get(ptrTy, {ptrTy, ptrTy}, false));
+      return builder_.CreateCall(concat, {lhs, rhs}, "strcat");
+    }
+    case ast::BinaryOp::Equal:
+    case ast::BinaryOp::NotEqual: {
+      auto cmp = module_.getOrInsertFunction(
+          "flux_strcmp",
+          llvm::FunctionType::get(i32Ty, {ptrTy, ptrTy}, false));
+      auto *result = builder_.CreateCall(cmp, {lhs, rhs}, "strcmp");
+      auto *zero = llvm::ConstantInt::get(i32Ty, 0);
+      return expr.op == ast::BinaryOp::Equal
+                 ? builder_.CreateICmpEQ(result, zero, "streq")
+                 : builder_.CreateICmpNE(result, zero, "strne");
+    }
+    default:
+      break;
+    }
+  }
+
   // Coerce integer types to match (e.g., i32 op i64 → widen to i64,
   // or truncate the literal side to match the variable side)
   if (lhs->getType()->isIntegerTy() && rhs->getType()->isIntegerTy() &&
@@ -467,64 +1287,24 @@ llvm::Value *IREmitter::emitBinaryExpr(ast::BinaryExpr &expr) {
     }
   }
 
-  // Integer operations (default for now)
-  bool isFloat = lhs->getType()->isFloatingPointTy();
-
-  switch (expr.op) {
-  case ast::BinaryOp::Add:
-    return isFloat ? builder_.CreateFAdd(lhs, rhs, "addtmp")
-                   : builder_.CreateAdd(lhs, rhs, "addtmp");
-  case ast::BinaryOp::Sub:
-    return isFloat ? builder_.CreateFSub(lhs, rhs, "subtmp")
-                   : builder_.CreateSub(lhs, rhs, "subtmp");
-  case ast::BinaryOp::Mul:
-    return isFloat ? builder_.CreateFMul(lhs, rhs, "multmp")
-                   : builder_.CreateMul(lhs, rhs, "multmp");
-  case ast::BinaryOp::Div:
-    return isFloat ? builder_.CreateFDiv(lhs, rhs, "divtmp")
-                   : builder_.CreateSDiv(lhs, rhs, "divtmp");
-  case ast::BinaryOp::Mod:
-    return isFloat ? builder_.CreateFRem(lhs, rhs, "modtmp")
-                   : builder_.CreateSRem(lhs, rhs, "modtmp");
-  case ast::BinaryOp::Equal:
-    return isFloat ? builder_.CreateFCmpOEQ(lhs, rhs, "eqtmp")
-                   : builder_.CreateICmpEQ(lhs, rhs, "eqtmp");
-  case ast::BinaryOp::NotEqual:
-    return isFloat ? builder_.CreateFCmpONE(lhs, rhs, "netmp")
-                   : builder_.CreateICmpNE(lhs, rhs, "netmp");
-  case ast::BinaryOp::Less:
-    return isFloat ? builder_.CreateFCmpOLT(lhs, rhs, "lttmp")
-                   : builder_.CreateICmpSLT(lhs, rhs, "lttmp");
-  case ast::BinaryOp::LessEqual:
-    return isFloat ? builder_.CreateFCmpOLE(lhs, rhs, "letmp")
-                   : builder_.CreateICmpSLE(lhs, rhs, "letmp");
-  case ast::BinaryOp::Greater:
-    return isFloat ? builder_.CreateFCmpOGT(lhs, rhs, "gttmp")
-                   : builder_.CreateICmpSGT(lhs, rhs, "gttmp");
-  case ast::BinaryOp::GreaterEqual:
-    return isFloat ? builder_.CreateFCmpOGE(lhs, rhs, "getmp")
-                   : builder_.CreateICmpSGE(lhs, rhs, "getmp");
-  case ast::BinaryOp::And:
-    return builder_.CreateAnd(lhs, rhs, "andtmp");
-  case ast::BinaryOp::Or:
-    return builder_.CreateOr(lhs, rhs, "ortmp");
-  case ast::BinaryOp::BitAnd:
-    return builder_.CreateAnd(lhs, rhs, "bandtmp");
-  case ast::BinaryOp::BitOr:
-    return builder_.CreateOr(lhs, rhs, "bortmp");
-  case ast::BinaryOp::BitXor:
-    return builder_.CreateXor(lhs, rhs, "bxortmp");
-  case ast::BinaryOp::ShiftLeft:
-    return builder_.CreateShl(lhs, rhs, "shltmp");
-  case ast::BinaryOp::ShiftRight:
-    return builder_.CreateAShr(lhs, rhs, "ashrtmp");
-  default:
-    return nullptr;
+  // One indexed call into the constexpr-specialized emitters
+  OperandClass cls = lhs->getType()->isFloatingPointTy()
+                         ? OperandClass::Float
+                         : OperandClass::Int;
+  size_t index = static_cast<size_t>(expr.op) +
+                 (cls == OperandClass::Float ? kBinaryOpCount : 0);
+  if (index < kBinaryEmitTable.size()) {
+    return kBinaryEmitTable[index](builder_, lhs, rhs);
   }
+  return nullptr;
 }
 
 llvm::Value *IREmitter::emitUnaryExpr(ast::UnaryExpr &expr) {
-  auto *operand = emitExpr(*expr.operand);
+  return emitUnaryOp(expr, emitExpr(*expr.operand));
+}
+
+llvm::Value *IREmitter::emitUnaryOp(ast::UnaryExpr &expr,
+                                    llvm::Value *operand) {
   if (!operand)
     return nullptr;
 
@@ -543,11 +1323,126 @@ llvm::Value *IREmitter::emitUnaryExpr(ast::UnaryExpr &expr) {
   }
 }
 
+llvm::Value *IREmitter::emitAssertCall(ast::CallExpr &expr) {
+  if (expr.arguments.empty()) {
+    diag_.emitError(expr.location, "assert requires a condition");
+    return nullptr;
+  }
+
+  llvm::Value *cond = emitExpr(*expr.arguments[0]);
+  if (!cond) {
+    return nullptr;
+  }
+  if (!cond->getType()->isIntegerTy(1)) {
+    cond = builder_.CreateICmpNE(
+        cond, llvm::Constant::getNullValue(cond->getType()), "assertcond");
+  }
+
+  // The message (second argument) or a default
+  llvm::Value *message = nullptr;
+  if (expr.arguments.size() > 1) {
+    message = emitExpr(*expr.arguments[1]);
+  }
+  if (!message) {
+    message = emitStringLiteral(
+        *ctxLiteral("assertion failed", expr.location));
+  }
+  auto *fileName =
+      emitStringLiteral(*ctxLiteral("<flux>", expr.location));
+  auto *i32Ty = llvm::Type::getInt32Ty(ctx_);
+  auto *line = llvm::ConstantInt::get(i32Ty, expr.location.raw);
+
+  auto *ptrTy = llvm::PointerType::getUnqual(ctx_);
+  auto *i1Ty = llvm::Type::getInt1Ty(ctx_);
+
+  switch (checkTier_) {
+  case CheckTier::Full: {
+    // Out-of-line call: best diagnostics, no control-flow cost modeling
+    auto assertFn = module_.getOrInsertFunction(
+        "flux_assert", llvm::FunctionType::get(
+                           llvm::Type::getVoidTy(ctx_),
+                           {i1Ty, ptrTy, ptrTy, i32Ty}, false));
+    builder_.CreateCall(assertFn, {cond, message, fileName, line});
+    return nullptr;
+  }
+  case CheckTier::Fast: {
+    // Inline test with the panic path outlined cold: the hot edge is
+    // fall-through and the optimizer (and vectorizer) treat the check
+    // as nearly free; llvm.assume propagates the invariant afterwards
+    auto *func = builder_.GetInsertBlock()->getParent();
+    auto *failBB = llvm::BasicBlock::Create(ctx_, "assert.fail", func);
+    auto *contBB = llvm::BasicBlock::Create(ctx_, "assert.cont", func);
+
+    llvm::MDBuilder mdBuilder(ctx_);
+    builder_.CreateCondBr(cond, contBB, failBB,
+                          mdBuilder.createBranchWeights(1 << 20, 1));
+
+    builder_.SetInsertPoint(failBB);
+    auto panicFn = module_.getOrInsertFunction(
+        "flux_panic", llvm::FunctionType::get(llvm::Type::getVoidTy(ctx_),
+                                              {ptrTy, ptrTy, i32Ty}, false));
+    if (auto *panicDecl = llvm::dyn_cast<llvm::Function>(
+            panicFn.getCallee()->stripPointerCasts())) {
+      panicDecl->addFnAttr(llvm::Attribute::Cold);
+      panicDecl->addFnAttr(llvm::Attribute::NoReturn);
+    }
+    builder_.CreateCall(panicFn, {message, fileName, line});
+    builder_.CreateUnreachable();
+
+    builder_.SetInsertPoint(contBB);
+    builder_.CreateAssumption(cond);
+    return nullptr;
+  }
+  case CheckTier::Off:
+    // Check elided; keep the invariant visible to the optimizer
+    builder_.CreateAssumption(cond);
+    return nullptr;
+  }
+  return nullptr;
+}
+
 llvm::Value *IREmitter::emitCallExpr(ast::CallExpr &expr) {
+  // Consume the tail-position flag; calls inside the arguments are not
+  // in tail position
+  bool isTailCall = inTailPosition_;
+  inTailPosition_ = false;
+
   // For now, handle direct calls via IdentExpr callee
   std::string calleeName;
   if (expr.callee->kind == ast::Expr::Kind::Ident) {
     calleeName = static_cast<ast::IdentExpr &>(*expr.callee).name;
+    if (calleeName == "assert") {
+      return emitAssertCall(expr);
+    }
+    if (calleeName == "panic") {
+      // Cold-annotated shim: branches leading here predict not-taken
+      auto *ptrTy = llvm::PointerType::getUnqual(ctx_);
+      auto *i32Ty = llvm::Type::getInt32Ty(ctx_);
+      auto panicFn = module_.getOrInsertFunction(
+          "flux_panic", llvm::FunctionType::get(llvm::Type::getVoidTy(ctx_),
+                                                {ptrTy, ptrTy, i32Ty},
+                                                false));
+      if (auto *panicDecl = llvm::dyn_cast<llvm::Function>(
+              panicFn.getCallee()->stripPointerCasts())) {
+        panicDecl->addFnAttr(llvm::Attribute::Cold);
+        panicDecl->addFnAttr(llvm::Attribute::NoReturn);
+      }
+      llvm::Value *message =
+          expr.arguments.empty() ? nullptr : emitExpr(*expr.arguments[0]);
+      if (!message) {
+        message = emitStringLiteral(*ctxLiteral("panic", expr.location));
+      }
+      auto *fileName = emitStringLiteral(*ctxLiteral("<flux>", expr.location));
+      builder_.CreateCall(panicFn,
+                          {message, fileName,
+                           llvm::ConstantInt::get(i32Ty, expr.location.raw)});
+      builder_.CreateUnreachable();
+      // Continue emission in a fresh (unreachable) block
+      auto *func = builder_.GetInsertBlock()->getParent();
+      builder_.SetInsertPoint(
+          llvm::BasicBlock::Create(ctx_, "panic.after", func));
+      return nullptr;
+    }
   } else if (expr.callee->kind == ast::Expr::Kind::Path) {
     auto &pe = static_cast<ast::PathExpr &>(*expr.callee);
     for (size_t i = 0; i < pe.segments.size(); ++i) {
@@ -619,11 +1514,24 @@ llvm::Value *IREmitter::emitCallExpr(ast::CallExpr &expr) {
     castedArgs.push_back(argVal);
   }
 
-  if (calleeFunc->getReturnType()->isVoidTy()) {
-    builder_.CreateCall(calleeFunc, castedArgs);
-    return nullptr;
+  llvm::CallInst *call =
+      calleeFunc->getReturnType()->isVoidTy()
+          ? builder_.CreateCall(calleeFunc, castedArgs)
+          : builder_.CreateCall(calleeFunc, castedArgs, "calltmp");
+
+  if (isTailCall) {
+    // Guarantee constant stack for self-recursion (the signatures match
+    // by construction); other tail calls get the optimizable hint
+    auto *caller = builder_.GetInsertBlock()->getParent();
+    if (calleeFunc == caller &&
+        calleeFunc->getFunctionType() == caller->getFunctionType()) {
+      call->setTailCallKind(llvm::CallInst::TCK_MustTail);
+    } else {
+      call->setTailCallKind(llvm::CallInst::TCK_Tail);
+    }
   }
-  return builder_.CreateCall(calleeFunc, castedArgs, "calltmp");
+
+  return calleeFunc->getReturnType()->isVoidTy() ? nullptr : call;
 }
 
 llvm::Value *IREmitter::emitIfExpr(ast::IfExpr &expr) {
@@ -683,6 +1591,75 @@ llvm::Value *IREmitter::emitBlockExpr(ast::BlockExpr &expr) {
   return nullptr;
 }
 
+llvm::Value *IREmitter::emitIndexExpr(ast::IndexExpr &expr) {
+  // Fixed-size array indexing: load through a GEP, bounds-checked
+  // unless range analysis proved the index in range
+  if (expr.object->kind != ast::Expr::Kind::Ident) {
+    diag_.emitError(expr.location, "unsupported index target");
+    return nullptr;
+  }
+  auto &ident = static_cast<ast::IdentExpr &>(*expr.object);
+  auto it = namedValues_.find(ident.name);
+  if (it == namedValues_.end() ||
+      !it->second->getAllocatedType()->isArrayTy()) {
+    diag_.emitError(expr.location,
+                    "indexing requires a fixed-size array variable");
+    return nullptr;
+  }
+  auto *arrayType = llvm::cast<llvm::ArrayType>(it->second->getAllocatedType());
+  uint64_t length = arrayType->getNumElements();
+
+  llvm::Value *index = emitExpr(*expr.index);
+  if (!index) {
+    return nullptr;
+  }
+  auto *i64Ty = llvm::Type::getInt64Ty(ctx_);
+  if (index->getType() != i64Ty && index->getType()->isIntegerTy()) {
+    index = builder_.CreateSExt(index, i64Ty, "idx");
+  }
+  auto *lengthConst = llvm::ConstantInt::get(i64Ty, length);
+
+  if (safeIndexes_.count(&expr)) {
+    // Proven by the loop header; keep the fact for the optimizer
+    builder_.CreateAssumption(
+        builder_.CreateICmpULT(index, lengthConst, "idx.inb"));
+    ++checksElided_;
+  } else {
+    // Cold-outlined check, same shape as the fast assertion tier
+    auto *func = builder_.GetInsertBlock()->getParent();
+    auto *failBB = llvm::BasicBlock::Create(ctx_, "bounds.fail", func);
+    auto *contBB = llvm::BasicBlock::Create(ctx_, "bounds.cont", func);
+    llvm::MDBuilder mdBuilder(ctx_);
+    builder_.CreateCondBr(
+        builder_.CreateICmpULT(index, lengthConst, "idx.ok"), contBB,
+        failBB, mdBuilder.createBranchWeights(1 << 20, 1));
+
+    builder_.SetInsertPoint(failBB);
+    auto *ptrTy = llvm::PointerType::getUnqual(ctx_);
+    auto *i32Ty = llvm::Type::getInt32Ty(ctx_);
+    auto panicFn = module_.getOrInsertFunction(
+        "flux_panic", llvm::FunctionType::get(llvm::Type::getVoidTy(ctx_),
+                                              {ptrTy, ptrTy, i32Ty}, false));
+    builder_.CreateCall(
+        panicFn,
+        {emitStringLiteral(*ctxLiteral("index out of bounds", expr.location)),
+         emitStringLiteral(*ctxLiteral("<flux>", expr.location)),
+         llvm::ConstantInt::get(i32Ty, expr.location.raw)});
+    builder_.CreateUnreachable();
+
+    builder_.SetInsertPoint(contBB);
+    ++checksRetained_;
+  }
+
+  auto *elementPtr = builder_.CreateInBoundsGEP(
+      arrayType, it->second, {llvm::ConstantInt::get(i64Ty, 0), index},
+      "elem");
+  auto *load = builder_.CreateLoad(arrayType->getElementType(), elementPtr,
+                                   ident.name + ".elem");
+  attachTBAA(load, arrayType->getElementType());
+  return load;
+}
+
 llvm::Value *IREmitter::emitAssignExpr(ast::AssignExpr &expr) {
   auto *val = emitExpr(*expr.value);
   if (!val)
@@ -692,7 +1669,17 @@ llvm::Value *IREmitter::emitAssignExpr(ast::AssignExpr &expr) {
     auto &ident = static_cast<ast::IdentExpr &>(*expr.target);
     auto it = namedValues_.find(ident.name);
     if (it != namedValues_.end()) {
-      builder_.CreateStore(val, it->second);
+      // Writes through a mut ref parameter land in the caller's storage
+      auto refIt = refParamPointees_.find(ident.name);
+      if (refIt != refParamPointees_.end()) {
+        auto *referent = builder_.CreateLoad(
+            it->second->getAllocatedType(), it->second, ident.name);
+        auto *store = builder_.CreateStore(val, referent);
+        attachTBAA(store, refIt->second);
+        return val;
+      }
+      auto *store = builder_.CreateStore(val, it->second);
+      attachTBAA(store, it->second->getAllocatedType());
       return val;
     }
   }
@@ -711,4 +1698,34 @@ llvm::AllocaInst *IREmitter::createEntryBlockAlloca(llvm::Function *func,
   return tempBuilder.CreateAlloca(type, nullptr, name);
 }
 
+ast::StringLiteralExpr *IREmitter::ctxLiteral(const std::string &text,
+                                              SourceLocation loc) {
+  // Scratch literals for assert/panic lowering live in a small local
+  // arena owned by the emitter
+  return scratch_.create<ast::StringLiteralExpr>(text, loc);
+}
+
+void IREmitter::attachTBAA(llvm::Instruction *inst, llvm::Type *type) {
+  if (!type || type->isVoidTy() || type->isStructTy() || type->isArrayTy()) {
+    return; // aggregates would need struct-path TBAA
+  }
+
+  llvm::MDBuilder mdBuilder(ctx_);
+  if (!tbaaRoot_) {
+    tbaaRoot_ = mdBuilder.createTBAARoot("Flux TBAA");
+  }
+
+  auto it = tbaaTags_.find(type);
+  if (it == tbaaTags_.end()) {
+    std::string name;
+    llvm::raw_string_ostream nameStream(name);
+    type->print(nameStream);
+    llvm::MDNode *scalar =
+        mdBuilder.createTBAAScalarTypeNode(nameStream.str(), tbaaRoot_);
+    llvm::MDNode *tag = mdBuilder.createTBAAStructTagNode(scalar, scalar, 0);
+    it = tbaaTags_.emplace(type, tag).first;
+  }
+  inst->setMetadata(llvm::LLVMContext::MD_tbaa, it->second);
+}
+
 } // namespace flux
@@ -0,0 +1,141 @@
+#include "flux/CodeGen/RangeAnalysis.h"
+
+#include "flux/AST/Expr.h"
+#include "flux/AST/Stmt.h"
+#include "flux/AST/Type.h"
+
+namespace flux {
+
+using namespace ast;
+
+std::unordered_set<const Expr *> RangeAnalysis::safeIndexes(FuncDecl &func) {
+  RangeAnalysis analysis;
+  // Fixed-size array parameters participate too
+  for (const auto &param : func.params) {
+    if (param.type && param.type->kind == TypeNode::Kind::Array) {
+      auto &array = static_cast<const ArrayType &>(*param.type);
+      if (array.size) {
+        analysis.arraySizes_[param.name] = *array.size;
+      }
+    }
+  }
+  if (func.body) {
+    analysis.walkStmt(*func.body);
+  }
+  return std::move(analysis.safe_);
+}
+
+void RangeAnalysis::visitLetStmt(LetStmt &stmt) {
+  if (stmt.initializer) {
+    walkExpr(*stmt.initializer);
+  }
+
+  // A rebinding replaces whatever was known about this name: an old
+  // array size or loop range must never survive a shadowing let
+  arraySizes_.erase(stmt.name);
+  loopRanges_.erase(stmt.name);
+
+  if (stmt.type && stmt.type->kind == TypeNode::Kind::Array) {
+    auto &array = static_cast<const ArrayType &>(*stmt.type);
+    if (array.size) {
+      arraySizes_[stmt.name] = *array.size;
+    }
+  }
+}
+
+void RangeAnalysis::visitBlockStmt(BlockStmt &stmt) {
+  // Facts established inside a block die with it (inner shadows must
+  // not leak over outer bindings), but poisoning is one-way: a name
+  // mutated inside the block stays untrusted afterwards
+  auto savedArrays = arraySizes_;
+  auto savedRanges = loopRanges_;
+  for (auto &inner : stmt.statements) {
+    walkStmt(*inner);
+  }
+  arraySizes_ = std::move(savedArrays);
+  loopRanges_ = std::move(savedRanges);
+  for (const auto &name : poisoned_) {
+    arraySizes_.erase(name);
+    loopRanges_.erase(name);
+  }
+}
+
+void RangeAnalysis::poison(const std::string &name) {
+  arraySizes_.erase(name);
+  loopRanges_.erase(name);
+  poisoned_.insert(name);
+}
+
+void RangeAnalysis::visitAssignExpr(AssignExpr &expr) {
+  if (expr.target->kind == Expr::Kind::Ident) {
+    poison(static_cast<IdentExpr &>(*expr.target).name);
+  } else {
+    walkExpr(*expr.target);
+  }
+  walkExpr(*expr.value);
+}
+
+void RangeAnalysis::visitCompoundAssignExpr(CompoundAssignExpr &expr) {
+  if (expr.target->kind == Expr::Kind::Ident) {
+    poison(static_cast<IdentExpr &>(*expr.target).name);
+  } else {
+    walkExpr(*expr.target);
+  }
+  walkExpr(*expr.value);
+}
+
+void RangeAnalysis::visitForStmt(ForStmt &stmt) {
+  walkExpr(*stmt.iterable);
+
+  // Canonical counted loop with literal bounds: i in lo..hi. The loop
+  // header rebinds the variable fresh, so earlier poisoning is lifted
+  bool tracked = false;
+  if (stmt.iterable->kind == Expr::Kind::Range) {
+    auto &range = static_cast<RangeExpr &>(*stmt.iterable);
+    if (range.start && range.end &&
+        range.start->kind == Expr::Kind::IntLiteral &&
+        range.end->kind == Expr::Kind::IntLiteral) {
+      int64_t lo = static_cast<IntLiteralExpr &>(*range.start).value;
+      int64_t hi = static_cast<IntLiteralExpr &>(*range.end).value;
+      int64_t max = range.inclusive ? hi : hi - 1;
+      if (lo >= 0 && max >= lo) {
+        poisoned_.erase(stmt.varName);
+        loopRanges_[stmt.varName] = {lo, max};
+        tracked = true;
+      }
+    }
+  }
+
+  walkStmt(*stmt.body);
+  if (tracked) {
+    loopRanges_.erase(stmt.varName);
+  }
+}
+
+void RangeAnalysis::visitIndexExpr(IndexExpr &expr) {
+  walkExpr(*expr.object);
+  walkExpr(*expr.index);
+
+  if (expr.object->kind != Expr::Kind::Ident ||
+      expr.index->kind != Expr::Kind::Ident) {
+    return;
+  }
+  const std::string &arrayName =
+      static_cast<IdentExpr &>(*expr.object).name;
+  const std::string &indexName =
+      static_cast<IdentExpr &>(*expr.index).name;
+  if (poisoned_.count(arrayName) || poisoned_.count(indexName)) {
+    return;
+  }
+  auto sizeIt = arraySizes_.find(arrayName);
+  auto rangeIt = loopRanges_.find(indexName);
+  if (sizeIt == arraySizes_.end() || rangeIt == loopRanges_.end()) {
+    return;
+  }
+  // The loop header already guarantees min >= 0 here
+  if (static_cast<uint64_t>(rangeIt->second.max) < sizeIt->second) {
+    safe_.insert(&expr);
+  }
+}
+
+} // namespace flux
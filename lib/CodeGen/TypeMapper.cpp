@@ -50,6 +50,20 @@ llvm::Type* TypeMapper::getBuiltinType(const std::string& name) {
 }
 
 llvm::Type* TypeMapper::mapType(const ast::TypeNode& type) {
+    // Memoize on canonical identity: structurally identical annotations
+    // share one lowering
+    const Type* canonical = typeCtx_.canonicalize(type);
+    auto it = lowered_.find(canonical);
+    if (it != lowered_.end()) {
+        return it->second;
+    }
+
+    llvm::Type* result = lowerType(type);
+    lowered_.emplace(canonical, result);
+    return result;
+}
+
+llvm::Type* TypeMapper::lowerType(const ast::TypeNode& type) {
     switch (type.kind) {
     case ast::TypeNode::Kind::Named: {
         auto& nt = static_cast<const ast::NamedType&>(type);
@@ -1,16 +1,44 @@
 #include "flux/Common/Diagnostics.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
 namespace flux {
 
-DiagnosticEngine::DiagnosticEngine() {
-  handler_ = [this](const Diagnostic &diag) { defaultHandler(diag); };
+std::string Diagnostic::renderMessage() const {
+  if (!message.empty() || !format) {
+    return message;
+  }
+
+  // Substitute "{N}" placeholders from the argument pack
+  std::string result;
+  const char *pos = format;
+  while (*pos) {
+    if (pos[0] == '{' && pos[1] >= '0' && pos[1] <= '9' && pos[2] == '}') {
+      size_t index = static_cast<size_t>(pos[1] - '0');
+      if (index < args.size()) {
+        result += args[index];
+      }
+      pos += 3;
+    } else {
+      result += *pos++;
+    }
+  }
+  return result;
+}
+
+DiagnosticEngine::DiagnosticEngine() : defaultSink_(*this) {
+  sink_ = &defaultSink_;
+}
+
+void DiagnosticEngine::setSink(DiagnosticSink *sink) {
+  sink_ = sink ? sink : &defaultSink_;
 }
 
 void DiagnosticEngine::setHandler(DiagnosticHandler handler) {
-  handler_ = std::move(handler);
+  callbackSink_ = std::make_unique<CallbackSink>(std::move(handler));
+  sink_ = callbackSink_.get();
 }
 
 void DiagnosticEngine::setSourceManager(const SourceManager *sm) {
@@ -19,48 +47,168 @@ void DiagnosticEngine::setSourceManager(const SourceManager *sm) {
 
 void DiagnosticEngine::emitError(SourceLocation loc,
                                  const std::string &message) {
-  emit(Diagnostic{DiagnosticSeverity::Error, loc, message, {}, {}});
+  Diagnostic diag;
+  diag.severity = DiagnosticSeverity::Error;
+  diag.location = loc;
+  diag.message = message;
+  emit(std::move(diag));
 }
 
 void DiagnosticEngine::emitWarning(SourceLocation loc,
                                    const std::string &message) {
-  emit(Diagnostic{DiagnosticSeverity::Warning, loc, message, {}, {}});
+  Diagnostic diag;
+  diag.severity = DiagnosticSeverity::Warning;
+  diag.location = loc;
+  diag.message = message;
+  emit(std::move(diag));
 }
 
 void DiagnosticEngine::emitNote(SourceLocation loc,
                                 const std::string &message) {
-  emit(Diagnostic{DiagnosticSeverity::Note, loc, message, {}, {}});
+  Diagnostic diag;
+  diag.severity = DiagnosticSeverity::Note;
+  diag.location = loc;
+  diag.message = message;
+  emit(std::move(diag));
 }
 
 void DiagnosticEngine::emitFatal(SourceLocation loc,
                                  const std::string &message) {
-  emit(Diagnostic{DiagnosticSeverity::Fatal, loc, message, {}, {}});
+  Diagnostic diag;
+  diag.severity = DiagnosticSeverity::Fatal;
+  diag.location = loc;
+  diag.message = message;
+  emit(std::move(diag));
+}
+
+void DiagnosticEngine::report(DiagnosticSeverity severity, SourceLocation loc,
+                              const char *format,
+                              std::vector<std::string> args) {
+  Diagnostic diag;
+  diag.severity = severity;
+  diag.location = loc;
+  diag.format = format;
+  diag.args = std::move(args);
+  emit(std::move(diag));
+}
+
+uint64_t DiagnosticEngine::dedupeKey(const Diagnostic &diag) {
+  uint64_t hash = 14695981039346656037ull;
+  auto mix = [&hash](const void *data, size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+  };
+  mix(&diag.location.raw, sizeof(diag.location.raw));
+  mix(&diag.severity, sizeof(diag.severity));
+  if (!diag.message.empty()) {
+    mix(diag.message.data(), diag.message.size());
+  } else if (diag.format) {
+    // Lazy diagnostics hash their template pointer and arguments —
+    // no rendering needed to detect a duplicate
+    mix(&diag.format, sizeof(diag.format));
+    for (const auto &arg : diag.args) {
+      mix(arg.data(), arg.size());
+    }
+  }
+  return hash;
 }
 
 void DiagnosticEngine::emit(Diagnostic diag) {
+  // Exact repeats (same location, severity, and message) are counted
+  // but never stored or formatted again. Sharding by the dedupe hash
+  // keeps dedup global while locking stays shard-local.
+  uint64_t key = dedupeKey(diag);
+  Shard &shard = shards_[key % kShards];
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!shard.seen.insert(key).second) {
+      suppressedCount_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  if (limitReached_.load(std::memory_order_relaxed)) {
+    suppressedCount_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
   switch (diag.severity) {
   case DiagnosticSeverity::Error:
   case DiagnosticSeverity::Fatal:
-    ++errorCount_;
+    errorCount_.fetch_add(1, std::memory_order_relaxed);
     break;
   case DiagnosticSeverity::Warning:
-    ++warningCount_;
+    warningCount_.fetch_add(1, std::memory_order_relaxed);
     break;
   case DiagnosticSeverity::Note:
     break;
   }
 
-  diagnostics_.push_back(diag);
+  if (buffered_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.pending.push_back(std::move(diag));
+    return;
+  }
+
+  dispatch(std::move(diag));
+}
+
+void DiagnosticEngine::dispatch(Diagnostic diag) {
+  std::lock_guard<std::mutex> lock(dispatchMutex_);
+  SourceLocation location = diag.location;
+  if (diagnostics_.size() < kMaxStoredDiagnostics) {
+    diagnostics_.push_back(diag);
+  }
+  sink_->handleDiagnostic(diag);
+
+  if (errorLimit_ > 0 &&
+      errorCount_.load(std::memory_order_relaxed) >= errorLimit_ &&
+      !limitReached_.exchange(true)) {
+    Diagnostic fatal;
+    fatal.severity = DiagnosticSeverity::Fatal;
+    fatal.location = location;
+    fatal.message =
+        "too many errors emitted (limit " + std::to_string(errorLimit_) +
+        "), stopping now";
+    sink_->handleDiagnostic(fatal);
+  }
+}
 
-  if (handler_) {
-    handler_(diag);
+void DiagnosticEngine::flush() {
+  // Merge every shard and dispatch in source order, so parallel phases
+  // produce deterministic output no matter how workers interleaved
+  std::vector<Diagnostic> merged;
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto &diag : shard.pending) {
+      merged.push_back(std::move(diag));
+    }
+    shard.pending.clear();
+  }
+  std::stable_sort(merged.begin(), merged.end(),
+                   [](const Diagnostic &a, const Diagnostic &b) {
+                     return a.location.raw < b.location.raw;
+                   });
+  for (auto &diag : merged) {
+    dispatch(std::move(diag));
   }
 }
 
 void DiagnosticEngine::reset() {
+  std::lock_guard<std::mutex> lock(dispatchMutex_);
   diagnostics_.clear();
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> shardLock(shard.mutex);
+    shard.seen.clear();
+    shard.pending.clear();
+  }
   errorCount_ = 0;
   warningCount_ = 0;
+  suppressedCount_ = 0;
+  limitReached_ = false;
 }
 
 std::string
@@ -81,12 +229,20 @@ DiagnosticEngine::severityString(DiagnosticSeverity severity) const {
 std::string DiagnosticEngine::formatDiagnostic(const Diagnostic &diag) const {
   std::ostringstream out;
 
-  // Severity and message
-  out << severityString(diag.severity) << ": " << diag.message << "\n";
+  // Severity and message (lazy diagnostics render here, not before)
+  out << severityString(diag.severity) << ": " << diag.renderMessage()
+      << "\n";
 
   // Location
   if (diag.location.isValid()) {
-    out << "  --> " << diag.location.toString() << "\n";
+    // Decode lazily through the source manager when we have one; the raw
+    // 32-bit location only knows its global offset.
+    if (sourceManager_) {
+      out << "  --> " << sourceManager_->decode(diag.location).toString()
+          << "\n";
+    } else {
+      out << "  --> " << diag.location.toString() << "\n";
+    }
 
     // Show source line if source manager is available
     if (sourceManager_) {
@@ -102,7 +258,10 @@ std::string DiagnosticEngine::formatDiagnostic(const Diagnostic &diag) const {
   for (const auto &note : diag.notes) {
     out << "  note: " << note.message << "\n";
     if (note.location.isValid()) {
-      out << "    --> " << note.location.toString() << "\n";
+      out << "    --> "
+          << (sourceManager_ ? sourceManager_->decode(note.location).toString()
+                             : note.location.toString())
+          << "\n";
     }
   }
 
@@ -117,9 +276,8 @@ std::string DiagnosticEngine::formatDiagnostic(const Diagnostic &diag) const {
   return out.str();
 }
 
-void DiagnosticEngine::defaultHandler(const Diagnostic &diag) {
-  std::string formatted = formatDiagnostic(diag);
-  std::cerr << formatted;
+void DiagnosticEngine::StderrSink::handleDiagnostic(const Diagnostic &diag) {
+  std::cerr << engine_.formatDiagnostic(diag);
 }
 
 } // namespace flux
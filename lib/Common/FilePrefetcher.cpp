@@ -0,0 +1,104 @@
+#include "flux/Common/FilePrefetcher.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace flux {
+
+FilePrefetcher::FilePrefetcher(unsigned workers) {
+  if (workers == 0) {
+    workers = 1;
+  }
+  for (unsigned i = 0; i < workers; ++i) {
+    workers_.emplace_back([this] { workerLoop(); });
+  }
+}
+
+FilePrefetcher::~FilePrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void FilePrefetcher::prefetch(std::string path) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(path));
+  }
+  cv_.notify_one();
+}
+
+void FilePrefetcher::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idleCV_.wait(lock, [&] { return queue_.empty() && inFlight_ == 0; });
+}
+
+void FilePrefetcher::workerLoop() {
+  for (;;) {
+    std::string path;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return; // stopping
+      }
+      path = std::move(queue_.back());
+      queue_.pop_back();
+      ++inFlight_;
+    }
+
+    touchFile(path);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --inFlight_;
+    }
+    idleCV_.notify_all();
+  }
+}
+
+void FilePrefetcher::touchFile(const std::string &path) {
+#ifndef _WIN32
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+#ifdef POSIX_FADV_WILLNEED
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    posix_fadvise(fd, 0, st.st_size, POSIX_FADV_WILLNEED);
+  }
+#else
+  // Fallback: pull the pages in with throwaway reads
+  char buffer[64 * 1024];
+  while (read(fd, buffer, sizeof(buffer)) > 0) {
+  }
+#endif
+  close(fd);
+#else
+  // Windows: opening with sequential-scan hint primes the cache manager
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file != INVALID_HANDLE_VALUE) {
+    char buffer[64 * 1024];
+    DWORD got = 0;
+    while (ReadFile(file, buffer, sizeof(buffer), &got, nullptr) && got > 0) {
+    }
+    CloseHandle(file);
+  }
+#endif
+}
+
+} // namespace flux
@@ -4,9 +4,26 @@
 #include <sstream>
 #include <stdexcept>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace flux {
 
 std::string SourceLocation::toString() const {
+  if (!isValid()) {
+    return "<unknown>";
+  }
+  return "<offset " + std::to_string(raw) + ">";
+}
+
+std::string DecodedLocation::toString() const {
   std::string result;
   result += filename;
   result += ':';
@@ -16,59 +33,178 @@ std::string SourceLocation::toString() const {
   return result;
 }
 
-uint32_t SourceManager::loadFile(const std::string &path) {
-  std::ifstream file(path, std::ios::binary);
-  if (!file.is_open()) {
-    throw std::runtime_error("Failed to open file: " + path);
+SourceManager::~SourceManager() {
+  for (auto &entry : files_) {
+    if (entry->mapping) {
+#ifdef _WIN32
+      UnmapViewOfFile(entry->mapping);
+#else
+      munmap(entry->mapping, entry->mappingSize);
+#endif
+    }
   }
+}
 
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-
-  FileEntry entry;
+uint32_t SourceManager::loadFile(const std::string &path) {
+  auto entryPtr = std::make_unique<FileEntry>();
+  FileEntry &entry = *entryPtr;
   entry.filename = path;
-  entry.content = buffer.str();
-  computeLineOffsets(entry);
 
+  if (!mapFile(path, entry)) {
+    // Fallback: pipes, stdin, special files, or mmap failure.
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+      throw std::runtime_error("Failed to open file: " + path);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    entry.content = buffer.str();
+    entry.data = entry.content;
+  }
+
+  return finishEntry(std::move(entryPtr));
+}
+
+uint32_t SourceManager::finishEntry(std::unique_ptr<FileEntry> entry) {
+  // Each file gets a contiguous range in the 32-bit address space; +1
+  // keeps ranges disjoint and reserves raw == 0 for "unknown".
+  if (!files_.empty()) {
+    const FileEntry &prev = *files_.back();
+    entry->baseOffset =
+        prev.baseOffset + static_cast<uint32_t>(prev.data.size()) + 1;
+  }
+  computeLineOffsets(*entry);
   files_.push_back(std::move(entry));
   return static_cast<uint32_t>(files_.size() - 1);
 }
 
+bool SourceManager::mapFile(const std::string &path, FileEntry &entry) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 ||
+      GetFileType(file) != FILE_TYPE_DISK) {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+                                      nullptr);
+  CloseHandle(file); // the mapping keeps the file alive
+  if (!mapping)
+    return false;
+
+  void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping); // the view keeps the mapping alive
+  if (!base)
+    return false;
+
+  entry.mapping = base;
+  entry.mappingSize = static_cast<size_t>(size.QuadPart);
+  entry.data = std::string_view(static_cast<const char *>(base),
+                                entry.mappingSize);
+  return true;
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  void *base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                    MAP_PRIVATE, fd, 0);
+  close(fd); // the mapping keeps the pages alive
+  if (base == MAP_FAILED)
+    return false;
+
+  entry.mapping = base;
+  entry.mappingSize = static_cast<size_t>(st.st_size);
+  entry.data = std::string_view(static_cast<const char *>(base),
+                                entry.mappingSize);
+  return true;
+#endif
+}
+
 uint32_t SourceManager::loadFromString(const std::string &name,
                                        std::string content) {
-  FileEntry entry;
+  auto entryPtr = std::make_unique<FileEntry>();
+  FileEntry &entry = *entryPtr;
   entry.filename = name;
   entry.content = std::move(content);
-  computeLineOffsets(entry);
-
-  files_.push_back(std::move(entry));
-  return static_cast<uint32_t>(files_.size() - 1);
+  entry.data = entry.content;
+  return finishEntry(std::move(entryPtr));
 }
 
 std::string_view SourceManager::getSource(uint32_t fileId) const {
   if (fileId >= files_.size()) {
     throw std::out_of_range("Invalid file ID");
   }
-  return files_[fileId].content;
+  return files_[fileId]->data;
 }
 
 std::string_view SourceManager::getFilename(uint32_t fileId) const {
   if (fileId >= files_.size()) {
     throw std::out_of_range("Invalid file ID");
   }
-  return files_[fileId].filename;
+  return files_[fileId]->filename;
 }
 
-SourceLocation SourceManager::getLocation(uint32_t fileId,
-                                          uint32_t offset) const {
+uint32_t SourceManager::fileBase(uint32_t fileId) const {
   if (fileId >= files_.size()) {
-    return SourceLocation::unknown();
+    throw std::out_of_range("Invalid file ID");
   }
+  return files_[fileId]->baseOffset;
+}
 
-  const auto &entry = files_[fileId];
-  if (offset >= entry.content.size()) {
+SourceLocation SourceManager::makeLocation(uint32_t fileId,
+                                           uint32_t offset) const {
+  if (fileId >= files_.size()) {
     return SourceLocation::unknown();
   }
+  return SourceLocation::fromRaw(files_[fileId]->baseOffset + offset);
+}
+
+DecodedLocation SourceManager::decode(SourceLocation loc) const {
+  if (!loc.isValid()) {
+    return DecodedLocation{};
+  }
+
+  // Binary search the file whose range contains loc.raw
+  uint32_t lo = 0, hi = static_cast<uint32_t>(files_.size());
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if (files_[mid]->baseOffset <= loc.raw) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo == 0) {
+    return DecodedLocation{};
+  }
+  uint32_t fileId = lo - 1;
+  return getLocation(fileId, loc.raw - files_[fileId]->baseOffset);
+}
+
+DecodedLocation SourceManager::getLocation(uint32_t fileId,
+                                           uint32_t offset) const {
+  if (fileId >= files_.size()) {
+    return DecodedLocation{};
+  }
+
+  const auto &entry = *files_[fileId];
+  if (offset > entry.data.size()) {
+    return DecodedLocation{};
+  }
 
   // Binary search for the line
   const auto &offsets = entry.lineOffsets;
@@ -86,7 +222,7 @@ SourceLocation SourceManager::getLocation(uint32_t fileId,
 
   uint32_t column = offset - offsets[line] + 1;
 
-  SourceLocation loc;
+  DecodedLocation loc;
   loc.filename = entry.filename;
   loc.line = line + 1; // 1-based
   loc.column = column;
@@ -94,12 +230,21 @@ SourceLocation SourceManager::getLocation(uint32_t fileId,
   return loc;
 }
 
+size_t SourceManager::totalBufferBytes() const {
+  size_t total = 0;
+  for (const auto &entry : files_) {
+    total += entry->data.size();
+    total += entry->lineOffsets.size() * sizeof(uint32_t);
+  }
+  return total;
+}
+
 void SourceManager::computeLineOffsets(FileEntry &entry) {
   entry.lineOffsets.clear();
   entry.lineOffsets.push_back(0); // First line starts at offset 0
 
-  for (uint32_t i = 0; i < entry.content.size(); ++i) {
-    if (entry.content[i] == '\n') {
+  for (uint32_t i = 0; i < entry.data.size(); ++i) {
+    if (entry.data[i] == '\n') {
       entry.lineOffsets.push_back(i + 1);
     }
   }
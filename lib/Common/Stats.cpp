@@ -0,0 +1,117 @@
+#include "flux/Common/Stats.h"
+
+#include <algorithm>
+#include <iomanip>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace flux {
+
+void CompilationStats::report(std::ostream &out) const {
+  uint64_t total = 0;
+  for (const auto &[name, micros] : phases_) {
+    total += micros;
+  }
+
+  out << "=== flux --stats ===\n";
+  out << std::fixed << std::setprecision(2);
+  for (const auto &[name, micros] : phases_) {
+    double ms = static_cast<double>(micros) / 1000.0;
+    double pct =
+        total ? 100.0 * static_cast<double>(micros) / static_cast<double>(total)
+              : 0.0;
+    out << "  " << std::left << std::setw(20) << name << std::right
+        << std::setw(10) << ms << " ms  (" << std::setw(5) << pct << "%)\n";
+  }
+  out << "  " << std::left << std::setw(20) << "total" << std::right
+      << std::setw(10) << static_cast<double>(total) / 1000.0 << " ms\n";
+
+  for (const auto &[name, value] : counters_) {
+    out << "  " << std::left << std::setw(20) << name << std::right
+        << std::setw(10) << value << "\n";
+  }
+
+  if (uint64_t rss = peakRSSBytes()) {
+    out << "  " << std::left << std::setw(20) << "peak RSS" << std::right
+        << std::setw(10) << rss / (1024 * 1024) << " MiB\n";
+  }
+}
+
+uint64_t CompilationStats::peakRSSBytes() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+    return pmc.PeakWorkingSetSize;
+  }
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<uint64_t>(usage.ru_maxrss); // bytes on macOS
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // KiB on Linux
+#endif
+#endif
+}
+
+DeclTimer::Entry &DeclTimer::entry(const std::string &name,
+                                   SourceLocation loc) {
+  for (auto &[existing, data] : entries_) {
+    if (existing == name) {
+      return data;
+    }
+  }
+  entries_.emplace_back(name, Entry{loc, 0, 0, 0});
+  return entries_.back().second;
+}
+
+void DeclTimer::recordSema(const std::string &name, SourceLocation loc,
+                           uint64_t micros) {
+  entry(name, loc).semaMicros += micros;
+}
+
+void DeclTimer::recordCodeGen(const std::string &name, SourceLocation loc,
+                              uint64_t micros, uint64_t instructions) {
+  Entry &data = entry(name, loc);
+  data.codegenMicros += micros;
+  data.instructions += instructions;
+}
+
+void DeclTimer::report(std::ostream &out,
+                       const SourceManager *sourceManager,
+                       size_t count) const {
+  auto sorted = entries_;
+  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+    return a.second.semaMicros + a.second.codegenMicros >
+           b.second.semaMicros + b.second.codegenMicros;
+  });
+  if (sorted.size() > count) {
+    sorted.resize(count);
+  }
+
+  out << "=== flux --time-per-decl (top " << sorted.size() << ") ===\n";
+  out << std::fixed << std::setprecision(2);
+  for (const auto &[name, data] : sorted) {
+    out << "  " << std::left << std::setw(28) << name << std::right
+        << " sema " << std::setw(8)
+        << static_cast<double>(data.semaMicros) / 1000.0 << " ms"
+        << "  codegen " << std::setw(8)
+        << static_cast<double>(data.codegenMicros) / 1000.0 << " ms"
+        << "  " << std::setw(7) << data.instructions << " instrs";
+    if (sourceManager && data.location.isValid()) {
+      out << "  " << sourceManager->decode(data.location).toString();
+    }
+    out << "\n";
+  }
+}
+
+} // namespace flux
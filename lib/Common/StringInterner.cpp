@@ -0,0 +1,52 @@
+#include "flux/Common/StringInterner.h"
+
+#include <cstring>
+
+namespace flux {
+
+SymbolID StringInterner::intern(std::string_view text) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = map_.find(text);
+  if (it != map_.end()) {
+    return it->second;
+  }
+
+  std::string_view stable = store(text);
+  SymbolID id = static_cast<SymbolID>(spellings_.size() + 1);
+  spellings_.push_back(stable);
+  map_.emplace(stable, id);
+  return id;
+}
+
+std::string_view StringInterner::text(SymbolID id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (id == kInvalidSymbolID || id > spellings_.size()) {
+    return {};
+  }
+  return spellings_[id - 1];
+}
+
+size_t StringInterner::storageBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return storageBytes_;
+}
+
+std::string_view StringInterner::store(std::string_view text) {
+  if (chunks_.empty() || chunkUsed_ + text.size() > kChunkSize) {
+    size_t size = text.size() > kChunkSize ? text.size() : kChunkSize;
+    chunks_.push_back(std::make_unique<char[]>(size));
+    storageBytes_ += size;
+    chunkUsed_ = 0;
+  }
+  char *dest = chunks_.back().get() + chunkUsed_;
+  std::memcpy(dest, text.data(), text.size());
+  chunkUsed_ += text.size();
+  return std::string_view(dest, text.size());
+}
+
+StringInterner &globalInterner() {
+  static StringInterner interner;
+  return interner;
+}
+
+} // namespace flux
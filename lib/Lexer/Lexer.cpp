@@ -1,8 +1,20 @@
 #include "flux/Lexer/Lexer.h"
 
+#include "flux/Common/StringInterner.h"
+
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
 #include <cctype>
-#include <unordered_map>
+
+#if defined(__SSE2__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+#define FLUX_LEXER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define FLUX_LEXER_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace flux {
 
@@ -125,77 +137,446 @@ const char* Token::kindToString(TokenKind kind) {
 // Keyword lookup table
 // ============================================================================
 
-static const std::unordered_map<std::string_view, TokenKind> keywords = {
-    {"module",   TokenKind::KwModule},
-    {"import",   TokenKind::KwImport},
-    {"func",     TokenKind::KwFunc},
-    {"let",      TokenKind::KwLet},
-    {"mut",      TokenKind::KwMut},
-    {"const",    TokenKind::KwConst},
-    {"struct",   TokenKind::KwStruct},
-    {"class",    TokenKind::KwClass},
-    {"enum",     TokenKind::KwEnum},
-    {"trait",    TokenKind::KwTrait},
-    {"impl",     TokenKind::KwImpl},
-    {"type",     TokenKind::KwType},
-    {"self",     TokenKind::KwSelf},
-    {"Self",     TokenKind::KwSelfType},
-    {"if",       TokenKind::KwIf},
-    {"else",     TokenKind::KwElse},
-    {"match",    TokenKind::KwMatch},
-    {"for",      TokenKind::KwFor},
-    {"while",    TokenKind::KwWhile},
-    {"loop",     TokenKind::KwLoop},
-    {"break",    TokenKind::KwBreak},
+// ============================================================================
+// Keyword lookup (compile-time perfect hash)
+// ============================================================================
+//
+// Keywords are classified by a perfect hash over (length, first byte,
+// third byte, last byte): a single multiply and shift maps each of the
+// keywords below to a distinct slot of a 128-entry constexpr table, which
+// the static_assert at the end verifies at compile time. Classification
+// costs one multiply, one shift, and at most one string compare — no
+// allocation and no hashing of the full spelling.
+
+namespace {
+
+constexpr std::pair<std::string_view, TokenKind> kKeywords[] = {
+    {"module", TokenKind::KwModule},
+    {"import", TokenKind::KwImport},
+    {"func", TokenKind::KwFunc},
+    {"let", TokenKind::KwLet},
+    {"mut", TokenKind::KwMut},
+    {"const", TokenKind::KwConst},
+    {"struct", TokenKind::KwStruct},
+    {"class", TokenKind::KwClass},
+    {"enum", TokenKind::KwEnum},
+    {"trait", TokenKind::KwTrait},
+    {"impl", TokenKind::KwImpl},
+    {"type", TokenKind::KwType},
+    {"self", TokenKind::KwSelf},
+    {"Self", TokenKind::KwSelfType},
+    {"if", TokenKind::KwIf},
+    {"else", TokenKind::KwElse},
+    {"match", TokenKind::KwMatch},
+    {"for", TokenKind::KwFor},
+    {"while", TokenKind::KwWhile},
+    {"loop", TokenKind::KwLoop},
+    {"break", TokenKind::KwBreak},
     {"continue", TokenKind::KwContinue},
-    {"return",   TokenKind::KwReturn},
-    {"in",       TokenKind::KwIn},
-    {"move",     TokenKind::KwMove},
-    {"ref",      TokenKind::KwRef},
-    {"drop",     TokenKind::KwDrop},
-    {"async",    TokenKind::KwAsync},
-    {"await",    TokenKind::KwAwait},
-    {"spawn",    TokenKind::KwSpawn},
-    {"unsafe",   TokenKind::KwUnsafe},
-    {"pub",      TokenKind::KwPub},
-    {"public",   TokenKind::KwPublic},
-    {"private",  TokenKind::KwPrivate},
-    {"true",     TokenKind::KwTrue},
-    {"false",    TokenKind::KwFalse},
-    {"and",      TokenKind::KwAnd},
-    {"or",       TokenKind::KwOr},
-    {"not",      TokenKind::KwNot},
-    {"as",       TokenKind::KwAs},
-    {"is",       TokenKind::KwIs},
-    {"where",    TokenKind::KwWhere},
-    {"use",      TokenKind::KwUse},
-    {"Void",     TokenKind::KwVoid},
-    {"panic",    TokenKind::KwPanic},
-    {"assert",   TokenKind::KwAssert},
+    {"return", TokenKind::KwReturn},
+    {"in", TokenKind::KwIn},
+    {"move", TokenKind::KwMove},
+    {"ref", TokenKind::KwRef},
+    {"drop", TokenKind::KwDrop},
+    {"async", TokenKind::KwAsync},
+    {"await", TokenKind::KwAwait},
+    {"spawn", TokenKind::KwSpawn},
+    {"unsafe", TokenKind::KwUnsafe},
+    {"pub", TokenKind::KwPub},
+    {"public", TokenKind::KwPublic},
+    {"private", TokenKind::KwPrivate},
+    {"true", TokenKind::KwTrue},
+    {"false", TokenKind::KwFalse},
+    {"and", TokenKind::KwAnd},
+    {"or", TokenKind::KwOr},
+    {"not", TokenKind::KwNot},
+    {"as", TokenKind::KwAs},
+    {"is", TokenKind::KwIs},
+    {"where", TokenKind::KwWhere},
+    {"use", TokenKind::KwUse},
+    {"Void", TokenKind::KwVoid},
+    {"panic", TokenKind::KwPanic},
+    {"assert", TokenKind::KwAssert},
 };
 
+constexpr size_t kKeywordTableSize = 128;
+constexpr uint32_t kKeywordHashMul = 0x6d6113b5u;
+
+struct KeywordEntry {
+    std::string_view text;
+    TokenKind kind = TokenKind::Identifier;
+};
+
+constexpr uint32_t keywordSlot(std::string_view text) {
+    uint32_t c2 = text.size() > 2 ? static_cast<unsigned char>(text[2]) : 0u;
+    uint32_t mix =
+        static_cast<uint32_t>(text.size()) |
+        (static_cast<uint32_t>(static_cast<unsigned char>(text.front()))
+         << 8) |
+        (c2 << 16) |
+        (static_cast<uint32_t>(static_cast<unsigned char>(text.back()))
+         << 24);
+    return (mix * kKeywordHashMul) >> 25;
+}
+
+constexpr std::array<KeywordEntry, kKeywordTableSize> makeKeywordTable() {
+    std::array<KeywordEntry, kKeywordTableSize> table{};
+    for (auto [text, kind] : kKeywords) {
+        table[keywordSlot(text)] = {text, kind};
+    }
+    return table;
+}
+
+constexpr auto kKeywordTable = makeKeywordTable();
+
+// Verify the hash really is perfect: every keyword must land in its own
+// slot (a collision would leave an earlier keyword overwritten).
+constexpr bool keywordTableIsPerfect() {
+    for (auto [text, kind] : kKeywords) {
+        if (kKeywordTable[keywordSlot(text)].text != text) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(keywordTableIsPerfect(),
+              "keyword perfect hash has collisions — "
+              "re-tune kKeywordHashMul after changing the keyword set");
+
+} // anonymous namespace
+
 // ============================================================================
 // Lexer implementation
 // ============================================================================
 
+
+// ============================================================================
+// SIMD byte-class scanners
+// ============================================================================
+//
+// The lexer spends most of its time walking runs of a single byte class:
+// horizontal whitespace, comment bodies, and identifier/number characters.
+// scanRun() classifies 16 bytes per iteration (SSE2 / NEON) and falls back
+// to a scalar loop on the tail and on platforms without either ISA. None of
+// the classes below include '\n', so callers can bump the column counter by
+// the run length without rescanning for line breaks.
+
+namespace {
+
+#if FLUX_LEXER_SSE2
+
+/// Length of the leading run for which vecClass (whole __m128i -> match
+/// mask) and scalarClass (per byte) hold.
+template <typename VecClass, typename ScalarClass>
+size_t scanRun(const char* data, size_t size, VecClass vecClass,
+               ScalarClass scalarClass) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask =
+            static_cast<unsigned>(_mm_movemask_epi8(vecClass(chunk)));
+        if (mask != 0xFFFF) {
+            return i + std::countr_zero(~mask & 0xFFFFu);
+        }
+    }
+    while (i < size && scalarClass(static_cast<unsigned char>(data[i]))) {
+        ++i;
+    }
+    return i;
+}
+
+size_t scanSpaceRun(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](__m128i c) {
+            __m128i space = _mm_cmpeq_epi8(c, _mm_set1_epi8(' '));
+            __m128i tab = _mm_cmpeq_epi8(c, _mm_set1_epi8('\t'));
+            __m128i cr = _mm_cmpeq_epi8(c, _mm_set1_epi8('\r'));
+            return _mm_or_si128(_mm_or_si128(space, tab), cr);
+        },
+        [](unsigned char c) { return c == ' ' || c == '\t' || c == '\r'; });
+}
+
+size_t scanUntilNewline(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](__m128i c) {
+            // Everything except '\n' matches
+            __m128i nl = _mm_cmpeq_epi8(c, _mm_set1_epi8('\n'));
+            return _mm_xor_si128(nl, _mm_set1_epi8(static_cast<char>(0xFF)));
+        },
+        [](unsigned char c) { return c != '\n'; });
+}
+
+size_t scanBlockCommentRun(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](__m128i c) {
+            // Stop at '*', '/', and '\n'; everything else matches
+            __m128i star = _mm_cmpeq_epi8(c, _mm_set1_epi8('*'));
+            __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+            __m128i nl = _mm_cmpeq_epi8(c, _mm_set1_epi8('\n'));
+            __m128i stop = _mm_or_si128(_mm_or_si128(star, slash), nl);
+            return _mm_xor_si128(stop, _mm_set1_epi8(static_cast<char>(0xFF)));
+        },
+        [](unsigned char c) { return c != '*' && c != '/' && c != '\n'; });
+}
+
+size_t scanIdentifierRun(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](__m128i c) {
+            // [A-Za-z0-9_]; bytes >= 0x80 read as negative and never match
+            __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+            __m128i alpha =
+                _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                              _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), lower));
+            __m128i digit =
+                _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                              _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+            __m128i uscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+            return _mm_or_si128(_mm_or_si128(alpha, digit), uscore);
+        },
+        [](unsigned char c) { return std::isalnum(c) || c == '_'; });
+}
+
+size_t scanDigitRun(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](__m128i c) {
+            __m128i digit =
+                _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                              _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+            __m128i uscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+            return _mm_or_si128(digit, uscore);
+        },
+        [](unsigned char c) { return std::isdigit(c) || c == '_'; });
+}
+
+#elif FLUX_LEXER_NEON
+
+/// Length of the leading run for which vecClass (uint8x16_t -> lane mask)
+/// and scalarClass (per byte) hold.
+template <typename VecClass, typename ScalarClass>
+size_t scanRun(const char* data, size_t size, VecClass vecClass,
+               ScalarClass scalarClass) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t chunk =
+            vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        // Narrow each 16-bit pair to a nibble: 4 mask bits per byte lane
+        uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(
+                vshrn_n_u16(vreinterpretq_u16_u8(vecClass(chunk)), 4)),
+            0);
+        if (mask != ~0ull) {
+            return i + (std::countr_zero(~mask) >> 2);
+        }
+    }
+    while (i < size && scalarClass(static_cast<unsigned char>(data[i]))) {
+        ++i;
+    }
+    return i;
+}
+
+size_t scanSpaceRun(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](uint8x16_t c) {
+            return vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8(' ')),
+                                     vceqq_u8(c, vdupq_n_u8('\t'))),
+                            vceqq_u8(c, vdupq_n_u8('\r')));
+        },
+        [](unsigned char c) { return c == ' ' || c == '\t' || c == '\r'; });
+}
+
+size_t scanUntilNewline(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](uint8x16_t c) { return vmvnq_u8(vceqq_u8(c, vdupq_n_u8('\n'))); },
+        [](unsigned char c) { return c != '\n'; });
+}
+
+size_t scanBlockCommentRun(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](uint8x16_t c) {
+            uint8x16_t stop = vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8('*')),
+                                                vceqq_u8(c, vdupq_n_u8('/'))),
+                                       vceqq_u8(c, vdupq_n_u8('\n')));
+            return vmvnq_u8(stop);
+        },
+        [](unsigned char c) { return c != '*' && c != '/' && c != '\n'; });
+}
+
+size_t scanIdentifierRun(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](uint8x16_t c) {
+            uint8x16_t lower = vorrq_u8(c, vdupq_n_u8(0x20));
+            uint8x16_t alpha = vandq_u8(vcgeq_u8(lower, vdupq_n_u8('a')),
+                                        vcleq_u8(lower, vdupq_n_u8('z')));
+            uint8x16_t digit = vandq_u8(vcgeq_u8(c, vdupq_n_u8('0')),
+                                        vcleq_u8(c, vdupq_n_u8('9')));
+            uint8x16_t uscore = vceqq_u8(c, vdupq_n_u8('_'));
+            return vorrq_u8(vorrq_u8(alpha, digit), uscore);
+        },
+        [](unsigned char c) { return std::isalnum(c) || c == '_'; });
+}
+
+size_t scanDigitRun(const char* data, size_t size) {
+    return scanRun(
+        data, size,
+        [](uint8x16_t c) {
+            uint8x16_t digit = vandq_u8(vcgeq_u8(c, vdupq_n_u8('0')),
+                                        vcleq_u8(c, vdupq_n_u8('9')));
+            return vorrq_u8(digit, vceqq_u8(c, vdupq_n_u8('_')));
+        },
+        [](unsigned char c) { return std::isdigit(c) || c == '_'; });
+}
+
+#else // scalar fallback
+
+size_t scanSpaceRun(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size &&
+           (data[i] == ' ' || data[i] == '\t' || data[i] == '\r')) {
+        ++i;
+    }
+    return i;
+}
+
+size_t scanUntilNewline(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size && data[i] != '\n') {
+        ++i;
+    }
+    return i;
+}
+
+size_t scanBlockCommentRun(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size && data[i] != '*' && data[i] != '/' && data[i] != '\n') {
+        ++i;
+    }
+    return i;
+}
+
+size_t scanIdentifierRun(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size && (std::isalnum(static_cast<unsigned char>(data[i])) ||
+                        data[i] == '_')) {
+        ++i;
+    }
+    return i;
+}
+
+size_t scanDigitRun(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size && (std::isdigit(static_cast<unsigned char>(data[i])) ||
+                        data[i] == '_')) {
+        ++i;
+    }
+    return i;
+}
+
+#endif
+
+} // anonymous namespace
+
 Lexer::Lexer(std::string_view source, std::string_view filename,
-             DiagnosticEngine& diag)
-    : source_(source), filename_(filename), diag_(diag) {}
+             DiagnosticEngine& diag, uint32_t locationBase)
+    : source_(source), filename_(filename), locationBase_(locationBase),
+      diag_(diag) {
+    validateSource();
+}
+
+void Lexer::validateSource() {
+    size_t spanCount = (source_.size() + 63) / 64;
+    nonAsciiSpans_.assign((spanCount + 63) / 64, 0);
+
+    const char* data = source_.data();
+    size_t size = source_.size();
+    size_t i = 0;
+    bool reportedInvalid = false;
+
+    while (i < size) {
+#if FLUX_LEXER_SSE2
+        // Bulk-skip pure-ASCII 16-byte chunks
+        while (i + 16 <= size) {
+            __m128i chunk = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(data + i));
+            if (_mm_movemask_epi8(chunk) != 0) {
+                break;
+            }
+            i += 16;
+        }
+#endif
+        if (i >= size) {
+            break;
+        }
+
+        unsigned char lead = static_cast<unsigned char>(data[i]);
+        if (lead < 0x80) {
+            ++i;
+            continue;
+        }
+
+        // Mark the span and validate the sequence
+        size_t span = i / 64;
+        nonAsciiSpans_[span / 64] |= 1ull << (span % 64);
+
+        size_t needed;
+        if ((lead & 0xE0) == 0xC0 && lead >= 0xC2) {
+            needed = 1;
+        } else if ((lead & 0xF0) == 0xE0) {
+            needed = 2;
+        } else if ((lead & 0xF8) == 0xF0 && lead <= 0xF4) {
+            needed = 3;
+        } else {
+            needed = SIZE_MAX; // invalid lead
+        }
+
+        bool valid = needed != SIZE_MAX && size - i - 1 >= needed;
+        for (size_t k = 1; valid && k <= needed; ++k) {
+            valid = (static_cast<unsigned char>(data[i + k]) & 0xC0) == 0x80;
+        }
+
+        if (!valid) {
+            if (!reportedInvalid) {
+                diag_.emitError(
+                    SourceLocation::fromRaw(locationBase_ +
+                                            static_cast<uint32_t>(i)),
+                    "invalid UTF-8 sequence in source file");
+                reportedInvalid = true;
+            }
+            ++i; // resynchronize byte-wise
+        } else {
+            i += needed + 1;
+        }
+    }
+}
 
-Lexer::State Lexer::saveState() const {
-    return {current_, tokenStart_, line_, column_,
-            tokenLine_, tokenColumn_, hasPeeked_, peekedToken_};
+bool Lexer::spanHasNonASCII(uint32_t offset) const {
+    size_t span = offset / 64;
+    size_t word = span / 64;
+    if (word >= nonAsciiSpans_.size()) {
+        return false;
+    }
+    return (nonAsciiSpans_[word] >> (span % 64)) & 1;
 }
 
-void Lexer::restoreState(const State& s) {
-    current_ = s.current;
-    tokenStart_ = s.tokenStart;
-    line_ = s.line;
-    column_ = s.column;
-    tokenLine_ = s.tokenLine;
-    tokenColumn_ = s.tokenColumn;
-    hasPeeked_ = s.hasPeeked;
-    peekedToken_ = s.peekedToken;
+uint32_t Lexer::consumeUTF8Sequence() {
+    unsigned char lead = static_cast<unsigned char>(source_[current_]);
+    uint32_t length = (lead & 0xE0) == 0xC0   ? 2
+                      : (lead & 0xF0) == 0xE0 ? 3
+                                              : 4;
+    if (current_ + length > source_.size()) {
+        length = 1; // invalid tail already diagnosed; don't run off
+    }
+    current_ += length;
+    return length;
 }
 
 bool Lexer::isAtEnd() const {
@@ -212,16 +593,9 @@ char Lexer::peekNext() const {
     return source_[current_ + 1];
 }
 
-char Lexer::advance() {
-    char c = source_[current_++];
-    if (c == '\n') {
-        ++line_;
-        column_ = 1;
-    } else {
-        ++column_;
-    }
-    return c;
-}
+char Lexer::advance() { return source_[current_++]; }
+
+void Lexer::advanceColumns(uint32_t count) { current_ += count; }
 
 bool Lexer::match(char expected) {
     if (isAtEnd() || source_[current_] != expected) return false;
@@ -231,11 +605,15 @@ bool Lexer::match(char expected) {
 
 void Lexer::skipWhitespace() {
     while (!isAtEnd()) {
+        // Bulk-skip horizontal whitespace; newlines stay scalar so line
+        // tracking remains in advance()
+        advanceColumns(static_cast<uint32_t>(scanSpaceRun(
+            source_.data() + current_, source_.size() - current_)));
+        if (isAtEnd()) {
+            return;
+        }
         char c = peek();
         switch (c) {
-            case ' ':
-            case '\t':
-            case '\r':
             case '\n':
                 advance();
                 break;
@@ -260,9 +638,8 @@ void Lexer::skipLineComment() {
     // Skip the //
     advance();
     advance();
-    while (!isAtEnd() && peek() != '\n') {
-        advance();
-    }
+    advanceColumns(static_cast<uint32_t>(scanUntilNewline(
+        source_.data() + current_, source_.size() - current_)));
 }
 
 bool Lexer::skipBlockComment() {
@@ -272,6 +649,12 @@ bool Lexer::skipBlockComment() {
     int depth = 1;
 
     while (!isAtEnd() && depth > 0) {
+        // Bulk-skip bytes that can affect neither nesting nor line count
+        advanceColumns(static_cast<uint32_t>(scanBlockCommentRun(
+            source_.data() + current_, source_.size() - current_)));
+        if (isAtEnd()) {
+            break;
+        }
         if (peek() == '/' && peekNext() == '*') {
             advance();
             advance();
@@ -286,11 +669,8 @@ bool Lexer::skipBlockComment() {
     }
 
     if (depth > 0) {
-        SourceLocation loc;
-        loc.filename = filename_;
-        loc.line = line_;
-        loc.column = column_;
-        diag_.emitError(loc, "unterminated block comment");
+        diag_.emitError(SourceLocation::fromRaw(locationBase_ + current_),
+                        "unterminated block comment");
         return false;
     }
     return true;
@@ -299,60 +679,79 @@ bool Lexer::skipBlockComment() {
 Token Lexer::makeToken(TokenKind kind) const {
     Token token;
     token.kind = kind;
-    token.text = source_.substr(tokenStart_, current_ - tokenStart_);
-    token.location.filename = filename_;
-    token.location.line = tokenLine_;
-    token.location.column = tokenColumn_;
-    token.location.offset = tokenStart_;
-    token.intValue = 0;
+    token.length = current_ - tokenStart_;
+    token.location = SourceLocation::fromRaw(locationBase_ + tokenStart_);
     return token;
 }
 
 Token Lexer::makeToken(TokenKind kind, std::string_view text) const {
     Token token;
     token.kind = kind;
-    token.text = text;
-    token.location.filename = filename_;
-    token.location.line = tokenLine_;
-    token.location.column = tokenColumn_;
-    token.location.offset = tokenStart_;
-    token.intValue = 0;
+    token.textOffset = static_cast<uint16_t>(
+        text.data() - (source_.data() + tokenStart_));
+    token.length = static_cast<uint32_t>(text.size());
+    token.location = SourceLocation::fromRaw(locationBase_ + tokenStart_);
     return token;
 }
 
+std::string_view Lexer::tokenText(const Token& token) const {
+    uint32_t offset = token.location.raw - locationBase_ + token.textOffset;
+    return source_.substr(offset, token.length);
+}
+
+int64_t Lexer::intValue(const Token& token) const {
+    if (token.symbol == 0 || token.symbol > intValues_.size()) {
+        return 0;
+    }
+    return intValues_[token.symbol - 1];
+}
+
+double Lexer::floatValue(const Token& token) const {
+    if (token.symbol == 0 || token.symbol > floatValues_.size()) {
+        return 0.0;
+    }
+    return floatValues_[token.symbol - 1];
+}
+
 Token Lexer::errorToken(const std::string& message) {
     SourceLocation loc;
-    loc.filename = filename_;
-    loc.line = tokenLine_;
-    loc.column = tokenColumn_;
-    loc.offset = tokenStart_;
+    loc = SourceLocation::fromRaw(locationBase_ + tokenStart_);
     diag_.emitError(loc, message);
 
     Token token;
     token.kind = TokenKind::Invalid;
-    token.text = source_.substr(tokenStart_, current_ - tokenStart_);
+    token.length = current_ - tokenStart_;
     token.location = loc;
-    token.intValue = 0;
     return token;
 }
 
 TokenKind Lexer::identifierKind(std::string_view text) const {
-    auto it = keywords.find(text);
-    if (it != keywords.end()) {
-        return it->second;
-    }
-    return TokenKind::Identifier;
+    const KeywordEntry& entry = kKeywordTable[keywordSlot(text)];
+    return entry.text == text ? entry.kind : TokenKind::Identifier;
 }
 
 Token Lexer::lexIdentifierOrKeyword() {
-    while (!isAtEnd() && (std::isalnum(peek()) || peek() == '_')) {
-        advance();
+    for (;;) {
+        advanceColumns(static_cast<uint32_t>(scanIdentifierRun(
+            source_.data() + current_, source_.size() - current_)));
+        // ASCII spans (the overwhelming case) stop here; spans the
+        // validation pass flagged may continue with UTF-8 identifiers
+        if (isAtEnd() ||
+            !(static_cast<unsigned char>(source_[current_]) & 0x80) ||
+            !spanHasNonASCII(current_)) {
+            break;
+        }
+        consumeUTF8Sequence();
     }
 
     std::string_view text = source_.substr(tokenStart_, current_ - tokenStart_);
     TokenKind kind = identifierKind(text);
 
-    return makeToken(kind, text);
+    Token token = makeToken(kind, text);
+    if (kind == TokenKind::Identifier) {
+        token.symbol = globalInterner().intern(text);
+    }
+    return token;
 }
 
 Token Lexer::lexNumber() {
@@ -372,12 +771,13 @@ Token Lexer::lexNumber() {
                 advance();
             }
             Token token = makeToken(TokenKind::IntLiteral);
+            std::string_view spelling = tokenText(token);
             // Parse hex value (skip 0x prefix and underscores)
             std::string clean;
-            for (size_t i = 2; i < token.text.size(); ++i) {
-                if (token.text[i] != '_') clean += token.text[i];
+            for (size_t i = 2; i < spelling.size(); ++i) {
+                if (spelling[i] != '_') clean += spelling[i];
             }
-            token.intValue = std::stoll(clean, nullptr, 16);
+            token.symbol = storeInt(std::stoll(clean, nullptr, 16));
             return token;
         } else if (next == 'b' || next == 'B') {
             // Binary
@@ -390,11 +790,12 @@ Token Lexer::lexNumber() {
                 advance();
             }
             Token token = makeToken(TokenKind::IntLiteral);
+            std::string_view spelling = tokenText(token);
             std::string clean;
-            for (size_t i = 2; i < token.text.size(); ++i) {
-                if (token.text[i] != '_') clean += token.text[i];
+            for (size_t i = 2; i < spelling.size(); ++i) {
+                if (spelling[i] != '_') clean += spelling[i];
             }
-            token.intValue = std::stoll(clean, nullptr, 2);
+            token.symbol = storeInt(std::stoll(clean, nullptr, 2));
             return token;
         } else if (next == 'o' || next == 'O') {
             // Octal
@@ -404,27 +805,26 @@ Token Lexer::lexNumber() {
                 advance();
             }
             Token token = makeToken(TokenKind::IntLiteral);
+            std::string_view spelling = tokenText(token);
             std::string clean;
-            for (size_t i = 2; i < token.text.size(); ++i) {
-                if (token.text[i] != '_') clean += token.text[i];
+            for (size_t i = 2; i < spelling.size(); ++i) {
+                if (spelling[i] != '_') clean += spelling[i];
             }
-            token.intValue = std::stoll(clean, nullptr, 8);
+            token.symbol = storeInt(std::stoll(clean, nullptr, 8));
             return token;
         }
     }
 
     // Decimal integer or float
-    while (!isAtEnd() && (std::isdigit(peek()) || peek() == '_')) {
-        advance();
-    }
+    advanceColumns(static_cast<uint32_t>(scanDigitRun(
+        source_.data() + current_, source_.size() - current_)));
 
     // Check for decimal point (but not ..)
     if (peek() == '.' && peekNext() != '.') {
         isFloat = true;
         advance(); // consume '.'
-        while (!isAtEnd() && (std::isdigit(peek()) || peek() == '_')) {
-            advance();
-        }
+        advanceColumns(static_cast<uint32_t>(scanDigitRun(
+            source_.data() + current_, source_.size() - current_)));
     }
 
     // Check for exponent
@@ -437,26 +837,25 @@ Token Lexer::lexNumber() {
         if (!std::isdigit(peek())) {
             return errorToken("expected digit in exponent");
         }
-        while (!isAtEnd() && (std::isdigit(peek()) || peek() == '_')) {
-            advance();
-        }
+        advanceColumns(static_cast<uint32_t>(scanDigitRun(
+            source_.data() + current_, source_.size() - current_)));
     }
 
     if (isFloat) {
         Token token = makeToken(TokenKind::FloatLiteral);
         std::string clean;
-        for (char c : token.text) {
+        for (char c : tokenText(token)) {
             if (c != '_') clean += c;
         }
-        token.floatValue = std::stod(clean);
+        token.symbol = storeFloat(std::stod(clean));
         return token;
     } else {
         Token token = makeToken(TokenKind::IntLiteral);
         std::string clean;
-        for (char c : token.text) {
+        for (char c : tokenText(token)) {
             if (c != '_') clean += c;
         }
-        token.intValue = std::stoll(clean);
+        token.symbol = storeInt(std::stoll(clean));
         return token;
     }
 }
@@ -488,9 +887,10 @@ Token Lexer::lexString() {
     uint32_t contentEnd = current_;
     advance(); // closing quote
 
-    // Store text as content without quotes
+    // The spelling window is the content without quotes
     auto token = makeToken(TokenKind::StringLiteral);
-    token.text = source_.substr(contentStart, contentEnd - contentStart);
+    token.textOffset = static_cast<uint16_t>(contentStart - tokenStart_);
+    token.length = contentEnd - contentStart;
     return token;
 }
 
@@ -537,8 +937,6 @@ Token Lexer::lexAnnotation() {
     // Unknown annotation — treat as @ followed by identifier
     // Reset to just after @
     current_ = nameStart;
-    line_ = tokenLine_;
-    column_ = tokenColumn_ + 1;
     return makeToken(TokenKind::At);
 }
 
@@ -552,8 +950,6 @@ Token Lexer::nextToken() {
     skipWhitespace();
 
     tokenStart_ = current_;
-    tokenLine_ = line_;
-    tokenColumn_ = column_;
 
     if (isAtEnd()) {
         return makeToken(TokenKind::Eof);
@@ -561,8 +957,15 @@ Token Lexer::nextToken() {
 
     char c = advance();
 
-    // Identifiers and keywords
-    if (std::isalpha(c) || c == '_') {
+    // Identifiers and keywords (UTF-8 lead bytes start identifiers too;
+    // the validation pre-pass guarantees the sequence is well-formed)
+    if (std::isalpha(c) || c == '_' ||
+        (static_cast<unsigned char>(c) & 0x80)) {
+        if (static_cast<unsigned char>(c) & 0x80) {
+            --current_; // re-read the lead byte inside the sequence walk
+            consumeUTF8Sequence();
+            return lexIdentifierOrKeyword();
+        }
         // Check for single underscore as wildcard
         if (c == '_' && (isAtEnd() || (!std::isalnum(peek()) && peek() != '_'))) {
             return makeToken(TokenKind::Underscore);
@@ -574,18 +977,12 @@ Token Lexer::nextToken() {
     if (std::isdigit(c)) {
         // We already advanced one char, back up
         --current_;
-        if (c == '\n') {
-            --line_;
-        } else {
-            --column_;
-        }
         return lexNumber();
     }
 
     // Strings
     if (c == '"') {
         --current_;
-        --column_;
         return lexString();
     }
 
@@ -597,16 +994,12 @@ Token Lexer::nextToken() {
         if (!isAtEnd() && std::isalpha(peek())) {
             // Could be lifetime or char — check further
             uint32_t savedCurrent = current_;
-            uint32_t savedLine = line_;
-            uint32_t savedColumn = column_;
 
             advance(); // consume the first character
             if (!isAtEnd() && peek() == '\'') {
                 // It's a char literal like 'a'
                 current_ = savedCurrent;
-                line_ = savedLine;
-                column_ = savedColumn;
-                --current_; --column_; // back up past the first '
+                --current_; // back up past the first '
                 return lexChar();
             } else {
                 // It's a lifetime 'a
@@ -621,7 +1014,7 @@ Token Lexer::nextToken() {
 
         if (!isAtEnd() && peek() == '\\') {
             // Escaped char literal
-            --current_; --column_;
+            --current_;
             return lexChar();
         }
 
@@ -631,7 +1024,7 @@ Token Lexer::nextToken() {
     // Annotations
     if (c == '@') {
         if (!isAtEnd() && std::isalpha(peek())) {
-            --current_; --column_;
+            --current_;
             return lexAnnotation();
         }
         return makeToken(TokenKind::At);
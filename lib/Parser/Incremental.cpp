@@ -0,0 +1,115 @@
+#include "flux/Parser/Incremental.h"
+
+#include "flux/Lexer/Lexer.h"
+
+#include <algorithm>
+
+namespace flux {
+
+ast::Module *IncrementalSession::open(std::string source,
+                                      std::string filename) {
+  source_ = std::move(source);
+  filename_ = std::move(filename);
+  retired_.clear();
+  return reparseAll();
+}
+
+ast::Module *IncrementalSession::reparseAll() {
+  Lexer lexer(source_, filename_, diag_);
+  Parser parser(lexer, diag_);
+  module_ = parser.parseModule();
+  retired_.clear();
+  lastReuseCount_ = 0;
+  return module_.get();
+}
+
+ast::Module *IncrementalSession::applyEdit(const SourceEdit &edit) {
+  if (!module_ || edit.start > source_.size() ||
+      edit.start + edit.removedLength > source_.size()) {
+    return reparseAll();
+  }
+
+  // Splice the text
+  source_.replace(edit.start, edit.removedLength, edit.insertedText);
+  int64_t delta = static_cast<int64_t>(edit.insertedText.size()) -
+                  static_cast<int64_t>(edit.removedLength);
+
+  auto &decls = module_->declarations;
+  if (decls.empty()) {
+    return reparseAll();
+  }
+
+  // A declaration's extent runs from its start to the next declaration's
+  // start (the last one runs to EOF). Find the damaged window: every
+  // declaration whose extent intersects [edit.start, editEnd).
+  uint32_t editEnd = edit.start + edit.removedLength;
+
+  size_t firstDamaged = decls.size();
+  for (size_t i = 0; i < decls.size(); ++i) {
+    uint32_t declEnd = i + 1 < decls.size()
+                           ? declOffset(*decls[i + 1])
+                           : static_cast<uint32_t>(source_.size());
+    if (edit.start < declEnd) {
+      firstDamaged = i;
+      break;
+    }
+  }
+  if (firstDamaged == decls.size()) {
+    firstDamaged = decls.size() - 1;
+  }
+
+  size_t lastDamaged = firstDamaged;
+  while (lastDamaged + 1 < decls.size() &&
+         declOffset(*decls[lastDamaged + 1]) < editEnd) {
+    ++lastDamaged;
+  }
+
+  // The window's byte range in the *edited* source
+  uint32_t windowStart = declOffset(*decls[firstDamaged]);
+  uint32_t windowEnd =
+      lastDamaged + 1 < decls.size()
+          ? static_cast<uint32_t>(
+                static_cast<int64_t>(declOffset(*decls[lastDamaged + 1])) +
+                delta)
+          : static_cast<uint32_t>(source_.size());
+  if (windowStart > source_.size() || windowEnd > source_.size() ||
+      windowStart >= windowEnd) {
+    return reparseAll();
+  }
+
+  // Re-lex and re-parse only the damaged window; locations inside it are
+  // encoded against the window's position in the edited text
+  std::string_view window(source_.data() + windowStart,
+                          windowEnd - windowStart);
+  Lexer lexer(window, filename_, diag_, /*locationBase=*/1 + windowStart);
+  Parser parser(lexer, diag_);
+  auto patch = parser.parseModule();
+
+  // Stitch: untouched declarations (with their owning arenas kept
+  // alive) around the freshly parsed ones
+  auto merged = std::make_unique<ast::Module>();
+  merged->name = module_->name;
+  merged->imports = module_->imports;
+  merged->location = module_->location;
+  merged->context = std::move(patch->context);
+
+  lastReuseCount_ = 0;
+  for (size_t i = 0; i < firstDamaged; ++i) {
+    merged->declarations.push_back(decls[i]);
+    ++lastReuseCount_;
+  }
+  for (auto &decl : patch->declarations) {
+    merged->declarations.push_back(decl);
+  }
+  for (size_t i = lastDamaged + 1; i < decls.size(); ++i) {
+    merged->declarations.push_back(decls[i]);
+    ++lastReuseCount_;
+  }
+
+  // The old module's arena still owns the reused declarations
+  retired_.push_back(std::move(module_));
+  module_ = std::move(merged);
+  return module_.get();
+}
+
+} // namespace flux
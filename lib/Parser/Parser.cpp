@@ -8,7 +8,7 @@ namespace flux {
 Parser::Parser(Lexer &lexer, DiagnosticEngine &diag)
     : lexer_(lexer), diag_(diag) {
   // Prime the parser with the first token
-  current_ = lexer_.nextToken();
+  current_ = tokenAt(0);
 }
 
 // ============================================================================
@@ -17,10 +17,24 @@ Parser::Parser(Lexer &lexer, DiagnosticEngine &diag)
 
 Token Parser::advance() {
   previous_ = current_;
-  current_ = lexer_.nextToken();
+  if (current_.kind != TokenKind::Eof) {
+    ++pos_;
+  }
+  current_ = tokenAt(pos_);
   return previous_;
 }
 
+const Token &Parser::tokenAt(size_t index) {
+  while (tokens_.size() <= index &&
+         (tokens_.empty() || tokens_.back().kind != TokenKind::Eof)) {
+    tokens_.push_back(lexer_.nextToken());
+  }
+  // Past the end means Eof; the buffer always ends with it.
+  return index < tokens_.size() ? tokens_[index] : tokens_.back();
+}
+
+const Token &Parser::peekAhead(size_t n) { return tokenAt(pos_ + n); }
+
 bool Parser::check(TokenKind kind) const { return current_.kind == kind; }
 
 bool Parser::match(TokenKind kind) {
@@ -35,8 +49,8 @@ Token Parser::expect(TokenKind kind, const std::string &message) {
   if (check(kind)) {
     return advance();
   }
-  diag_.emitError(current_.location,
-                  message + ", got '" + std::string(current_.text) + "'");
+  diag_.report(DiagnosticSeverity::Error, current_.location, "{0}, got '{1}'",
+               {message, std::string(text(current_))});
   return current_;
 }
 
@@ -49,7 +63,14 @@ Token Parser::expectSemicolon() {
 // ============================================================================
 
 std::unique_ptr<ast::Module> Parser::parseModule() {
+  return parseModule(nullptr);
+}
+
+std::unique_ptr<ast::Module>
+Parser::parseModule(const std::function<void(ast::DeclPtr)> &declReady) {
   auto module = std::make_unique<ast::Module>();
+  module->context = std::make_unique<ast::ASTContext>();
+  ctx_ = module->context.get();
   module->location = current_.location;
 
   // Optional module declaration
@@ -85,7 +106,10 @@ std::unique_ptr<ast::Module> Parser::parseModule() {
   while (!check(TokenKind::Eof)) {
     auto decl = parseDeclaration();
     if (decl) {
-      module->declarations.push_back(std::move(decl));
+      module->declarations.push_back(decl);
+      if (declReady) {
+        declReady(decl);
+      }
     } else {
       // Error recovery: skip token
       if (!check(TokenKind::Eof)) {
@@ -97,16 +121,181 @@ std::unique_ptr<ast::Module> Parser::parseModule() {
   return module;
 }
 
+std::vector<Parser::TopLevelName> Parser::preScanTopLevelNames() {
+  std::vector<TopLevelName> names;
+  int braceDepth = 0;
+  bool isPublic = false;
+
+  for (size_t i = pos_;; ++i) {
+    // Copy: tokenAt(i + 1) below can lex more tokens and reallocate the
+    // buffer, which would leave a reference dangling
+    Token tok = tokenAt(i);
+    if (tok.kind == TokenKind::Eof) {
+      break;
+    }
+    switch (tok.kind) {
+    case TokenKind::LBrace:
+      ++braceDepth;
+      break;
+    case TokenKind::RBrace:
+      if (braceDepth > 0) {
+        --braceDepth;
+      }
+      break;
+    case TokenKind::KwPub:
+    case TokenKind::KwPublic:
+      if (braceDepth == 0) {
+        isPublic = true;
+      }
+      break;
+    case TokenKind::KwFunc:
+    case TokenKind::KwStruct:
+    case TokenKind::KwClass:
+    case TokenKind::KwEnum:
+    case TokenKind::KwTrait:
+    case TokenKind::KwType:
+      if (braceDepth == 0) {
+        Token nameTok = tokenAt(i + 1);
+        if (nameTok.kind == TokenKind::Identifier) {
+          names.push_back({tok.kind, std::string(text(nameTok)),
+                           nameTok.location, isPublic, {}});
+          if (tok.kind == TokenKind::KwEnum) {
+            scanEnumVariants(i + 2, std::string(text(nameTok)), names);
+          }
+        }
+        isPublic = false;
+      }
+      break;
+    case TokenKind::KwImport:
+      // Record the trailing path segment (the imported module's name)
+      if (braceDepth == 0) {
+        size_t j = i + 1;
+        std::string last;
+        SourceLocation lastLoc;
+        while (tokenAt(j).kind == TokenKind::Identifier ||
+               tokenAt(j).kind == TokenKind::ColonColon) {
+          if (tokenAt(j).kind == TokenKind::Identifier) {
+            last = std::string(text(tokenAt(j)));
+            lastLoc = tokenAt(j).location;
+          }
+          ++j;
+        }
+        if (!last.empty()) {
+          names.push_back({TokenKind::KwImport, std::move(last), lastLoc,
+                           /*isPublic=*/false, {}});
+        }
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  return names;
+}
+
+void Parser::scanEnumVariants(size_t index, const std::string &enumName,
+                              std::vector<TopLevelName> &names) {
+  // Skip an optional generic parameter list, then require the body brace
+  if (tokenAt(index).kind == TokenKind::Less) {
+    int angleDepth = 1;
+    ++index;
+    while (angleDepth > 0 && tokenAt(index).kind != TokenKind::Eof) {
+      if (tokenAt(index).kind == TokenKind::Less) {
+        ++angleDepth;
+      } else if (tokenAt(index).kind == TokenKind::Greater) {
+        --angleDepth;
+      }
+      ++index;
+    }
+  }
+  if (tokenAt(index).kind != TokenKind::LBrace) {
+    return;
+  }
+  ++index;
+
+  // A variant name is the identifier opening each comma-separated entry;
+  // payload parentheses/braces nest past depth 1
+  int depth = 1;
+  bool expectVariant = true;
+  while (depth > 0 && tokenAt(index).kind != TokenKind::Eof) {
+    Token tok = tokenAt(index);
+    switch (tok.kind) {
+    case TokenKind::LBrace:
+    case TokenKind::LParen:
+      ++depth;
+      expectVariant = false;
+      break;
+    case TokenKind::RBrace:
+    case TokenKind::RParen:
+      --depth;
+      break;
+    case TokenKind::Comma:
+      if (depth == 1) {
+        expectVariant = true;
+      }
+      break;
+    case TokenKind::Identifier:
+      if (depth == 1 && expectVariant) {
+        names.push_back({TokenKind::Identifier, std::string(text(tok)),
+                         tok.location, /*isPublic=*/true, enumName});
+        expectVariant = false;
+      }
+      break;
+    default:
+      break;
+    }
+    ++index;
+  }
+}
+
 // ============================================================================
 // Declaration parsing
 // ============================================================================
 
 ast::DeclPtr Parser::parseDeclaration() {
-  // Skip annotations for now
+  // Annotations: @layout(optimize) and @inline(...) are consumed; the
+  // rest are skipped
+  bool optimizeLayout = false;
+  bool fastMath = false;
+  ast::FuncDecl::InlineHint inlineHint = ast::FuncDecl::InlineHint::None;
   while (check(TokenKind::At) || check(TokenKind::KwDoc) ||
          check(TokenKind::KwDeprecated) || check(TokenKind::KwTest) ||
          check(TokenKind::Hash) || check(TokenKind::HashBang)) {
+    bool isAt = check(TokenKind::At);
     advance();
+    if (isAt && check(TokenKind::Identifier) &&
+        text(current_) == "fastmath") {
+      fastMath = true;
+      advance(); // fastmath
+      continue;
+    }
+    if (isAt && check(TokenKind::Identifier) && text(current_) == "inline" &&
+        peekAhead(1).kind == TokenKind::LParen &&
+        peekAhead(2).kind == TokenKind::Identifier &&
+        peekAhead(3).kind == TokenKind::RParen) {
+      if (text(peekAhead(2)) == "always") {
+        inlineHint = ast::FuncDecl::InlineHint::Always;
+      } else if (text(peekAhead(2)) == "never") {
+        inlineHint = ast::FuncDecl::InlineHint::Never;
+      }
+      advance(); // inline
+      advance(); // (
+      advance(); // always/never
+      advance(); // )
+      continue;
+    }
+    if (isAt && check(TokenKind::Identifier) && text(current_) == "layout" &&
+        peekAhead(1).kind == TokenKind::LParen &&
+        peekAhead(2).kind == TokenKind::Identifier &&
+        text(peekAhead(2)) == "optimize" &&
+        peekAhead(3).kind == TokenKind::RParen) {
+      optimizeLayout = true;
+      advance(); // layout
+      advance(); // (
+      advance(); // optimize
+      advance(); // )
+      continue;
+    }
     // Skip annotation arguments
     if (check(TokenKind::LParen)) {
       advance();
@@ -121,14 +310,26 @@ ast::DeclPtr Parser::parseDeclaration() {
     }
   }
 
-  if (check(TokenKind::KwFunc))
-    return parseFuncDecl();
-  if (check(TokenKind::KwAsync)) {
-    advance();
-    return parseFuncDecl(/*isAsync=*/true);
+  if (check(TokenKind::KwStruct)) {
+    auto *structDecl = parseStructDecl();
+    if (structDecl) {
+      structDecl->optimizeLayout = optimizeLayout;
+    }
+    return structDecl;
+  }
+
+  if (check(TokenKind::KwFunc) || check(TokenKind::KwAsync)) {
+    bool isAsync = check(TokenKind::KwAsync);
+    if (isAsync) {
+      advance();
+    }
+    auto *func = parseFuncDecl(isAsync);
+    if (func) {
+      func->inlineHint = inlineHint;
+      func->fastMath = fastMath;
+    }
+    return func;
   }
-  if (check(TokenKind::KwStruct))
-    return parseStructDecl();
   if (check(TokenKind::KwClass))
     return parseClassDecl();
   if (check(TokenKind::KwEnum))
@@ -162,42 +363,42 @@ ast::DeclPtr Parser::parseDeclaration() {
   return nullptr;
 }
 
-std::unique_ptr<ast::ModuleDecl> Parser::parseModuleDecl() {
+ast::ModuleDecl *Parser::parseModuleDecl() {
   auto loc = current_.location;
   expect(TokenKind::KwModule, "expected 'module'");
   auto path = parsePath();
   expectSemicolon();
-  return std::make_unique<ast::ModuleDecl>(std::move(path), loc);
+  return ctx_->create<ast::ModuleDecl>(std::move(path), loc);
 }
 
-std::unique_ptr<ast::ImportDecl> Parser::parseImportDecl() {
+ast::ImportDecl *Parser::parseImportDecl() {
   auto loc = current_.location;
   expect(TokenKind::KwImport, "expected 'import'");
   auto path = parsePath();
   expectSemicolon();
-  return std::make_unique<ast::ImportDecl>(std::move(path), std::nullopt, loc);
+  return ctx_->create<ast::ImportDecl>(std::move(path), std::nullopt, loc);
 }
 
 std::vector<std::string> Parser::parsePath() {
   std::vector<std::string> segments;
 
   auto tok = expect(TokenKind::Identifier, "expected identifier in path");
-  segments.push_back(std::string(tok.text));
+  segments.push_back(std::string(text(tok)));
 
   while (match(TokenKind::ColonColon)) {
     tok = expect(TokenKind::Identifier, "expected identifier after '::'");
-    segments.push_back(std::string(tok.text));
+    segments.push_back(std::string(text(tok)));
   }
 
   return segments;
 }
 
-std::unique_ptr<ast::FuncDecl> Parser::parseFuncDecl(bool isAsync) {
+ast::FuncDecl *Parser::parseFuncDecl(bool isAsync) {
   auto loc = current_.location;
   expect(TokenKind::KwFunc, "expected 'func'");
 
   auto nameTok = expect(TokenKind::Identifier, "expected function name");
-  std::string name(nameTok.text);
+  std::string name(text(nameTok));
 
   // Optional generic parameters
   auto genericParams = parseGenericParams();
@@ -208,20 +409,20 @@ std::unique_ptr<ast::FuncDecl> Parser::parseFuncDecl(bool isAsync) {
   expect(TokenKind::RParen, "expected ')' after parameters");
 
   // Return type
-  ast::TypeNodePtr returnType;
+  ast::TypeNodePtr returnType = nullptr;
   if (match(TokenKind::Arrow)) {
     returnType = parseType();
   }
 
   // Body
-  std::unique_ptr<ast::BlockStmt> body;
+  ast::BlockStmt *body = nullptr;
   if (check(TokenKind::LBrace)) {
     body = parseBlock();
   } else {
     expectSemicolon(); // trait method declaration with no body
   }
 
-  auto func = std::make_unique<ast::FuncDecl>(
+  auto func = ctx_->create<ast::FuncDecl>(
       std::move(name), std::move(params), std::move(returnType),
       std::move(body), loc);
   func->genericParams = std::move(genericParams);
@@ -242,20 +443,20 @@ std::vector<ast::GenericParam> Parser::parseGenericParams() {
     if (check(TokenKind::Apostrophe)) {
       advance();
       auto nameTok = expect(TokenKind::Identifier, "expected lifetime name");
-      param.lifetime = std::string(nameTok.text);
+      param.lifetime = std::string(text(nameTok));
     } else {
       auto nameTok =
           expect(TokenKind::Identifier, "expected type parameter name");
-      param.name = std::string(nameTok.text);
+      param.name = std::string(text(nameTok));
 
       // Trait bounds: T: Comparable + Clone
       if (match(TokenKind::Colon)) {
         auto boundTok = expect(TokenKind::Identifier, "expected trait bound");
-        param.traitBounds.push_back(std::string(boundTok.text));
+        param.traitBounds.push_back(std::string(text(boundTok)));
 
         while (match(TokenKind::Plus)) {
           boundTok = expect(TokenKind::Identifier, "expected trait bound");
-          param.traitBounds.push_back(std::string(boundTok.text));
+          param.traitBounds.push_back(std::string(text(boundTok)));
         }
       }
     }
@@ -314,7 +515,7 @@ ast::FuncParam Parser::parseFuncParam() {
   } else {
     nameTok = expect(TokenKind::Identifier, "expected parameter name");
   }
-  param.name = std::string(nameTok.text);
+  param.name = std::string(text(nameTok));
 
   // Type annotation
   expect(TokenKind::Colon, "expected ':' after parameter name");
@@ -323,12 +524,12 @@ ast::FuncParam Parser::parseFuncParam() {
   return param;
 }
 
-std::unique_ptr<ast::StructDecl> Parser::parseStructDecl() {
+ast::StructDecl *Parser::parseStructDecl() {
   auto loc = current_.location;
   expect(TokenKind::KwStruct, "expected 'struct'");
 
   auto nameTok = expect(TokenKind::Identifier, "expected struct name");
-  std::string name(nameTok.text);
+  std::string name(text(nameTok));
 
   auto genericParams = parseGenericParams();
 
@@ -336,7 +537,7 @@ std::unique_ptr<ast::StructDecl> Parser::parseStructDecl() {
   auto fields = parseStructFields();
   expect(TokenKind::RBrace, "expected '}' after struct fields");
 
-  auto decl = std::make_unique<ast::StructDecl>(std::move(name),
+  auto decl = ctx_->create<ast::StructDecl>(std::move(name),
                                                 std::move(fields), loc);
   decl->genericParams = std::move(genericParams);
   return decl;
@@ -350,7 +551,7 @@ std::vector<ast::FieldDecl> Parser::parseStructFields() {
     field.location = current_.location;
 
     auto nameTok = expect(TokenKind::Identifier, "expected field name");
-    field.name = std::string(nameTok.text);
+    field.name = std::string(text(nameTok));
 
     expect(TokenKind::Colon, "expected ':' after field name");
     field.type = parseType();
@@ -364,12 +565,12 @@ std::vector<ast::FieldDecl> Parser::parseStructFields() {
   return fields;
 }
 
-std::unique_ptr<ast::ClassDecl> Parser::parseClassDecl() {
+ast::ClassDecl *Parser::parseClassDecl() {
   auto loc = current_.location;
   expect(TokenKind::KwClass, "expected 'class'");
 
   auto nameTok = expect(TokenKind::Identifier, "expected class name");
-  std::string name(nameTok.text);
+  std::string name(text(nameTok));
 
   auto genericParams = parseGenericParams();
 
@@ -378,7 +579,7 @@ std::unique_ptr<ast::ClassDecl> Parser::parseClassDecl() {
   expect(TokenKind::RBrace, "expected '}' after class fields");
 
   auto decl =
-      std::make_unique<ast::ClassDecl>(std::move(name), std::move(fields), loc);
+      ctx_->create<ast::ClassDecl>(std::move(name), std::move(fields), loc);
   decl->genericParams = std::move(genericParams);
   return decl;
 }
@@ -398,7 +599,7 @@ std::vector<ast::FieldDecl> Parser::parseClassFields() {
     }
 
     auto nameTok = expect(TokenKind::Identifier, "expected field name");
-    field.name = std::string(nameTok.text);
+    field.name = std::string(text(nameTok));
 
     expect(TokenKind::Colon, "expected ':' after field name");
     field.type = parseType();
@@ -412,12 +613,12 @@ std::vector<ast::FieldDecl> Parser::parseClassFields() {
   return fields;
 }
 
-std::unique_ptr<ast::EnumDecl> Parser::parseEnumDecl() {
+ast::EnumDecl *Parser::parseEnumDecl() {
   auto loc = current_.location;
   expect(TokenKind::KwEnum, "expected 'enum'");
 
   auto nameTok = expect(TokenKind::Identifier, "expected enum name");
-  std::string name(nameTok.text);
+  std::string name(text(nameTok));
 
   auto genericParams = parseGenericParams();
 
@@ -425,7 +626,7 @@ std::unique_ptr<ast::EnumDecl> Parser::parseEnumDecl() {
   auto variants = parseEnumVariants();
   expect(TokenKind::RBrace, "expected '}' after enum variants");
 
-  auto decl = std::make_unique<ast::EnumDecl>(std::move(name),
+  auto decl = ctx_->create<ast::EnumDecl>(std::move(name),
                                               std::move(variants), loc);
   decl->genericParams = std::move(genericParams);
   return decl;
@@ -439,7 +640,7 @@ std::vector<ast::EnumVariant> Parser::parseEnumVariants() {
     variant.location = current_.location;
 
     auto nameTok = expect(TokenKind::Identifier, "expected variant name");
-    variant.name = std::string(nameTok.text);
+    variant.name = std::string(text(nameTok));
 
     if (match(TokenKind::LParen)) {
       // Tuple variant: Write(String)
@@ -457,7 +658,7 @@ std::vector<ast::EnumVariant> Parser::parseEnumVariants() {
         ast::FieldDecl field;
         field.location = current_.location;
         auto fieldName = expect(TokenKind::Identifier, "expected field name");
-        field.name = std::string(fieldName.text);
+        field.name = std::string(text(fieldName));
         expect(TokenKind::Colon, "expected ':' after field name");
         field.type = parseType();
         variant.structFields.push_back(std::move(field));
@@ -477,28 +678,28 @@ std::vector<ast::EnumVariant> Parser::parseEnumVariants() {
   return variants;
 }
 
-std::unique_ptr<ast::TraitDecl> Parser::parseTraitDecl() {
+ast::TraitDecl *Parser::parseTraitDecl() {
   auto loc = current_.location;
   expect(TokenKind::KwTrait, "expected 'trait'");
 
   auto nameTok = expect(TokenKind::Identifier, "expected trait name");
-  std::string name(nameTok.text);
+  std::string name(text(nameTok));
 
   auto genericParams = parseGenericParams();
 
   std::vector<std::string> superTraits;
   if (match(TokenKind::Colon)) {
     auto traitTok = expect(TokenKind::Identifier, "expected super trait name");
-    superTraits.push_back(std::string(traitTok.text));
+    superTraits.push_back(std::string(text(traitTok)));
     while (match(TokenKind::Plus)) {
       traitTok = expect(TokenKind::Identifier, "expected trait name");
-      superTraits.push_back(std::string(traitTok.text));
+      superTraits.push_back(std::string(text(traitTok)));
     }
   }
 
   expect(TokenKind::LBrace, "expected '{' in trait declaration");
 
-  std::vector<std::unique_ptr<ast::FuncDecl>> methods;
+  std::vector<ast::FuncDecl *> methods;
   while (!check(TokenKind::RBrace) && !check(TokenKind::Eof)) {
     bool async = false;
     if (check(TokenKind::KwAsync)) {
@@ -516,14 +717,14 @@ std::unique_ptr<ast::TraitDecl> Parser::parseTraitDecl() {
 
   expect(TokenKind::RBrace, "expected '}' after trait methods");
 
-  auto decl = std::make_unique<ast::TraitDecl>(std::move(name),
+  auto decl = ctx_->create<ast::TraitDecl>(std::move(name),
                                                std::move(methods), loc);
   decl->genericParams = std::move(genericParams);
   decl->superTraits = std::move(superTraits);
   return decl;
 }
 
-std::unique_ptr<ast::ImplDecl> Parser::parseImplDecl() {
+ast::ImplDecl *Parser::parseImplDecl() {
   auto loc = current_.location;
   expect(TokenKind::KwImpl, "expected 'impl'");
 
@@ -533,13 +734,13 @@ std::unique_ptr<ast::ImplDecl> Parser::parseImplDecl() {
   auto firstType = parseType();
 
   std::optional<std::string> traitName;
-  ast::TypeNodePtr targetType;
+  ast::TypeNodePtr targetType = nullptr;
 
   // Check if this is "impl Trait for Type"
   if (match(TokenKind::KwFor)) {
     // firstType was actually the trait name
     if (firstType->kind == ast::TypeNode::Kind::Named) {
-      traitName = static_cast<ast::NamedType *>(firstType.get())->path.back();
+      traitName = static_cast<ast::NamedType *>(firstType)->path.back();
     }
     targetType = parseType();
   } else {
@@ -548,7 +749,7 @@ std::unique_ptr<ast::ImplDecl> Parser::parseImplDecl() {
 
   expect(TokenKind::LBrace, "expected '{' in impl block");
 
-  std::vector<std::unique_ptr<ast::FuncDecl>> methods;
+  std::vector<ast::FuncDecl *> methods;
   while (!check(TokenKind::RBrace) && !check(TokenKind::Eof)) {
     bool async = false;
     if (check(TokenKind::KwAsync)) {
@@ -566,18 +767,18 @@ std::unique_ptr<ast::ImplDecl> Parser::parseImplDecl() {
 
   expect(TokenKind::RBrace, "expected '}' after impl block");
 
-  auto decl = std::make_unique<ast::ImplDecl>(
+  auto decl = ctx_->create<ast::ImplDecl>(
       std::move(targetType), std::move(traitName), std::move(methods), loc);
   decl->genericParams = std::move(genericParams);
   return decl;
 }
 
-std::unique_ptr<ast::TypeAliasDecl> Parser::parseTypeAliasDecl() {
+ast::TypeAliasDecl *Parser::parseTypeAliasDecl() {
   auto loc = current_.location;
   expect(TokenKind::KwType, "expected 'type'");
 
   auto nameTok = expect(TokenKind::Identifier, "expected type alias name");
-  std::string name(nameTok.text);
+  std::string name(text(nameTok));
 
   auto genericParams = parseGenericParams();
 
@@ -585,7 +786,7 @@ std::unique_ptr<ast::TypeAliasDecl> Parser::parseTypeAliasDecl() {
   auto aliasedType = parseType();
   expectSemicolon();
 
-  auto decl = std::make_unique<ast::TypeAliasDecl>(std::move(name),
+  auto decl = ctx_->create<ast::TypeAliasDecl>(std::move(name),
                                                    std::move(aliasedType), loc);
   decl->genericParams = std::move(genericParams);
   return decl;
@@ -616,13 +817,13 @@ ast::StmtPtr Parser::parseStatement() {
     auto loc = current_.location;
     advance();
     expectSemicolon();
-    return std::make_unique<ast::BreakStmt>(loc);
+    return ctx_->create<ast::BreakStmt>(loc);
   }
   if (check(TokenKind::KwContinue)) {
     auto loc = current_.location;
     advance();
     expectSemicolon();
-    return std::make_unique<ast::ContinueStmt>(loc);
+    return ctx_->create<ast::ContinueStmt>(loc);
   }
   if (check(TokenKind::LBrace))
     return parseBlock();
@@ -635,38 +836,38 @@ ast::StmtPtr Parser::parseStatement() {
     return nullptr;
   }
   expectSemicolon();
-  return std::make_unique<ast::ExprStmt>(std::move(expr), loc);
+  return ctx_->create<ast::ExprStmt>(std::move(expr), loc);
 }
 
-std::unique_ptr<ast::LetStmt> Parser::parseLetStmt() {
+ast::LetStmt *Parser::parseLetStmt() {
   auto loc = current_.location;
   expect(TokenKind::KwLet, "expected 'let'");
 
   bool isMutable = match(TokenKind::KwMut);
 
   auto nameTok = expect(TokenKind::Identifier, "expected variable name");
-  std::string name(nameTok.text);
+  std::string name(text(nameTok));
 
   expect(TokenKind::Colon,
          "expected ':' after variable name (Flux requires explicit types)");
   auto type = parseType();
 
-  ast::ExprPtr init;
+  ast::ExprPtr init = nullptr;
   if (match(TokenKind::Equal)) {
     init = parseExpression();
   }
 
   expectSemicolon();
-  return std::make_unique<ast::LetStmt>(std::move(name), std::move(type),
+  return ctx_->create<ast::LetStmt>(std::move(name), std::move(type),
                                         std::move(init), isMutable, loc);
 }
 
-std::unique_ptr<ast::ConstStmt> Parser::parseConstStmt() {
+ast::ConstStmt *Parser::parseConstStmt() {
   auto loc = current_.location;
   expect(TokenKind::KwConst, "expected 'const'");
 
   auto nameTok = expect(TokenKind::Identifier, "expected constant name");
-  std::string name(nameTok.text);
+  std::string name(text(nameTok));
 
   expect(TokenKind::Colon, "expected ':' after constant name");
   auto type = parseType();
@@ -675,31 +876,31 @@ std::unique_ptr<ast::ConstStmt> Parser::parseConstStmt() {
   auto value = parseExpression();
 
   expectSemicolon();
-  return std::make_unique<ast::ConstStmt>(std::move(name), std::move(type),
+  return ctx_->create<ast::ConstStmt>(std::move(name), std::move(type),
                                           std::move(value), loc);
 }
 
-std::unique_ptr<ast::ReturnStmt> Parser::parseReturnStmt() {
+ast::ReturnStmt *Parser::parseReturnStmt() {
   auto loc = current_.location;
   expect(TokenKind::KwReturn, "expected 'return'");
 
-  ast::ExprPtr value;
+  ast::ExprPtr value = nullptr;
   if (!check(TokenKind::Semicolon) && !check(TokenKind::RBrace)) {
     value = parseExpression();
   }
 
   expectSemicolon();
-  return std::make_unique<ast::ReturnStmt>(std::move(value), loc);
+  return ctx_->create<ast::ReturnStmt>(std::move(value), loc);
 }
 
-std::unique_ptr<ast::IfStmt> Parser::parseIfStmt() {
+ast::IfStmt *Parser::parseIfStmt() {
   auto loc = current_.location;
   expect(TokenKind::KwIf, "expected 'if'");
 
   auto condition = parseExpression();
   auto thenBranch = parseBlock();
 
-  ast::StmtPtr elseBranch;
+  ast::StmtPtr elseBranch = nullptr;
   if (match(TokenKind::KwElse)) {
     if (check(TokenKind::KwIf)) {
       elseBranch = parseIfStmt();
@@ -708,11 +909,11 @@ std::unique_ptr<ast::IfStmt> Parser::parseIfStmt() {
     }
   }
 
-  return std::make_unique<ast::IfStmt>(
+  return ctx_->create<ast::IfStmt>(
       std::move(condition), std::move(thenBranch), std::move(elseBranch), loc);
 }
 
-std::unique_ptr<ast::MatchStmt> Parser::parseMatchStmt() {
+ast::MatchStmt *Parser::parseMatchStmt() {
   auto loc = current_.location;
   expect(TokenKind::KwMatch, "expected 'match'");
 
@@ -728,7 +929,7 @@ std::unique_ptr<ast::MatchStmt> Parser::parseMatchStmt() {
 
   expect(TokenKind::RBrace, "expected '}' after match arms");
 
-  return std::make_unique<ast::MatchStmt>(std::move(scrutinee), std::move(arms),
+  return ctx_->create<ast::MatchStmt>(std::move(scrutinee), std::move(arms),
                                           loc);
 }
 
@@ -754,12 +955,12 @@ ast::MatchArm Parser::parseMatchArm() {
   return arm;
 }
 
-std::unique_ptr<ast::ForStmt> Parser::parseForStmt() {
+ast::ForStmt *Parser::parseForStmt() {
   auto loc = current_.location;
   expect(TokenKind::KwFor, "expected 'for'");
 
   auto varTok = expect(TokenKind::Identifier, "expected loop variable name");
-  std::string varName(varTok.text);
+  std::string varName(text(varTok));
 
   expect(TokenKind::Colon, "expected ':' after loop variable name");
   auto varType = parseType();
@@ -769,32 +970,32 @@ std::unique_ptr<ast::ForStmt> Parser::parseForStmt() {
 
   auto body = parseBlock();
 
-  return std::make_unique<ast::ForStmt>(std::move(varName), std::move(varType),
+  return ctx_->create<ast::ForStmt>(std::move(varName), std::move(varType),
                                         std::move(iterable), std::move(body),
                                         loc);
 }
 
-std::unique_ptr<ast::WhileStmt> Parser::parseWhileStmt() {
+ast::WhileStmt *Parser::parseWhileStmt() {
   auto loc = current_.location;
   expect(TokenKind::KwWhile, "expected 'while'");
 
   auto condition = parseExpression();
   auto body = parseBlock();
 
-  return std::make_unique<ast::WhileStmt>(std::move(condition), std::move(body),
+  return ctx_->create<ast::WhileStmt>(std::move(condition), std::move(body),
                                           loc);
 }
 
-std::unique_ptr<ast::LoopStmt> Parser::parseLoopStmt() {
+ast::LoopStmt *Parser::parseLoopStmt() {
   auto loc = current_.location;
   expect(TokenKind::KwLoop, "expected 'loop'");
 
   auto body = parseBlock();
 
-  return std::make_unique<ast::LoopStmt>(std::move(body), loc);
+  return ctx_->create<ast::LoopStmt>(std::move(body), loc);
 }
 
-std::unique_ptr<ast::BlockStmt> Parser::parseBlock() {
+ast::BlockStmt *Parser::parseBlock() {
   auto loc = current_.location;
   expect(TokenKind::LBrace, "expected '{'");
 
@@ -807,7 +1008,7 @@ std::unique_ptr<ast::BlockStmt> Parser::parseBlock() {
   }
 
   expect(TokenKind::RBrace, "expected '}'");
-  return std::make_unique<ast::BlockStmt>(std::move(stmts), loc);
+  return ctx_->create<ast::BlockStmt>(std::move(stmts), loc);
 }
 
 // ============================================================================
@@ -817,13 +1018,18 @@ std::unique_ptr<ast::BlockStmt> Parser::parseBlock() {
 ast::ExprPtr Parser::parseExpression() { return parseAssignment(); }
 
 ast::ExprPtr Parser::parseAssignment() {
-  auto expr = parseOr();
+  auto expr = parseBinaryExpr();
+
+  // One load answers "is any assignment ahead?" for the common case
+  if (!tokenTraits(current_.kind).isAssignment) {
+    return expr;
+  }
 
   if (check(TokenKind::Equal)) {
     auto loc = current_.location;
     advance();
     auto value = parseAssignment(); // right-associative
-    return std::make_unique<ast::AssignExpr>(std::move(expr), std::move(value),
+    return ctx_->create<ast::AssignExpr>(std::move(expr), std::move(value),
                                              loc);
   }
 
@@ -855,172 +1061,91 @@ ast::ExprPtr Parser::parseAssignment() {
     auto loc = current_.location;
     advance();
     auto value = parseAssignment();
-    return std::make_unique<ast::CompoundAssignExpr>(
+    return ctx_->create<ast::CompoundAssignExpr>(
         *compoundOp, std::move(expr), std::move(value), loc);
   }
 
   return expr;
 }
 
-ast::ExprPtr Parser::parseOr() {
-  auto left = parseAnd();
-  while (check(TokenKind::KwOr)) {
-    auto loc = current_.location;
-    advance();
-    auto right = parseAnd();
-    left = std::make_unique<ast::BinaryExpr>(ast::BinaryOp::Or, std::move(left),
-                                             std::move(right), loc);
+// ============================================================================
+// Binary operators: table-driven precedence climbing
+// ============================================================================
+//
+// One loop replaces the Or -> And -> ... -> Multiplicative recursion, so
+// parsing an atom no longer walks the whole ladder of call frames and
+// stack depth on generated one-liner formulas stays flat. All binary
+// operators are left-associative; unary and postfix stay recursive.
+
+namespace {
+
+struct BinaryOpInfo {
+  int precedence; // higher binds tighter; 1 is the loosest (or)
+  ast::BinaryOp op;
+};
+
+std::optional<BinaryOpInfo> binaryOpInfo(TokenKind kind) {
+  switch (kind) {
+  case TokenKind::KwOr:
+    return BinaryOpInfo{1, ast::BinaryOp::Or};
+  case TokenKind::KwAnd:
+    return BinaryOpInfo{2, ast::BinaryOp::And};
+  case TokenKind::EqualEqual:
+    return BinaryOpInfo{3, ast::BinaryOp::Equal};
+  case TokenKind::BangEqual:
+    return BinaryOpInfo{3, ast::BinaryOp::NotEqual};
+  case TokenKind::Less:
+    return BinaryOpInfo{4, ast::BinaryOp::Less};
+  case TokenKind::LessEqual:
+    return BinaryOpInfo{4, ast::BinaryOp::LessEqual};
+  case TokenKind::Greater:
+    return BinaryOpInfo{4, ast::BinaryOp::Greater};
+  case TokenKind::GreaterEqual:
+    return BinaryOpInfo{4, ast::BinaryOp::GreaterEqual};
+  case TokenKind::Pipe:
+    return BinaryOpInfo{5, ast::BinaryOp::BitOr};
+  case TokenKind::Caret:
+    return BinaryOpInfo{6, ast::BinaryOp::BitXor};
+  case TokenKind::Ampersand:
+    return BinaryOpInfo{7, ast::BinaryOp::BitAnd};
+  case TokenKind::ShiftLeft:
+    return BinaryOpInfo{8, ast::BinaryOp::ShiftLeft};
+  case TokenKind::ShiftRight:
+    return BinaryOpInfo{8, ast::BinaryOp::ShiftRight};
+  case TokenKind::Plus:
+    return BinaryOpInfo{9, ast::BinaryOp::Add};
+  case TokenKind::Minus:
+    return BinaryOpInfo{9, ast::BinaryOp::Sub};
+  case TokenKind::Star:
+    return BinaryOpInfo{10, ast::BinaryOp::Mul};
+  case TokenKind::Slash:
+    return BinaryOpInfo{10, ast::BinaryOp::Div};
+  case TokenKind::Percent:
+    return BinaryOpInfo{10, ast::BinaryOp::Mod};
+  default:
+    return std::nullopt;
   }
-  return left;
 }
 
-ast::ExprPtr Parser::parseAnd() {
-  auto left = parseEquality();
-  while (check(TokenKind::KwAnd)) {
-    auto loc = current_.location;
-    advance();
-    auto right = parseEquality();
-    left = std::make_unique<ast::BinaryExpr>(
-        ast::BinaryOp::And, std::move(left), std::move(right), loc);
-  }
-  return left;
-}
+} // anonymous namespace
 
-ast::ExprPtr Parser::parseEquality() {
-  auto left = parseComparison();
-  while (check(TokenKind::EqualEqual) || check(TokenKind::BangEqual)) {
-    auto loc = current_.location;
-    auto op = current_.kind == TokenKind::EqualEqual ? ast::BinaryOp::Equal
-                                                     : ast::BinaryOp::NotEqual;
-    advance();
-    auto right = parseComparison();
-    left = std::make_unique<ast::BinaryExpr>(op, std::move(left),
-                                             std::move(right), loc);
-  }
-  return left;
-}
+ast::ExprPtr Parser::parseBinaryExpr(int minPrecedence) {
+  auto left = parseUnary();
 
-ast::ExprPtr Parser::parseComparison() {
-  auto left = parseBitwiseOr();
-  while (check(TokenKind::Less) || check(TokenKind::LessEqual) ||
-         check(TokenKind::Greater) || check(TokenKind::GreaterEqual)) {
-    auto loc = current_.location;
-    ast::BinaryOp op;
-    switch (current_.kind) {
-    case TokenKind::Less:
-      op = ast::BinaryOp::Less;
-      break;
-    case TokenKind::LessEqual:
-      op = ast::BinaryOp::LessEqual;
-      break;
-    case TokenKind::Greater:
-      op = ast::BinaryOp::Greater;
-      break;
-    case TokenKind::GreaterEqual:
-      op = ast::BinaryOp::GreaterEqual;
-      break;
-    default:
-      op = ast::BinaryOp::Less;
-      break; // unreachable
+  for (;;) {
+    // Single table load rejects non-operators before the op mapping
+    int precedence = tokenTraits(current_.kind).binaryPrecedence;
+    if (precedence == 0 || precedence < minPrecedence) {
+      return left;
     }
-    advance();
-    auto right = parseBitwiseOr();
-    left = std::make_unique<ast::BinaryExpr>(op, std::move(left),
-                                             std::move(right), loc);
-  }
-  return left;
-}
-
-ast::ExprPtr Parser::parseBitwiseOr() {
-  auto left = parseBitwiseXor();
-  while (check(TokenKind::Pipe)) {
-    auto loc = current_.location;
-    advance();
-    auto right = parseBitwiseXor();
-    left = std::make_unique<ast::BinaryExpr>(
-        ast::BinaryOp::BitOr, std::move(left), std::move(right), loc);
-  }
-  return left;
-}
-
-ast::ExprPtr Parser::parseBitwiseXor() {
-  auto left = parseBitwiseAnd();
-  while (check(TokenKind::Caret)) {
-    auto loc = current_.location;
-    advance();
-    auto right = parseBitwiseAnd();
-    left = std::make_unique<ast::BinaryExpr>(
-        ast::BinaryOp::BitXor, std::move(left), std::move(right), loc);
-  }
-  return left;
-}
-
-ast::ExprPtr Parser::parseBitwiseAnd() {
-  auto left = parseShift();
-  while (check(TokenKind::Ampersand)) {
-    auto loc = current_.location;
-    advance();
-    auto right = parseShift();
-    left = std::make_unique<ast::BinaryExpr>(
-        ast::BinaryOp::BitAnd, std::move(left), std::move(right), loc);
-  }
-  return left;
-}
-
-ast::ExprPtr Parser::parseShift() {
-  auto left = parseAdditive();
-  while (check(TokenKind::ShiftLeft) || check(TokenKind::ShiftRight)) {
-    auto loc = current_.location;
-    auto op = current_.kind == TokenKind::ShiftLeft ? ast::BinaryOp::ShiftLeft
-                                                    : ast::BinaryOp::ShiftRight;
-    advance();
-    auto right = parseAdditive();
-    left = std::make_unique<ast::BinaryExpr>(op, std::move(left),
-                                             std::move(right), loc);
-  }
-  return left;
-}
-
-ast::ExprPtr Parser::parseAdditive() {
-  auto left = parseMultiplicative();
-  while (check(TokenKind::Plus) || check(TokenKind::Minus)) {
-    auto loc = current_.location;
-    auto op = current_.kind == TokenKind::Plus ? ast::BinaryOp::Add
-                                               : ast::BinaryOp::Sub;
-    advance();
-    auto right = parseMultiplicative();
-    left = std::make_unique<ast::BinaryExpr>(op, std::move(left),
-                                             std::move(right), loc);
-  }
-  return left;
-}
-
-ast::ExprPtr Parser::parseMultiplicative() {
-  auto left = parseUnary();
-  while (check(TokenKind::Star) || check(TokenKind::Slash) ||
-         check(TokenKind::Percent)) {
+    auto info = binaryOpInfo(current_.kind);
     auto loc = current_.location;
-    ast::BinaryOp op;
-    switch (current_.kind) {
-    case TokenKind::Star:
-      op = ast::BinaryOp::Mul;
-      break;
-    case TokenKind::Slash:
-      op = ast::BinaryOp::Div;
-      break;
-    case TokenKind::Percent:
-      op = ast::BinaryOp::Mod;
-      break;
-    default:
-      op = ast::BinaryOp::Mul;
-      break;
-    }
     advance();
-    auto right = parseUnary();
-    left = std::make_unique<ast::BinaryExpr>(op, std::move(left),
-                                             std::move(right), loc);
+    // +1: equal precedence binds left
+    auto right = parseBinaryExpr(precedence + 1);
+    left = ctx_->create<ast::BinaryExpr>(info->op, std::move(left),
+                                         std::move(right), loc);
   }
-  return left;
 }
 
 ast::ExprPtr Parser::parseUnary() {
@@ -1029,48 +1154,48 @@ ast::ExprPtr Parser::parseUnary() {
   // Negate
   if (match(TokenKind::Minus)) {
     auto operand = parseUnary();
-    return std::make_unique<ast::UnaryExpr>(ast::UnaryOp::Negate,
+    return ctx_->create<ast::UnaryExpr>(ast::UnaryOp::Negate,
                                             std::move(operand), loc);
   }
 
   // Logical not
   if (match(TokenKind::KwNot)) {
     auto operand = parseUnary();
-    return std::make_unique<ast::UnaryExpr>(ast::UnaryOp::Not,
+    return ctx_->create<ast::UnaryExpr>(ast::UnaryOp::Not,
                                             std::move(operand), loc);
   }
 
   // Bitwise not
   if (match(TokenKind::Tilde)) {
     auto operand = parseUnary();
-    return std::make_unique<ast::UnaryExpr>(ast::UnaryOp::BitwiseNot,
+    return ctx_->create<ast::UnaryExpr>(ast::UnaryOp::BitwiseNot,
                                             std::move(operand), loc);
   }
 
   // ref expr
   if (match(TokenKind::KwRef)) {
     auto operand = parseUnary();
-    return std::make_unique<ast::RefExpr>(std::move(operand), loc);
+    return ctx_->create<ast::RefExpr>(std::move(operand), loc);
   }
 
   // mut ref expr
-  if (check(TokenKind::KwMut) && lexer_.peekToken().kind == TokenKind::KwRef) {
+  if (check(TokenKind::KwMut) && peekAhead(1).kind == TokenKind::KwRef) {
     advance(); // mut
     advance(); // ref
     auto operand = parseUnary();
-    return std::make_unique<ast::MutRefExpr>(std::move(operand), loc);
+    return ctx_->create<ast::MutRefExpr>(std::move(operand), loc);
   }
 
   // move expr
   if (match(TokenKind::KwMove)) {
     auto operand = parseUnary();
-    return std::make_unique<ast::MoveExpr>(std::move(operand), loc);
+    return ctx_->create<ast::MoveExpr>(std::move(operand), loc);
   }
 
   // await expr
   if (match(TokenKind::KwAwait)) {
     auto operand = parseUnary();
-    return std::make_unique<ast::AwaitExpr>(std::move(operand), loc);
+    return ctx_->create<ast::AwaitExpr>(std::move(operand), loc);
   }
 
   auto expr = parsePrimary();
@@ -1108,7 +1233,7 @@ ast::ExprPtr Parser::parsePostfix(ast::ExprPtr left) {
     auto loc = current_.location;
     auto memberTok =
         expect(TokenKind::Identifier, "expected member name after '.'");
-    std::string member(memberTok.text);
+    std::string member(text(memberTok));
 
     // Check if this is a method call
     if (check(TokenKind::LParen)) {
@@ -1120,11 +1245,11 @@ ast::ExprPtr Parser::parsePostfix(ast::ExprPtr left) {
           break;
       }
       expect(TokenKind::RParen, "expected ')' after method arguments");
-      return std::make_unique<ast::MethodCallExpr>(
+      return ctx_->create<ast::MethodCallExpr>(
           std::move(left), std::move(member), std::move(args), loc);
     }
 
-    return std::make_unique<ast::MemberAccessExpr>(std::move(left),
+    return ctx_->create<ast::MemberAccessExpr>(std::move(left),
                                                    std::move(member), loc);
   }
 
@@ -1139,19 +1264,19 @@ ast::ExprPtr Parser::parsePostfix(ast::ExprPtr left) {
     // Build path segments
     std::vector<std::string> segments;
     if (left->kind == ast::Expr::Kind::Ident) {
-      segments.push_back(static_cast<ast::IdentExpr *>(left.get())->name);
+      segments.push_back(static_cast<ast::IdentExpr *>(left)->name);
     } else if (left->kind == ast::Expr::Kind::Path) {
-      segments = static_cast<ast::PathExpr *>(left.get())->segments;
+      segments = static_cast<ast::PathExpr *>(left)->segments;
     }
-    segments.push_back(std::string(nextTok.text));
+    segments.push_back(std::string(text(nextTok)));
 
     while (match(TokenKind::ColonColon)) {
       auto seg =
           expect(TokenKind::Identifier, "expected identifier after '::'");
-      segments.push_back(std::string(seg.text));
+      segments.push_back(std::string(text(seg)));
     }
 
-    auto pathExpr = std::make_unique<ast::PathExpr>(std::move(segments), loc);
+    auto pathExpr = ctx_->create<ast::PathExpr>(std::move(segments), loc);
 
     // Check for struct construction: Type { field: value }
     // or function call: Path::func(args)
@@ -1160,13 +1285,13 @@ ast::ExprPtr Parser::parsePostfix(ast::ExprPtr left) {
 
   // Try operator (?)
   if (match(TokenKind::Question)) {
-    return std::make_unique<ast::TryExpr>(std::move(left), left->location);
+    return ctx_->create<ast::TryExpr>(std::move(left), left->location);
   }
 
   // Type cast (as)
   if (match(TokenKind::KwAs)) {
     auto type = parseType();
-    return std::make_unique<ast::CastExpr>(std::move(left), std::move(type),
+    return ctx_->create<ast::CastExpr>(std::move(left), std::move(type),
                                            left->location);
   }
 
@@ -1185,7 +1310,7 @@ ast::ExprPtr Parser::parseCallArguments(ast::ExprPtr callee) {
   }
 
   expect(TokenKind::RParen, "expected ')' after arguments");
-  return std::make_unique<ast::CallExpr>(std::move(callee), std::move(args),
+  return ctx_->create<ast::CallExpr>(std::move(callee), std::move(args),
                                          loc);
 }
 
@@ -1194,54 +1319,62 @@ ast::ExprPtr Parser::parseIndexExpression(ast::ExprPtr object) {
   expect(TokenKind::LBracket, "expected '['");
   auto index = parseExpression();
   expect(TokenKind::RBracket, "expected ']'");
-  return std::make_unique<ast::IndexExpr>(std::move(object), std::move(index),
+  return ctx_->create<ast::IndexExpr>(std::move(object), std::move(index),
                                           loc);
 }
 
 ast::ExprPtr Parser::parsePrimary() {
   auto loc = current_.location;
 
+  // assert(...) / panic(...) are keyword-spelled builtins; surface them
+  // as identifiers so call syntax and codegen lowering apply uniformly
+  if (check(TokenKind::KwAssert) || check(TokenKind::KwPanic)) {
+    std::string name(text(current_));
+    advance();
+    return ctx_->create<ast::IdentExpr>(std::move(name), loc);
+  }
+
   // Integer literal
   if (check(TokenKind::IntLiteral)) {
     auto tok = advance();
-    return std::make_unique<ast::IntLiteralExpr>(tok.intValue, loc);
+    return ctx_->create<ast::IntLiteralExpr>(lexer_.intValue(tok), loc);
   }
 
   // Float literal
   if (check(TokenKind::FloatLiteral)) {
     auto tok = advance();
-    return std::make_unique<ast::FloatLiteralExpr>(tok.floatValue, loc);
+    return ctx_->create<ast::FloatLiteralExpr>(lexer_.floatValue(tok), loc);
   }
 
   // String literal
   if (check(TokenKind::StringLiteral)) {
     auto tok = advance();
     // Text is already stored without quotes by the lexer
-    std::string value(tok.text);
-    return std::make_unique<ast::StringLiteralExpr>(std::move(value), loc);
+    std::string value(text(tok));
+    return ctx_->create<ast::StringLiteralExpr>(std::move(value), loc);
   }
 
   // Char literal
   if (check(TokenKind::CharLiteral)) {
     auto tok = advance();
-    char32_t value = tok.text[1]; // simplified
-    return std::make_unique<ast::CharLiteralExpr>(value, loc);
+    char32_t value = text(tok)[1]; // simplified
+    return ctx_->create<ast::CharLiteralExpr>(value, loc);
   }
 
   // Bool literal (true/false keywords)
   if (check(TokenKind::KwTrue)) {
     advance();
-    return std::make_unique<ast::BoolLiteralExpr>(true, loc);
+    return ctx_->create<ast::BoolLiteralExpr>(true, loc);
   }
   if (check(TokenKind::KwFalse)) {
     advance();
-    return std::make_unique<ast::BoolLiteralExpr>(false, loc);
+    return ctx_->create<ast::BoolLiteralExpr>(false, loc);
   }
 
   // Identifier or path
   if (check(TokenKind::Identifier)) {
     auto tok = advance();
-    std::string name(tok.text);
+    std::string name(text(tok));
 
     // Check for :: path
     if (check(TokenKind::ColonColon)) {
@@ -1250,16 +1383,15 @@ ast::ExprPtr Parser::parsePrimary() {
       while (match(TokenKind::ColonColon)) {
         auto seg =
             expect(TokenKind::Identifier, "expected identifier after '::'");
-        segments.push_back(std::string(seg.text));
+        segments.push_back(std::string(text(seg)));
       }
-      return std::make_unique<ast::PathExpr>(std::move(segments), loc);
+      return ctx_->create<ast::PathExpr>(std::move(segments), loc);
     }
 
     // Check for struct construction: TypeName { ... }
     if (check(TokenKind::LBrace)) {
       // Disambiguate: struct literal if next tokens look like "ident : expr"
-      auto parserSaved = saveState();
-      auto lexerSaved = lexer_.saveState();
+      auto saved = saveState();
       advance(); // consume '{'
       bool isStructLiteral = false;
       if (check(TokenKind::Identifier)) {
@@ -1272,8 +1404,7 @@ ast::ExprPtr Parser::parsePrimary() {
         isStructLiteral = true;
       }
       // Restore state
-      restoreState(parserSaved);
-      lexer_.restoreState(lexerSaved);
+      restoreState(saved);
 
       if (isStructLiteral) {
         advance(); // consume '{'
@@ -1282,17 +1413,17 @@ ast::ExprPtr Parser::parsePrimary() {
           auto fieldName = expect(TokenKind::Identifier, "expected field name");
           expect(TokenKind::Colon, "expected ':' after field name");
           auto value = parseExpression();
-          fields.emplace_back(std::string(fieldName.text), std::move(value));
+          fields.emplace_back(std::string(text(fieldName)), std::move(value));
           if (!match(TokenKind::Comma))
             break;
         }
         expect(TokenKind::RBrace, "expected '}' after struct literal");
-        return std::make_unique<ast::StructLiteralExpr>(std::move(name),
+        return ctx_->create<ast::StructLiteralExpr>(std::move(name),
                                                         std::move(fields), loc);
       }
     }
 
-    return std::make_unique<ast::IdentExpr>(std::move(name), loc);
+    return ctx_->create<ast::IdentExpr>(std::move(name), loc);
   }
 
   // Parenthesized expression or tuple
@@ -1300,7 +1431,7 @@ ast::ExprPtr Parser::parsePrimary() {
     if (check(TokenKind::RParen)) {
       advance();
       // Empty tuple / void
-      return std::make_unique<ast::TupleExpr>(ast::ExprList{}, loc);
+      return ctx_->create<ast::TupleExpr>(ast::ExprList{}, loc);
     }
 
     auto first = parseExpression();
@@ -1315,7 +1446,7 @@ ast::ExprPtr Parser::parsePrimary() {
         elements.push_back(parseExpression());
       }
       expect(TokenKind::RParen, "expected ')' after tuple");
-      return std::make_unique<ast::TupleExpr>(std::move(elements), loc);
+      return ctx_->create<ast::TupleExpr>(std::move(elements), loc);
     }
 
     expect(TokenKind::RParen, "expected ')'");
@@ -1344,11 +1475,11 @@ ast::ExprPtr Parser::parsePrimary() {
 
   // Wildcard
   if (match(TokenKind::Underscore)) {
-    return std::make_unique<ast::IdentExpr>("_", loc);
+    return ctx_->create<ast::IdentExpr>("_", loc);
   }
 
   diag_.emitError(loc, "expected expression, got '" +
-                           std::string(current_.text) + "'");
+                           std::string(text(current_)) + "'");
   return nullptr;
 }
 
@@ -1365,7 +1496,7 @@ ast::ExprPtr Parser::parseBlockExpr() {
   }
 
   expect(TokenKind::RBrace, "expected '}'");
-  return std::make_unique<ast::BlockExpr>(std::move(stmts), nullptr, loc);
+  return ctx_->create<ast::BlockExpr>(std::move(stmts), nullptr, loc);
 }
 
 ast::ExprPtr Parser::parseIfExpr() {
@@ -1375,7 +1506,7 @@ ast::ExprPtr Parser::parseIfExpr() {
   auto condition = parseExpression();
   auto thenBranch = parseBlockExpr();
 
-  ast::ExprPtr elseBranch;
+  ast::ExprPtr elseBranch = nullptr;
   if (match(TokenKind::KwElse)) {
     if (check(TokenKind::KwIf)) {
       elseBranch = parseIfExpr();
@@ -1384,7 +1515,7 @@ ast::ExprPtr Parser::parseIfExpr() {
     }
   }
 
-  return std::make_unique<ast::IfExpr>(
+  return ctx_->create<ast::IfExpr>(
       std::move(condition), std::move(thenBranch), std::move(elseBranch), loc);
 }
 
@@ -1402,7 +1533,7 @@ ast::ExprPtr Parser::parseMatchExpr() {
   }
 
   expect(TokenKind::RBrace, "expected '}' after match arms");
-  return std::make_unique<ast::MatchExpr>(std::move(scrutinee), std::move(arms),
+  return ctx_->create<ast::MatchExpr>(std::move(scrutinee), std::move(arms),
                                           loc);
 }
 
@@ -1414,7 +1545,7 @@ ast::ExprPtr Parser::parseClosureExpr() {
   while (!check(TokenKind::Pipe) && !check(TokenKind::Eof)) {
     ast::ClosureParam param;
     auto nameTok = expect(TokenKind::Identifier, "expected parameter name");
-    param.name = std::string(nameTok.text);
+    param.name = std::string(text(nameTok));
 
     if (match(TokenKind::Colon)) {
       param.type = parseType();
@@ -1425,14 +1556,14 @@ ast::ExprPtr Parser::parseClosureExpr() {
   }
   expect(TokenKind::Pipe, "expected '|' after closure parameters");
 
-  ast::TypeNodePtr returnType;
+  ast::TypeNodePtr returnType = nullptr;
   if (match(TokenKind::Arrow)) {
     returnType = parseType();
   }
 
   auto body = parseBlockExpr();
 
-  return std::make_unique<ast::ClosureExpr>(
+  return ctx_->create<ast::ClosureExpr>(
       std::move(params), std::move(returnType), std::move(body), loc);
 }
 
@@ -1445,27 +1576,27 @@ ast::PatternPtr Parser::parsePattern() {
 
   // Wildcard: _
   if (match(TokenKind::Underscore)) {
-    return std::make_unique<ast::WildcardPattern>(loc);
+    return ctx_->create<ast::WildcardPattern>(loc);
   }
 
   // Literal patterns
   if (check(TokenKind::IntLiteral)) {
     auto tok = advance();
-    auto lit = std::make_unique<ast::IntLiteralExpr>(tok.intValue, loc);
-    return std::make_unique<ast::LiteralPattern>(std::move(lit), loc);
+    auto lit = ctx_->create<ast::IntLiteralExpr>(lexer_.intValue(tok), loc);
+    return ctx_->create<ast::LiteralPattern>(std::move(lit), loc);
   }
 
   if (check(TokenKind::StringLiteral)) {
     auto tok = advance();
-    std::string value(tok.text.substr(1, tok.text.size() - 2));
-    auto lit = std::make_unique<ast::StringLiteralExpr>(std::move(value), loc);
-    return std::make_unique<ast::LiteralPattern>(std::move(lit), loc);
+    std::string value(text(tok).substr(1, text(tok).size() - 2));
+    auto lit = ctx_->create<ast::StringLiteralExpr>(std::move(value), loc);
+    return ctx_->create<ast::LiteralPattern>(std::move(lit), loc);
   }
 
   if (check(TokenKind::BoolLiteral)) {
     auto tok = advance();
-    auto lit = std::make_unique<ast::BoolLiteralExpr>(tok.intValue != 0, loc);
-    return std::make_unique<ast::LiteralPattern>(std::move(lit), loc);
+    auto lit = ctx_->create<ast::BoolLiteralExpr>(lexer_.intValue(tok) != 0, loc);
+    return ctx_->create<ast::LiteralPattern>(std::move(lit), loc);
   }
 
   // Tuple pattern
@@ -1477,13 +1608,13 @@ ast::PatternPtr Parser::parsePattern() {
         break;
     }
     expect(TokenKind::RParen, "expected ')' after tuple pattern");
-    return std::make_unique<ast::TuplePattern>(std::move(elements), loc);
+    return ctx_->create<ast::TuplePattern>(std::move(elements), loc);
   }
 
   // Identifier or constructor pattern
   if (check(TokenKind::Identifier)) {
     auto tok = advance();
-    std::string name(tok.text);
+    std::string name(text(tok));
 
     // Check for :: (constructor pattern like Option::Some)
     if (check(TokenKind::ColonColon)) {
@@ -1491,11 +1622,11 @@ ast::PatternPtr Parser::parsePattern() {
       path.push_back(std::move(name));
       while (match(TokenKind::ColonColon)) {
         auto seg = expect(TokenKind::Identifier, "expected identifier");
-        path.push_back(std::string(seg.text));
+        path.push_back(std::string(text(seg)));
       }
 
       auto pattern =
-          std::make_unique<ast::ConstructorPattern>(std::move(path), loc);
+          ctx_->create<ast::ConstructorPattern>(std::move(path), loc);
 
       // Check for tuple fields: Option::Some(value)
       if (match(TokenKind::LParen)) {
@@ -1512,14 +1643,14 @@ ast::PatternPtr Parser::parsePattern() {
         while (!check(TokenKind::RBrace) && !check(TokenKind::Eof)) {
           auto fieldTok = expect(TokenKind::Identifier, "expected field name");
           ast::ConstructorPattern::NamedField field;
-          field.name = std::string(fieldTok.text);
+          field.name = std::string(text(fieldTok));
 
           if (match(TokenKind::Colon)) {
             field.pattern = parsePattern();
           } else {
             // Shorthand: { x } means { x: x }
-            field.pattern = std::make_unique<ast::IdentPattern>(
-                std::string(fieldTok.text), fieldTok.location);
+            field.pattern = ctx_->create<ast::IdentPattern>(
+                std::string(text(fieldTok)), fieldTok.location);
           }
           pattern->namedFields.push_back(std::move(field));
           if (!match(TokenKind::Comma))
@@ -1532,11 +1663,11 @@ ast::PatternPtr Parser::parsePattern() {
     }
 
     // Simple identifier binding
-    return std::make_unique<ast::IdentPattern>(std::move(name), loc);
+    return ctx_->create<ast::IdentPattern>(std::move(name), loc);
   }
 
   diag_.emitError(loc, "expected pattern");
-  return std::make_unique<ast::WildcardPattern>(loc);
+  return ctx_->create<ast::WildcardPattern>(loc);
 }
 
 // ============================================================================
@@ -1556,11 +1687,11 @@ ast::TypeNodePtr Parser::parseType() {
     if (check(TokenKind::KwMut)) {
       advance();
       auto inner = parseType();
-      return std::make_unique<ast::MutRefType>(std::move(inner), loc);
+      return ctx_->create<ast::MutRefType>(std::move(inner), loc);
     }
     // &Type
     auto inner = parseType();
-    return std::make_unique<ast::ReferenceType>(std::move(inner), loc);
+    return ctx_->create<ast::ReferenceType>(std::move(inner), loc);
   }
 
   // mut ref Type
@@ -1569,7 +1700,7 @@ ast::TypeNodePtr Parser::parseType() {
     if (check(TokenKind::KwRef)) {
       advance();
       auto inner = parseType();
-      return std::make_unique<ast::MutRefType>(std::move(inner), loc);
+      return ctx_->create<ast::MutRefType>(std::move(inner), loc);
     }
     diag_.emitError(loc, "expected 'ref' after 'mut' in type");
     return nullptr;
@@ -1594,22 +1725,22 @@ ast::TypeNodePtr Parser::parseNamedOrGenericType() {
   if (check(TokenKind::KwVoid)) {
     advance();
     path.push_back("Void");
-    return std::make_unique<ast::NamedType>(std::move(path), loc);
+    return ctx_->create<ast::NamedType>(std::move(path), loc);
   }
 
   // Handle Self keyword
   if (check(TokenKind::KwSelfType)) {
     advance();
     path.push_back("Self");
-    return std::make_unique<ast::NamedType>(std::move(path), loc);
+    return ctx_->create<ast::NamedType>(std::move(path), loc);
   }
 
   auto tok = expect(TokenKind::Identifier, "expected type name");
-  path.push_back(std::string(tok.text));
+  path.push_back(std::string(text(tok)));
 
   while (match(TokenKind::ColonColon)) {
     tok = expect(TokenKind::Identifier, "expected type name after '::'");
-    path.push_back(std::string(tok.text));
+    path.push_back(std::string(text(tok)));
   }
 
   // Check for generic type arguments: Type<T1, T2>
@@ -1623,12 +1754,12 @@ ast::TypeNodePtr Parser::parseNamedOrGenericType() {
     }
     expect(TokenKind::Greater, "expected '>' after type arguments");
 
-    auto base = std::make_unique<ast::NamedType>(std::move(path), loc);
-    return std::make_unique<ast::GenericType>(std::move(base),
+    auto base = ctx_->create<ast::NamedType>(std::move(path), loc);
+    return ctx_->create<ast::GenericType>(std::move(base),
                                               std::move(typeArgs), loc);
   }
 
-  return std::make_unique<ast::NamedType>(std::move(path), loc);
+  return ctx_->create<ast::NamedType>(std::move(path), loc);
 }
 
 ast::TypeNodePtr Parser::parseTupleType() {
@@ -1646,11 +1777,11 @@ ast::TypeNodePtr Parser::parseTupleType() {
   // Check for function type: (T1, T2) -> RetType
   if (match(TokenKind::Arrow)) {
     auto retType = parseType();
-    return std::make_unique<ast::FunctionType>(std::move(elements),
+    return ctx_->create<ast::FunctionType>(std::move(elements),
                                                std::move(retType), loc);
   }
 
-  return std::make_unique<ast::TupleType>(std::move(elements), loc);
+  return ctx_->create<ast::TupleType>(std::move(elements), loc);
 }
 
 ast::TypeNodePtr Parser::parseRefType() {
@@ -1662,11 +1793,11 @@ ast::TypeNodePtr Parser::parseRefType() {
   if (check(TokenKind::Apostrophe)) {
     advance();
     auto lifetimeTok = expect(TokenKind::Identifier, "expected lifetime name");
-    lifetime = std::string(lifetimeTok.text);
+    lifetime = std::string(text(lifetimeTok));
   }
 
   auto inner = parseType();
-  auto refType = std::make_unique<ast::ReferenceType>(std::move(inner), loc);
+  auto refType = ctx_->create<ast::ReferenceType>(std::move(inner), loc);
   refType->lifetime = std::move(lifetime);
   return refType;
 }
@@ -1675,13 +1806,12 @@ ast::TypeNodePtr Parser::parseRefType() {
 // State save/restore (for lookahead disambiguation)
 // ============================================================================
 
-Parser::ParserState Parser::saveState() const {
-  return {current_, previous_, 0, 0, 0}; // lexer state is saved separately
-}
+Parser::ParserState Parser::saveState() const { return {pos_}; }
 
 void Parser::restoreState(const ParserState &state) {
-  current_ = state.current;
-  previous_ = state.previous;
+  pos_ = state.pos;
+  current_ = tokenAt(pos_);
+  previous_ = pos_ > 0 ? tokens_[pos_ - 1] : Token{};
 }
 
 // ============================================================================
@@ -0,0 +1,499 @@
+#include "flux/Sema/CTFE.h"
+
+#include "flux/Sema/FoldedArithmetic.h"
+
+#include <cstring>
+#include <sstream>
+
+namespace flux {
+
+using namespace ast;
+
+namespace {
+
+/// Render an argument list into a stable memo key suffix. Doubles are
+/// keyed by their exact bit pattern — any textual rounding would make
+/// distinct arguments collide and replay the wrong memoized constant.
+std::string renderValue(const CTFEInterpreter::Value &value) {
+  std::ostringstream out;
+  if (std::holds_alternative<int64_t>(value)) {
+    out << 'i' << std::get<int64_t>(value);
+  } else if (std::holds_alternative<double>(value)) {
+    uint64_t bits;
+    double number = std::get<double>(value);
+    std::memcpy(&bits, &number, sizeof(bits));
+    out << 'f' << bits;
+  } else if (std::holds_alternative<bool>(value)) {
+    out << 'b' << std::get<bool>(value);
+  } else {
+    out << 's' << std::get<std::string>(value);
+  }
+  return out.str();
+}
+
+bool truthy(const CTFEInterpreter::Value &value) {
+  if (std::holds_alternative<bool>(value)) {
+    return std::get<bool>(value);
+  }
+  if (std::holds_alternative<int64_t>(value)) {
+    return std::get<int64_t>(value) != 0;
+  }
+  return false;
+}
+
+} // anonymous namespace
+
+CTFEInterpreter::CTFEInterpreter(Module &module, const DeclIndex *declIndex,
+                                 uint64_t stepBudget)
+    : module_(module), stepsRemaining_(stepBudget), declIndex_(declIndex) {
+  if (declIndex_) {
+    return; // the resolver already indexed every top-level declaration
+  }
+  for (auto &decl : module.declarations) {
+    if (decl->kind == Decl::Kind::Func) {
+      auto &func = static_cast<FuncDecl &>(*decl);
+      if (func.body) {
+        functions_[func.name] = &func;
+      }
+    }
+  }
+}
+
+FuncDecl *CTFEInterpreter::findFunction(const std::string &name) const {
+  if (declIndex_) {
+    ast::Decl *decl = declIndex_->lookup(name);
+    if (decl && decl->kind == Decl::Kind::Func) {
+      auto *func = static_cast<FuncDecl *>(decl);
+      return func->body ? func : nullptr;
+    }
+    return nullptr;
+  }
+  auto it = functions_.find(name);
+  return it != functions_.end() ? it->second : nullptr;
+}
+
+size_t CTFEInterpreter::run() {
+  for (auto &decl : module_.declarations) {
+    foldDecl(*decl);
+  }
+  return replaced_;
+}
+
+void CTFEInterpreter::foldDecl(Decl &decl) {
+  switch (decl.kind) {
+  case Decl::Kind::Func: {
+    auto &func = static_cast<FuncDecl &>(decl);
+    if (func.body) {
+      foldBlockInitializers(*func.body);
+    }
+    break;
+  }
+  case Decl::Kind::Class:
+    for (auto &method : static_cast<ClassDecl &>(decl).methods) {
+      foldDecl(*method);
+    }
+    break;
+  case Decl::Kind::Impl:
+    for (auto &method : static_cast<ImplDecl &>(decl).methods) {
+      foldDecl(*method);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+void CTFEInterpreter::foldBlockInitializers(BlockStmt &block) {
+  for (auto &stmt : block.statements) {
+    switch (stmt->kind) {
+    case Stmt::Kind::Const: {
+      auto &constStmt = static_cast<ConstStmt &>(*stmt);
+      // Calls are what the folder can't reduce; everything literal was
+      // already folded
+      if (constStmt.value && constStmt.value->kind == Expr::Kind::Call) {
+        Environment env;
+        if (auto value = evalExpr(*constStmt.value, env)) {
+          constStmt.value = literalFor(*value, constStmt.value->location);
+          ++replaced_;
+        }
+      }
+      break;
+    }
+    case Stmt::Kind::Let: {
+      auto &let = static_cast<LetStmt &>(*stmt);
+      if (let.initializer && let.initializer->kind == Expr::Kind::Call) {
+        Environment env;
+        if (auto value = evalExpr(*let.initializer, env)) {
+          let.initializer = literalFor(*value, let.initializer->location);
+          ++replaced_;
+        }
+      }
+      break;
+    }
+    case Stmt::Kind::Block:
+      foldBlockInitializers(static_cast<BlockStmt &>(*stmt));
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+ExprPtr CTFEInterpreter::literalFor(const Value &value, SourceLocation loc) {
+  ASTContext &ctx = *module_.context;
+  if (std::holds_alternative<int64_t>(value)) {
+    return ctx.create<IntLiteralExpr>(std::get<int64_t>(value), loc);
+  }
+  if (std::holds_alternative<double>(value)) {
+    return ctx.create<FloatLiteralExpr>(std::get<double>(value), loc);
+  }
+  if (std::holds_alternative<bool>(value)) {
+    return ctx.create<BoolLiteralExpr>(std::get<bool>(value), loc);
+  }
+  return ctx.create<StringLiteralExpr>(std::get<std::string>(value), loc);
+}
+
+std::optional<CTFEInterpreter::Value>
+CTFEInterpreter::evalExpr(Expr &expr, Environment &env) {
+  if (!spendStep()) {
+    return std::nullopt;
+  }
+
+  switch (expr.kind) {
+  case Expr::Kind::IntLiteral:
+    return Value{static_cast<IntLiteralExpr &>(expr).value};
+  case Expr::Kind::FloatLiteral:
+    return Value{static_cast<FloatLiteralExpr &>(expr).value};
+  case Expr::Kind::BoolLiteral:
+    return Value{static_cast<BoolLiteralExpr &>(expr).value};
+  case Expr::Kind::StringLiteral:
+    return Value{static_cast<StringLiteralExpr &>(expr).value};
+  case Expr::Kind::Ident: {
+    auto it = env.find(static_cast<IdentExpr &>(expr).name);
+    if (it == env.end()) {
+      return std::nullopt; // free variable: not compile-time evaluable
+    }
+    return it->second;
+  }
+  case Expr::Kind::Unary: {
+    auto &unary = static_cast<UnaryExpr &>(expr);
+    auto operand = evalExpr(*unary.operand, env);
+    if (!operand) {
+      return std::nullopt;
+    }
+    switch (unary.op) {
+    case UnaryOp::Negate:
+      if (std::holds_alternative<int64_t>(*operand)) {
+        return Value{folded::negate(std::get<int64_t>(*operand))};
+      }
+      if (std::holds_alternative<double>(*operand)) {
+        return Value{-std::get<double>(*operand)};
+      }
+      return std::nullopt;
+    case UnaryOp::Not:
+      if (std::holds_alternative<bool>(*operand)) {
+        return Value{!std::get<bool>(*operand)};
+      }
+      return std::nullopt;
+    case UnaryOp::BitwiseNot:
+      if (std::holds_alternative<int64_t>(*operand)) {
+        return Value{~std::get<int64_t>(*operand)};
+      }
+      return std::nullopt;
+    }
+    return std::nullopt;
+  }
+  case Expr::Kind::Binary: {
+    auto &binary = static_cast<BinaryExpr &>(expr);
+
+    // Short-circuit forms first
+    if (binary.op == BinaryOp::And || binary.op == BinaryOp::Or) {
+      auto lhs = evalExpr(*binary.lhs, env);
+      if (!lhs || !std::holds_alternative<bool>(*lhs)) {
+        return std::nullopt;
+      }
+      bool lhsValue = std::get<bool>(*lhs);
+      if (binary.op == BinaryOp::And && !lhsValue) {
+        return Value{false};
+      }
+      if (binary.op == BinaryOp::Or && lhsValue) {
+        return Value{true};
+      }
+      auto rhs = evalExpr(*binary.rhs, env);
+      if (!rhs || !std::holds_alternative<bool>(*rhs)) {
+        return std::nullopt;
+      }
+      return rhs;
+    }
+
+    auto lhs = evalExpr(*binary.lhs, env);
+    auto rhs = evalExpr(*binary.rhs, env);
+    if (!lhs || !rhs) {
+      return std::nullopt;
+    }
+
+    if (std::holds_alternative<int64_t>(*lhs) &&
+        std::holds_alternative<int64_t>(*rhs)) {
+      int64_t a = std::get<int64_t>(*lhs);
+      int64_t b = std::get<int64_t>(*rhs);
+      switch (binary.op) {
+      case BinaryOp::Add: return Value{folded::add(a, b)};
+      case BinaryOp::Sub: return Value{folded::sub(a, b)};
+      case BinaryOp::Mul: return Value{folded::mul(a, b)};
+      case BinaryOp::Div:
+        if (folded::divTraps(a, b)) return std::nullopt;
+        return Value{a / b};
+      case BinaryOp::Mod:
+        if (folded::divTraps(a, b)) return std::nullopt;
+        return Value{a % b};
+      case BinaryOp::BitAnd: return Value{a & b};
+      case BinaryOp::BitOr: return Value{a | b};
+      case BinaryOp::BitXor: return Value{a ^ b};
+      case BinaryOp::ShiftLeft:
+        if (b < 0 || b >= 64) return std::nullopt;
+        return Value{static_cast<int64_t>(static_cast<uint64_t>(a) << b)};
+      case BinaryOp::ShiftRight:
+        if (b < 0 || b >= 64) return std::nullopt;
+        return Value{a >> b};
+      case BinaryOp::Equal: return Value{a == b};
+      case BinaryOp::NotEqual: return Value{a != b};
+      case BinaryOp::Less: return Value{a < b};
+      case BinaryOp::LessEqual: return Value{a <= b};
+      case BinaryOp::Greater: return Value{a > b};
+      case BinaryOp::GreaterEqual: return Value{a >= b};
+      default: return std::nullopt;
+      }
+    }
+
+    if (std::holds_alternative<double>(*lhs) &&
+        std::holds_alternative<double>(*rhs)) {
+      double a = std::get<double>(*lhs);
+      double b = std::get<double>(*rhs);
+      switch (binary.op) {
+      case BinaryOp::Add: return Value{a + b};
+      case BinaryOp::Sub: return Value{a - b};
+      case BinaryOp::Mul: return Value{a * b};
+      case BinaryOp::Div: return Value{a / b};
+      case BinaryOp::Equal: return Value{a == b};
+      case BinaryOp::NotEqual: return Value{a != b};
+      case BinaryOp::Less: return Value{a < b};
+      case BinaryOp::LessEqual: return Value{a <= b};
+      case BinaryOp::Greater: return Value{a > b};
+      case BinaryOp::GreaterEqual: return Value{a >= b};
+      default: return std::nullopt;
+      }
+    }
+
+    if (std::holds_alternative<std::string>(*lhs) &&
+        std::holds_alternative<std::string>(*rhs)) {
+      const auto &a = std::get<std::string>(*lhs);
+      const auto &b = std::get<std::string>(*rhs);
+      switch (binary.op) {
+      case BinaryOp::Add: return Value{a + b};
+      case BinaryOp::Equal: return Value{a == b};
+      case BinaryOp::NotEqual: return Value{a != b};
+      default: return std::nullopt;
+      }
+    }
+
+    return std::nullopt;
+  }
+  case Expr::Kind::Call:
+    return evalCall(static_cast<CallExpr &>(expr), env);
+  default:
+    return std::nullopt; // unsupported node: leave for runtime
+  }
+}
+
+std::optional<CTFEInterpreter::Value>
+CTFEInterpreter::evalCall(CallExpr &call, Environment &env) {
+  if (call.callee->kind != Expr::Kind::Ident) {
+    return std::nullopt;
+  }
+  FuncDecl *callee =
+      findFunction(static_cast<IdentExpr &>(*call.callee).name);
+  if (!callee) {
+    return std::nullopt; // unknown / external: assume impure
+  }
+  FuncDecl &func = *callee;
+  if (func.params.size() != call.arguments.size()) {
+    return std::nullopt;
+  }
+
+  // Evaluate arguments and build the memo key
+  std::string memoKey = func.name;
+  Environment callEnv;
+  for (size_t i = 0; i < call.arguments.size(); ++i) {
+    auto arg = evalExpr(*call.arguments[i], env);
+    if (!arg) {
+      return std::nullopt;
+    }
+    memoKey += '|';
+    memoKey += renderValue(*arg);
+    callEnv[func.params[i].name] = std::move(*arg);
+  }
+
+  auto memoIt = memo_.find(memoKey);
+  if (memoIt != memo_.end()) {
+    return memoIt->second;
+  }
+
+  if (callDepth_ >= kMaxCallDepth) {
+    return std::nullopt;
+  }
+  ++callDepth_;
+  auto result = execBlock(*func.body, callEnv);
+  --callDepth_;
+  if (!result || !result->returned || !result->value) {
+    return std::nullopt;
+  }
+  memo_.emplace(std::move(memoKey), *result->value);
+  return result->value;
+}
+
+std::optional<CTFEInterpreter::ExecResult>
+CTFEInterpreter::execBlock(BlockStmt &block, Environment &env) {
+  // Bindings introduced in this block (let/const) are block-scoped:
+  // remember what each name shadowed and restore it on exit, so an
+  // inner `let x` never leaks over an outer `x`. Assignments to outer
+  // names intentionally persist — only fresh bindings are scoped.
+  std::vector<std::pair<std::string, std::optional<Value>>> shadowed;
+  auto rememberBinding = [&](const std::string &name) {
+    auto it = env.find(name);
+    shadowed.emplace_back(name, it != env.end()
+                                    ? std::optional<Value>(it->second)
+                                    : std::nullopt);
+  };
+  auto restoreBindings = [&] {
+    for (auto it = shadowed.rbegin(); it != shadowed.rend(); ++it) {
+      if (it->second) {
+        env[it->first] = std::move(*it->second);
+      } else {
+        env.erase(it->first);
+      }
+    }
+  };
+
+  for (auto &stmt : block.statements) {
+    if (stmt->kind == Stmt::Kind::Let) {
+      rememberBinding(static_cast<LetStmt &>(*stmt).name);
+    } else if (stmt->kind == Stmt::Kind::Const) {
+      rememberBinding(static_cast<ConstStmt &>(*stmt).name);
+    }
+    auto result = execStmt(*stmt, env);
+    if (!result) {
+      restoreBindings();
+      return std::nullopt;
+    }
+    if (result->returned) {
+      restoreBindings();
+      return result;
+    }
+  }
+  restoreBindings();
+  return ExecResult{};
+}
+
+std::optional<CTFEInterpreter::ExecResult>
+CTFEInterpreter::execStmt(Stmt &stmt, Environment &env) {
+  if (!spendStep()) {
+    return std::nullopt;
+  }
+
+  switch (stmt.kind) {
+  case Stmt::Kind::Let: {
+    auto &let = static_cast<LetStmt &>(stmt);
+    if (!let.initializer) {
+      return std::nullopt; // uninitialized locals not modeled
+    }
+    auto value = evalExpr(*let.initializer, env);
+    if (!value) {
+      return std::nullopt;
+    }
+    env[let.name] = std::move(*value);
+    return ExecResult{};
+  }
+  case Stmt::Kind::Const: {
+    auto &constStmt = static_cast<ConstStmt &>(stmt);
+    auto value = evalExpr(*constStmt.value, env);
+    if (!value) {
+      return std::nullopt;
+    }
+    env[constStmt.name] = std::move(*value);
+    return ExecResult{};
+  }
+  case Stmt::Kind::Return: {
+    auto &ret = static_cast<ReturnStmt &>(stmt);
+    ExecResult result;
+    result.returned = true;
+    if (ret.value) {
+      auto value = evalExpr(*ret.value, env);
+      if (!value) {
+        return std::nullopt;
+      }
+      result.value = std::move(*value);
+    }
+    return result;
+  }
+  case Stmt::Kind::If: {
+    auto &ifStmt = static_cast<IfStmt &>(stmt);
+    auto cond = evalExpr(*ifStmt.condition, env);
+    if (!cond) {
+      return std::nullopt;
+    }
+    if (truthy(*cond)) {
+      return execStmt(*ifStmt.thenBranch, env);
+    }
+    if (ifStmt.elseBranch) {
+      return execStmt(*ifStmt.elseBranch, env);
+    }
+    return ExecResult{};
+  }
+  case Stmt::Kind::While: {
+    auto &whileStmt = static_cast<WhileStmt &>(stmt);
+    for (;;) {
+      if (!spendStep()) {
+        return std::nullopt; // budget exhausted: leave for runtime
+      }
+      auto cond = evalExpr(*whileStmt.condition, env);
+      if (!cond) {
+        return std::nullopt;
+      }
+      if (!truthy(*cond)) {
+        return ExecResult{};
+      }
+      auto result = execStmt(*whileStmt.body, env);
+      if (!result) {
+        return std::nullopt;
+      }
+      if (result->returned) {
+        return result;
+      }
+    }
+  }
+  case Stmt::Kind::Block:
+    return execBlock(static_cast<BlockStmt &>(stmt), env);
+  case Stmt::Kind::Expr: {
+    auto &exprStmt = static_cast<ExprStmt &>(stmt);
+    // Assignments to known locals are the only effect we model
+    if (exprStmt.expression->kind == Expr::Kind::Assign) {
+      auto &assign = static_cast<AssignExpr &>(*exprStmt.expression);
+      if (assign.target->kind != Expr::Kind::Ident) {
+        return std::nullopt;
+      }
+      auto value = evalExpr(*assign.value, env);
+      if (!value) {
+        return std::nullopt;
+      }
+      env[static_cast<IdentExpr &>(*assign.target).name] =
+          std::move(*value);
+      return ExecResult{};
+    }
+    return std::nullopt; // other expression statements may have effects
+  }
+  default:
+    return std::nullopt;
+  }
+}
+
+} // namespace flux
@@ -0,0 +1,355 @@
+#include "flux/Sema/ConstantFolder.h"
+
+#include "flux/Sema/FoldedArithmetic.h"
+
+namespace flux {
+
+using namespace ast;
+
+void ConstantFolder::run(Module &module) {
+  if (!module.context) {
+    return;
+  }
+  ConstantFolder folder(*module.context);
+  for (auto &decl : module.declarations) {
+    folder.foldDecl(*decl);
+  }
+}
+
+void ConstantFolder::foldDecl(Decl &decl) {
+  switch (decl.kind) {
+  case Decl::Kind::Func: {
+    auto &func = static_cast<FuncDecl &>(decl);
+    if (func.body) {
+      foldBlock(*func.body);
+    }
+    break;
+  }
+  case Decl::Kind::Class:
+    for (auto &method : static_cast<ClassDecl &>(decl).methods) {
+      foldDecl(*method);
+    }
+    break;
+  case Decl::Kind::Trait:
+    for (auto &method : static_cast<TraitDecl &>(decl).methods) {
+      foldDecl(*method);
+    }
+    break;
+  case Decl::Kind::Impl:
+    for (auto &method : static_cast<ImplDecl &>(decl).methods) {
+      foldDecl(*method);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+void ConstantFolder::foldBlock(BlockStmt &block) {
+  StmtList folded;
+  folded.reserve(block.statements.size());
+  for (auto &stmt : block.statements) {
+    if (StmtPtr replacement = foldStmt(stmt)) {
+      folded.push_back(replacement);
+    }
+  }
+  block.statements = std::move(folded);
+}
+
+StmtPtr ConstantFolder::foldStmt(StmtPtr stmt) {
+  switch (stmt->kind) {
+  case Stmt::Kind::Let: {
+    auto &let = static_cast<LetStmt &>(*stmt);
+    if (let.initializer) {
+      let.initializer = foldExpr(let.initializer);
+    }
+    return stmt;
+  }
+  case Stmt::Kind::Const: {
+    auto &constStmt = static_cast<ConstStmt &>(*stmt);
+    if (constStmt.value) {
+      constStmt.value = foldExpr(constStmt.value);
+    }
+    return stmt;
+  }
+  case Stmt::Kind::Return: {
+    auto &ret = static_cast<ReturnStmt &>(*stmt);
+    if (ret.value) {
+      ret.value = foldExpr(ret.value);
+    }
+    return stmt;
+  }
+  case Stmt::Kind::If: {
+    auto &ifStmt = static_cast<IfStmt &>(*stmt);
+    ifStmt.condition = foldExpr(ifStmt.condition);
+
+    bool condValue;
+    if (isBoolLiteral(*ifStmt.condition, condValue)) {
+      // Dead branch: keep only the side that runs
+      if (condValue) {
+        return foldStmt(ifStmt.thenBranch);
+      }
+      return ifStmt.elseBranch ? foldStmt(ifStmt.elseBranch) : nullptr;
+    }
+
+    ifStmt.thenBranch = foldStmt(ifStmt.thenBranch);
+    if (ifStmt.elseBranch) {
+      ifStmt.elseBranch = foldStmt(ifStmt.elseBranch);
+    }
+    return stmt;
+  }
+  case Stmt::Kind::While: {
+    auto &whileStmt = static_cast<WhileStmt &>(*stmt);
+    whileStmt.condition = foldExpr(whileStmt.condition);
+
+    bool condValue;
+    if (isBoolLiteral(*whileStmt.condition, condValue) && !condValue) {
+      return nullptr; // while false: never runs
+    }
+    whileStmt.body = foldStmt(whileStmt.body);
+    return stmt;
+  }
+  case Stmt::Kind::For: {
+    auto &forStmt = static_cast<ForStmt &>(*stmt);
+    forStmt.iterable = foldExpr(forStmt.iterable);
+    forStmt.body = foldStmt(forStmt.body);
+    return stmt;
+  }
+  case Stmt::Kind::Loop: {
+    auto &loop = static_cast<LoopStmt &>(*stmt);
+    loop.body = foldStmt(loop.body);
+    return stmt;
+  }
+  case Stmt::Kind::Block: {
+    foldBlock(static_cast<BlockStmt &>(*stmt));
+    return stmt;
+  }
+  case Stmt::Kind::Expr: {
+    auto &exprStmt = static_cast<ExprStmt &>(*stmt);
+    exprStmt.expression = foldExpr(exprStmt.expression);
+    return stmt;
+  }
+  default:
+    return stmt;
+  }
+}
+
+ExprPtr ConstantFolder::foldExpr(ExprPtr expr) {
+  switch (expr->kind) {
+  case Expr::Kind::Binary:
+    return foldBinary(static_cast<BinaryExpr &>(*expr));
+  case Expr::Kind::Unary:
+    return foldUnary(static_cast<UnaryExpr &>(*expr));
+  case Expr::Kind::If: {
+    auto &ifExpr = static_cast<IfExpr &>(*expr);
+    ifExpr.condition = foldExpr(ifExpr.condition);
+
+    bool condValue;
+    if (isBoolLiteral(*ifExpr.condition, condValue)) {
+      if (condValue) {
+        return foldExpr(ifExpr.thenExpr);
+      }
+      if (ifExpr.elseExpr) {
+        return foldExpr(ifExpr.elseExpr);
+      }
+      return expr; // no else to take; leave as-is
+    }
+
+    ifExpr.thenExpr = foldExpr(ifExpr.thenExpr);
+    if (ifExpr.elseExpr) {
+      ifExpr.elseExpr = foldExpr(ifExpr.elseExpr);
+    }
+    return expr;
+  }
+  case Expr::Kind::Call: {
+    auto &call = static_cast<CallExpr &>(*expr);
+    call.callee = foldExpr(call.callee);
+    for (auto &arg : call.arguments) {
+      arg = foldExpr(arg);
+    }
+    return expr;
+  }
+  case Expr::Kind::Block: {
+    auto &block = static_cast<BlockExpr &>(*expr);
+    StmtList folded;
+    folded.reserve(block.statements.size());
+    for (auto &stmt : block.statements) {
+      if (StmtPtr replacement = foldStmt(stmt)) {
+        folded.push_back(replacement);
+      }
+    }
+    block.statements = std::move(folded);
+    if (block.finalExpr) {
+      block.finalExpr = foldExpr(block.finalExpr);
+    }
+    return expr;
+  }
+  case Expr::Kind::Assign: {
+    auto &assign = static_cast<AssignExpr &>(*expr);
+    assign.value = foldExpr(assign.value);
+    return expr;
+  }
+  default:
+    return expr;
+  }
+}
+
+ExprPtr ConstantFolder::foldBinary(BinaryExpr &expr) {
+  expr.lhs = foldExpr(expr.lhs);
+  expr.rhs = foldExpr(expr.rhs);
+
+  // --- Integer folding ---
+  if (expr.lhs->kind == Expr::Kind::IntLiteral &&
+      expr.rhs->kind == Expr::Kind::IntLiteral) {
+    int64_t lhs = static_cast<IntLiteralExpr &>(*expr.lhs).value;
+    int64_t rhs = static_cast<IntLiteralExpr &>(*expr.rhs).value;
+    auto intResult = [&](int64_t value) {
+      return ctx_.create<IntLiteralExpr>(value, expr.location);
+    };
+    auto boolResult = [&](bool value) -> ExprPtr {
+      return ctx_.create<BoolLiteralExpr>(value, expr.location);
+    };
+    switch (expr.op) {
+    case BinaryOp::Add:
+      return intResult(folded::add(lhs, rhs));
+    case BinaryOp::Sub:
+      return intResult(folded::sub(lhs, rhs));
+    case BinaryOp::Mul:
+      return intResult(folded::mul(lhs, rhs));
+    case BinaryOp::Div:
+      if (!folded::divTraps(lhs, rhs)) {
+        return intResult(lhs / rhs);
+      }
+      return &expr; // division by zero / MIN / -1: leave for the runtime
+    case BinaryOp::Mod:
+      if (!folded::divTraps(lhs, rhs)) {
+        return intResult(lhs % rhs);
+      }
+      return &expr;
+    case BinaryOp::BitAnd:
+      return intResult(lhs & rhs);
+    case BinaryOp::BitOr:
+      return intResult(lhs | rhs);
+    case BinaryOp::BitXor:
+      return intResult(lhs ^ rhs);
+    case BinaryOp::ShiftLeft:
+      if (rhs >= 0 && rhs < 64) {
+        return intResult(static_cast<int64_t>(
+            static_cast<uint64_t>(lhs) << static_cast<uint64_t>(rhs)));
+      }
+      return &expr;
+    case BinaryOp::ShiftRight:
+      if (rhs >= 0 && rhs < 64) {
+        return intResult(lhs >> rhs);
+      }
+      return &expr;
+    case BinaryOp::Equal:
+      return boolResult(lhs == rhs);
+    case BinaryOp::NotEqual:
+      return boolResult(lhs != rhs);
+    case BinaryOp::Less:
+      return boolResult(lhs < rhs);
+    case BinaryOp::LessEqual:
+      return boolResult(lhs <= rhs);
+    case BinaryOp::Greater:
+      return boolResult(lhs > rhs);
+    case BinaryOp::GreaterEqual:
+      return boolResult(lhs >= rhs);
+    default:
+      return &expr;
+    }
+  }
+
+  // --- Float folding (arithmetic only; comparisons stay runtime to
+  //     preserve NaN semantics decisions for later) ---
+  if (expr.lhs->kind == Expr::Kind::FloatLiteral &&
+      expr.rhs->kind == Expr::Kind::FloatLiteral) {
+    double lhs = static_cast<FloatLiteralExpr &>(*expr.lhs).value;
+    double rhs = static_cast<FloatLiteralExpr &>(*expr.rhs).value;
+    auto floatResult = [&](double value) {
+      return ctx_.create<FloatLiteralExpr>(value, expr.location);
+    };
+    switch (expr.op) {
+    case BinaryOp::Add:
+      return floatResult(lhs + rhs);
+    case BinaryOp::Sub:
+      return floatResult(lhs - rhs);
+    case BinaryOp::Mul:
+      return floatResult(lhs * rhs);
+    case BinaryOp::Div:
+      return floatResult(lhs / rhs);
+    default:
+      return &expr;
+    }
+  }
+
+  // --- Boolean logic ---
+  bool lhsValue, rhsValue;
+  if (isBoolLiteral(*expr.lhs, lhsValue)) {
+    if (expr.op == BinaryOp::And) {
+      // true and x -> x; false and x -> false
+      return lhsValue ? expr.rhs
+                      : ctx_.create<BoolLiteralExpr>(false, expr.location);
+    }
+    if (expr.op == BinaryOp::Or) {
+      return lhsValue ? ctx_.create<BoolLiteralExpr>(true, expr.location)
+                      : expr.rhs;
+    }
+  }
+  if (isBoolLiteral(*expr.lhs, lhsValue) &&
+      isBoolLiteral(*expr.rhs, rhsValue)) {
+    if (expr.op == BinaryOp::Equal) {
+      return ctx_.create<BoolLiteralExpr>(lhsValue == rhsValue,
+                                          expr.location);
+    }
+    if (expr.op == BinaryOp::NotEqual) {
+      return ctx_.create<BoolLiteralExpr>(lhsValue != rhsValue,
+                                          expr.location);
+    }
+  }
+
+  return &expr;
+}
+
+ExprPtr ConstantFolder::foldUnary(UnaryExpr &expr) {
+  expr.operand = foldExpr(expr.operand);
+
+  switch (expr.op) {
+  case UnaryOp::Negate:
+    if (expr.operand->kind == Expr::Kind::IntLiteral) {
+      return ctx_.create<IntLiteralExpr>(
+          folded::negate(static_cast<IntLiteralExpr &>(*expr.operand).value),
+          expr.location);
+    }
+    if (expr.operand->kind == Expr::Kind::FloatLiteral) {
+      return ctx_.create<FloatLiteralExpr>(
+          -static_cast<FloatLiteralExpr &>(*expr.operand).value,
+          expr.location);
+    }
+    break;
+  case UnaryOp::Not: {
+    bool value;
+    if (isBoolLiteral(*expr.operand, value)) {
+      return ctx_.create<BoolLiteralExpr>(!value, expr.location);
+    }
+    break;
+  }
+  case UnaryOp::BitwiseNot:
+    if (expr.operand->kind == Expr::Kind::IntLiteral) {
+      return ctx_.create<IntLiteralExpr>(
+          ~static_cast<IntLiteralExpr &>(*expr.operand).value, expr.location);
+    }
+    break;
+  }
+  return &expr;
+}
+
+bool ConstantFolder::isBoolLiteral(const Expr &expr, bool &value) {
+  if (expr.kind == Expr::Kind::BoolLiteral) {
+    value = static_cast<const BoolLiteralExpr &>(expr).value;
+    return true;
+  }
+  return false;
+}
+
+} // namespace flux
@@ -0,0 +1,203 @@
+#include "flux/Sema/ModuleInterface.h"
+
+#include "flux/Common/SourceLocation.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace flux {
+
+namespace {
+
+constexpr char kMagic[4] = {'F', 'L', 'I', '\x01'};
+constexpr uint32_t kFormatVersion = 1;
+
+// --- Writing primitives ---
+
+void writeU32(std::string &out, uint32_t value) {
+  char bytes[4] = {static_cast<char>(value & 0xFF),
+                   static_cast<char>((value >> 8) & 0xFF),
+                   static_cast<char>((value >> 16) & 0xFF),
+                   static_cast<char>((value >> 24) & 0xFF)};
+  out.append(bytes, 4);
+}
+
+void writeString(std::string &out, const std::string &text) {
+  writeU32(out, static_cast<uint32_t>(text.size()));
+  out.append(text);
+}
+
+void writeStringList(std::string &out, const std::vector<std::string> &list) {
+  writeU32(out, static_cast<uint32_t>(list.size()));
+  for (const auto &item : list) {
+    writeString(out, item);
+  }
+}
+
+// --- Reading primitives (over a mapped buffer; never read past the end) ---
+
+struct Reader {
+  const char *pos;
+  const char *end;
+  bool ok = true;
+
+  uint32_t readU32() {
+    if (end - pos < 4) {
+      ok = false;
+      return 0;
+    }
+    uint32_t value = static_cast<unsigned char>(pos[0]) |
+                     (static_cast<unsigned char>(pos[1]) << 8) |
+                     (static_cast<unsigned char>(pos[2]) << 16) |
+                     (static_cast<unsigned char>(pos[3]) << 24);
+    pos += 4;
+    return value;
+  }
+
+  std::string readString() {
+    uint32_t size = readU32();
+    if (!ok || static_cast<size_t>(end - pos) < size) {
+      ok = false;
+      return {};
+    }
+    std::string result(pos, size);
+    pos += size;
+    return result;
+  }
+
+  std::vector<std::string> readStringList() {
+    std::vector<std::string> result;
+    uint32_t count = readU32();
+    for (uint32_t i = 0; ok && i < count; ++i) {
+      result.push_back(readString());
+    }
+    return result;
+  }
+};
+
+} // anonymous namespace
+
+bool ModuleInterface::write(const std::string &path,
+                            const Scope &globalScope) {
+  std::string buffer;
+  buffer.append(kMagic, 4);
+  writeU32(buffer, kFormatVersion);
+
+  // Only public symbols cross module boundaries. Sort by name so the
+  // file bytes are independent of interning order (symbol IDs vary
+  // under the parallel front end) — interface hashes and content caches
+  // depend on this being deterministic.
+  std::vector<const Symbol *> publicSymbols;
+  for (const auto &[id, sym] : globalScope.symbols) {
+    if (sym.visibility == ast::Decl::Visibility::Public) {
+      publicSymbols.push_back(&sym);
+    }
+  }
+  std::sort(publicSymbols.begin(), publicSymbols.end(),
+            [](const Symbol *a, const Symbol *b) { return a->name < b->name; });
+  writeU32(buffer, static_cast<uint32_t>(publicSymbols.size()));
+
+  for (const Symbol *symPtr : publicSymbols) {
+    const Symbol &sym = *symPtr;
+    writeU32(buffer, static_cast<uint32_t>(sym.kind));
+    writeString(buffer, sym.name);
+    writeString(buffer, sym.qualifiedName);
+    writeString(buffer, sym.typeName);
+    writeString(buffer, sym.returnType);
+    writeStringList(buffer, sym.paramTypes);
+    writeStringList(buffer, sym.genericParams);
+    uint32_t flags = (sym.isMutable ? 1u : 0u) | (sym.isConst ? 2u : 0u) |
+                     (sym.isAsync ? 4u : 0u);
+    writeU32(buffer, flags);
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    return false;
+  }
+  out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  return out.good();
+}
+
+bool ModuleInterface::load(const std::string &path, Scope &scope) {
+  // SourceManager maps the file read-only; the decode below is one
+  // forward pass over the mapping.
+  SourceManager srcMgr;
+  std::string_view data;
+  try {
+    data = srcMgr.getSource(srcMgr.loadFile(path));
+  } catch (const std::exception &) {
+    return false;
+  }
+
+  if (data.size() < 12 || std::memcmp(data.data(), kMagic, 4) != 0) {
+    return false;
+  }
+
+  Reader reader{data.data() + 4, data.data() + data.size()};
+  if (reader.readU32() != kFormatVersion) {
+    return false;
+  }
+
+  uint32_t count = reader.readU32();
+  for (uint32_t i = 0; reader.ok && i < count; ++i) {
+    Symbol sym;
+    sym.kind = static_cast<Symbol::Kind>(reader.readU32());
+    sym.name = reader.readString();
+    sym.qualifiedName = reader.readString();
+    sym.typeName = reader.readString();
+    sym.returnType = reader.readString();
+    sym.paramTypes = reader.readStringList();
+    sym.genericParams = reader.readStringList();
+    uint32_t flags = reader.readU32();
+    sym.isMutable = (flags & 1) != 0;
+    sym.isConst = (flags & 2) != 0;
+    sym.isAsync = (flags & 4) != 0;
+    sym.visibility = ast::Decl::Visibility::Public;
+
+    if (!reader.ok) {
+      return false;
+    }
+    // Ignore collisions with locally declared names; local wins
+    scope.insert(sym.name, std::move(sym));
+  }
+
+  return reader.ok;
+}
+
+std::string ModuleInterface::interfacePathFor(const std::string &sourcePath) {
+  return std::filesystem::path(sourcePath).replace_extension(".fli").string();
+}
+
+std::string ModuleInterface::findInterface(const std::string &moduleName) {
+  std::vector<std::filesystem::path> searchDirs = {"."};
+  if (const char *modulePath = std::getenv("FLUX_MODULE_PATH")) {
+    std::stringstream stream(modulePath);
+    std::string dir;
+#ifdef _WIN32
+    const char separator = ';';
+#else
+    const char separator = ':';
+#endif
+    while (std::getline(stream, dir, separator)) {
+      if (!dir.empty()) {
+        searchDirs.emplace_back(dir);
+      }
+    }
+  }
+
+  for (const auto &dir : searchDirs) {
+    auto candidate = dir / (moduleName + ".fli");
+    std::error_code ec;
+    if (std::filesystem::exists(candidate, ec)) {
+      return candidate.string();
+    }
+  }
+  return {};
+}
+
+} // namespace flux
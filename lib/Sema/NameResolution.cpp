@@ -1,4 +1,6 @@
 #include "flux/Sema/NameResolution.h"
+#include "flux/Common/StringInterner.h"
+#include "flux/Sema/ModuleInterface.h"
 #include "flux/AST/Expr.h"
 #include "flux/AST/Stmt.h"
 
@@ -10,49 +12,112 @@ namespace flux {
 // Scope implementation
 // -----------------------------------------------------------------------
 
-Symbol *Scope::lookup(const std::string &symbolName) {
-  auto it = symbols.find(symbolName);
-  if (it != symbols.end()) {
-    return &it->second;
+Symbol *Scope::lookup(SymbolID id) {
+  if (Symbol *sym = symbols.find(id)) {
+    return sym;
   }
   if (parent) {
-    return parent->lookup(symbolName);
+    return parent->lookup(id);
   }
   return nullptr;
 }
 
-const Symbol *Scope::lookup(const std::string &symbolName) const {
-  auto it = symbols.find(symbolName);
-  if (it != symbols.end()) {
-    return &it->second;
+const Symbol *Scope::lookup(SymbolID id) const {
+  if (const Symbol *sym = symbols.find(id)) {
+    return sym;
   }
   if (parent) {
-    return parent->lookup(symbolName);
+    return parent->lookup(id);
   }
   return nullptr;
 }
 
+Symbol *Scope::lookup(const std::string &symbolName) {
+  return lookup(globalInterner().intern(symbolName));
+}
+
+const Symbol *Scope::lookup(const std::string &symbolName) const {
+  return lookup(globalInterner().intern(symbolName));
+}
+
+bool Scope::insert(SymbolID id, Symbol sym) {
+  return symbols.insert(id, std::move(sym));
+}
+
 bool Scope::insert(const std::string &symbolName, Symbol sym) {
-  auto [it, inserted] = symbols.emplace(symbolName, std::move(sym));
-  return inserted;
+  return insert(globalInterner().intern(symbolName), std::move(sym));
+}
+
+// -----------------------------------------------------------------------
+// DeclIndex
+// -----------------------------------------------------------------------
+
+void DeclIndex::build(ast::Module &module) {
+  for (auto &decl : module.declarations) {
+    std::string_view name;
+    switch (decl->kind) {
+    case ast::Decl::Kind::Func:
+      name = static_cast<ast::FuncDecl &>(*decl).name;
+      break;
+    case ast::Decl::Kind::Struct:
+      name = static_cast<ast::StructDecl &>(*decl).name;
+      break;
+    case ast::Decl::Kind::Class:
+      name = static_cast<ast::ClassDecl &>(*decl).name;
+      break;
+    case ast::Decl::Kind::Enum:
+      name = static_cast<ast::EnumDecl &>(*decl).name;
+      break;
+    case ast::Decl::Kind::Trait:
+      name = static_cast<ast::TraitDecl &>(*decl).name;
+      break;
+    case ast::Decl::Kind::TypeAlias:
+      name = static_cast<ast::TypeAliasDecl &>(*decl).name;
+      break;
+    default:
+      continue; // Module/Import/Impl introduce no top-level name
+    }
+    // First declaration wins; redefinitions are diagnosed by the
+    // registration pass
+    map_.insert(globalInterner().intern(name), decl);
+  }
 }
 
 // -----------------------------------------------------------------------
 // NameResolver implementation
 // -----------------------------------------------------------------------
 
-NameResolver::NameResolver(DiagnosticEngine &diag, Scope &globalScope)
-    : diag_(diag), currentScope_(&globalScope) {}
+NameResolver::NameResolver(DiagnosticEngine &diag, Scope &globalScope,
+                           ScratchArena *scratch)
+    : diag_(diag), currentScope_(&globalScope), scratch_(scratch) {}
 
-void NameResolver::resolve(ast::Module &module) {
-  // First pass: register all top-level declarations (forward declarations)
+void NameResolver::registerAll(ast::Module &module) {
+  // Declaration-index pass: one linear sweep maps every top-level name
+  // to its declaration (and registers its symbol), so forward
+  // references during body resolution never rescan the DeclList
+  declIndex_.build(module);
   for (auto &decl : module.declarations) {
     registerDecl(*decl);
   }
+}
 
-  // Second pass: resolve bodies
+void NameResolver::resolve(ast::Module &module) {
+  registerAll(module);
+
+  // Body pass: single sweep, all names already indexed; scratch state
+  // (local scopes) is rewound between declarations
   for (auto &decl : module.declarations) {
     resolveDecl(*decl);
+    finishTopLevel();
+  }
+}
+
+void NameResolver::finishTopLevel() {
+  currentScope_->children.clear();
+  if (scratch_) {
+    scratch_->reset();
+  } else {
+    ownedScopes_.clear();
   }
 }
 
@@ -108,7 +173,8 @@ void NameResolver::registerDecl(ast::Decl &decl) {
   }
 
   if (!currentScope_->insert(sym.name, sym)) {
-    diag_.emitError(decl.location, "redefinition of '" + sym.name + "'");
+    diag_.report(DiagnosticSeverity::Error, decl.location,
+                 "redefinition of '{0}'", {sym.name});
   }
 }
 
@@ -259,8 +325,8 @@ void NameResolver::resolveExpr(ast::Expr &expr) {
   case ast::Expr::Kind::Ident: {
     auto &ie = static_cast<ast::IdentExpr &>(expr);
     if (!currentScope_->lookup(ie.name)) {
-      diag_.emitError(expr.location,
-                      "use of undeclared identifier '" + ie.name + "'");
+      diag_.report(DiagnosticSeverity::Error, expr.location,
+                   "use of undeclared identifier '{0}'", {ie.name});
     }
     break;
   }
@@ -430,10 +496,15 @@ void NameResolver::resolveExpr(ast::Expr &expr) {
 }
 
 void NameResolver::enterScope(const std::string &name) {
-  auto child = std::make_unique<Scope>(name, currentScope_);
-  auto *raw = child.get();
-  currentScope_->children.push_back(std::move(child));
-  currentScope_ = raw;
+  Scope *child;
+  if (scratch_) {
+    child = scratch_->create<Scope>(name, currentScope_);
+  } else {
+    ownedScopes_.push_back(std::make_unique<Scope>(name, currentScope_));
+    child = ownedScopes_.back().get();
+  }
+  currentScope_->children.push_back(child);
+  currentScope_ = child;
 }
 
 void NameResolver::exitScope() {
@@ -445,8 +516,18 @@ void NameResolver::exitScope() {
 // Private helpers for specific declarations
 // -----------------------------------------------------------------------
 
-void NameResolver::resolveImport(ast::ImportDecl & /*decl*/) {
-  // TODO: cross-module import resolution
+void NameResolver::resolveImport(ast::ImportDecl &decl) {
+  // Bring the imported module's public symbols into scope from its
+  // precompiled interface when one is available; source-level import
+  // resolution stays a fallback for modules without a .fli.
+  if (decl.path.empty()) {
+    return;
+  }
+  std::string interfacePath = ModuleInterface::findInterface(decl.path.back());
+  if (interfacePath.empty()) {
+    return;
+  }
+  ModuleInterface::load(interfacePath, *currentScope_);
 }
 
 void NameResolver::resolveFunc(ast::FuncDecl &decl) {
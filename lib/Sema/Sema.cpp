@@ -1,15 +1,103 @@
 #include "flux/Sema/Sema.h"
 
+#include "flux/Parser/Parser.h"
+#include "flux/Sema/CTFE.h"
+#include "flux/Sema/ConstantFolder.h"
+#include "flux/Common/FilePrefetcher.h"
+#include "flux/Sema/ModuleInterface.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 namespace flux {
 
+namespace {
+
+/// Display name for a top-level declaration (for --time-per-decl).
+std::string declName(const ast::Decl &decl) {
+  switch (decl.kind) {
+  case ast::Decl::Kind::Func:
+    return static_cast<const ast::FuncDecl &>(decl).name;
+  case ast::Decl::Kind::Struct:
+    return static_cast<const ast::StructDecl &>(decl).name;
+  case ast::Decl::Kind::Class:
+    return static_cast<const ast::ClassDecl &>(decl).name;
+  case ast::Decl::Kind::Enum:
+    return static_cast<const ast::EnumDecl &>(decl).name;
+  case ast::Decl::Kind::Trait:
+    return static_cast<const ast::TraitDecl &>(decl).name;
+  case ast::Decl::Kind::TypeAlias:
+    return static_cast<const ast::TypeAliasDecl &>(decl).name;
+  default:
+    return "<decl>";
+  }
+}
+
+} // anonymous namespace
+
 Sema::Sema(DiagnosticEngine &diag) : diag_(diag), globalScope_("global") {}
 
+void Sema::loadImportedInterfaces(const std::vector<std::string> &imports) {
+  // Resolve every interface path first and push the reads into the
+  // background, so the page cache warms for all imports in parallel
+  // while the first ones are decoded
+  std::vector<std::string> interfacePaths;
+  for (const auto &importPath : imports) {
+    // The module name is the trailing path segment
+    auto pos = importPath.rfind("::");
+    std::string name =
+        pos == std::string::npos ? importPath : importPath.substr(pos + 2);
+    std::string interfacePath = ModuleInterface::findInterface(name);
+    if (!interfacePath.empty()) {
+      interfacePaths.push_back(std::move(interfacePath));
+    }
+  }
+
+  if (interfacePaths.size() > 1) {
+    FilePrefetcher prefetcher;
+    for (const auto &path : interfacePaths) {
+      prefetcher.prefetch(path);
+    }
+    for (const auto &path : interfacePaths) {
+      ModuleInterface::load(path, globalScope_);
+    }
+    return; // destructor joins the prefetch workers
+  }
+
+  for (const auto &path : interfacePaths) {
+    ModuleInterface::load(path, globalScope_);
+  }
+}
+
 bool Sema::analyze(ast::Module &module) {
   size_t errorsBefore = diag_.getErrorCount();
 
-  // Phase 1: Name resolution
-  NameResolver resolver(diag_, globalScope_);
-  resolver.resolve(module);
+  // Phase 0: bring precompiled interfaces for imports into scope
+  loadImportedInterfaces(module.imports);
+
+  // Phase 1: Name resolution (local scopes live in the scratch arena)
+  NameResolver resolver(diag_, globalScope_, &scratch_);
+  if (declTimer_) {
+    // Timed mode: drive the per-declaration entry points and attribute
+    // wall time to each top-level declaration
+    resolver.registerAll(module);
+    for (auto &decl : module.declarations) {
+      auto start = std::chrono::steady_clock::now();
+      resolver.resolveTopLevel(*decl);
+      auto end = std::chrono::steady_clock::now();
+      declTimer_->recordSema(
+          declName(*decl), decl->location,
+          static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                    start)
+                  .count()));
+    }
+  } else {
+    resolver.resolve(module);
+  }
 
   if (diag_.getErrorCount() > errorsBefore) {
     return false; // Name resolution errors prevent type checking
@@ -17,9 +105,164 @@ bool Sema::analyze(ast::Module &module) {
 
   // Phase 2: Type checking
   TypeChecker checker(diag_, globalScope_);
-  checker.check(module);
+  if (declTimer_) {
+    for (auto &decl : module.declarations) {
+      auto start = std::chrono::steady_clock::now();
+      checker.checkTopLevel(*decl);
+      auto end = std::chrono::steady_clock::now();
+      declTimer_->recordSema(
+          declName(*decl), decl->location,
+          static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                    start)
+                  .count()));
+    }
+  } else {
+    checker.check(module);
+  }
+
+  if (diag_.getErrorCount() == errorsBefore) {
+    // Phase 3: constant folding / dead-branch pruning before IR emission
+    ConstantFolder::run(module);
+    // Phase 4: compile-time function evaluation of const initializers
+    // (callee lookups answered by the resolver's declaration index)
+    CTFEInterpreter(module, &resolver.declIndex()).run();
+  }
 
   return diag_.getErrorCount() == errorsBefore;
 }
 
-} // namespace flux
\ No newline at end of file
+std::unique_ptr<ast::Module> Sema::analyzePipelined(Parser &parser,
+                                                    unsigned workers) {
+  // Cheap symbol pre-scan: register every top-level name (and load
+  // imported interfaces) up front so declaration bodies can be resolved
+  // out of order while parsing continues.
+  for (auto &name : parser.preScanTopLevelNames()) {
+    // Enum variants are visible across declarations (another worker's
+    // function may reference them before the enum's own worker resolves
+    // it), so they must land in the shared scope up front
+    if (name.keyword == TokenKind::Identifier && !name.parent.empty()) {
+      Symbol sym;
+      sym.name = name.parent + "::" + name.name;
+      sym.kind = Symbol::Kind::EnumVariant;
+      sym.location = name.location;
+      globalScope_.insert(name.name, sym);
+      continue;
+    }
+    if (name.keyword == TokenKind::KwImport) {
+      std::string interfacePath = ModuleInterface::findInterface(name.name);
+      if (!interfacePath.empty()) {
+        ModuleInterface::load(interfacePath, globalScope_);
+      }
+      continue;
+    }
+
+    Symbol sym;
+    sym.name = name.name;
+    sym.location = name.location;
+    sym.visibility = name.isPublic ? ast::Decl::Visibility::Public
+                                   : ast::Decl::Visibility::Private;
+    switch (name.keyword) {
+    case TokenKind::KwFunc:
+      sym.kind = Symbol::Kind::Function;
+      break;
+    case TokenKind::KwStruct:
+      sym.kind = Symbol::Kind::Struct;
+      break;
+    case TokenKind::KwClass:
+      sym.kind = Symbol::Kind::Class;
+      break;
+    case TokenKind::KwEnum:
+      sym.kind = Symbol::Kind::Enum;
+      break;
+    case TokenKind::KwTrait:
+      sym.kind = Symbol::Kind::Trait;
+      break;
+    case TokenKind::KwType:
+      sym.kind = Symbol::Kind::TypeAlias;
+      break;
+    default:
+      continue;
+    }
+    if (!globalScope_.insert(sym.name, sym)) {
+      diag_.emitError(name.location, "redefinition of '" + sym.name + "'");
+    }
+  }
+
+  if (workers == 0) {
+    workers = std::thread::hardware_concurrency();
+  }
+  if (workers == 0) {
+    workers = 1;
+  }
+
+  std::mutex queueMutex;
+  std::condition_variable queueCV;
+  std::deque<ast::DeclPtr> queue;
+  bool parseDone = false;
+
+  // The engine is thread-safe; buffered mode defers dispatch so output
+  // comes out source-ordered after the workers join.
+  diag_.setBuffered(true);
+
+  auto workerFn = [&] {
+    // A worker-local scope chained under the global one, so creating
+    // child scopes never races between workers.
+    Scope workerScope("worker", &globalScope_);
+    ScratchArena workerScratch;
+    NameResolver resolver(diag_, workerScope, &workerScratch);
+    TypeChecker checker(diag_, globalScope_);
+
+    for (;;) {
+      ast::DeclPtr decl = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        queueCV.wait(lock, [&] { return parseDone || !queue.empty(); });
+        if (queue.empty()) {
+          return; // parseDone and drained
+        }
+        decl = queue.front();
+        queue.pop_front();
+      }
+      resolver.resolveTopLevel(*decl);
+      checker.checkTopLevel(*decl);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned i = 0; i < workers; ++i) {
+    pool.emplace_back(workerFn);
+  }
+
+  // Parse on this thread, feeding completed declarations to the pool
+  auto module = parser.parseModule([&](ast::DeclPtr decl) {
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      queue.push_back(decl);
+    }
+    queueCV.notify_one();
+  });
+
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    parseDone = true;
+  }
+  queueCV.notify_all();
+  for (auto &thread : pool) {
+    thread.join();
+  }
+
+  diag_.setBuffered(false);
+  diag_.flush();
+
+  // Folding mutates the shared arena, so it runs single-threaded after
+  // the workers drain
+  if (!diag_.hasErrors()) {
+    ConstantFolder::run(*module);
+    CTFEInterpreter(*module).run();
+  }
+
+  return module;
+}
+
+} // namespace flux
@@ -1,5 +1,7 @@
 #include "flux/Sema/TypeChecker.h"
 
+#include "flux/Common/StringInterner.h"
+
 #include <cassert>
 
 namespace flux {
@@ -11,50 +13,65 @@ TypeChecker::TypeChecker(DiagnosticEngine &diag, const Scope &scope)
 
 void TypeChecker::registerBuiltinTypes() {
   // Primitive types from the Flux spec
-  knownTypes_.insert("Int8");
-  knownTypes_.insert("Int16");
-  knownTypes_.insert("Int32");
-  knownTypes_.insert("Int64");
-  knownTypes_.insert("UInt8");
-  knownTypes_.insert("UInt16");
-  knownTypes_.insert("UInt32");
-  knownTypes_.insert("UInt64");
-  knownTypes_.insert("Float32");
-  knownTypes_.insert("Float64");
-  knownTypes_.insert("Bool");
-  knownTypes_.insert("Char");
-  knownTypes_.insert("String");
-  knownTypes_.insert("Void");
-
-  // Common standard library types
-  knownTypes_.insert("Option");
-  knownTypes_.insert("Result");
-  knownTypes_.insert("Vec");
-  knownTypes_.insert("Map");
-  knownTypes_.insert("Set");
-  knownTypes_.insert("Box");
-  knownTypes_.insert("Rc");
-  knownTypes_.insert("Arc");
-  knownTypes_.insert("Mutex");
-  knownTypes_.insert("Channel");
-  knownTypes_.insert("Future");
+  static const char *kPrimitives[] = {
+      "Int8",   "Int16",   "Int32",   "Int64", "UInt8", "UInt16", "UInt32",
+      "UInt64", "Float32", "Float64", "Bool",  "Char",  "String", "Void",
+  };
+  for (const char *name : kPrimitives) {
+    knownTypes_.insert(globalInterner().intern(name));
+  }
+
+  // Built-in generic containers
+  static const char *kContainers[] = {
+      "Option", "Result", "Vec",   "Map",     "Set",    "Box",
+      "Rc",     "Arc",    "Mutex", "Channel", "Future",
+  };
+  for (const char *name : kContainers) {
+    knownTypes_.insert(globalInterner().intern(name));
+  }
+
+  // Canonical instances the checker compares against constantly
+  int64Type_ = typeCtx_.getNamed("Int64");
+  float64Type_ = typeCtx_.getNamed("Float64");
+  float32Type_ = typeCtx_.getNamed("Float32");
+  boolType_ = typeCtx_.getNamed("Bool");
+  stringType_ = typeCtx_.getNamed("String");
+  charType_ = typeCtx_.getNamed("Char");
+  voidType_ = typeCtx_.getNamed("Void");
+
+  for (const char *name : {"Int8", "Int16", "Int32", "Int64", "UInt8",
+                           "UInt16", "UInt32", "UInt64"}) {
+    integerTypes_.insert(typeCtx_.getNamed(name));
+  }
 }
 
-void TypeChecker::check(ast::Module &module) {
+void TypeChecker::registerScopeTypes() {
   // Register user-defined types from the scope
-  for (auto &[name, sym] : scope_.symbols) {
+  for (auto &[id, sym] : scope_.symbols) {
     if (sym.kind == Symbol::Kind::Struct || sym.kind == Symbol::Kind::Class ||
         sym.kind == Symbol::Kind::Enum || sym.kind == Symbol::Kind::Trait ||
         sym.kind == Symbol::Kind::TypeAlias) {
-      knownTypes_.insert(name);
+      knownTypes_.insert(id);
     }
   }
+}
+
+void TypeChecker::check(ast::Module &module) {
+  registerScopeTypes();
 
   for (auto &decl : module.declarations) {
     checkDecl(*decl);
   }
 }
 
+void TypeChecker::checkTopLevel(ast::Decl &decl) {
+  if (!scopeTypesRegistered_) {
+    registerScopeTypes();
+    scopeTypesRegistered_ = true;
+  }
+  checkDecl(decl);
+}
+
 void TypeChecker::checkDecl(ast::Decl &decl) {
   switch (decl.kind) {
   case ast::Decl::Kind::Func:
@@ -80,25 +97,46 @@ void TypeChecker::checkDecl(ast::Decl &decl) {
   }
 }
 
+namespace {
+
+/// Cheap size metric: node count of a function body.
+struct SizeCounter : ast::ASTWalker<SizeCounter> {
+  using Base = ast::ASTWalker<SizeCounter>;
+  uint32_t count = 0;
+  void walkStmt(ast::Stmt &stmt) { ++count; Base::walkStmt(stmt); }
+  void walkExpr(ast::Expr &expr) { ++count; Base::walkExpr(expr); }
+};
+
+} // anonymous namespace
+
 void TypeChecker::checkFuncDecl(ast::FuncDecl &decl) {
+  // Size metric for the inline cost model (consumed by IREmitter)
+  if (decl.body) {
+    SizeCounter counter;
+    counter.walkStmt(*decl.body);
+    decl.bodySize = counter.count;
+  }
+
   // Validate return type
   if (decl.returnType) {
-    std::string retType = typeToString(*decl.returnType);
+    const Type *retType = canonicalType(*decl.returnType);
     if (!isValidType(retType)) {
-      diag_.emitError(decl.location, "unknown return type '" + retType +
+      diag_.emitError(decl.location, "unknown return type '" +
+                                         retType->toString() +
                                          "' in function '" + decl.name + "'");
     }
     currentReturnType_ = retType;
   } else {
-    currentReturnType_ = "Void";
+    currentReturnType_ = voidType_;
   }
 
   // Validate parameter types
   for (auto &param : decl.params) {
     if (param.type) {
-      std::string paramType = typeToString(*param.type);
+      const Type *paramType = canonicalType(*param.type);
       if (!isValidType(paramType)) {
-        diag_.emitError(decl.location, "unknown parameter type '" + paramType +
+        diag_.emitError(decl.location, "unknown parameter type '" +
+                                           paramType->toString() +
                                            "' for parameter '" + param.name +
                                            "'");
       }
@@ -116,15 +154,16 @@ void TypeChecker::checkFuncDecl(ast::FuncDecl &decl) {
     }
   }
 
-  currentReturnType_.clear();
+  currentReturnType_ = nullptr;
 }
 
 void TypeChecker::checkStructDecl(ast::StructDecl &decl) {
   for (auto &field : decl.fields) {
     if (field.type) {
-      std::string fieldType = typeToString(*field.type);
+      const Type *fieldType = canonicalType(*field.type);
       if (!isValidType(fieldType)) {
-        diag_.emitError(decl.location, "unknown field type '" + fieldType +
+        diag_.emitError(decl.location, "unknown field type '" +
+                                           fieldType->toString() +
                                            "' for field '" + field.name +
                                            "' in struct '" + decl.name + "'");
       }
@@ -135,9 +174,10 @@ void TypeChecker::checkStructDecl(ast::StructDecl &decl) {
 void TypeChecker::checkClassDecl(ast::ClassDecl &decl) {
   for (auto &field : decl.fields) {
     if (field.type) {
-      std::string fieldType = typeToString(*field.type);
+      const Type *fieldType = canonicalType(*field.type);
       if (!isValidType(fieldType)) {
-        diag_.emitError(decl.location, "unknown field type '" + fieldType +
+        diag_.emitError(decl.location, "unknown field type '" +
+                                           fieldType->toString() +
                                            "' for field '" + field.name +
                                            "' in class '" + decl.name + "'");
       }
@@ -153,9 +193,9 @@ void TypeChecker::checkEnumDecl(ast::EnumDecl &decl) {
     // Check tuple field types
     for (auto &fieldType : variant.tupleFields) {
       if (fieldType) {
-        std::string ft = typeToString(*fieldType);
+        const Type *ft = canonicalType(*fieldType);
         if (!isValidType(ft)) {
-          diag_.emitError(decl.location, "unknown type '" + ft +
+          diag_.emitError(decl.location, "unknown type '" + ft->toString() +
                                              "' in enum variant '" +
                                              variant.name + "'");
         }
@@ -164,9 +204,10 @@ void TypeChecker::checkEnumDecl(ast::EnumDecl &decl) {
     // Check struct field types
     for (auto &field : variant.structFields) {
       if (field.type) {
-        std::string fieldType = typeToString(*field.type);
+        const Type *fieldType = canonicalType(*field.type);
         if (!isValidType(fieldType)) {
-          diag_.emitError(decl.location, "unknown type '" + fieldType +
+          diag_.emitError(decl.location, "unknown type '" +
+                                             fieldType->toString() +
                                              "' in enum variant '" +
                                              variant.name + "'");
         }
@@ -191,49 +232,22 @@ void TypeChecker::checkImplDecl(ast::ImplDecl &decl) {
 // Statement checking
 // -----------------------------------------------------------------------
 
-void TypeChecker::checkStmt(ast::Stmt &stmt) {
-  switch (stmt.kind) {
-  case ast::Stmt::Kind::Let:
-    checkLetStmt(static_cast<ast::LetStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::Return:
-    checkReturnStmt(static_cast<ast::ReturnStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::If:
-    checkIfStmt(static_cast<ast::IfStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::For:
-    checkForStmt(static_cast<ast::ForStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::While:
-    checkWhileStmt(static_cast<ast::WhileStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::Block:
-    checkBlockStmt(static_cast<ast::BlockStmt &>(stmt));
-    break;
-  case ast::Stmt::Kind::Expr: {
-    auto &es = static_cast<ast::ExprStmt &>(stmt);
-    checkExpr(*es.expression);
-    break;
-  }
-  default:
-    break;
-  }
-}
+void TypeChecker::checkStmt(ast::Stmt &stmt) { walkStmt(stmt); }
 
 void TypeChecker::checkLetStmt(ast::LetStmt &stmt) {
   // Flux requires explicit type annotations
   if (stmt.type) {
-    std::string declType = typeToString(*stmt.type);
+    const Type *declType = canonicalType(*stmt.type);
     if (!isValidType(declType)) {
-      diag_.emitError(stmt.location,
-                      "unknown type '" + declType + "' in let binding");
+      diag_.emitError(stmt.location, "unknown type '" + declType->toString() +
+                                         "' in let binding");
     }
     if (stmt.initializer) {
-      std::string initType = checkExpr(*stmt.initializer);
-      if (!initType.empty() && !typesCompatible(declType, initType)) {
-        diag_.emitError(stmt.location, "type mismatch: expected '" + declType +
-                                           "', got '" + initType + "'");
+      const Type *initType = checkExpr(*stmt.initializer);
+      if (initType && !typesCompatible(declType, initType)) {
+        diag_.emitError(stmt.location, "type mismatch: expected '" +
+                                           declType->toString() + "', got '" +
+                                           initType->toString() + "'");
       }
     }
   } else {
@@ -245,25 +259,26 @@ void TypeChecker::checkLetStmt(ast::LetStmt &stmt) {
 
 void TypeChecker::checkReturnStmt(ast::ReturnStmt &stmt) {
   if (stmt.value) {
-    std::string retType = checkExpr(*stmt.value);
-    if (!currentReturnType_.empty() && !retType.empty() &&
+    const Type *retType = checkExpr(*stmt.value);
+    if (currentReturnType_ && retType &&
         !typesCompatible(currentReturnType_, retType)) {
       diag_.emitError(stmt.location, "return type mismatch: expected '" +
-                                         currentReturnType_ + "', got '" +
-                                         retType + "'");
+                                         currentReturnType_->toString() +
+                                         "', got '" + retType->toString() +
+                                         "'");
     }
   } else {
-    if (!currentReturnType_.empty() && currentReturnType_ != "Void") {
+    if (currentReturnType_ && currentReturnType_ != voidType_) {
       diag_.emitError(stmt.location, "non-void function must return a value");
     }
   }
 }
 
 void TypeChecker::checkIfStmt(ast::IfStmt &stmt) {
-  std::string condType = checkExpr(*stmt.condition);
-  if (!condType.empty() && condType != "Bool") {
-    diag_.emitError(stmt.location,
-                    "condition must be of type 'Bool', got '" + condType + "'");
+  const Type *condType = checkExpr(*stmt.condition);
+  if (condType && condType != boolType_) {
+    diag_.emitError(stmt.location, "condition must be of type 'Bool', got '" +
+                                       condType->toString() + "'");
   }
   checkStmt(*stmt.thenBranch);
   if (stmt.elseBranch) {
@@ -277,10 +292,10 @@ void TypeChecker::checkForStmt(ast::ForStmt &stmt) {
 }
 
 void TypeChecker::checkWhileStmt(ast::WhileStmt &stmt) {
-  std::string condType = checkExpr(*stmt.condition);
-  if (!condType.empty() && condType != "Bool") {
-    diag_.emitError(stmt.location,
-                    "condition must be of type 'Bool', got '" + condType + "'");
+  const Type *condType = checkExpr(*stmt.condition);
+  if (condType && condType != boolType_) {
+    diag_.emitError(stmt.location, "condition must be of type 'Bool', got '" +
+                                       condType->toString() + "'");
   }
   checkStmt(*stmt.body);
 }
@@ -295,18 +310,18 @@ void TypeChecker::checkBlockStmt(ast::BlockStmt &stmt) {
 // Expression checking
 // -----------------------------------------------------------------------
 
-std::string TypeChecker::checkExpr(ast::Expr &expr) {
+const Type *TypeChecker::checkExpr(ast::Expr &expr) {
   switch (expr.kind) {
   case ast::Expr::Kind::IntLiteral:
-    return "Int64";
+    return int64Type_;
   case ast::Expr::Kind::FloatLiteral:
-    return "Float64";
+    return float64Type_;
   case ast::Expr::Kind::StringLiteral:
-    return "String";
+    return stringType_;
   case ast::Expr::Kind::CharLiteral:
-    return "Char";
+    return charType_;
   case ast::Expr::Kind::BoolLiteral:
-    return "Bool";
+    return boolType_;
   case ast::Expr::Kind::Ident:
     return checkIdentExpr(static_cast<ast::IdentExpr &>(expr));
   case ast::Expr::Kind::Binary:
@@ -314,13 +329,13 @@ std::string TypeChecker::checkExpr(ast::Expr &expr) {
   case ast::Expr::Kind::Call:
     return checkCallExpr(static_cast<ast::CallExpr &>(expr));
   default:
-    return ""; // Unknown for now
+    return nullptr; // Unknown for now
   }
 }
 
-std::string TypeChecker::checkBinaryExpr(ast::BinaryExpr &expr) {
-  std::string lhsType = checkExpr(*expr.lhs);
-  std::string rhsType = checkExpr(*expr.rhs);
+const Type *TypeChecker::checkBinaryExpr(ast::BinaryExpr &expr) {
+  const Type *lhsType = checkExpr(*expr.lhs);
+  const Type *rhsType = checkExpr(*expr.rhs);
 
   // Comparison and logical ops return Bool
   switch (expr.op) {
@@ -332,104 +347,94 @@ std::string TypeChecker::checkBinaryExpr(ast::BinaryExpr &expr) {
   case ast::BinaryOp::GreaterEqual:
   case ast::BinaryOp::And:
   case ast::BinaryOp::Or:
-    return "Bool";
+    return boolType_;
   default:
     break;
   }
 
   // Arithmetic ops — both sides should match
-  if (!lhsType.empty() && !rhsType.empty() &&
-      !typesCompatible(lhsType, rhsType)) {
+  if (lhsType && rhsType && !typesCompatible(lhsType, rhsType)) {
     diag_.emitError(expr.location, "binary expression type mismatch: '" +
-                                       lhsType + "' vs '" + rhsType + "'");
+                                       lhsType->toString() + "' vs '" +
+                                       rhsType->toString() + "'");
   }
-  return lhsType.empty() ? rhsType : lhsType;
+  return lhsType ? lhsType : rhsType;
 }
 
-std::string TypeChecker::checkCallExpr(ast::CallExpr &expr) {
+const Type *TypeChecker::checkCallExpr(ast::CallExpr &expr) {
   checkExpr(*expr.callee);
   for (auto &arg : expr.arguments) {
     checkExpr(*arg);
   }
   // Full overload resolution would go here
-  return "";
+  return nullptr;
 }
 
-std::string TypeChecker::checkIdentExpr(ast::IdentExpr &expr) {
+const Type *TypeChecker::checkIdentExpr(ast::IdentExpr &expr) {
   auto *sym = scope_.lookup(expr.name);
   if (sym && !sym->typeName.empty()) {
-    return sym->typeName;
+    return typeCtx_.getNamed(sym->typeName);
   }
-  return "";
+  return nullptr;
 }
 
 // -----------------------------------------------------------------------
 // Type utilities
 // -----------------------------------------------------------------------
 
-bool TypeChecker::isValidType(const std::string &typeName) const {
-  return knownTypes_.count(typeName) > 0;
+const Type *TypeChecker::canonicalType(const ast::TypeNode &node) {
+  return typeCtx_.canonicalize(node);
+}
+
+bool TypeChecker::isValidType(const Type *type) const {
+  // Canonical identity makes this a perfect memoization key: the 500th
+  // use of Vec<Int64> is one hash lookup, not a re-validation.
+  auto it = instantiationCache_.find(type);
+  if (it != instantiationCache_.end()) {
+    return it->second;
+  }
+  bool valid = computeTypeValidity(type);
+  instantiationCache_.emplace(type, valid);
+  return valid;
 }
 
-bool TypeChecker::typesCompatible(const std::string &expected,
-                                  const std::string &actual) const {
+bool TypeChecker::computeTypeValidity(const Type *type) const {
+  switch (type->kind()) {
+  case Type::Kind::Named:
+    return knownTypes_.count(type->name()) > 0;
+  case Type::Kind::Generic:
+    if (knownTypes_.count(type->name()) == 0) {
+      return false;
+    }
+    break;
+  default:
+    break;
+  }
+  for (const Type *param : type->params()) {
+    if (!isValidType(param)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TypeChecker::typesCompatible(const Type *expected,
+                                  const Type *actual) const {
+  // Canonicalization makes structural equality a pointer compare
   if (expected == actual)
     return true;
 
   // Integer literal type (Int64) is compatible with any integer type
-  if (actual == "Int64" &&
-      (expected == "Int8" || expected == "Int16" || expected == "Int32" ||
-       expected == "UInt8" || expected == "UInt16" || expected == "UInt32" ||
-       expected == "UInt64")) {
+  if (actual == int64Type_ && integerTypes_.count(expected) > 0) {
     return true;
   }
 
   // Float literal type (Float64) is compatible with Float32
-  if (actual == "Float64" && expected == "Float32") {
+  if (actual == float64Type_ && expected == float32Type_) {
     return true;
   }
 
   return false;
 }
 
-std::string TypeChecker::typeToString(const ast::TypeNode &type) const {
-  switch (type.kind) {
-  case ast::TypeNode::Kind::Named: {
-    auto &nt = static_cast<const ast::NamedType &>(type);
-    std::string result;
-    for (size_t i = 0; i < nt.path.size(); ++i) {
-      if (i > 0)
-        result += "::";
-      result += nt.path[i];
-    }
-    return result;
-  }
-  case ast::TypeNode::Kind::Generic: {
-    auto &gt = static_cast<const ast::GenericType &>(type);
-    return typeToString(*gt.base);
-  }
-  case ast::TypeNode::Kind::Reference:
-    return "&" +
-           typeToString(*static_cast<const ast::ReferenceType &>(type).inner);
-  case ast::TypeNode::Kind::MutRef:
-    return "&mut " +
-           typeToString(*static_cast<const ast::MutRefType &>(type).inner);
-  case ast::TypeNode::Kind::Array:
-    return "[" +
-           typeToString(
-               *static_cast<const ast::ArrayType &>(type).elementType) +
-           "]";
-  case ast::TypeNode::Kind::Option:
-    return "Option";
-  case ast::TypeNode::Kind::Result:
-    return "Result";
-  case ast::TypeNode::Kind::Tuple:
-    return "(tuple)";
-  case ast::TypeNode::Kind::Function:
-    return "(func)";
-  default:
-    return "<unknown>";
-  }
-}
-
 } // namespace flux
@@ -0,0 +1,135 @@
+#include "flux/Sema/TypeContext.h"
+
+namespace flux {
+
+std::string Type::toString() const {
+  switch (kind_) {
+  case Kind::Named:
+    return std::string(globalInterner().text(name_));
+  case Kind::Generic: {
+    std::string result(globalInterner().text(name_));
+    result += '<';
+    for (size_t i = 0; i < params_.size(); ++i) {
+      if (i > 0)
+        result += ", ";
+      result += params_[i]->toString();
+    }
+    result += '>';
+    return result;
+  }
+  case Kind::Reference:
+    return "&" + params_[0]->toString();
+  case Kind::MutRef:
+    return "&mut " + params_[0]->toString();
+  case Kind::Tuple: {
+    std::string result = "(";
+    for (size_t i = 0; i < params_.size(); ++i) {
+      if (i > 0)
+        result += ", ";
+      result += params_[i]->toString();
+    }
+    result += ')';
+    return result;
+  }
+  case Kind::Function: {
+    std::string result = "(";
+    for (size_t i = 0; i + 1 < params_.size(); ++i) {
+      if (i > 0)
+        result += ", ";
+      result += params_[i]->toString();
+    }
+    result += ") -> ";
+    result += params_.back()->toString();
+    return result;
+  }
+  case Kind::Array:
+    return "[" + params_[0]->toString() + "]";
+  }
+  return "<unknown>";
+}
+
+const Type *TypeContext::get(Type::Kind kind, SymbolID name,
+                             std::vector<const Type *> params) {
+  Key key{kind, name, params};
+  auto it = types_.find(key);
+  if (it != types_.end()) {
+    return it->second.get();
+  }
+
+  auto type = std::unique_ptr<Type>(new Type(kind, name, std::move(params)));
+  const Type *result = type.get();
+  types_.emplace(std::move(key), std::move(type));
+  return result;
+}
+
+const Type *TypeContext::getNamed(std::string_view name) {
+  return getNamed(globalInterner().intern(name));
+}
+
+const Type *TypeContext::getNamed(SymbolID name) {
+  return get(Type::Kind::Named, name);
+}
+
+const Type *TypeContext::canonicalize(const ast::TypeNode &node) {
+  switch (node.kind) {
+  case ast::TypeNode::Kind::Named: {
+    auto &named = static_cast<const ast::NamedType &>(node);
+    std::string joined;
+    for (size_t i = 0; i < named.path.size(); ++i) {
+      if (i > 0)
+        joined += "::";
+      joined += named.path[i];
+    }
+    return getNamed(joined);
+  }
+  case ast::TypeNode::Kind::Generic: {
+    auto &generic = static_cast<const ast::GenericType &>(node);
+    std::vector<const Type *> args;
+    args.reserve(generic.typeArguments.size());
+    for (const auto &arg : generic.typeArguments) {
+      args.push_back(canonicalize(*arg));
+    }
+    const Type *base = canonicalize(*generic.base);
+    return get(Type::Kind::Generic, base->name(), std::move(args));
+  }
+  case ast::TypeNode::Kind::Reference: {
+    auto &ref = static_cast<const ast::ReferenceType &>(node);
+    return get(Type::Kind::Reference, kInvalidSymbolID,
+               {canonicalize(*ref.inner)});
+  }
+  case ast::TypeNode::Kind::MutRef: {
+    auto &ref = static_cast<const ast::MutRefType &>(node);
+    return get(Type::Kind::MutRef, kInvalidSymbolID,
+               {canonicalize(*ref.inner)});
+  }
+  case ast::TypeNode::Kind::Tuple: {
+    auto &tuple = static_cast<const ast::TupleType &>(node);
+    std::vector<const Type *> elements;
+    elements.reserve(tuple.elements.size());
+    for (const auto &element : tuple.elements) {
+      elements.push_back(canonicalize(*element));
+    }
+    return get(Type::Kind::Tuple, kInvalidSymbolID, std::move(elements));
+  }
+  case ast::TypeNode::Kind::Function: {
+    auto &func = static_cast<const ast::FunctionType &>(node);
+    std::vector<const Type *> params;
+    params.reserve(func.paramTypes.size() + 1);
+    for (const auto &param : func.paramTypes) {
+      params.push_back(canonicalize(*param));
+    }
+    params.push_back(func.returnType ? canonicalize(*func.returnType)
+                                     : getNamed("Void"));
+    return get(Type::Kind::Function, kInvalidSymbolID, std::move(params));
+  }
+  case ast::TypeNode::Kind::Array: {
+    auto &array = static_cast<const ast::ArrayType &>(node);
+    return get(Type::Kind::Array, kInvalidSymbolID,
+               {canonicalize(*array.elementType)});
+  }
+  default:
+    return getNamed("<unknown>");
+  }
+}
+
+} // namespace flux
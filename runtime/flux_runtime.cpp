@@ -1,8 +1,295 @@
 #include "flux_runtime.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <charconv>
+#include <chrono>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <mutex>
+
+#if defined(__SSE2__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+#define FLUX_RT_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define FLUX_RT_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef _WIN32
+// File mappings in the I/O section below use the Win32 API directly
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------
+// Instrumentation
+// -----------------------------------------------------------------------
+//
+// Counters are plain thread-local increments (no atomics, no locks).
+// Probes append fixed-size events into a per-thread ring buffer; a
+// registry tracks all live rings so flux_trace_flush can merge them.
+// Target overhead is a couple of stores per probe, cheap enough to
+// leave on in production.
+
+namespace {
+
+struct TraceEvent {
+  uint32_t idAndFlag; // function ID; high bit set on exit
+  uint64_t timestamp; // steady-clock nanoseconds
+};
+
+constexpr size_t kTraceRingEvents = 64 * 1024;
+
+struct ThreadTrace {
+  std::vector<TraceEvent> ring = std::vector<TraceEvent>(kTraceRingEvents);
+  size_t head = 0;    // next write slot
+  bool wrapped = false;
+  FluxThreadCounters counters{0, 0, 0};
+};
+
+std::mutex traceRegistryMutex;
+std::vector<ThreadTrace *> traceRegistry;
+
+ThreadTrace &threadTrace() {
+  thread_local ThreadTrace *trace = [] {
+    auto *fresh = new ThreadTrace();
+    std::lock_guard<std::mutex> lock(traceRegistryMutex);
+    traceRegistry.push_back(fresh);
+    return fresh;
+  }();
+  return *trace;
+}
+
+std::mutex probeNamesMutex;
+std::vector<std::string> probeNames; // index = ID - 1
+
+uint64_t traceNow() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/// With FLUX_TRACE=<path> set, the rings flush there at process exit,
+/// closing the loop from --instrument-functions to flux-order without
+/// any code in the traced program.
+struct TraceFlushAtExit {
+  TraceFlushAtExit() {
+    std::atexit([] {
+      if (const char *path = std::getenv("FLUX_TRACE")) {
+        if (path[0] != '\0') {
+          flux_trace_flush(path);
+        }
+      }
+    });
+  }
+} traceFlushAtExit;
+
+void recordProbe(uint32_t idAndFlag) {
+  ThreadTrace &trace = threadTrace();
+  trace.ring[trace.head] = {idAndFlag, traceNow()};
+  if (++trace.head == kTraceRingEvents) {
+    trace.head = 0;
+    trace.wrapped = true;
+  }
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+void flux_thread_counters(FluxThreadCounters *out) {
+  *out = threadTrace().counters;
+}
+
+uint32_t flux_probe_register(const char *name) {
+  std::lock_guard<std::mutex> lock(probeNamesMutex);
+  for (size_t i = 0; i < probeNames.size(); ++i) {
+    if (probeNames[i] == name) {
+      return static_cast<uint32_t>(i + 1);
+    }
+  }
+  probeNames.emplace_back(name);
+  return static_cast<uint32_t>(probeNames.size());
+}
+
+void flux_probe_enter(uint32_t functionID) {
+  recordProbe(functionID & 0x7FFFFFFFu);
+}
+
+void flux_probe_exit(uint32_t functionID) {
+  recordProbe(functionID | 0x80000000u);
+}
+
+bool flux_trace_flush(const char *path) {
+  std::FILE *out = std::fopen(path, "wb");
+  if (!out) {
+    return false;
+  }
+  std::fwrite("FTR\x01", 1, 4, out);
+
+  // Name table: u32 count, then u32 length + bytes per name
+  {
+    std::lock_guard<std::mutex> lock(probeNamesMutex);
+    uint32_t count = static_cast<uint32_t>(probeNames.size());
+    std::fwrite(&count, sizeof(count), 1, out);
+    for (const auto &name : probeNames) {
+      uint32_t size = static_cast<uint32_t>(name.size());
+      std::fwrite(&size, sizeof(size), 1, out);
+      std::fwrite(name.data(), 1, name.size(), out);
+    }
+  }
+
+  // Events, oldest first per ring
+  std::lock_guard<std::mutex> lock(traceRegistryMutex);
+  for (ThreadTrace *trace : traceRegistry) {
+    size_t begin = trace->wrapped ? trace->head : 0;
+    size_t count = trace->wrapped ? kTraceRingEvents : trace->head;
+    for (size_t i = 0; i < count; ++i) {
+      const TraceEvent &event =
+          trace->ring[(begin + i) % kTraceRingEvents];
+      std::fwrite(&event.idAndFlag, sizeof(event.idAndFlag), 1, out);
+      std::fwrite(&event.timestamp, sizeof(event.timestamp), 1, out);
+    }
+    trace->head = 0;
+    trace->wrapped = false;
+  }
+
+  std::fclose(out);
+  return true;
+}
+
+} // extern "C"
+
+// -----------------------------------------------------------------------
+// Size-classed pool allocator
+// -----------------------------------------------------------------------
+//
+// flux_alloc serves small requests from thread-local free lists carved
+// out of 64 KiB slabs — no lock, no global-heap contention on the hot
+// path. Each block carries a 16-byte header recording its size class so
+// flux_free can return it to the freeing thread's list (blocks may
+// migrate between threads; slabs are never returned to the OS).
+// Requests above the largest class fall through to malloc.
+
+namespace {
+
+constexpr size_t kSizeClasses[] = {16, 32, 48, 64, 96, 128, 192, 256,
+                                   384, 512};
+constexpr size_t kNumClasses = sizeof(kSizeClasses) / sizeof(kSizeClasses[0]);
+constexpr uint64_t kLargeClass = ~0ull;
+constexpr size_t kHeaderSize = 16; // keeps user blocks 16-aligned
+constexpr size_t kSlabSize = 64 * 1024;
+
+struct BlockHeader {
+  uint64_t sizeClass; // index into kSizeClasses, or kLargeClass
+  uint64_t unused;    // pad to 16 bytes
+};
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+struct ThreadPools {
+  FreeBlock *freeLists[kNumClasses] = {};
+};
+
+thread_local ThreadPools threadPools;
+
+// Cumulative, process-wide counters
+std::atomic<uint64_t> statTotalAllocations{0};
+std::atomic<uint64_t> statTotalFrees{0};
+std::atomic<uint64_t> statPooledAllocations{0};
+std::atomic<uint64_t> statBytesRequested{0};
+std::atomic<uint64_t> statSlabBytes{0};
+
+size_t classForSize(size_t size) {
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    if (size <= kSizeClasses[i]) {
+      return i;
+    }
+  }
+  return kNumClasses; // too big for the pools
+}
+
+/// Carve a fresh slab into blocks for one class and thread them onto
+/// the caller's free list.
+void refillClass(size_t classIndex) {
+  size_t blockSize = kHeaderSize + kSizeClasses[classIndex];
+  char *slab = static_cast<char *>(std::malloc(kSlabSize));
+  if (!slab) {
+    return;
+  }
+  statSlabBytes.fetch_add(kSlabSize, std::memory_order_relaxed);
+
+  size_t count = kSlabSize / blockSize;
+  FreeBlock *head = threadPools.freeLists[classIndex];
+  for (size_t i = 0; i < count; ++i) {
+    char *block = slab + i * blockSize;
+    reinterpret_cast<BlockHeader *>(block)->sizeClass = classIndex;
+    auto *freeBlock = reinterpret_cast<FreeBlock *>(block + kHeaderSize);
+    freeBlock->next = head;
+    head = freeBlock;
+  }
+  threadPools.freeLists[classIndex] = head;
+}
+
+} // anonymous namespace
+
+// -----------------------------------------------------------------------
+// Buffered stdout
+// -----------------------------------------------------------------------
+//
+// Print calls append into a 64 KiB buffer and hit the OS once per buffer
+// instead of once per value. The buffer flushes when full, on
+// flux_flush, at process exit, and before a panic so output ordering
+// stays sane.
+
+namespace {
+
+constexpr size_t kOutBufferSize = 64 * 1024;
+
+char outBuffer[kOutBufferSize];
+size_t outBufferUsed = 0;
+std::mutex outMutex;
+
+// Must be called with outMutex held
+void flushLocked() {
+  if (outBufferUsed > 0) {
+    std::fwrite(outBuffer, 1, outBufferUsed, stdout);
+    std::fflush(stdout);
+    outBufferUsed = 0;
+  }
+}
+
+// Must be called with outMutex held
+void writeLocked(const char *data, size_t size) {
+  if (size >= kOutBufferSize) {
+    // Oversized writes bypass the buffer (keeping order)
+    flushLocked();
+    std::fwrite(data, 1, size, stdout);
+    std::fflush(stdout);
+    return;
+  }
+  if (outBufferUsed + size > kOutBufferSize) {
+    flushLocked();
+  }
+  std::memcpy(outBuffer + outBufferUsed, data, size);
+  outBufferUsed += size;
+}
+
+// Flush whatever is buffered when the process exits
+struct FlushAtExit {
+  FlushAtExit() { std::atexit([] { flux_flush(); }); }
+} flushAtExit;
+
+} // anonymous namespace
 
 extern "C" {
 
@@ -10,15 +297,54 @@ extern "C" {
 // Panic & abort
 // -----------------------------------------------------------------------
 
-[[noreturn]]
+// All panic machinery lives in the unlikely/cold section so the hot
+// paths that branch to it never pull formatting code into their i-cache.
+#if defined(__GNUC__) && !defined(_WIN32)
+#define FLUX_COLD_PATH \
+  __attribute__((cold, noinline, section(".text.unlikely")))
+#elif defined(__GNUC__)
+#define FLUX_COLD_PATH __attribute__((cold, noinline))
+#else
+#define FLUX_COLD_PATH
+#endif
+
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
+
+namespace {
+
+/// Best-effort backtrace to stderr. Opt out with FLUX_BACKTRACE=0.
+FLUX_COLD_PATH void printBacktrace() {
+#if defined(__GLIBC__)
+  const char *setting = std::getenv("FLUX_BACKTRACE");
+  if (setting && setting[0] == '0') {
+    return;
+  }
+  void *frames[64];
+  int count = backtrace(frames, 64);
+  if (count > 1) {
+    std::fputs("backtrace:\n", stderr);
+    // Skip frame 0 (this function)
+    backtrace_symbols_fd(frames + 1, count - 1, 2);
+  }
+#endif
+}
+
+} // anonymous namespace
+
+[[noreturn]] FLUX_COLD_PATH
 void flux_panic(const char *message, const char *file, int32_t line) {
+  flux_flush(); // keep buffered output ordered before the abort
   std::fprintf(stderr, "PANIC at %s:%d: %s\n", file, line, message);
+  printBacktrace();
   std::fflush(stderr);
   std::abort();
 }
 
 void flux_assert(bool condition, const char *message, const char *file,
                  int32_t line) {
+  ++threadTrace().counters.checksExecuted;
   if (!condition) {
     flux_panic(message, file, line);
   }
@@ -29,65 +355,1033 @@ void flux_assert(bool condition, const char *message, const char *file,
 // -----------------------------------------------------------------------
 
 void *flux_alloc(size_t size) {
-  void *ptr = std::malloc(size);
-  if (!ptr && size > 0) {
-    flux_panic("allocation failed", __FILE__, __LINE__);
+  statTotalAllocations.fetch_add(1, std::memory_order_relaxed);
+  statBytesRequested.fetch_add(size, std::memory_order_relaxed);
+  FluxThreadCounters &counters = threadTrace().counters;
+  ++counters.allocations;
+  counters.bytesAllocated += size;
+
+  size_t classIndex = classForSize(size);
+  if (classIndex < kNumClasses) {
+    if (!threadPools.freeLists[classIndex]) {
+      refillClass(classIndex);
+    }
+    if (FreeBlock *block = threadPools.freeLists[classIndex]) {
+      threadPools.freeLists[classIndex] = block->next;
+      statPooledAllocations.fetch_add(1, std::memory_order_relaxed);
+      return block;
+    }
+    // Slab refill failed; fall through to the general heap
   }
-  return ptr;
+
+  char *raw = static_cast<char *>(std::malloc(kHeaderSize + size));
+  if (!raw) {
+    if (size > 0) {
+      flux_panic("allocation failed", __FILE__, __LINE__);
+    }
+    return nullptr;
+  }
+  reinterpret_cast<BlockHeader *>(raw)->sizeClass = kLargeClass;
+  return raw + kHeaderSize;
 }
 
 void *flux_alloc_zeroed(size_t count, size_t size) {
-  void *ptr = std::calloc(count, size);
-  if (!ptr && count > 0 && size > 0) {
-    flux_panic("allocation failed", __FILE__, __LINE__);
+  if (count != 0 && size > (~size_t(0)) / count) {
+    flux_panic("allocation overflow", __FILE__, __LINE__);
+  }
+  size_t total = count * size;
+  void *ptr = flux_alloc(total);
+  if (ptr) {
+    std::memset(ptr, 0, total);
   }
   return ptr;
 }
 
 void *flux_realloc(void *ptr, size_t newSize) {
-  void *result = std::realloc(ptr, newSize);
-  if (!result && newSize > 0) {
-    flux_panic("reallocation failed", __FILE__, __LINE__);
+  if (!ptr) {
+    return flux_alloc(newSize);
+  }
+
+  auto *header = reinterpret_cast<BlockHeader *>(static_cast<char *>(ptr) -
+                                                 kHeaderSize);
+  size_t oldSize = header->sizeClass == kLargeClass
+                       ? newSize // unknown; realloc below preserves data
+                       : kSizeClasses[header->sizeClass];
+
+  if (header->sizeClass == kLargeClass) {
+    char *raw = static_cast<char *>(
+        std::realloc(header, kHeaderSize + newSize));
+    if (!raw && newSize > 0) {
+      flux_panic("reallocation failed", __FILE__, __LINE__);
+    }
+    reinterpret_cast<BlockHeader *>(raw)->sizeClass = kLargeClass;
+    return raw + kHeaderSize;
   }
+
+  if (newSize <= oldSize) {
+    return ptr; // still fits in its class
+  }
+
+  void *result = flux_alloc(newSize);
+  std::memcpy(result, ptr, oldSize);
+  flux_free(ptr);
   return result;
 }
 
-void flux_free(void *ptr) { std::free(ptr); }
+void flux_free(void *ptr) {
+  if (!ptr) {
+    return;
+  }
+  statTotalFrees.fetch_add(1, std::memory_order_relaxed);
+
+  auto *header = reinterpret_cast<BlockHeader *>(static_cast<char *>(ptr) -
+                                                 kHeaderSize);
+  if (header->sizeClass == kLargeClass) {
+    std::free(header);
+    return;
+  }
+
+  size_t classIndex = static_cast<size_t>(header->sizeClass);
+  auto *block = static_cast<FreeBlock *>(ptr);
+  block->next = threadPools.freeLists[classIndex];
+  threadPools.freeLists[classIndex] = block;
+}
+
+void flux_alloc_stats(FluxAllocStats *out) {
+  out->totalAllocations = statTotalAllocations.load(std::memory_order_relaxed);
+  out->totalFrees = statTotalFrees.load(std::memory_order_relaxed);
+  out->pooledAllocations =
+      statPooledAllocations.load(std::memory_order_relaxed);
+  out->bytesRequested = statBytesRequested.load(std::memory_order_relaxed);
+  out->slabBytesReserved = statSlabBytes.load(std::memory_order_relaxed);
+}
 
 // -----------------------------------------------------------------------
 // I/O
 // -----------------------------------------------------------------------
 
 void flux_print(const char *str) {
-  std::fputs(str, stdout);
-  std::fflush(stdout);
+  std::lock_guard<std::mutex> lock(outMutex);
+  writeLocked(str, std::strlen(str));
 }
 
 void flux_println(const char *str) {
-  std::puts(str);
-  std::fflush(stdout);
+  std::lock_guard<std::mutex> lock(outMutex);
+  writeLocked(str, std::strlen(str));
+  writeLocked("\n", 1);
+}
+
+size_t flux_format_int(char *buffer, int64_t value) {
+  // Two digits per table lookup; digits are produced backwards into a
+  // scratch area and reversed out, with INT64_MIN handled as unsigned
+  static const char kDigitPairs[201] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+
+  char *out = buffer;
+  uint64_t magnitude;
+  if (value < 0) {
+    *out++ = '-';
+    magnitude = ~static_cast<uint64_t>(value) + 1;
+  } else {
+    magnitude = static_cast<uint64_t>(value);
+  }
+
+  char scratch[20];
+  char *pos = scratch + sizeof(scratch);
+  while (magnitude >= 100) {
+    uint64_t pair = (magnitude % 100) * 2;
+    magnitude /= 100;
+    *--pos = kDigitPairs[pair + 1];
+    *--pos = kDigitPairs[pair];
+  }
+  if (magnitude >= 10) {
+    uint64_t pair = magnitude * 2;
+    *--pos = kDigitPairs[pair + 1];
+    *--pos = kDigitPairs[pair];
+  } else {
+    *--pos = static_cast<char>('0' + magnitude);
+  }
+
+  size_t digits = static_cast<size_t>(scratch + sizeof(scratch) - pos);
+  std::memcpy(out, pos, digits);
+  return static_cast<size_t>(out - buffer) + digits;
+}
+
+size_t flux_format_float(char *buffer, double value) {
+  // std::to_chars produces the shortest round-trippable form with a
+  // Ryu-class algorithm — no locale, no lock, no allocation
+  auto result = std::to_chars(buffer, buffer + 32, value);
+  if (result.ec != std::errc()) {
+    buffer[0] = '0';
+    return 1;
+  }
+  return static_cast<size_t>(result.ptr - buffer);
 }
 
 void flux_print_int(int64_t value) {
-  std::printf("%lld", static_cast<long long>(value));
-  std::fflush(stdout);
+  char scratch[24];
+  size_t size = flux_format_int(scratch, value);
+  std::lock_guard<std::mutex> lock(outMutex);
+  writeLocked(scratch, size);
 }
 
 void flux_print_float(double value) {
-  std::printf("%g", value);
-  std::fflush(stdout);
+  char scratch[32];
+  size_t size = flux_format_float(scratch, value);
+  std::lock_guard<std::mutex> lock(outMutex);
+  writeLocked(scratch, size);
 }
 
 void flux_print_bool(bool value) {
-  std::fputs(value ? "true" : "false", stdout);
-  std::fflush(stdout);
+  std::lock_guard<std::mutex> lock(outMutex);
+  if (value) {
+    writeLocked("true", 4);
+  } else {
+    writeLocked("false", 5);
+  }
+}
+
+void flux_print_batch(const char **strings, size_t count) {
+  std::lock_guard<std::mutex> lock(outMutex);
+  for (size_t i = 0; i < count; ++i) {
+    writeLocked(strings[i], std::strlen(strings[i]));
+  }
+}
+
+void flux_flush(void) {
+  std::lock_guard<std::mutex> lock(outMutex);
+  flushLocked();
+}
+
+// -----------------------------------------------------------------------
+// Managed heap (generational, opt-in)
+// -----------------------------------------------------------------------
+//
+// Young generation: a bump region, so allocation is a pointer
+// increment. Collection promotes reachable young objects into
+// malloc-backed old-generation blocks, rewrites the registered root
+// slots (and promoted objects' interior words, conservatively), and
+// resets the bump cursor — fragmentation in the nursery is structurally
+// impossible and allocation-heavy phases reuse the same warm pages.
+// Reachability is root-set based until the compiler emits precise stack
+// maps; generated code and the runtime register roots explicitly.
+
+namespace {
+
+struct GCObjectHeader {
+  size_t size;       // payload bytes
+  void *forwarded;   // new location during a collection
+};
+
+constexpr size_t kDefaultYoungSize = 8 * 1024 * 1024;
+constexpr size_t kGCAlign = 16;
+
+struct GCHeap {
+  char *young = nullptr;
+  size_t youngSize = 0;
+  size_t youngUsed = 0;
+  std::vector<void **> roots;
+  std::mutex mutex;
+
+  uint64_t statAllocations = 0;
+  uint64_t statCollections = 0;
+  uint64_t statPromotedBytes = 0;
+
+  bool contains(const void *ptr) const {
+    return ptr >= young && ptr < young + youngUsed;
+  }
+};
+
+GCHeap gcHeap;
+
+/// Promote one young object, returning its new (old-gen) address.
+void *promote(void *payload) {
+  auto *header = reinterpret_cast<GCObjectHeader *>(
+      static_cast<char *>(payload) - sizeof(GCObjectHeader));
+  if (header->forwarded) {
+    return header->forwarded;
+  }
+  void *copy = std::malloc(header->size);
+  std::memcpy(copy, payload, header->size);
+  header->forwarded = copy;
+  gcHeap.statPromotedBytes += header->size;
+
+  // Conservative interior scan: any word that points into the nursery
+  // is treated as a reference and chased
+  auto **words = static_cast<void **>(copy);
+  size_t wordCount = header->size / sizeof(void *);
+  for (size_t i = 0; i < wordCount; ++i) {
+    if (gcHeap.contains(words[i])) {
+      words[i] = promote(words[i]);
+    }
+  }
+  return copy;
+}
+
+// Must be called with gcHeap.mutex held
+void collectLocked() {
+  ++gcHeap.statCollections;
+  for (void **root : gcHeap.roots) {
+    if (root && gcHeap.contains(*root)) {
+      *root = promote(*root);
+    }
+  }
+  gcHeap.youngUsed = 0; // everything live has been moved out
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+void flux_gc_enable(size_t youngSize) {
+  std::lock_guard<std::mutex> lock(gcHeap.mutex);
+  if (gcHeap.young) {
+    return;
+  }
+  gcHeap.youngSize = youngSize ? youngSize : kDefaultYoungSize;
+  gcHeap.young = static_cast<char *>(std::malloc(gcHeap.youngSize));
+  gcHeap.youngUsed = 0;
+}
+
+void *flux_gc_alloc(size_t size) {
+  std::lock_guard<std::mutex> lock(gcHeap.mutex);
+  if (!gcHeap.young) {
+    // GC not enabled: behave like the ordinary allocator
+    return flux_alloc(size);
+  }
+
+  size_t total = (sizeof(GCObjectHeader) + size + kGCAlign - 1) &
+                 ~(kGCAlign - 1);
+  if (gcHeap.youngUsed + total > gcHeap.youngSize) {
+    collectLocked();
+    if (gcHeap.youngUsed + total > gcHeap.youngSize) {
+      // Larger than the nursery: allocate old directly
+      return flux_alloc(size);
+    }
+  }
+
+  char *block = gcHeap.young + gcHeap.youngUsed;
+  gcHeap.youngUsed += total;
+  auto *header = reinterpret_cast<GCObjectHeader *>(block);
+  header->size = size;
+  header->forwarded = nullptr;
+  ++gcHeap.statAllocations;
+  return block + sizeof(GCObjectHeader);
+}
+
+void flux_gc_add_root(void **slot) {
+  std::lock_guard<std::mutex> lock(gcHeap.mutex);
+  gcHeap.roots.push_back(slot);
+}
+
+void flux_gc_remove_root(void **slot) {
+  std::lock_guard<std::mutex> lock(gcHeap.mutex);
+  for (auto it = gcHeap.roots.begin(); it != gcHeap.roots.end(); ++it) {
+    if (*it == slot) {
+      gcHeap.roots.erase(it);
+      return;
+    }
+  }
+}
+
+void flux_gc_collect(void) {
+  std::lock_guard<std::mutex> lock(gcHeap.mutex);
+  if (gcHeap.young) {
+    collectLocked();
+  }
+}
+
+void flux_gc_stats(FluxGCStats *out) {
+  std::lock_guard<std::mutex> lock(gcHeap.mutex);
+  out->youngAllocations = gcHeap.statAllocations;
+  out->collections = gcHeap.statCollections;
+  out->promotedBytes = gcHeap.statPromotedBytes;
+  out->youngUsed = gcHeap.youngUsed;
+  out->youngCapacity = gcHeap.youngSize;
+}
+
+} // extern "C"
+
+// -----------------------------------------------------------------------
+// File I/O
+// -----------------------------------------------------------------------
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+extern "C" {
+
+bool flux_file_mmap(const char *path, FluxFileMap *out, uint32_t hints) {
+  out->data = nullptr;
+  out->size = 0;
+  out->handle = nullptr;
+#ifndef _WIN32
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  void *base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                    MAP_PRIVATE, fd, 0);
+  close(fd); // the mapping keeps the pages alive
+  if (base == MAP_FAILED) {
+    return false;
+  }
+  if (hints & FLUX_IO_SEQUENTIAL) {
+    madvise(base, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+  }
+  if (hints & FLUX_IO_RANDOM) {
+    madvise(base, static_cast<size_t>(st.st_size), MADV_RANDOM);
+  }
+  if (hints & FLUX_IO_UNCACHED) {
+    madvise(base, static_cast<size_t>(st.st_size), MADV_DONTNEED);
+  }
+  out->data = base;
+  out->size = static_cast<size_t>(st.st_size);
+  return true;
+#else
+  (void)hints;
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping) {
+    return false;
+  }
+  void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!base) {
+    return false;
+  }
+  out->data = base;
+  out->size = static_cast<size_t>(size.QuadPart);
+  return true;
+#endif
+}
+
+void flux_file_unmap(FluxFileMap *map) {
+  if (!map || !map->data) {
+    return;
+  }
+#ifndef _WIN32
+  munmap(const_cast<void *>(map->data), map->size);
+#else
+  UnmapViewOfFile(map->data);
+#endif
+  map->data = nullptr;
+  map->size = 0;
+}
+
+int64_t flux_file_read_into(const char *path, void *buffer, size_t size,
+                            uint64_t offset) {
+#ifndef _WIN32
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  size_t total = 0;
+  while (total < size) {
+    ssize_t got = pread(fd, static_cast<char *>(buffer) + total,
+                        size - total, static_cast<off_t>(offset + total));
+    if (got < 0) {
+      close(fd);
+      return -1;
+    }
+    if (got == 0) {
+      break; // EOF
+    }
+    total += static_cast<size_t>(got);
+  }
+  close(fd);
+  return static_cast<int64_t>(total);
+#else
+  FILE *file = std::fopen(path, "rb");
+  if (!file) {
+    return -1;
+  }
+  _fseeki64(file, static_cast<long long>(offset), SEEK_SET);
+  size_t got = std::fread(buffer, 1, size, file);
+  std::fclose(file);
+  return static_cast<int64_t>(got);
+#endif
+}
+
+int64_t flux_file_writev(const char *path, const FluxIOVec *vecs,
+                         size_t count, bool append) {
+#ifndef _WIN32
+  int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+  int fd = open(path, flags, 0644);
+  if (fd < 0) {
+    return -1;
+  }
+
+  int64_t total = 0;
+  size_t index = 0;
+  while (index < count) {
+    // writev caps the vector count; feed it in IOV_MAX-sized slices
+    size_t batch = count - index;
+    if (batch > static_cast<size_t>(IOV_MAX)) {
+      batch = static_cast<size_t>(IOV_MAX);
+    }
+    struct iovec iov[64];
+    if (batch > 64) {
+      batch = 64;
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      iov[i].iov_base = const_cast<void *>(vecs[index + i].data);
+      iov[i].iov_len = vecs[index + i].size;
+    }
+    ssize_t written = writev(fd, iov, static_cast<int>(batch));
+    if (written < 0) {
+      close(fd);
+      return -1;
+    }
+    total += written;
+    index += batch;
+  }
+  close(fd);
+  return total;
+#else
+  FILE *file = std::fopen(path, append ? "ab" : "wb");
+  if (!file) {
+    return -1;
+  }
+  int64_t total = 0;
+  for (size_t i = 0; i < count; ++i) {
+    total += static_cast<int64_t>(
+        std::fwrite(vecs[i].data, 1, vecs[i].size, file));
+  }
+  std::fclose(file);
+  return total;
+#endif
+}
+
+} // extern "C"
+
+// -----------------------------------------------------------------------
+// Work-stealing task scheduler
+// -----------------------------------------------------------------------
+//
+// One deque per worker: a worker pushes and pops its own back (LIFO,
+// cache-warm) and steals from other workers' fronts (FIFO, coarse
+// units). flux_block_on keeps the calling thread productive by helping
+// to run tasks while it waits for the pending count to drain.
+
+namespace {
+
+struct Task {
+  FluxTaskFn fn;
+  void *arg;
+};
+
+class Scheduler {
+public:
+  static Scheduler &instance() {
+    static Scheduler scheduler;
+    return scheduler;
+  }
+
+  void spawn(Task task) {
+    start();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_ += 1;
+      queued_ += 1;
+      size_t victim = nextQueue_++ % queues_.size();
+      queues_[victim].push_back(task);
+    }
+    cv_.notify_one();
+  }
+
+  void blockOn(Task task) {
+    std::atomic<bool> done{false};
+    struct Wrapper {
+      Task inner;
+      std::atomic<bool> *done;
+    } wrapper{task, &done};
+
+    spawn({[](void *arg) {
+             auto *w = static_cast<Wrapper *>(arg);
+             w->inner.fn(w->inner.arg);
+             w->done->store(true, std::memory_order_release);
+           },
+           &wrapper});
+
+    // Help run tasks instead of sleeping
+    while (!done.load(std::memory_order_acquire)) {
+      if (!runOne()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) {
+        return;
+      }
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+    workers_.clear();
+    running_ = false;
+    stopping_ = false;
+  }
+
+private:
+  Scheduler() = default;
+
+  void start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+      return;
+    }
+    unsigned count = std::thread::hardware_concurrency();
+    if (count == 0) {
+      count = 2;
+    }
+    queues_.resize(count);
+    for (unsigned i = 0; i < count; ++i) {
+      workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+    running_ = true;
+  }
+
+  /// Pop a task: own queue's back first, then steal someone's front.
+  bool take(size_t self, Task &task) {
+    if (!queues_[self].empty()) {
+      task = queues_[self].back();
+      queues_[self].pop_back();
+      queued_ -= 1;
+      return true;
+    }
+    for (size_t i = 0; i < queues_.size(); ++i) {
+      size_t victim = (self + 1 + i) % queues_.size();
+      if (!queues_[victim].empty()) {
+        task = queues_[victim].front();
+        queues_[victim].pop_front();
+        queued_ -= 1;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Run one queued task on the calling (non-worker) thread.
+  bool runOne() {
+    Task task;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queues_.empty() || !take(0, task)) {
+        return false;
+      }
+    }
+    task.fn(task.arg);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_ -= 1;
+    }
+    return true;
+  }
+
+  void workerLoop(size_t self) {
+    for (;;) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return stopping_ || queued_ > 0; });
+        if (stopping_ && pending_ == 0) {
+          return;
+        }
+        if (!take(self, task)) {
+          continue;
+        }
+      }
+      task.fn(task.arg);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ -= 1;
+      }
+      cv_.notify_all();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::deque<Task>> queues_;
+  std::vector<std::thread> workers_;
+  size_t pending_ = 0; // queued + currently executing
+  size_t queued_ = 0;  // sitting in a deque
+  size_t nextQueue_ = 0;
+  bool running_ = false;
+  bool stopping_ = false;
+};
+
+} // anonymous namespace
+
+extern "C" {
+
+void flux_spawn(FluxTaskFn fn, void *arg) {
+  Scheduler::instance().spawn({fn, arg});
+}
+
+void flux_block_on(FluxTaskFn fn, void *arg) {
+  Scheduler::instance().blockOn({fn, arg});
+}
+
+void flux_scheduler_shutdown(void) { Scheduler::instance().shutdown(); }
+
+} // extern "C"
+
+// -----------------------------------------------------------------------
+// SIMD string primitives
+// -----------------------------------------------------------------------
+//
+// strlen aligns to 16 and then scans a cache line's worth of bytes per
+// iteration (aligned loads never cross a page, so scanning past the NUL
+// within a chunk is safe). strcmp measures both strings first and then
+// compares bounded memory, which keeps every vector load inside a known
+// buffer. The scalar fallbacks compile everywhere else.
+
+namespace {
+
+#if FLUX_RT_SSE2
+
+size_t simdStrlen(const char *str) {
+  const char *pos = str;
+  // Byte-wise until 16-aligned
+  while (reinterpret_cast<uintptr_t>(pos) & 15) {
+    if (*pos == '\0') {
+      return static_cast<size_t>(pos - str);
+    }
+    ++pos;
+  }
+  const __m128i zero = _mm_setzero_si128();
+  for (;;) {
+    __m128i chunk = _mm_load_si128(reinterpret_cast<const __m128i *>(pos));
+    unsigned mask = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero)));
+    if (mask != 0) {
+      return static_cast<size_t>(pos - str) +
+             static_cast<size_t>(__builtin_ctz(mask));
+    }
+    pos += 16;
+  }
+}
+
+/// memcmp over [0, len) returning the index of the first difference,
+/// or len when equal. All loads stay inside the buffers.
+size_t firstDifference(const char *a, const char *b, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    unsigned mask = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+    if (mask != 0xFFFF) {
+      return i + static_cast<size_t>(__builtin_ctz(~mask & 0xFFFF));
+    }
+  }
+  while (i < len && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+#else
+
+size_t simdStrlen(const char *str) { return std::strlen(str); }
+
+size_t firstDifference(const char *a, const char *b, size_t len) {
+  size_t i = 0;
+  while (i < len && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+#endif
+
+} // anonymous namespace
+
+extern "C" {
+
+size_t flux_memfind(const void *haystack, size_t hlen, const void *needle,
+                    size_t nlen) {
+  if (nlen == 0) {
+    return 0;
+  }
+  if (nlen > hlen) {
+    return SIZE_MAX;
+  }
+  const char *hay = static_cast<const char *>(haystack);
+  const char *need = static_cast<const char *>(needle);
+  size_t last = hlen - nlen;
+
+#if FLUX_RT_SSE2
+  const __m128i first = _mm_set1_epi8(need[0]);
+  size_t i = 0;
+  while (i + 16 <= last + 1) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i));
+    unsigned mask = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, first)));
+    while (mask != 0) {
+      unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+      size_t candidate = i + bit;
+      if (std::memcmp(hay + candidate, need, nlen) == 0) {
+        return candidate;
+      }
+      mask &= mask - 1;
+    }
+    i += 16;
+  }
+  for (; i <= last; ++i) {
+    if (hay[i] == need[0] && std::memcmp(hay + i, need, nlen) == 0) {
+      return i;
+    }
+  }
+#else
+  for (size_t i = 0; i <= last; ++i) {
+    if (hay[i] == need[0] && std::memcmp(hay + i, need, nlen) == 0) {
+      return i;
+    }
+  }
+#endif
+  return SIZE_MAX;
+}
+
+uint64_t flux_str_hash(const void *data, size_t len) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+bool flux_utf8_validate(const void *data, size_t len) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  size_t i = 0;
+
+  for (;;) {
+#if FLUX_RT_SSE2
+    // Fast path: skip whole-ASCII chunks
+    while (i + 16 <= len) {
+      __m128i chunk =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+      if (_mm_movemask_epi8(chunk) != 0) {
+        break; // high bit set somewhere in the chunk
+      }
+      i += 16;
+    }
+#endif
+    if (i >= len) {
+      return true;
+    }
+
+    unsigned char lead = bytes[i];
+    if (lead < 0x80) {
+      ++i;
+      continue;
+    }
+
+    // Multi-byte sequence: length from the lead byte, with the
+    // classic overlong / surrogate / range checks
+    size_t needed;
+    uint32_t codepoint;
+    if ((lead & 0xE0) == 0xC0) {
+      needed = 1;
+      codepoint = lead & 0x1F;
+      if (lead < 0xC2) {
+        return false; // overlong
+      }
+    } else if ((lead & 0xF0) == 0xE0) {
+      needed = 2;
+      codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+      needed = 3;
+      codepoint = lead & 0x07;
+      if (lead > 0xF4) {
+        return false; // beyond U+10FFFF
+      }
+    } else {
+      return false; // stray continuation or invalid lead
+    }
+
+    if (len - i - 1 < needed) {
+      return false; // truncated sequence
+    }
+    for (size_t k = 1; k <= needed; ++k) {
+      unsigned char cont = bytes[i + k];
+      if ((cont & 0xC0) != 0x80) {
+        return false;
+      }
+      codepoint = (codepoint << 6) | (cont & 0x3F);
+    }
+    if (needed == 2 &&
+        (codepoint < 0x800 || (codepoint >= 0xD800 && codepoint <= 0xDFFF))) {
+      return false; // overlong or surrogate
+    }
+    if (needed == 3 && (codepoint < 0x10000 || codepoint > 0x10FFFF)) {
+      return false;
+    }
+    i += needed + 1;
+  }
+}
+
+} // extern "C"
+
+// -----------------------------------------------------------------------
+// Length-prefixed strings
+// -----------------------------------------------------------------------
+
+} // extern "C"
+
+/// Small-string threshold: contents up to 23 bytes (plus NUL) live in
+/// the header itself and never touch the heap.
+struct FluxString {
+  size_t len;
+  size_t cap;       // usable bytes at data, excluding the NUL slot
+  char *data;       // == inlineBuf for small strings
+  char inlineBuf[24];
+};
+
+namespace {
+
+constexpr size_t kInlineCap = sizeof(FluxString::inlineBuf) - 1;
+
+bool isInline(const FluxString *str) { return str->data == str->inlineBuf; }
+
+/// Ensure room for `needed` content bytes (plus NUL), growing ×2.
+void stringReserve(FluxString *str, size_t needed) {
+  if (needed <= str->cap) {
+    return;
+  }
+  size_t newCap = str->cap * 2;
+  if (newCap < needed) {
+    newCap = needed;
+  }
+  char *newData = static_cast<char *>(flux_alloc(newCap + 1));
+  std::memcpy(newData, str->data, str->len + 1);
+  if (!isInline(str)) {
+    flux_free(str->data);
+  }
+  str->data = newData;
+  str->cap = newCap;
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+FluxString *flux_string_new(void) {
+  auto *str = static_cast<FluxString *>(flux_alloc(sizeof(FluxString)));
+  str->len = 0;
+  str->cap = kInlineCap;
+  str->data = str->inlineBuf;
+  str->inlineBuf[0] = '\0';
+  return str;
+}
+
+FluxString *flux_string_from(const char *data, size_t len) {
+  FluxString *str = flux_string_new();
+  flux_string_append(str, data, len);
+  return str;
+}
+
+FluxString *flux_string_from_cstr(const char *cstr) {
+  return flux_string_from(cstr, std::strlen(cstr));
+}
+
+size_t flux_string_len(const FluxString *str) { return str->len; }
+
+const char *flux_string_data(const FluxString *str) { return str->data; }
+
+void flux_string_append(FluxString *str, const char *data, size_t len) {
+  stringReserve(str, str->len + len);
+  std::memcpy(str->data + str->len, data, len);
+  str->len += len;
+  str->data[str->len] = '\0';
+}
+
+FluxString *flux_string_concat(const FluxString *a, const FluxString *b) {
+  auto *result = static_cast<FluxString *>(flux_alloc(sizeof(FluxString)));
+  result->len = 0;
+  result->cap = kInlineCap;
+  result->data = result->inlineBuf;
+  result->inlineBuf[0] = '\0';
+  stringReserve(result, a->len + b->len); // one growth, not two
+  flux_string_append(result, a->data, a->len);
+  flux_string_append(result, b->data, b->len);
+  return result;
+}
+
+int32_t flux_string_cmp(const FluxString *a, const FluxString *b) {
+  size_t common = a->len < b->len ? a->len : b->len;
+  int cmp = std::memcmp(a->data, b->data, common);
+  if (cmp != 0) {
+    return static_cast<int32_t>(cmp);
+  }
+  if (a->len == b->len) {
+    return 0;
+  }
+  return a->len < b->len ? -1 : 1;
+}
+
+void flux_string_free(FluxString *str) {
+  if (!isInline(str)) {
+    flux_free(str->data);
+  }
+  flux_free(str);
+}
+
+char *flux_string_concat_cstr(const char *a, const char *b) {
+  size_t lenA = std::strlen(a);
+  size_t lenB = std::strlen(b);
+  char *result = static_cast<char *>(flux_alloc(lenA + lenB + 1));
+  std::memcpy(result, a, lenA);
+  std::memcpy(result + lenA, b, lenB + 1); // includes the NUL
+  return result;
 }
 
 // -----------------------------------------------------------------------
-// String helpers
+// String helpers (legacy NUL-terminated API)
 // -----------------------------------------------------------------------
 
-size_t flux_strlen(const char *str) { return std::strlen(str); }
+size_t flux_strlen(const char *str) { return simdStrlen(str); }
 
 char *flux_strcat(const char *a, const char *b) {
   size_t lenA = std::strlen(a);
@@ -99,7 +1393,20 @@ char *flux_strcat(const char *a, const char *b) {
 }
 
 int32_t flux_strcmp(const char *a, const char *b) {
-  return static_cast<int32_t>(std::strcmp(a, b));
+  // Measure first, then compare bounded memory: every vector load stays
+  // inside a known buffer
+  size_t lenA = simdStrlen(a);
+  size_t lenB = simdStrlen(b);
+  size_t common = lenA < lenB ? lenA : lenB;
+  size_t diff = firstDifference(a, b, common);
+  if (diff < common) {
+    return static_cast<int32_t>(static_cast<unsigned char>(a[diff])) -
+           static_cast<int32_t>(static_cast<unsigned char>(b[diff]));
+  }
+  if (lenA == lenB) {
+    return 0;
+  }
+  return lenA < lenB ? -1 : 1;
 }
 
 } // extern "C"
@@ -40,7 +40,18 @@ FLUX_RT_API void flux_assert(bool condition, const char *message,
 // Memory
 // -----------------------------------------------------------------------
 
+/// Allocation statistics for flux_alloc_stats.
+typedef struct FluxAllocStats {
+  uint64_t totalAllocations;  // every flux_alloc/flux_alloc_zeroed call
+  uint64_t totalFrees;        // every flux_free of a non-null pointer
+  uint64_t pooledAllocations; // served from a thread-local size class
+  uint64_t bytesRequested;    // sum of requested sizes
+  uint64_t slabBytesReserved; // OS memory backing the pools
+} FluxAllocStats;
+
 /// Allocate `size` bytes, returns null on failure.
+/// Small sizes are served from thread-local size-classed pools; only
+/// large blocks touch the general-purpose heap.
 FLUX_RT_API void *flux_alloc(size_t size);
 
 /// Allocate and zero `count * size` bytes.
@@ -52,11 +63,16 @@ FLUX_RT_API void *flux_realloc(void *ptr, size_t newSize);
 /// Free a block.
 FLUX_RT_API void flux_free(void *ptr);
 
+/// Snapshot allocator counters (cumulative across threads).
+FLUX_RT_API void flux_alloc_stats(FluxAllocStats *out);
+
 // -----------------------------------------------------------------------
 // I/O
 // -----------------------------------------------------------------------
 
 /// Print a string to stdout (no newline).
+/// Output is batched in a runtime-managed buffer (64 KiB by default) and
+/// written with one syscall per buffer; use flux_flush to force it out.
 FLUX_RT_API void flux_print(const char *str);
 
 /// Print a string to stdout followed by newline.
@@ -71,6 +87,185 @@ FLUX_RT_API void flux_print_float(double value);
 /// Print a boolean to stdout.
 FLUX_RT_API void flux_print_bool(bool value);
 
+/// Format `value` into `buffer` (no NUL). Returns the length written.
+/// `buffer` must hold at least 20 bytes. Lock-free and syscall-free.
+FLUX_RT_API size_t flux_format_int(char *buffer, int64_t value);
+
+/// Format `value` as the shortest round-trippable decimal into
+/// `buffer` (no NUL). `buffer` must hold at least 32 bytes.
+FLUX_RT_API size_t flux_format_float(char *buffer, double value);
+
+/// Print `count` NUL-terminated strings in one batched write.
+FLUX_RT_API void flux_print_batch(const char **strings, size_t count);
+
+/// Flush the runtime's buffered stdout writes.
+FLUX_RT_API void flux_flush(void);
+
+// -----------------------------------------------------------------------
+// Instrumentation
+// -----------------------------------------------------------------------
+
+/// Per-thread counters, always maintained (a few relaxed increments).
+typedef struct FluxThreadCounters {
+  uint64_t allocations;    // flux_alloc calls on this thread
+  uint64_t bytesAllocated; // sum of requested sizes
+  uint64_t checksExecuted; // flux_assert evaluations (panics averted)
+} FluxThreadCounters;
+
+/// Snapshot the calling thread's counters.
+FLUX_RT_API void flux_thread_counters(FluxThreadCounters *out);
+
+/// Intern a function name, returning a stable probe ID (for generated
+/// entry/exit probes). Thread-safe; same name always yields one ID.
+FLUX_RT_API uint32_t flux_probe_register(const char *name);
+
+/// Record function entry/exit into the calling thread's ring buffer.
+FLUX_RT_API void flux_probe_enter(uint32_t functionID);
+FLUX_RT_API void flux_probe_exit(uint32_t functionID);
+
+/// Write every thread's trace ring plus the ID->name table to `path`
+/// as a binary trace ("FTR"; name table, then per-event records of
+/// {u32 id | exit bit, u64 timestamp}). Rings are cleared.
+FLUX_RT_API bool flux_trace_flush(const char *path);
+
+// -----------------------------------------------------------------------
+// Managed heap (opt-in, --runtime=gc)
+// -----------------------------------------------------------------------
+
+/// GC heap statistics.
+typedef struct FluxGCStats {
+  uint64_t youngAllocations; // bump allocations served
+  uint64_t collections;      // young-generation collections run
+  uint64_t promotedBytes;    // bytes moved to the old generation
+  uint64_t youngUsed;        // current young-generation fill
+  uint64_t youngCapacity;
+} FluxGCStats;
+
+/// Enable the managed heap with a young generation of `youngSize`
+/// bytes (0 picks the default). Idempotent.
+FLUX_RT_API void flux_gc_enable(size_t youngSize);
+
+/// Allocate from the young generation: a pointer bump. Collects (and
+/// promotes survivors to the old generation) when the nursery fills.
+FLUX_RT_API void *flux_gc_alloc(size_t size);
+
+/// Register/unregister a root slot. Live young objects are reachable
+/// only through registered roots; the collector updates the slots when
+/// it moves objects.
+FLUX_RT_API void flux_gc_add_root(void **slot);
+FLUX_RT_API void flux_gc_remove_root(void **slot);
+
+/// Force a young-generation collection.
+FLUX_RT_API void flux_gc_collect(void);
+
+FLUX_RT_API void flux_gc_stats(FluxGCStats *out);
+
+// -----------------------------------------------------------------------
+// File I/O (zero-copy first)
+// -----------------------------------------------------------------------
+
+/// Access-pattern hints for flux_file_mmap.
+enum FluxIOHint : uint32_t {
+  FLUX_IO_DEFAULT = 0,
+  FLUX_IO_SEQUENTIAL = 1, // will be read front to back
+  FLUX_IO_RANDOM = 2,     // scattered access
+  FLUX_IO_UNCACHED = 4,   // advise the OS not to keep pages around
+};
+
+/// A read-only mapping of a whole file.
+typedef struct FluxFileMap {
+  const void *data;
+  size_t size;
+  void *handle; // platform bookkeeping; do not touch
+} FluxFileMap;
+
+/// Map `path` read-only. No bytes are copied; pages are shared with
+/// every other process mapping the same file. Returns false on failure
+/// (missing file, pipe, empty file).
+FLUX_RT_API bool flux_file_mmap(const char *path, FluxFileMap *out,
+                                uint32_t hints);
+
+/// Release a mapping created by flux_file_mmap.
+FLUX_RT_API void flux_file_unmap(FluxFileMap *map);
+
+/// Read up to `size` bytes at `offset` into a caller-owned buffer.
+/// Returns bytes read, or -1 on error. Never allocates.
+FLUX_RT_API int64_t flux_file_read_into(const char *path, void *buffer,
+                                        size_t size, uint64_t offset);
+
+/// One segment of a vectored write.
+typedef struct FluxIOVec {
+  const void *data;
+  size_t size;
+} FluxIOVec;
+
+/// Write `count` segments to `path` in one pass (one writev syscall on
+/// POSIX). Truncates unless `append`. Returns total bytes written or -1.
+FLUX_RT_API int64_t flux_file_writev(const char *path, const FluxIOVec *vecs,
+                                     size_t count, bool append);
+
+// -----------------------------------------------------------------------
+// Task scheduler (async runtime)
+// -----------------------------------------------------------------------
+
+/// A unit of async work: a function applied to an opaque argument.
+typedef void (*FluxTaskFn)(void *arg);
+
+/// Enqueue a task on the work-stealing scheduler. Worker threads start
+/// lazily on first use (one per hardware thread).
+FLUX_RT_API void flux_spawn(FluxTaskFn fn, void *arg);
+
+/// Run a task and wait for it to finish. The calling thread helps
+/// execute queued tasks while it waits instead of blocking.
+FLUX_RT_API void flux_block_on(FluxTaskFn fn, void *arg);
+
+/// Drain outstanding tasks and join the worker threads.
+FLUX_RT_API void flux_scheduler_shutdown(void);
+
+// -----------------------------------------------------------------------
+// Length-prefixed strings
+// -----------------------------------------------------------------------
+
+/// Runtime string with an explicit length/capacity header and
+/// small-string optimization. Length queries are O(1) and appends grow
+/// amortized; contents stay NUL-terminated so flux_string_data
+/// interoperates with C APIs.
+typedef struct FluxString FluxString;
+
+/// Create an empty string.
+FLUX_RT_API FluxString *flux_string_new(void);
+
+/// Create a string from `len` bytes.
+FLUX_RT_API FluxString *flux_string_from(const char *data, size_t len);
+
+/// Create a string from a NUL-terminated C string.
+FLUX_RT_API FluxString *flux_string_from_cstr(const char *cstr);
+
+/// Length in bytes, O(1).
+FLUX_RT_API size_t flux_string_len(const FluxString *str);
+
+/// NUL-terminated contents (valid until the next mutation).
+FLUX_RT_API const char *flux_string_data(const FluxString *str);
+
+/// Append `len` bytes, growing geometrically (amortized O(1) per byte).
+FLUX_RT_API void flux_string_append(FluxString *str, const char *data,
+                                    size_t len);
+
+/// Concatenate two strings into a new one (single allocation).
+FLUX_RT_API FluxString *flux_string_concat(const FluxString *a,
+                                           const FluxString *b);
+
+/// Three-way compare (length-aware; no NUL scanning).
+FLUX_RT_API int32_t flux_string_cmp(const FluxString *a, const FluxString *b);
+
+/// Free a string and its buffer.
+FLUX_RT_API void flux_string_free(FluxString *str);
+
+/// Convenience for generated code: concatenate two NUL-terminated
+/// strings with exactly one length computation per input and one
+/// allocation; caller frees the result with flux_free.
+FLUX_RT_API char *flux_string_concat_cstr(const char *a, const char *b);
+
 // -----------------------------------------------------------------------
 // String helpers
 // -----------------------------------------------------------------------
@@ -84,4 +279,15 @@ FLUX_RT_API char *flux_strcat(const char *a, const char *b);
 /// Compare two strings. Returns 0 if equal.
 FLUX_RT_API int32_t flux_strcmp(const char *a, const char *b);
 
+/// Find `needle` (nlen bytes) in `haystack` (hlen bytes).
+/// Returns the byte offset of the first occurrence, or SIZE_MAX.
+FLUX_RT_API size_t flux_memfind(const void *haystack, size_t hlen,
+                                const void *needle, size_t nlen);
+
+/// 64-bit FNV-1a hash over `len` bytes.
+FLUX_RT_API uint64_t flux_str_hash(const void *data, size_t len);
+
+/// Validate that `len` bytes are well-formed UTF-8.
+FLUX_RT_API bool flux_utf8_validate(const void *data, size_t len);
+
 } // extern "C"
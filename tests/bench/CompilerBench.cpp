@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include "flux/CodeGen/CodeGen.h"
+#include "flux/Common/Diagnostics.h"
+#include "flux/Lexer/Lexer.h"
+#include "flux/Parser/Parser.h"
+#include "flux/Sema/Sema.h"
+
+#include <string>
+
+using namespace flux;
+
+// -----------------------------------------------------------------------
+// Synthetic corpora
+// -----------------------------------------------------------------------
+
+/// A large, realistic mixed source: functions with arithmetic, calls,
+/// comments, and string literals. `count` controls the declaration count.
+static std::string makeLargeCorpus(size_t count) {
+    std::string src = "module bench;\n";
+    for (size_t i = 0; i < count; ++i) {
+        std::string n = std::to_string(i);
+        src += "// worker function " + n + "\n";
+        src += "func work_" + n + "(a: Int32, b: Int32) -> Int32 {\n";
+        src += "    let label: String = \"step " + n + "\";\n";
+        src += "    let x: Int32 = a * 2 + b - " + n + ";\n";
+        src += "    /* block comment " + n + " */\n";
+        src += "    return x + a % 7;\n";
+        src += "}\n";
+    }
+    return src;
+}
+
+/// Deeply nested expression: stresses the recursive descent chain.
+static std::string makeDeepExpression(size_t depth) {
+    std::string src = "module deep;\nfunc f() -> Int64 {\n    let x: Int64 = ";
+    for (size_t i = 0; i < depth; ++i) {
+        src += "(1 + ";
+    }
+    src += "0";
+    for (size_t i = 0; i < depth; ++i) {
+        src += ")";
+    }
+    src += ";\n    return x;\n}\n";
+    return src;
+}
+
+/// Wide module: many small declarations (registration-heavy).
+static std::string makeWideModule(size_t count) {
+    std::string src = "module wide;\n";
+    for (size_t i = 0; i < count; ++i) {
+        std::string n = std::to_string(i);
+        src += "struct S" + n + " { x: Int32, y: Float64 }\n";
+        src += "func get_" + n + "(s: Int32) -> Int32 { return s; }\n";
+    }
+    return src;
+}
+
+/// Generic-heavy code for sema.
+static std::string makeGenericHeavy(size_t count) {
+    std::string src = "module generics;\n";
+    for (size_t i = 0; i < count; ++i) {
+        std::string n = std::to_string(i);
+        src += "func map_" + n + "<T, U>(input: Vec<T>) -> Vec<U> {\n";
+        src += "    let out: Vec<U> = make_" + n + "();\n";
+        src += "    return out;\n";
+        src += "}\n";
+        src += "func make_" + n + "<U>() -> Vec<U>;\n";
+    }
+    return src;
+}
+
+// -----------------------------------------------------------------------
+// Lexer
+// -----------------------------------------------------------------------
+
+static void BM_LexAll_LargeCorpus(benchmark::State& state) {
+    std::string src = makeLargeCorpus(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        DiagnosticEngine diag;
+        Lexer lexer(src, "bench.fl", diag);
+        auto tokens = lexer.lexAll();
+        benchmark::DoNotOptimize(tokens);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(src.size()));
+}
+BENCHMARK(BM_LexAll_LargeCorpus)->Arg(100)->Arg(1000)->Arg(5000);
+
+// -----------------------------------------------------------------------
+// Parser
+// -----------------------------------------------------------------------
+
+static void BM_Parse_DeepExpression(benchmark::State& state) {
+    std::string src = makeDeepExpression(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        DiagnosticEngine diag;
+        Lexer lexer(src, "deep.fl", diag);
+        Parser parser(lexer, diag);
+        auto module = parser.parseModule();
+        benchmark::DoNotOptimize(module);
+    }
+}
+BENCHMARK(BM_Parse_DeepExpression)->Arg(64)->Arg(256)->Arg(1024);
+
+static void BM_Parse_WideModule(benchmark::State& state) {
+    std::string src = makeWideModule(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        DiagnosticEngine diag;
+        Lexer lexer(src, "wide.fl", diag);
+        Parser parser(lexer, diag);
+        auto module = parser.parseModule();
+        benchmark::DoNotOptimize(module);
+    }
+}
+BENCHMARK(BM_Parse_WideModule)->Arg(100)->Arg(1000)->Arg(4000);
+
+// -----------------------------------------------------------------------
+// Sema
+// -----------------------------------------------------------------------
+
+static void BM_Sema_GenericHeavy(benchmark::State& state) {
+    std::string src = makeGenericHeavy(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        DiagnosticEngine diag;
+        diag.setHandler([](const Diagnostic&) {}); // drop output
+        Lexer lexer(src, "generics.fl", diag);
+        Parser parser(lexer, diag);
+        auto module = parser.parseModule();
+        state.ResumeTiming();
+
+        Sema sema(diag);
+        sema.analyze(*module);
+        benchmark::DoNotOptimize(module);
+    }
+}
+BENCHMARK(BM_Sema_GenericHeavy)->Arg(100)->Arg(1000)->Arg(4000);
+
+// -----------------------------------------------------------------------
+// End-to-end codegen
+// -----------------------------------------------------------------------
+
+static void BM_CodeGen_EndToEnd(benchmark::State& state) {
+    std::string src = makeLargeCorpus(200);
+    int optLevel = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        DiagnosticEngine diag;
+        diag.setHandler([](const Diagnostic&) {});
+        Lexer lexer(src, "bench.fl", diag);
+        Parser parser(lexer, diag);
+        auto module = parser.parseModule();
+        Sema sema(diag);
+        sema.analyze(*module);
+        state.ResumeTiming();
+
+        CodeGenOptions cgOpts;
+        cgOpts.optimizationLevel = optLevel;
+        cgOpts.outputFormat = OutputFormat::Object;
+        CodeGen codegen(diag, cgOpts);
+        bool ok = codegen.generate(*module);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_CodeGen_EndToEnd)->Arg(0)->Arg(2)->Unit(benchmark::kMillisecond);
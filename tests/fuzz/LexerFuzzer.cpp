@@ -10,13 +10,19 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
 
   std::string source(reinterpret_cast<const char *>(Data), Size);
 
-  // We use a dummy diagnostics engine that doesn't print to stderr to keep the
-  // fuzzer fast
-  flux::DiagnosticsEngine diags;
+  // A silent diagnostics engine keeps the fuzzer fast
+  flux::DiagnosticEngine diags;
+  diags.setHandler([](const flux::Diagnostic &) {});
   flux::Lexer lexer(source, "fuzz.fl", diags);
 
   try {
-    auto tokens = lexer.tokenize();
+    auto tokens = lexer.lexAll();
+
+    // Performance oracle: the lexer can never produce more tokens than
+    // bytes; a blowup here means a progress bug, not just slowness
+    if (tokens.size() > Size + 1) {
+      __builtin_trap();
+    }
   } catch (...) {
     // We don't want the fuzzer to stop on expected exceptions,
     // only on memory errors/crashes which LibFuzzer catches automatically.
@@ -0,0 +1,35 @@
+#include <cstdint>
+#include <flux/Common/Diagnostics.h>
+#include <flux/Lexer/Lexer.h>
+#include <flux/Parser/Parser.h>
+#include <stddef.h>
+#include <string>
+
+/// Parser fuzzer with a performance oracle: beyond crashes, it aborts
+/// when the token buffer grows superlinearly relative to the input —
+/// the signature of re-lexing or runaway recovery loops.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
+  if (Size == 0)
+    return 0;
+
+  std::string source(reinterpret_cast<const char *>(Data), Size);
+
+  flux::DiagnosticEngine diags;
+  diags.setHandler([](const flux::Diagnostic &) {});
+  flux::Lexer lexer(source, "fuzz.fl", diags);
+  flux::Parser parser(lexer, diags);
+
+  try {
+    auto module = parser.parseModule();
+
+    // Each byte can yield at most one token; the buffer lexes each
+    // exactly once. Anything past a small constant factor means the
+    // parser's backtracking or recovery went superlinear.
+    if (parser.tokenCount() > 2 * Size + 16) {
+      __builtin_trap();
+    }
+  } catch (...) {
+  }
+
+  return 0;
+}
@@ -0,0 +1,38 @@
+#include <cstdint>
+#include <flux/Common/Diagnostics.h>
+#include <flux/Lexer/Lexer.h>
+#include <flux/Parser/Parser.h>
+#include <flux/Sema/Sema.h>
+#include <stddef.h>
+#include <string>
+
+/// End-to-end front-end fuzzer: parse then analyze. Diagnostic volume
+/// is capped so error floods surface as the bounded-path behavior we
+/// ship, and a diagnostics-per-byte oracle catches cascading-error
+/// blowups in resolution/checking.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
+  if (Size == 0)
+    return 0;
+
+  std::string source(reinterpret_cast<const char *>(Data), Size);
+
+  flux::DiagnosticEngine diags;
+  diags.setHandler([](const flux::Diagnostic &) {});
+  diags.setErrorLimit(1024);
+
+  flux::Lexer lexer(source, "fuzz.fl", diags);
+  flux::Parser parser(lexer, diags);
+
+  try {
+    auto module = parser.parseModule();
+    flux::Sema sema(diags);
+    sema.analyze(*module);
+
+    if (diags.errorCount() > Size + 64) {
+      __builtin_trap();
+    }
+  } catch (...) {
+  }
+
+  return 0;
+}
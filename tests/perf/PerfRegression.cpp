@@ -0,0 +1,170 @@
+/// Compile-time performance regression harness.
+///
+/// Two kinds of checks:
+///  1. Corpus replay: every file under the corpus directory must lex and
+///     parse within an absolute wall-clock ceiling and a memory ceiling
+///     proportional to its size.
+///  2. Scaling probes: generated pathological patterns (deep nesting,
+///     long operator chains, giant string literals) are run at 1x and 4x
+///     size; if time grows by more than ~10x for 4x input, the phase has
+///     gone superlinear and the harness fails.
+///
+/// Exit code is non-zero on any violation, so ctest fails the build.
+
+#include "flux/Common/Diagnostics.h"
+#include "flux/Lexer/Lexer.h"
+#include "flux/Parser/Parser.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace flux;
+
+namespace {
+
+// Generous ceilings: these catch order-of-magnitude blowups, not noise.
+constexpr double kAbsoluteCeilingMs = 2000.0;
+constexpr double kScalingInputFactor = 4.0;
+constexpr double kScalingTimeLimit = 10.0; // linear = 4x, quadratic = 16x
+constexpr size_t kArenaBytesPerSourceByte = 400;
+
+int failures = 0;
+
+void fail(const std::string &message) {
+  std::cerr << "FAIL: " << message << "\n";
+  ++failures;
+}
+
+/// Lex + parse `source`, returning wall milliseconds (best of 3 runs)
+/// and the AST arena footprint.
+double timeParse(const std::string &source, size_t &arenaBytes) {
+  double best = 1e300;
+  for (int run = 0; run < 3; ++run) {
+    DiagnosticEngine diag;
+    diag.setHandler([](const Diagnostic &) {}); // errors are expected noise
+    Lexer lexer(source, "<perf>", diag);
+    Parser parser(lexer, diag);
+
+    auto start = std::chrono::steady_clock::now();
+    auto module = parser.parseModule();
+    auto end = std::chrono::steady_clock::now();
+
+    arenaBytes = module->context ? module->context->bytesAllocated() : 0;
+    double ms =
+        std::chrono::duration<double, std::milli>(end - start).count();
+    if (ms < best) {
+      best = ms;
+    }
+  }
+  return best;
+}
+
+void checkCorpusFile(const std::filesystem::path &path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream buffer;
+  buffer << file.rdbuf();
+  std::string source = buffer.str();
+
+  size_t arenaBytes = 0;
+  double ms = timeParse(source, arenaBytes);
+
+  std::cout << path.filename().string() << ": " << ms << " ms, arena "
+            << arenaBytes << " bytes\n";
+
+  if (ms > kAbsoluteCeilingMs) {
+    fail(path.filename().string() + " exceeded time ceiling (" +
+         std::to_string(ms) + " ms)");
+  }
+  size_t memoryCeiling =
+      (source.size() + 1024) * kArenaBytesPerSourceByte;
+  if (arenaBytes > memoryCeiling) {
+    fail(path.filename().string() + " exceeded memory ceiling (" +
+         std::to_string(arenaBytes) + " bytes)");
+  }
+}
+
+// --- Generated pathological patterns ---
+
+std::string deepParens(size_t depth) {
+  std::string src = "func f() -> Int64 { let x: Int64 = ";
+  for (size_t i = 0; i < depth; ++i) {
+    src += "(1 + ";
+  }
+  src += "0";
+  src.append(depth, ')');
+  src += "; return x; }\n";
+  return src;
+}
+
+std::string operatorChain(size_t length) {
+  std::string src = "func f() -> Int64 { let x: Int64 = 1";
+  for (size_t i = 0; i < length; ++i) {
+    src += " + 2 * 3";
+  }
+  src += "; return x; }\n";
+  return src;
+}
+
+std::string giantStringLiteral(size_t size) {
+  std::string src = "func f() -> String { return \"";
+  src.append(size, 'a');
+  src += "\"; }\n";
+  return src;
+}
+
+void checkScaling(const std::string &name,
+                  std::string (*generate)(size_t), size_t baseSize) {
+  size_t arenaBytes = 0;
+  double baseMs = timeParse(generate(baseSize), arenaBytes);
+  double scaledMs = timeParse(
+      generate(static_cast<size_t>(baseSize * kScalingInputFactor)),
+      arenaBytes);
+
+  // Very fast runs are all noise; only the scaled timing matters then
+  if (baseMs < 0.5) {
+    baseMs = 0.5;
+  }
+  double ratio = scaledMs / baseMs;
+  std::cout << name << ": " << baseMs << " ms -> " << scaledMs
+            << " ms (x" << ratio << ")\n";
+  if (ratio > kScalingTimeLimit) {
+    fail(name + " scales superlinearly (x" + std::to_string(ratio) +
+         " time for x" + std::to_string(kScalingInputFactor) + " input)");
+  }
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+  // 1. Corpus replay
+  if (argc > 1) {
+    std::filesystem::path corpusDir = argv[1];
+    if (std::filesystem::is_directory(corpusDir)) {
+      for (const auto &entry :
+           std::filesystem::directory_iterator(corpusDir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".fl") {
+          checkCorpusFile(entry.path());
+        }
+      }
+    } else {
+      std::cerr << "warning: corpus directory '" << corpusDir.string()
+                << "' not found; running scaling probes only\n";
+    }
+  }
+
+  // 2. Scaling probes
+  checkScaling("deep-parens", deepParens, 500);
+  checkScaling("operator-chain", operatorChain, 4000);
+  checkScaling("giant-string", giantStringLiteral, 256 * 1024);
+
+  if (failures > 0) {
+    std::cerr << failures << " performance regression(s) detected\n";
+    return 1;
+  }
+  std::cout << "all compile-time performance checks passed\n";
+  return 0;
+}
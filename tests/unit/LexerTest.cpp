@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include "flux/Common/Diagnostics.h"
+#include "flux/Common/SourceLocation.h"
 #include "flux/Lexer/Lexer.h"
 #include "flux/Lexer/Token.h"
 
@@ -15,58 +17,74 @@ static std::vector<Token> lex(std::string_view source)
     return lexer.lexAll();
 }
 
+/// Tokens no longer own their spelling; rebuild it the way consumers do
+/// (a lexer over the same source yields the same windows).
+static std::string tokenText(std::string_view source, const Token &token)
+{
+    DiagnosticEngine diag;
+    Lexer lexer(source, "<test>", diag);
+    return std::string(lexer.tokenText(token));
+}
+
 // -----------------------------------------------------------------------
 // Basic token tests
 // -----------------------------------------------------------------------
 
 TEST(LexerTest, EmptyInput)
 {
-    auto tokens = lex("");
+    std::string_view source = "";
+    auto tokens = lex(source);
     ASSERT_EQ(tokens.size(), 1u);
     EXPECT_EQ(tokens[0].kind, TokenKind::Eof);
 }
 
 TEST(LexerTest, Whitespace)
 {
-    auto tokens = lex("   \n\t  ");
+    std::string_view source = "   \n\t  ";
+    auto tokens = lex(source);
     ASSERT_EQ(tokens.size(), 1u);
     EXPECT_EQ(tokens[0].kind, TokenKind::Eof);
 }
 
 TEST(LexerTest, IntegerLiteral)
 {
-    auto tokens = lex("42");
+    std::string_view source = "42";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 2u);
     EXPECT_EQ(tokens[0].kind, TokenKind::IntLiteral);
-    EXPECT_EQ(tokens[0].text, "42");
+    EXPECT_EQ(tokenText(source, tokens[0]), "42");
 }
 
 TEST(LexerTest, FloatLiteral)
 {
-    auto tokens = lex("3.14");
+    std::string_view source = "3.14";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 2u);
     EXPECT_EQ(tokens[0].kind, TokenKind::FloatLiteral);
-    EXPECT_EQ(tokens[0].text, "3.14");
+    EXPECT_EQ(tokenText(source, tokens[0]), "3.14");
 }
 
 TEST(LexerTest, StringLiteral)
 {
-    auto tokens = lex("\"hello world\"");
+    std::string_view source = "\"hello world\"";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 2u);
     EXPECT_EQ(tokens[0].kind, TokenKind::StringLiteral);
-    EXPECT_EQ(tokens[0].text, "hello world");
+    EXPECT_EQ(tokenText(source, tokens[0]), "hello world");
 }
 
 TEST(LexerTest, CharLiteral)
 {
-    auto tokens = lex("'a'");
+    std::string_view source = "'a'";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 2u);
     EXPECT_EQ(tokens[0].kind, TokenKind::CharLiteral);
 }
 
 TEST(LexerTest, BoolLiterals)
 {
-    auto tokens = lex("true false");
+    std::string_view source = "true false";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 3u);
     EXPECT_EQ(tokens[0].kind, TokenKind::KwTrue);
     EXPECT_EQ(tokens[1].kind, TokenKind::KwFalse);
@@ -74,7 +92,8 @@ TEST(LexerTest, BoolLiterals)
 
 TEST(LexerTest, Keywords)
 {
-    auto tokens = lex("func let mut const struct class enum trait impl");
+    std::string_view source = "func let mut const struct class enum trait impl";
+    auto tokens = lex(source);
     // 9 keywords + EOF
     ASSERT_GE(tokens.size(), 10u);
     EXPECT_EQ(tokens[0].kind, TokenKind::KwFunc);
@@ -90,7 +109,8 @@ TEST(LexerTest, Keywords)
 
 TEST(LexerTest, Operators)
 {
-    auto tokens = lex("+ - * / = == != < > <= >=");
+    std::string_view source = "+ - * / = == != < > <= >=";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 12u);
     EXPECT_EQ(tokens[0].kind, TokenKind::Plus);
     EXPECT_EQ(tokens[1].kind, TokenKind::Minus);
@@ -107,7 +127,8 @@ TEST(LexerTest, Operators)
 
 TEST(LexerTest, Punctuation)
 {
-    auto tokens = lex("( ) { } [ ] , : ; .");
+    std::string_view source = "( ) { } [ ] , : ; .";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 11u);
     EXPECT_EQ(tokens[0].kind, TokenKind::LParen);
     EXPECT_EQ(tokens[1].kind, TokenKind::RParen);
@@ -123,31 +144,34 @@ TEST(LexerTest, Punctuation)
 
 TEST(LexerTest, Identifiers)
 {
-    auto tokens = lex("foo bar_baz _private myVar123");
+    std::string_view source = "foo bar_baz _private myVar123";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 5u);
     for (int i = 0; i < 4; ++i)
     {
         EXPECT_EQ(tokens[i].kind, TokenKind::Identifier);
     }
-    EXPECT_EQ(tokens[0].text, "foo");
-    EXPECT_EQ(tokens[1].text, "bar_baz");
-    EXPECT_EQ(tokens[2].text, "_private");
-    EXPECT_EQ(tokens[3].text, "myVar123");
+    EXPECT_EQ(tokenText(source, tokens[0]), "foo");
+    EXPECT_EQ(tokenText(source, tokens[1]), "bar_baz");
+    EXPECT_EQ(tokenText(source, tokens[2]), "_private");
+    EXPECT_EQ(tokenText(source, tokens[3]), "myVar123");
 }
 
 TEST(LexerTest, LineComment)
 {
-    auto tokens = lex("42 // this is a comment\n100");
+    std::string_view source = "42 // this is a comment\n100";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 3u);
     EXPECT_EQ(tokens[0].kind, TokenKind::IntLiteral);
-    EXPECT_EQ(tokens[0].text, "42");
+    EXPECT_EQ(tokenText(source, tokens[0]), "42");
     EXPECT_EQ(tokens[1].kind, TokenKind::IntLiteral);
-    EXPECT_EQ(tokens[1].text, "100");
+    EXPECT_EQ(tokenText(source, tokens[1]), "100");
 }
 
 TEST(LexerTest, BlockComment)
 {
-    auto tokens = lex("42 /* block comment */ 100");
+    std::string_view source = "42 /* block comment */ 100";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 3u);
     EXPECT_EQ(tokens[0].kind, TokenKind::IntLiteral);
     EXPECT_EQ(tokens[1].kind, TokenKind::IntLiteral);
@@ -155,7 +179,8 @@ TEST(LexerTest, BlockComment)
 
 TEST(LexerTest, Arrow)
 {
-    auto tokens = lex("-> =>");
+    std::string_view source = "-> =>";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 3u);
     EXPECT_EQ(tokens[0].kind, TokenKind::Arrow);
     EXPECT_EQ(tokens[1].kind, TokenKind::FatArrow);
@@ -163,7 +188,8 @@ TEST(LexerTest, Arrow)
 
 TEST(LexerTest, ColonColon)
 {
-    auto tokens = lex("std::io::println");
+    std::string_view source = "std::io::println";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 6u);
     EXPECT_EQ(tokens[0].kind, TokenKind::Identifier);
     EXPECT_EQ(tokens[1].kind, TokenKind::ColonColon);
@@ -174,7 +200,8 @@ TEST(LexerTest, ColonColon)
 
 TEST(LexerTest, HexLiteral)
 {
-    auto tokens = lex("0xFF 0x1A2B");
+    std::string_view source = "0xFF 0x1A2B";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 3u);
     EXPECT_EQ(tokens[0].kind, TokenKind::IntLiteral);
     EXPECT_EQ(tokens[1].kind, TokenKind::IntLiteral);
@@ -182,7 +209,8 @@ TEST(LexerTest, HexLiteral)
 
 TEST(LexerTest, BinaryLiteral)
 {
-    auto tokens = lex("0b1010 0b11001100");
+    std::string_view source = "0b1010 0b11001100";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 3u);
     EXPECT_EQ(tokens[0].kind, TokenKind::IntLiteral);
     EXPECT_EQ(tokens[1].kind, TokenKind::IntLiteral);
@@ -190,16 +218,24 @@ TEST(LexerTest, BinaryLiteral)
 
 TEST(LexerTest, NumberWithUnderscores)
 {
-    auto tokens = lex("1_000_000");
+    std::string_view source = "1_000_000";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 2u);
     EXPECT_EQ(tokens[0].kind, TokenKind::IntLiteral);
 }
 
 TEST(LexerTest, SourceLocation)
 {
-    auto tokens = lex("let x: Int32 = 42;");
-    EXPECT_EQ(tokens[0].location.line, 1u);
-    EXPECT_EQ(tokens[0].location.column, 1u);
+    SourceManager srcMgr;
+    uint32_t fileId = srcMgr.loadFromString("<test>", "let x: Int32 = 42;");
+    DiagnosticEngine diag;
+    Lexer lexer(srcMgr.getSource(fileId), "<test>", diag,
+                srcMgr.fileBase(fileId));
+    auto tokens = lexer.lexAll();
+    ASSERT_GE(tokens.size(), 2u);
+    auto loc = srcMgr.decode(tokens[0].location);
+    EXPECT_EQ(loc.line, 1u);
+    EXPECT_EQ(loc.column, 1u);
 }
 
 // -----------------------------------------------------------------------
@@ -208,16 +244,18 @@ TEST(LexerTest, SourceLocation)
 
 TEST(LexerTest, FunctionDeclaration)
 {
-    auto tokens = lex("func add(a: Int32, b: Int32) -> Int32 { return a + b; }");
+    std::string_view source = "func add(a: Int32, b: Int32) -> Int32 { return a + b; }";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 2u);
     EXPECT_EQ(tokens[0].kind, TokenKind::KwFunc);
     EXPECT_EQ(tokens[1].kind, TokenKind::Identifier);
-    EXPECT_EQ(tokens[1].text, "add");
+    EXPECT_EQ(tokenText(source, tokens[1]), "add");
 }
 
 TEST(LexerTest, AsyncAwait)
 {
-    auto tokens = lex("async func fetch() -> String { let x: String = await getData(); return x; }");
+    std::string_view source = "async func fetch() -> String { let x: String = await getData(); return x; }";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 2u);
     EXPECT_EQ(tokens[0].kind, TokenKind::KwAsync);
     EXPECT_EQ(tokens[1].kind, TokenKind::KwFunc);
@@ -225,9 +263,10 @@ TEST(LexerTest, AsyncAwait)
 
 TEST(LexerTest, Annotation)
 {
-    auto tokens = lex("@inline\nfunc testAdd() -> Void {}");
+    std::string_view source = "@inline\nfunc testAdd() -> Void {}";
+    auto tokens = lex(source);
     ASSERT_GE(tokens.size(), 3u);
     EXPECT_EQ(tokens[0].kind, TokenKind::At);
     EXPECT_EQ(tokens[1].kind, TokenKind::Identifier);
-    EXPECT_EQ(tokens[1].text, "inline");
+    EXPECT_EQ(tokenText(source, tokens[1]), "inline");
 }
@@ -6,6 +6,7 @@
 #include "flux/AST/Stmt.h"
 #include "flux/Common/Diagnostics.h"
 #include "flux/Lexer/Lexer.h"
+#include "flux/Parser/Incremental.h"
 #include "flux/Parser/Parser.h"
 
 using namespace flux;
@@ -205,3 +206,87 @@ TEST(ParserTest, MultipleDeclarations) {
     )");
     EXPECT_EQ(mod.declarations.size(), 2u);
 }
+
+
+// -----------------------------------------------------------------------
+// Pre-scan (pipelined front end)
+// -----------------------------------------------------------------------
+
+TEST(ParserTest, PreScanReportsEnumVariants) {
+    DiagnosticEngine diag;
+    Lexer lexer(
+        "enum Color { Red, Green, Blue }\n"
+        "enum Shape { Circle(Float64), Box { w: Int64, h: Int64 }, Dot }\n"
+        "func f() -> Void {}\n",
+        "<test>", diag);
+    Parser parser(lexer, diag);
+    auto names = parser.preScanTopLevelNames();
+
+    size_t variants = 0;
+    bool sawRed = false, sawDot = false, sawPayloadField = false;
+    for (const auto& name : names) {
+        if (name.keyword != TokenKind::Identifier) {
+            continue;
+        }
+        ++variants;
+        if (name.name == "Red" && name.parent == "Color") sawRed = true;
+        if (name.name == "Dot" && name.parent == "Shape") sawDot = true;
+        if (name.name == "w" || name.name == "h") sawPayloadField = true;
+    }
+    EXPECT_EQ(variants, 6u); // Red Green Blue Circle Box Dot
+    EXPECT_TRUE(sawRed);
+    EXPECT_TRUE(sawDot);
+    EXPECT_FALSE(sawPayloadField); // payload members are not variants
+}
+
+// -----------------------------------------------------------------------
+// Incremental re-parsing
+// -----------------------------------------------------------------------
+
+TEST(IncrementalTest, EditReusesUntouchedDeclarations) {
+    DiagnosticEngine diag;
+    diag.setHandler([](const Diagnostic&) {});
+    IncrementalSession session(diag);
+
+    std::string src =
+        "func a() -> Int32 { return 1; }\n"
+        "func b() -> Int32 { return 2; }\n"
+        "func c() -> Int32 { return 3; }\n";
+    auto* mod = session.open(src, "<test>");
+    ASSERT_EQ(mod->declarations.size(), 3u);
+
+    // Replace the '2' in b with '42'
+    uint32_t pos = static_cast<uint32_t>(src.find("return 2") + 7);
+    mod = session.applyEdit(SourceEdit{pos, 1, "42"});
+    ASSERT_EQ(mod->declarations.size(), 3u);
+    EXPECT_EQ(session.lastReuseCount(), 2u);
+    EXPECT_EQ(diag.getErrorCount(), 0u);
+
+    EXPECT_EQ(static_cast<ast::FuncDecl&>(*mod->declarations[0]).name, "a");
+    EXPECT_EQ(static_cast<ast::FuncDecl&>(*mod->declarations[1]).name, "b");
+    EXPECT_EQ(static_cast<ast::FuncDecl&>(*mod->declarations[2]).name, "c");
+}
+
+TEST(IncrementalTest, PrependAddsDeclaration) {
+    DiagnosticEngine diag;
+    diag.setHandler([](const Diagnostic&) {});
+    IncrementalSession session(diag);
+
+    session.open("func a() -> Int32 { return 1; }\n", "<test>");
+    auto* mod = session.applyEdit(
+        SourceEdit{0, 0, "func z() -> Int32 { return 0; }\n"});
+    ASSERT_EQ(mod->declarations.size(), 2u);
+    EXPECT_EQ(diag.getErrorCount(), 0u);
+}
+
+TEST(IncrementalTest, OutOfRangeEditFallsBackToFullReparse) {
+    DiagnosticEngine diag;
+    diag.setHandler([](const Diagnostic&) {});
+    IncrementalSession session(diag);
+
+    session.open("func a() -> Int32 { return 1; }\n", "<test>");
+    auto* mod = session.applyEdit(SourceEdit{10000, 5, "x"});
+    ASSERT_NE(mod, nullptr);
+    EXPECT_EQ(mod->declarations.size(), 1u);
+    EXPECT_EQ(session.lastReuseCount(), 0u);
+}
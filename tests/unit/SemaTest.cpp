@@ -1,11 +1,15 @@
 #include <gtest/gtest.h>
 
 #include "flux/AST/AST.h"
+#include "flux/AST/Expr.h"
+#include "flux/AST/Stmt.h"
 #include "flux/Common/Diagnostics.h"
 #include "flux/Lexer/Lexer.h"
 #include "flux/Parser/Parser.h"
 #include "flux/Sema/Sema.h"
 
+#include <optional>
+
 using namespace flux;
 
 // -----------------------------------------------------------------------
@@ -119,3 +123,146 @@ TEST(SemaTest, SingleFunction) {
     )");
     EXPECT_EQ(errors, 0u);
 }
+
+
+// -----------------------------------------------------------------------
+// Constant folding / CTFE (runs inside Sema::analyze)
+// -----------------------------------------------------------------------
+
+/// Value of the first statement's const initializer in declaration
+/// `declIndex` after analysis, when it folded to an integer literal.
+static std::optional<int64_t> foldedConstValue(std::string_view source,
+                                               size_t declIndex) {
+    DiagnosticEngine diag;
+    diag.setHandler([](const Diagnostic&) {});
+    Lexer lexer(source, "<test>", diag);
+    Parser parser(lexer, diag);
+    auto module = parser.parseModule();
+    Sema sema(diag);
+    sema.analyze(*module);
+
+    auto& fn = static_cast<ast::FuncDecl&>(*module->declarations[declIndex]);
+    auto& stmt = static_cast<ast::ConstStmt&>(*fn.body->statements[0]);
+    if (stmt.value->kind != ast::Expr::Kind::IntLiteral) {
+        return std::nullopt;
+    }
+    return static_cast<ast::IntLiteralExpr&>(*stmt.value).value;
+}
+
+TEST(SemaTest, CTFEFoldsConstCall) {
+    auto value = foldedConstValue(
+        "func add(a: Int64, b: Int64) -> Int64 { return a + b; }\n"
+        "func main() -> Int64 { const X: Int64 = add(2, 3); return X; }\n",
+        1);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, 5);
+}
+
+TEST(SemaTest, CTFEFoldsRecursion) {
+    auto value = foldedConstValue(
+        "func fib(n: Int64) -> Int64 {\n"
+        "  if n < 2 { return n; }\n"
+        "  return fib(n - 1) + fib(n - 2);\n"
+        "}\n"
+        "func main() -> Int64 { const X: Int64 = fib(20); return X; }\n",
+        1);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, 6765);
+}
+
+TEST(SemaTest, CTFEBlockScopedShadowing) {
+    // A shadowing let inside a nested block must not leak outward
+    auto value = foldedConstValue(
+        "func f() -> Int64 {\n"
+        "  let x: Int64 = 1;\n"
+        "  { let x: Int64 = 2; }\n"
+        "  return x;\n"
+        "}\n"
+        "func main() -> Int64 { const X: Int64 = f(); return X; }\n",
+        1);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, 1);
+}
+
+TEST(SemaTest, CTFEAssignmentInBlockPersists) {
+    // Assignment to an outer binding is not a new binding; it persists
+    auto value = foldedConstValue(
+        "func f() -> Int64 {\n"
+        "  let x: Int64 = 1;\n"
+        "  { x = 5; }\n"
+        "  return x;\n"
+        "}\n"
+        "func main() -> Int64 { const X: Int64 = f(); return X; }\n",
+        1);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, 5);
+}
+
+TEST(SemaTest, CTFEBailsOnUnboundedRecursion) {
+    // No base case: the step/depth budget must bail, not crash
+    auto value = foldedConstValue(
+        "func f(n: Int64) -> Int64 { return f(n - 1) + f(n - 2); }\n"
+        "func main() -> Int64 { const X: Int64 = f(1); return X; }\n",
+        1);
+    EXPECT_FALSE(value.has_value());
+}
+
+TEST(SemaTest, CTFELeavesMinDivMinusOneForRuntime) {
+    // INT64_MIN / -1 traps in hardware; the compiler must neither fold
+    // it nor SIGFPE evaluating it
+    auto value = foldedConstValue(
+        "func div(a: Int64, b: Int64) -> Int64 { return a / b; }\n"
+        "func main() -> Int64 {\n"
+        "  const X: Int64 = div(0 - 9223372036854775807 - 1, 0 - 1);\n"
+        "  return X;\n"
+        "}\n",
+        1);
+    EXPECT_FALSE(value.has_value());
+}
+
+TEST(SemaTest, CTFEDistinctFloatArgsDistinctResults) {
+    // Memo keys must not round doubles: nearby float arguments used to
+    // collide at 6 significant digits and replay the wrong constant
+    DiagnosticEngine diag;
+    diag.setHandler([](const Diagnostic&) {});
+    Lexer lexer(
+        "func id(x: Float64) -> Float64 { return x; }\n"
+        "func main() -> Float64 {\n"
+        "  let a: Float64 = id(1.00000011);\n"
+        "  let b: Float64 = id(1.00000012);\n"
+        "  return a;\n"
+        "}\n",
+        "<test>", diag);
+    Parser parser(lexer, diag);
+    auto module = parser.parseModule();
+    Sema sema(diag);
+    sema.analyze(*module);
+
+    auto& fn = static_cast<ast::FuncDecl&>(*module->declarations[1]);
+    auto& letA = static_cast<ast::LetStmt&>(*fn.body->statements[0]);
+    auto& letB = static_cast<ast::LetStmt&>(*fn.body->statements[1]);
+    ASSERT_EQ(letA.initializer->kind, ast::Expr::Kind::FloatLiteral);
+    ASSERT_EQ(letB.initializer->kind, ast::Expr::Kind::FloatLiteral);
+    EXPECT_NE(static_cast<ast::FloatLiteralExpr&>(*letA.initializer).value,
+              static_cast<ast::FloatLiteralExpr&>(*letB.initializer).value);
+}
+
+TEST(SemaTest, FolderArithmetic) {
+    auto value = foldedConstValue(
+        "func main() -> Int64 { const X: Int64 = 2 + 3 * 4 - 6 / 2; "
+        "return X; }\n",
+        0);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, 11);
+}
+
+TEST(SemaTest, FolderSurvivesMinDivMinusOne) {
+    // Must not fold (and must not crash); the expression reaches codegen
+    auto value = foldedConstValue(
+        "func main() -> Int64 {\n"
+        "  const X: Int64 = (0 - 9223372036854775807 - 1) / (0 - 1);\n"
+        "  return X;\n"
+        "}\n",
+        0);
+    EXPECT_FALSE(value.has_value());
+}
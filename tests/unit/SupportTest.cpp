@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include "flux/AST/SmallList.h"
+#include "flux/Common/StringInterner.h"
+#include "flux/Sema/NameResolution.h"
+#include "flux/Sema/SymbolTable.h"
+
+#include <string>
+#include <vector>
+
+using namespace flux;
+
+// -----------------------------------------------------------------------
+// StringInterner
+// -----------------------------------------------------------------------
+
+TEST(StringInternerTest, SameSpellingSameID) {
+    StringInterner interner;
+    SymbolID a = interner.intern("alpha");
+    SymbolID b = interner.intern("beta");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(interner.intern("alpha"), a);
+    EXPECT_EQ(interner.intern("beta"), b);
+    EXPECT_EQ(interner.size(), 2u);
+}
+
+TEST(StringInternerTest, TextRoundTrip) {
+    StringInterner interner;
+    SymbolID id = interner.intern("round_trip");
+    EXPECT_EQ(interner.text(id), "round_trip");
+    EXPECT_EQ(interner.text(kInvalidSymbolID), "");
+    EXPECT_EQ(interner.text(id + 100), "");
+}
+
+TEST(StringInternerTest, ViewsStableAcrossGrowth) {
+    StringInterner interner;
+    SymbolID first = interner.intern("first");
+    std::string_view view = interner.text(first);
+    // Force many chunk allocations
+    for (int i = 0; i < 10000; ++i) {
+        interner.intern("sym_" + std::to_string(i));
+    }
+    EXPECT_EQ(view, "first");
+    EXPECT_EQ(interner.text(first), "first");
+}
+
+// -----------------------------------------------------------------------
+// FlatSymbolMap
+// -----------------------------------------------------------------------
+
+TEST(FlatSymbolMapTest, InsertFindAndDuplicates) {
+    FlatSymbolMap<int> map;
+    EXPECT_TRUE(map.insert(1, 10));
+    EXPECT_TRUE(map.insert(2, 20));
+    EXPECT_FALSE(map.insert(1, 99)); // duplicate key refused
+    ASSERT_NE(map.find(1), nullptr);
+    EXPECT_EQ(*map.find(1), 10);
+    EXPECT_EQ(map.find(3), nullptr);
+    EXPECT_EQ(map.find(kInvalidSymbolID), nullptr);
+    EXPECT_EQ(map.size(), 2u);
+}
+
+TEST(FlatSymbolMapTest, GrowsPastInlineCapacity) {
+    FlatSymbolMap<int> map;
+    for (SymbolID id = 1; id <= 1000; ++id) {
+        EXPECT_TRUE(map.insert(id, static_cast<int>(id * 3)));
+    }
+    EXPECT_EQ(map.size(), 1000u);
+    for (SymbolID id = 1; id <= 1000; ++id) {
+        ASSERT_NE(map.find(id), nullptr) << "id " << id;
+        EXPECT_EQ(*map.find(id), static_cast<int>(id * 3));
+    }
+}
+
+TEST(FlatSymbolMapTest, IterationVisitsEveryEntryOnce) {
+    FlatSymbolMap<int> map;
+    for (SymbolID id = 1; id <= 100; ++id) {
+        map.insert(id, 1);
+    }
+    size_t count = 0;
+    uint64_t keySum = 0;
+    for (auto &[id, value] : map) {
+        ++count;
+        keySum += id;
+        EXPECT_EQ(value, 1);
+    }
+    EXPECT_EQ(count, 100u);
+    EXPECT_EQ(keySum, 100u * 101u / 2u);
+}
+
+TEST(FlatSymbolMapTest, ScopeLookupChainsToParent) {
+    Scope outer("outer");
+    Scope inner("inner", &outer);
+
+    Symbol sym;
+    sym.name = "x";
+    sym.kind = Symbol::Kind::Variable;
+    EXPECT_TRUE(outer.insert("x", sym));
+
+    ASSERT_NE(inner.lookup("x"), nullptr);
+    EXPECT_EQ(inner.lookup("x")->name, "x");
+    EXPECT_EQ(inner.lookup("missing"), nullptr);
+}
+
+// -----------------------------------------------------------------------
+// SmallList
+// -----------------------------------------------------------------------
+
+TEST(SmallListTest, InlineThenSpill) {
+    ast::SmallList<int, 4> list;
+    EXPECT_TRUE(list.empty());
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(i);
+    }
+    EXPECT_EQ(list.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(list[static_cast<size_t>(i)], i);
+    }
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_EQ(list.back(), 99);
+}
+
+TEST(SmallListTest, MoveStealsHeapAndCopiesInline) {
+    // Inline case: elements move element-wise
+    ast::SmallList<std::string, 4> small;
+    small.push_back("a");
+    small.push_back("b");
+    ast::SmallList<std::string, 4> movedSmall(std::move(small));
+    ASSERT_EQ(movedSmall.size(), 2u);
+    EXPECT_EQ(movedSmall[0], "a");
+    EXPECT_EQ(small.size(), 0u);
+
+    // Spilled case: the heap block transfers wholesale
+    ast::SmallList<std::string, 4> big;
+    for (int i = 0; i < 32; ++i) {
+        big.push_back("elem_" + std::to_string(i));
+    }
+    ast::SmallList<std::string, 4> movedBig(std::move(big));
+    ASSERT_EQ(movedBig.size(), 32u);
+    EXPECT_EQ(movedBig[31], "elem_31");
+    EXPECT_EQ(big.size(), 0u);
+}
+
+TEST(SmallListTest, MoveAssignAndClear) {
+    ast::SmallList<int, 4> list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    ast::SmallList<int, 4> other;
+    other.push_back(42);
+    other = std::move(list);
+    ASSERT_EQ(other.size(), 10u);
+    EXPECT_EQ(other[9], 9);
+
+    other.clear();
+    EXPECT_TRUE(other.empty());
+    other.push_back(7);
+    EXPECT_EQ(other.back(), 7);
+}
+
+TEST(SmallListTest, RangeForMatchesIndexing) {
+    ast::SmallList<int, 4> list;
+    for (int i = 0; i < 20; ++i) {
+        list.push_back(i * 2);
+    }
+    int expected = 0;
+    for (int value : list) {
+        EXPECT_EQ(value, expected);
+        expected += 2;
+    }
+}
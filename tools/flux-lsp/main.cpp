@@ -0,0 +1,421 @@
+/// flux-lsp — Language Server Protocol server for Flux.
+///
+/// Speaks JSON-RPC over stdio (Content-Length framing) and keeps the
+/// parsed module and Sema's symbol table resident per open document, so
+/// diagnostics, hover, and go-to-definition answer from in-memory state
+/// instead of re-running the compiler per request.
+///
+/// Supported requests:
+///   initialize / initialized / shutdown / exit
+///   textDocument/didOpen, didChange (full sync), didClose
+///     -> textDocument/publishDiagnostics
+///   textDocument/hover        (symbol kind and declared type)
+///   textDocument/definition   (declaration location)
+///
+/// The JSON handling below is a purpose-built scanner for the handful
+/// of fields the protocol subset needs; it is not a general JSON
+/// parser.
+
+#include "flux/Common/Diagnostics.h"
+#include "flux/Lexer/Lexer.h"
+#include "flux/Parser/Parser.h"
+#include "flux/Sema/Sema.h"
+
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ============================================================================
+// Minimal JSON helpers
+// ============================================================================
+
+/// Extract the string value of `"key":"..."` (first occurrence after
+/// `from`), decoding the common escapes. Returns empty when absent.
+std::string jsonString(const std::string &body, const std::string &key,
+                       size_t from = 0) {
+  std::string needle = "\"" + key + "\"";
+  size_t pos = body.find(needle, from);
+  if (pos == std::string::npos) {
+    return {};
+  }
+  pos = body.find(':', pos + needle.size());
+  if (pos == std::string::npos) {
+    return {};
+  }
+  pos = body.find('"', pos);
+  if (pos == std::string::npos) {
+    return {};
+  }
+  ++pos;
+
+  std::string result;
+  while (pos < body.size() && body[pos] != '"') {
+    char c = body[pos];
+    if (c == '\\' && pos + 1 < body.size()) {
+      char esc = body[pos + 1];
+      switch (esc) {
+      case 'n': result += '\n'; break;
+      case 't': result += '\t'; break;
+      case 'r': result += '\r'; break;
+      case '"': result += '"'; break;
+      case '\\': result += '\\'; break;
+      case '/': result += '/'; break;
+      default: result += esc; break;
+      }
+      pos += 2;
+    } else {
+      result += c;
+      ++pos;
+    }
+  }
+  return result;
+}
+
+/// Extract an integer field `"key": 123`.
+int64_t jsonInt(const std::string &body, const std::string &key,
+                int64_t fallback = -1, size_t from = 0) {
+  std::string needle = "\"" + key + "\"";
+  size_t pos = body.find(needle, from);
+  if (pos == std::string::npos) {
+    return fallback;
+  }
+  pos = body.find(':', pos + needle.size());
+  if (pos == std::string::npos) {
+    return fallback;
+  }
+  ++pos;
+  while (pos < body.size() && std::isspace(static_cast<unsigned char>(
+                                  body[pos]))) {
+    ++pos;
+  }
+  bool negative = pos < body.size() && body[pos] == '-';
+  if (negative) {
+    ++pos;
+  }
+  int64_t value = 0;
+  bool any = false;
+  while (pos < body.size() &&
+         std::isdigit(static_cast<unsigned char>(body[pos]))) {
+    value = value * 10 + (body[pos] - '0');
+    ++pos;
+    any = true;
+  }
+  return any ? (negative ? -value : value) : fallback;
+}
+
+std::string jsonEscape(const std::string &text) {
+  std::string result;
+  for (char c : text) {
+    switch (c) {
+    case '"': result += "\\\""; break;
+    case '\\': result += "\\\\"; break;
+    case '\n': result += "\\n"; break;
+    case '\t': result += "\\t"; break;
+    case '\r': result += "\\r"; break;
+    default: result += c; break;
+    }
+  }
+  return result;
+}
+
+// ============================================================================
+// Transport
+// ============================================================================
+
+bool readMessage(std::string &body) {
+  size_t contentLength = 0;
+  std::string line;
+  while (std::getline(std::cin, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      break; // end of headers
+    }
+    if (line.rfind("Content-Length:", 0) == 0) {
+      contentLength = static_cast<size_t>(
+          std::stoull(line.substr(15)));
+    }
+  }
+  if (!std::cin || contentLength == 0) {
+    return false;
+  }
+  body.resize(contentLength);
+  std::cin.read(body.data(), static_cast<std::streamsize>(contentLength));
+  return static_cast<size_t>(std::cin.gcount()) == contentLength;
+}
+
+void writeMessage(const std::string &body) {
+  std::cout << "Content-Length: " << body.size() << "\r\n\r\n" << body;
+  std::cout.flush();
+}
+
+// ============================================================================
+// Document state
+// ============================================================================
+
+/// Everything the server keeps warm for one open document.
+struct DocumentState {
+  std::string uri;
+  std::string text;
+  std::unique_ptr<flux::DiagnosticEngine> diag;
+  std::unique_ptr<flux::Sema> sema;
+  std::unique_ptr<flux::ast::Module> module;
+
+  /// Re-run the front end and refresh the resident analysis state.
+  void analyze() {
+    diag = std::make_unique<flux::DiagnosticEngine>();
+    diag->setHandler([](const flux::Diagnostic &) {}); // collected, not printed
+
+    flux::Lexer lexer(text, uri, *diag);
+    flux::Parser parser(lexer, *diag);
+    module = parser.parseModule();
+    sema = std::make_unique<flux::Sema>(*diag);
+    sema->analyze(*module);
+  }
+};
+
+std::map<std::string, DocumentState> documents;
+
+// ---- Position mapping (LSP is 0-based line/character) ----
+
+size_t positionToOffset(const std::string &text, int64_t line,
+                        int64_t character) {
+  size_t offset = 0;
+  while (line > 0 && offset < text.size()) {
+    if (text[offset] == '\n') {
+      --line;
+    }
+    ++offset;
+  }
+  while (character > 0 && offset < text.size() && text[offset] != '\n') {
+    --character;
+    ++offset;
+  }
+  return offset;
+}
+
+void offsetToPosition(const std::string &text, size_t offset, int64_t &line,
+                      int64_t &character) {
+  line = 0;
+  character = 0;
+  for (size_t i = 0; i < offset && i < text.size(); ++i) {
+    if (text[i] == '\n') {
+      ++line;
+      character = 0;
+    } else {
+      ++character;
+    }
+  }
+}
+
+/// The identifier under `offset`, or empty.
+std::string identifierAt(const std::string &text, size_t offset) {
+  auto isIdent = [](char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+  };
+  if (offset >= text.size() || !isIdent(text[offset])) {
+    return {};
+  }
+  size_t begin = offset;
+  while (begin > 0 && isIdent(text[begin - 1])) {
+    --begin;
+  }
+  size_t end = offset;
+  while (end < text.size() && isIdent(text[end])) {
+    ++end;
+  }
+  return text.substr(begin, end - begin);
+}
+
+// ============================================================================
+// Features
+// ============================================================================
+
+void publishDiagnostics(const DocumentState &doc) {
+  std::ostringstream out;
+  out << R"({"jsonrpc":"2.0","method":"textDocument/publishDiagnostics",)"
+      << R"("params":{"uri":")" << jsonEscape(doc.uri)
+      << R"(","diagnostics":[)";
+
+  bool first = true;
+  for (const auto &diagnostic : doc.diag->diagnostics()) {
+    // Session lexers use locationBase 1, so raw - 1 is the byte offset
+    size_t offset =
+        diagnostic.location.isValid() ? diagnostic.location.raw - 1 : 0;
+    int64_t line, character;
+    offsetToPosition(doc.text, offset, line, character);
+
+    int severity;
+    switch (diagnostic.severity) {
+    case flux::DiagnosticSeverity::Error:
+    case flux::DiagnosticSeverity::Fatal:
+      severity = 1;
+      break;
+    case flux::DiagnosticSeverity::Warning:
+      severity = 2;
+      break;
+    default:
+      severity = 3;
+      break;
+    }
+
+    if (!first) {
+      out << ",";
+    }
+    first = false;
+    out << R"({"range":{"start":{"line":)" << line << R"(,"character":)"
+        << character << R"(},"end":{"line":)" << line << R"(,"character":)"
+        << character + 1 << R"(}},"severity":)" << severity
+        << R"(,"message":")" << jsonEscape(diagnostic.renderMessage())
+        << R"("})";
+  }
+  out << "]}}";
+  writeMessage(out.str());
+}
+
+const flux::Symbol *lookupSymbol(DocumentState &doc, const std::string &name) {
+  if (!doc.sema || name.empty()) {
+    return nullptr;
+  }
+  return doc.sema->getGlobalScope().lookup(name);
+}
+
+std::string symbolKindName(flux::Symbol::Kind kind) {
+  switch (kind) {
+  case flux::Symbol::Kind::Variable: return "variable";
+  case flux::Symbol::Kind::Function: return "function";
+  case flux::Symbol::Kind::Struct: return "struct";
+  case flux::Symbol::Kind::Class: return "class";
+  case flux::Symbol::Kind::Enum: return "enum";
+  case flux::Symbol::Kind::Trait: return "trait";
+  case flux::Symbol::Kind::TypeAlias: return "type alias";
+  case flux::Symbol::Kind::GenericParam: return "generic parameter";
+  case flux::Symbol::Kind::Module: return "module";
+  case flux::Symbol::Kind::EnumVariant: return "enum variant";
+  }
+  return "symbol";
+}
+
+void handleHover(DocumentState &doc, int64_t id, int64_t line,
+                 int64_t character) {
+  size_t offset = positionToOffset(doc.text, line, character);
+  std::string name = identifierAt(doc.text, offset);
+  const flux::Symbol *sym = lookupSymbol(doc, name);
+
+  std::ostringstream out;
+  out << R"({"jsonrpc":"2.0","id":)" << id << R"(,"result":)";
+  if (sym) {
+    std::string contents = symbolKindName(sym->kind) + " " + sym->name;
+    if (!sym->typeName.empty()) {
+      contents += ": " + sym->typeName;
+    }
+    if (!sym->returnType.empty()) {
+      contents += " -> " + sym->returnType;
+    }
+    out << R"({"contents":{"kind":"plaintext","value":")"
+        << jsonEscape(contents) << R"("}})";
+  } else {
+    out << "null";
+  }
+  out << "}";
+  writeMessage(out.str());
+}
+
+void handleDefinition(DocumentState &doc, int64_t id, int64_t line,
+                      int64_t character) {
+  size_t offset = positionToOffset(doc.text, line, character);
+  std::string name = identifierAt(doc.text, offset);
+  const flux::Symbol *sym = lookupSymbol(doc, name);
+
+  std::ostringstream out;
+  out << R"({"jsonrpc":"2.0","id":)" << id << R"(,"result":)";
+  if (sym && sym->location.isValid()) {
+    size_t declOffset = sym->location.raw - 1;
+    int64_t declLine, declCharacter;
+    offsetToPosition(doc.text, declOffset, declLine, declCharacter);
+    out << R"({"uri":")" << jsonEscape(doc.uri)
+        << R"(","range":{"start":{"line":)" << declLine << R"(,"character":)"
+        << declCharacter << R"(},"end":{"line":)" << declLine
+        << R"(,"character":)" << declCharacter + static_cast<int64_t>(name.size())
+        << "}}}";
+  } else {
+    out << "null";
+  }
+  out << "}";
+  writeMessage(out.str());
+}
+
+} // anonymous namespace
+
+int main() {
+  std::string body;
+  while (readMessage(body)) {
+    std::string method = jsonString(body, "method");
+    int64_t id = jsonInt(body, "id");
+
+    if (method == "initialize") {
+      std::ostringstream out;
+      out << R"({"jsonrpc":"2.0","id":)" << id << R"(,"result":{)"
+          << R"("capabilities":{)"
+          << R"("textDocumentSync":1,)" // full document sync
+          << R"("hoverProvider":true,)"
+          << R"("definitionProvider":true)"
+          << R"(},"serverInfo":{"name":"flux-lsp","version":"0.1.0"}}})";
+      writeMessage(out.str());
+    } else if (method == "shutdown") {
+      std::ostringstream out;
+      out << R"({"jsonrpc":"2.0","id":)" << id << R"(,"result":null})";
+      writeMessage(out.str());
+    } else if (method == "exit") {
+      break;
+    } else if (method == "textDocument/didOpen") {
+      std::string uri = jsonString(body, "uri");
+      DocumentState &doc = documents[uri];
+      doc.uri = uri;
+      doc.text = jsonString(body, "text");
+      doc.analyze();
+      publishDiagnostics(doc);
+    } else if (method == "textDocument/didChange") {
+      std::string uri = jsonString(body, "uri");
+      auto it = documents.find(uri);
+      if (it != documents.end()) {
+        // Full sync: the last "text" field is the new content
+        it->second.text = jsonString(body, "text");
+        it->second.analyze();
+        publishDiagnostics(it->second);
+      }
+    } else if (method == "textDocument/didClose") {
+      documents.erase(jsonString(body, "uri"));
+    } else if (method == "textDocument/hover" ||
+               method == "textDocument/definition") {
+      std::string uri = jsonString(body, "uri");
+      int64_t line = jsonInt(body, "line", 0);
+      int64_t character = jsonInt(body, "character", 0);
+      auto it = documents.find(uri);
+      if (it == documents.end()) {
+        std::ostringstream out;
+        out << R"({"jsonrpc":"2.0","id":)" << id << R"(,"result":null})";
+        writeMessage(out.str());
+      } else if (method == "textDocument/hover") {
+        handleHover(it->second, id, line, character);
+      } else {
+        handleDefinition(it->second, id, line, character);
+      }
+    } else if (id >= 0) {
+      // Politely decline unknown requests (notifications are ignored)
+      std::ostringstream out;
+      out << R"({"jsonrpc":"2.0","id":)" << id
+          << R"(,"error":{"code":-32601,"message":"method not found"}})";
+      writeMessage(out.str());
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,152 @@
+/// flux-order — turn runtime function traces into layout inputs.
+///
+/// Ingests the binary trace written by flux_trace_flush ("FTR\1"),
+/// computes a call-affinity layout (functions ordered by first touch,
+/// so startup and hot paths walk text forward), and writes:
+///
+///   <out>.order  one symbol per line, hottest-first — feed to the
+///                linker via flux --order-file=<out>.order
+///   <out>.cold   functions whose event share is below the cold
+///                threshold — feed to flux --cold-functions=<out>.cold
+///
+/// Usage: flux-order <trace> [-o <out-base>] [--cold-threshold <N>]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct FunctionStats {
+  std::string name;
+  uint64_t events = 0;
+  uint64_t firstTouch = UINT64_MAX; // earliest timestamp seen
+};
+
+bool readTrace(const std::string &path, std::vector<FunctionStats> &stats) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::ostringstream buffer;
+  buffer << in.rdbuf();
+  std::string data = buffer.str();
+
+  if (data.size() < 8 || std::memcmp(data.data(), "FTR\x01", 4) != 0) {
+    return false;
+  }
+  size_t pos = 4;
+
+  auto readU32 = [&](uint32_t &value) {
+    if (data.size() - pos < 4) {
+      return false;
+    }
+    std::memcpy(&value, data.data() + pos, 4);
+    pos += 4;
+    return true;
+  };
+
+  // Name table
+  uint32_t count;
+  if (!readU32(count)) {
+    return false;
+  }
+  stats.resize(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t size;
+    if (!readU32(size) || data.size() - pos < size) {
+      return false;
+    }
+    stats[i].name.assign(data.data() + pos, size);
+    pos += size;
+  }
+
+  // Events: {u32 id | exit bit, u64 timestamp}
+  while (data.size() - pos >= 12) {
+    uint32_t idAndFlag;
+    std::memcpy(&idAndFlag, data.data() + pos, 4);
+    uint64_t timestamp;
+    std::memcpy(&timestamp, data.data() + pos + 4, 8);
+    pos += 12;
+
+    uint32_t id = idAndFlag & 0x7FFFFFFFu;
+    if (id == 0 || id > stats.size()) {
+      continue;
+    }
+    FunctionStats &fn = stats[id - 1];
+    ++fn.events;
+    if (timestamp < fn.firstTouch) {
+      fn.firstTouch = timestamp;
+    }
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+  std::string tracePath;
+  std::string outBase = "flux";
+  uint64_t coldThreshold = 2; // <= this many events counts as cold
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-o" && i + 1 < argc) {
+      outBase = argv[++i];
+    } else if (arg == "--cold-threshold" && i + 1 < argc) {
+      coldThreshold = static_cast<uint64_t>(std::atoll(argv[++i]));
+    } else if (arg[0] != '-') {
+      tracePath = arg;
+    } else {
+      std::cerr << "usage: flux-order <trace> [-o <out-base>] "
+                   "[--cold-threshold <N>]\n";
+      return 1;
+    }
+  }
+  if (tracePath.empty()) {
+    std::cerr << "error: no trace file given\n";
+    return 1;
+  }
+
+  std::vector<FunctionStats> stats;
+  if (!readTrace(tracePath, stats)) {
+    std::cerr << "error: could not read trace '" << tracePath << "'\n";
+    return 1;
+  }
+
+  // Affinity layout: functions in first-touch order, so call neighbors
+  // land on adjacent text pages; untouched functions follow, then cold
+  std::vector<const FunctionStats *> hot;
+  std::vector<const FunctionStats *> cold;
+  for (const auto &fn : stats) {
+    if (fn.events > coldThreshold) {
+      hot.push_back(&fn);
+    } else {
+      cold.push_back(&fn);
+    }
+  }
+  std::sort(hot.begin(), hot.end(),
+            [](const FunctionStats *a, const FunctionStats *b) {
+              return a->firstTouch < b->firstTouch;
+            });
+
+  std::ofstream orderFile(outBase + ".order", std::ios::trunc);
+  for (const auto *fn : hot) {
+    orderFile << fn->name << "\n";
+  }
+  std::ofstream coldFile(outBase + ".cold", std::ios::trunc);
+  for (const auto *fn : cold) {
+    coldFile << fn->name << "\n";
+  }
+
+  std::cout << "flux-order: " << hot.size() << " hot, " << cold.size()
+            << " cold -> " << outBase << ".order / " << outBase
+            << ".cold\n";
+  return 0;
+}
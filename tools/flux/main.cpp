@@ -8,29 +8,59 @@
 ///   --emit <format>   Output format: llvm-ir, bitcode, asm, obj, exe (default:
 ///   exe) -O<level>         Optimization level: 0, 1, 2, 3 (default: 0)
 ///   --target <triple> Target triple (default: host)
+///   --native          Optimize for this exact host CPU and its features
+///   --features <str>  Extra target features (e.g. +avx2,-sse4.2)
 ///   --dump-ast        Dump the AST to stdout
 ///   --dump-tokens     Dump the token stream to stdout
 ///   --help            Show this help message
 ///   --version         Show version
 
 #include "flux/AST/AST.h"
+#include "flux/AST/ASTSerializer.h"
+#include "flux/AST/ASTStatistics.h"
+#include "flux/Common/FilePrefetcher.h"
+#include "flux/Common/StringInterner.h"
 #include "flux/CodeGen/CodeGen.h"
 #include "flux/Common/Diagnostics.h"
+#include "flux/Common/Stats.h"
 
 #include "flux/Common/SourceLocation.h"
 #include "flux/Lexer/Lexer.h"
 #include "flux/Parser/Parser.h"
+#include "flux/Sema/ModuleInterface.h"
 #include "flux/Sema/Sema.h"
+#include "flux_runtime.h"
 #include <memory>
 
+#ifdef FLUX_HAVE_LLD
+#include <lld/Common/Driver.h>
+#endif
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/TimeProfiler.h>
+
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#ifndef _WIN32
+#include <csignal>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -45,12 +75,52 @@ namespace {
 
 struct DriverOptions {
   std::string inputFile;
+  bool noCache = false;            // --no-cache: bypass the object cache
+  std::vector<std::string> inputs; // `flux build` inputs (files or dirs)
+  bool buildMode = false;          // `flux build`: parallel multi-file compile
+  bool runMode = false;            // `flux run`: execute in-process via ORC
+  bool replMode = false;           // `flux repl`: interactive session
+  unsigned jobs = 0;               // worker count (0 = hardware concurrency)
   std::string outputFile;
   std::string targetTriple;
   flux::OutputFormat outputFormat = flux::OutputFormat::Executable;
   int optimizationLevel = 0;
+  bool fastDebug = false;          // -Odebug: fastest possible backend
   bool dumpAST = false;
   bool dumpTokens = false;
+  bool dumpBinary = false;       // --dump-tokens=binary / --dump-ast=binary
+  bool emitInterface = false;    // --emit-interface: write <stem>.fli
+  bool pipeline = false;         // --pipeline: overlap parse and sema
+  bool lto = false;              // --lto: cross-module LTO in build mode
+  bool watch = false;            // --watch: incremental rebuild on change
+  bool parallelCodegen = false;  // --parallel-codegen: shard the backend
+  bool incremental = false;      // --incremental: one hash-guided pass
+  bool nativeCPU = false;        // --native: host CPU + feature detection
+  std::string features;          // --features <str>
+  bool profileGenerate = false;  // --profile-generate
+  std::string profileUse;        // --profile-use=<profdata>
+  uint32_t errorLimit = 0;       // --error-limit=N (0 = unlimited)
+  bool warnPadding = false;      // --warn-padding
+  bool memStats = false;         // --mem-stats: front-end memory JSON
+  std::string checks;            // --checks=fast|full|off
+  bool vectorizeReport = false;  // --vectorize-report
+  bool timePerDecl = false;      // --time-per-decl
+  bool deterministic = false;    // --deterministic: bit-identical output
+  bool managedHeap = false;      // --runtime=gc
+  bool instrumentFunctions = false; // --instrument-functions
+  bool fastMath = false;         // --ffast-math
+  bool fpContractFast = false;   // --ffp-contract=fast
+  bool reportChecks = false;     // --report-checks
+  bool stripDead = false;        // --strip-dead
+  std::string orderFile;         // --order-file=<f>: symbol ordering
+  std::string coldFunctionsFile; // --cold-functions=<f>
+  std::string distWorkerPort;    // --dist-worker=<port>: serve compiles
+  std::vector<std::string> distHosts; // --dist=<host:port,...>
+  bool stats = false;            // --stats: per-phase timing/memory report
+  std::string timeTraceFile;     // --time-trace[=file]: Chrome trace JSON
+  bool timeTrace = false;
+  bool daemonMode = false;       // --daemon: run as a persistent server
+  bool useDaemon = false;        // --use-daemon: forward to the server
   bool showHelp = false;
   bool showVersion = false;
 };
@@ -59,14 +129,59 @@ void printUsage() {
   std::cout << R"(Flux Compiler v0.1.0
 
 Usage: flux <input.fl> [options]
+       flux build <dir | files...> [options]
+       flux run <input.fl>
+       flux repl
+
+In build mode every .fl file is compiled to an object in parallel
+(-j workers), then linked once into a single executable. Run mode
+JIT-compiles and executes the program in-process — nothing is written
+to disk.
 
 Options:
   -o <file>         Output file path
+  -j <N>            Number of parallel jobs in build mode (default: all cores)
+  --no-cache        Bypass the content-addressed object cache
+  --lto             Build mode: link module bitcode and optimize as one unit
+  --watch           Build mode: watch files and rebuild only what changed
+  --parallel-codegen  Shard backend work across cores (-j) for one file
+  --incremental     Build mode: one pass guided by content/interface hashes
   --emit <format>   Output format: llvm-ir, bitcode, asm, obj, exe (default: exe)
   -O0, -O1, -O2, -O3  Optimization level (default: -O0)
+  -Odebug           Fastest compile: FastISel + fast regalloc, no opt
   --target <triple> Target triple (default: host)
-  --dump-ast        Print the AST to stdout
-  --dump-tokens     Print the token stream to stdout
+  --native          Optimize for this exact host CPU and its features
+  --features <str>  Extra target features (e.g. +avx2,-sse4.2)
+  --dump-ast[=binary]     Dump the AST (text, or compact binary records)
+  --dump-tokens[=binary]  Dump the token stream (text or binary)
+  --emit-interface  Also write a binary module interface (<input>.fli)
+  --profile-generate  Instrument for PGO (writes default_%m.profraw at run)
+  --profile-use=<f>   Optimize using an indexed .profdata file
+  --pipeline        Overlap parsing with name resolution / type checking
+  --daemon          Run as a persistent compile server (keeps LLVM warm)
+  --use-daemon      Forward this invocation to a running --daemon server
+  --error-limit=<N> Stop after N errors (deduplicated; 0 = unlimited)
+  --warn-padding    Warn about bytes lost to struct field padding
+  --mem-stats       Report front-end memory usage as JSON
+  --vectorize-report  Surface LLVM loop-vectorizer remarks as notes
+  --time-per-decl   Attribute compile time to top-level declarations
+  --deterministic   Bit-identical outputs for content-addressed caches
+  --runtime=gc      Allocate through the managed generational heap
+  --instrument-functions  Emit entry/exit probes into the runtime trace
+  --ffast-math      Relax FP semantics module-wide (see also @fastmath)
+  --ffp-contract=fast  Allow FMA contraction without full fast-math
+  --report-checks   Summarize bounds checks eliminated vs retained
+  --strip-dead      Emit only declarations reachable from main (plus
+                    gc-sections at link) so unused imports cost nothing
+  --order-file=<f>  Link with a flux-order symbol ordering file
+  --cold-functions=<f>  Mark the listed functions cold (from flux-order)
+  --dist-worker=<p> Run as a remote compile worker on TCP port <p>
+  --dist=<hosts>    Build mode: dispatch compiles to host:port workers
+                    (comma separated), falling back to local compiles
+  --checks=<tier>   Assertion lowering: full (default at -O0/-O1),
+                    fast (default at -O2+; cold-outlined), or off
+  --stats           Report per-phase wall time, counters, and peak RSS
+  --time-trace[=f]  Write a Chrome trace JSON (includes LLVM pass times)
   --help            Show this help message
   --version         Show version information
 )";
@@ -83,7 +198,20 @@ DriverOptions parseArgs(int argc, char *argv[]) {
   for (int i = 1; i < argc; ++i) {
     std::string arg = argv[i];
 
-    if (arg == "--help" || arg == "-h") {
+    if (arg == "build" && !opts.buildMode && !opts.runMode &&
+        opts.inputFile.empty() && opts.inputs.empty()) {
+      opts.buildMode = true;
+    } else if (arg == "run" && !opts.buildMode && !opts.runMode &&
+               opts.inputFile.empty()) {
+      opts.runMode = true;
+    } else if (arg == "repl" && !opts.buildMode && !opts.runMode &&
+               opts.inputFile.empty()) {
+      opts.replMode = true;
+    } else if (arg == "-j" && i + 1 < argc) {
+      opts.jobs = static_cast<unsigned>(std::atoi(argv[++i]));
+    } else if (arg == "--no-cache") {
+      opts.noCache = true;
+    } else if (arg == "--help" || arg == "-h") {
       opts.showHelp = true;
     } else if (arg == "--version" || arg == "-v") {
       opts.showVersion = true;
@@ -109,6 +237,9 @@ DriverOptions parseArgs(int argc, char *argv[]) {
       opts.targetTriple = argv[++i];
     } else if (arg == "-O0") {
       opts.optimizationLevel = 0;
+    } else if (arg == "-Odebug") {
+      opts.optimizationLevel = 0;
+      opts.fastDebug = true;
     } else if (arg == "-O1") {
       opts.optimizationLevel = 1;
     } else if (arg == "-O2") {
@@ -117,10 +248,97 @@ DriverOptions parseArgs(int argc, char *argv[]) {
       opts.optimizationLevel = 3;
     } else if (arg == "--dump-ast") {
       opts.dumpAST = true;
+    } else if (arg == "--dump-ast=binary") {
+      opts.dumpAST = true;
+      opts.dumpBinary = true;
+    } else if (arg == "--dump-tokens=binary") {
+      opts.dumpTokens = true;
+      opts.dumpBinary = true;
+    } else if (arg == "--stats") {
+      opts.stats = true;
+    } else if (arg.rfind("--error-limit=", 0) == 0) {
+      opts.errorLimit = static_cast<uint32_t>(std::atoi(arg.c_str() + 14));
+    } else if (arg == "--warn-padding") {
+      opts.warnPadding = true;
+    } else if (arg == "--mem-stats") {
+      opts.memStats = true;
+    } else if (arg == "--vectorize-report") {
+      opts.vectorizeReport = true;
+    } else if (arg == "--time-per-decl") {
+      opts.timePerDecl = true;
+    } else if (arg == "--deterministic") {
+      opts.deterministic = true;
+    } else if (arg == "--runtime=gc") {
+      opts.managedHeap = true;
+    } else if (arg == "--instrument-functions") {
+      opts.instrumentFunctions = true;
+    } else if (arg == "--ffast-math") {
+      opts.fastMath = true;
+    } else if (arg == "--ffp-contract=fast") {
+      opts.fpContractFast = true;
+    } else if (arg == "--report-checks") {
+      opts.reportChecks = true;
+    } else if (arg == "--strip-dead") {
+      opts.stripDead = true;
+    } else if (arg.rfind("--order-file=", 0) == 0) {
+      opts.orderFile = arg.substr(13);
+    } else if (arg.rfind("--cold-functions=", 0) == 0) {
+      opts.coldFunctionsFile = arg.substr(17);
+    } else if (arg.rfind("--dist-worker=", 0) == 0) {
+      opts.distWorkerPort = arg.substr(14);
+    } else if (arg.rfind("--dist=", 0) == 0) {
+      std::stringstream hosts(arg.substr(7));
+      std::string host;
+      while (std::getline(hosts, host, ',')) {
+        if (!host.empty()) {
+          opts.distHosts.push_back(host);
+        }
+      }
+    } else if (arg.rfind("--checks=", 0) == 0) {
+      opts.checks = arg.substr(9);
+      if (opts.checks != "fast" && opts.checks != "full" &&
+          opts.checks != "off") {
+        std::cerr << "error: unknown check tier '" << opts.checks
+                  << "'\n";
+        std::exit(1);
+      }
+    } else if (arg == "--emit-interface") {
+      opts.emitInterface = true;
+    } else if (arg == "--pipeline") {
+      opts.pipeline = true;
+    } else if (arg == "--lto") {
+      opts.lto = true;
+    } else if (arg == "--watch") {
+      opts.watch = true;
+    } else if (arg == "--parallel-codegen") {
+      opts.parallelCodegen = true;
+    } else if (arg == "--incremental") {
+      opts.incremental = true;
+    } else if (arg == "--daemon") {
+      opts.daemonMode = true;
+    } else if (arg == "--use-daemon") {
+      opts.useDaemon = true;
+    } else if (arg == "--native") {
+      opts.nativeCPU = true;
+    } else if (arg == "--features" && i + 1 < argc) {
+      opts.features = argv[++i];
+    } else if (arg == "--profile-generate") {
+      opts.profileGenerate = true;
+    } else if (arg.rfind("--profile-use=", 0) == 0) {
+      opts.profileUse = arg.substr(14);
+    } else if (arg == "--time-trace" || arg.rfind("--time-trace=", 0) == 0) {
+      opts.timeTrace = true;
+      if (arg.size() > 13 && arg[12] == '=') {
+        opts.timeTraceFile = arg.substr(13);
+      }
     } else if (arg == "--dump-tokens") {
       opts.dumpTokens = true;
     } else if (arg[0] != '-') {
-      opts.inputFile = arg;
+      if (opts.buildMode) {
+        opts.inputs.push_back(arg);
+      } else {
+        opts.inputFile = arg;
+      }
     } else {
       std::cerr << "error: unknown option '" << arg << "'\n";
       std::exit(1);
@@ -130,17 +348,6 @@ DriverOptions parseArgs(int argc, char *argv[]) {
   return opts;
 }
 
-std::string readFile(const std::string &path) {
-  std::ifstream file(path);
-  if (!file.is_open()) {
-    std::cerr << "error: could not open file '" << path << "'\n";
-    std::exit(1);
-  }
-  std::ostringstream ss;
-  ss << file.rdbuf();
-  return ss.str();
-}
-
 std::string deriveOutputFilename(const std::string &input,
                                  flux::OutputFormat format) {
   namespace fs = std::filesystem;
@@ -184,11 +391,1064 @@ std::filesystem::path getExecutablePath() {
   return std::filesystem::path();
 }
 
+// ============================================================================
+// Content-addressed object cache
+// ============================================================================
+//
+// Object files are cached under FLUX_CACHE_DIR (default ~/.cache/flux),
+// keyed by a hash of the source bytes, the codegen options, and the
+// compiler version. A hit short-circuits the entire pipeline.
+
+constexpr const char *kFluxVersion = "0.1.0";
+
+uint64_t fnv1aHash(uint64_t hash, const void *data, size_t size) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+uint64_t fnv1aHash(uint64_t hash, std::string_view text) {
+  return fnv1aHash(hash, text.data(), text.size());
+}
+
+/// The check tier actually in effect (the default depends on -O level).
+flux::CheckTier resolveCheckTier(const DriverOptions &opts) {
+  if (opts.checks == "off") {
+    return flux::CheckTier::Off;
+  }
+  if (opts.checks == "fast" ||
+      (opts.checks.empty() && opts.optimizationLevel >= 2)) {
+    return flux::CheckTier::Fast;
+  }
+  return flux::CheckTier::Full;
+}
+
+/// Every CodeGenOptions field the driver controls, in one place, so the
+/// single-file path, build workers, the LTO combine step, and the cache
+/// key can never disagree about what affects the object. The output
+/// format is the caller's business.
+flux::CodeGenOptions makeCodeGenOptions(const DriverOptions &opts) {
+  flux::CodeGenOptions cgOpts;
+  cgOpts.targetTriple = opts.targetTriple;
+  cgOpts.optimizationLevel = opts.optimizationLevel;
+  cgOpts.nativeCPU = opts.nativeCPU;
+  cgOpts.features = opts.features;
+  cgOpts.profileGenerate = opts.profileGenerate;
+  cgOpts.profileUse = opts.profileUse;
+  cgOpts.warnPadding = opts.warnPadding;
+  cgOpts.checks = resolveCheckTier(opts);
+  cgOpts.fastDebug = opts.fastDebug;
+  cgOpts.vectorizeReport = opts.vectorizeReport;
+  cgOpts.deterministic = opts.deterministic;
+  cgOpts.managedHeap = opts.managedHeap;
+  cgOpts.instrumentFunctions = opts.instrumentFunctions;
+  cgOpts.fastMath = opts.fastMath;
+  cgOpts.fpContractFast = opts.fpContractFast;
+  cgOpts.reportChecks = opts.reportChecks;
+  cgOpts.stripDead = opts.stripDead;
+  if (!opts.coldFunctionsFile.empty()) {
+    std::ifstream coldList(opts.coldFunctionsFile);
+    std::string name;
+    while (std::getline(coldList, name)) {
+      if (!name.empty()) {
+        cgOpts.coldFunctions.push_back(name);
+      }
+    }
+  }
+  return cgOpts;
+}
+
+/// Hash everything that can influence the produced object file.
+uint64_t objectCacheKey(std::string_view source, const DriverOptions &opts) {
+  // Hash the *resolved* codegen options — the same struct every compile
+  // path uses — so any flag that changes the object changes the key.
+  flux::CodeGenOptions cgOpts = makeCodeGenOptions(opts);
+
+  uint64_t hash = 14695981039346656037ull;
+  hash = fnv1aHash(hash, source);
+  hash = fnv1aHash(hash, kFluxVersion);
+  hash = fnv1aHash(hash, cgOpts.targetTriple);
+  hash = fnv1aHash(hash, cgOpts.cpu);
+  hash = fnv1aHash(hash, cgOpts.features);
+  hash = fnv1aHash(hash, cgOpts.profileUse);
+  hash = fnv1aHash(hash, &cgOpts.optimizationLevel,
+                   sizeof(cgOpts.optimizationLevel));
+  hash = fnv1aHash(hash, &cgOpts.checks, sizeof(cgOpts.checks));
+  for (const auto &name : cgOpts.coldFunctions) {
+    hash = fnv1aHash(hash, name);
+    hash = fnv1aHash(hash, "\0", 1);
+  }
+  // Boolean switches, one byte each in a fixed order
+  const bool flags[] = {
+      cgOpts.nativeCPU,     cgOpts.profileGenerate,
+      cgOpts.fastDebug,     cgOpts.deterministic,
+      cgOpts.managedHeap,   cgOpts.instrumentFunctions,
+      cgOpts.fastMath,      cgOpts.fpContractFast,
+      cgOpts.stripDead,     opts.lto,
+  };
+  hash = fnv1aHash(hash, flags, sizeof(flags));
+  return hash;
+}
+
+std::filesystem::path objectCacheDir() {
+  if (const char *dir = std::getenv("FLUX_CACHE_DIR")) {
+    return dir;
+  }
+#ifdef _WIN32
+  if (const char *localAppData = std::getenv("LOCALAPPDATA")) {
+    return std::filesystem::path(localAppData) / "flux" / "cache";
+  }
+#else
+  if (const char *home = std::getenv("HOME")) {
+    return std::filesystem::path(home) / ".cache" / "flux";
+  }
+#endif
+  return std::filesystem::path(".flux-cache");
+}
+
+std::filesystem::path objectCachePath(uint64_t key) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.o",
+                static_cast<unsigned long long>(key));
+  return objectCacheDir() / name;
+}
+
+/// Copy a cached object to `objFile` if present. Returns true on a hit.
+bool objectCacheLookup(uint64_t key, const std::string &objFile) {
+  std::error_code ec;
+  return std::filesystem::copy_file(
+      objectCachePath(key), objFile,
+      std::filesystem::copy_options::overwrite_existing, ec);
+}
+
+/// Store a freshly produced object under its key. Best-effort: a failure
+/// only loses the caching, never the build. Writes go through a unique
+/// temp name and a rename so parallel workers never see torn entries.
+void objectCacheStore(uint64_t key, const std::string &objFile) {
+  std::error_code ec;
+  std::filesystem::create_directories(objectCacheDir(), ec);
+  auto finalPath = objectCachePath(key);
+  auto tempPath = finalPath;
+  tempPath += "." + std::to_string(
+#ifdef _WIN32
+      GetCurrentProcessId()
+#else
+      static_cast<unsigned>(getpid())
+#endif
+  ) + ".tmp";
+  if (std::filesystem::copy_file(
+          objFile, tempPath,
+          std::filesystem::copy_options::overwrite_existing, ec)) {
+    std::filesystem::rename(tempPath, finalPath, ec);
+    if (ec) {
+      std::filesystem::remove(tempPath, ec);
+    }
+  }
+}
+
+/// Locate the Flux runtime static library next to the compiler.
+std::string findRuntimeLibrary() {
+  auto exeDir = getExecutablePath().parent_path();
+
+  std::vector<std::filesystem::path> searchDirs = {exeDir, exeDir / "../lib",
+                                                   exeDir / "lib"};
+  std::vector<std::string> libNames = {"libFluxRuntime.a", "FluxRuntime.lib"};
+
+  for (const auto &dir : searchDirs) {
+    for (const auto &name : libNames) {
+      auto p = dir / name;
+      if (std::filesystem::exists(p)) {
+        return p.string();
+      }
+    }
+  }
+  return {};
+}
+
+#if defined(FLUX_HAVE_LLD) && defined(__linux__)
+
+/// Find a CRT startup object in the usual multiarch locations.
+std::string findCRTObject(const char *name) {
+  static const char *kDirs[] = {
+      "/usr/lib/x86_64-linux-gnu",
+      "/usr/lib/aarch64-linux-gnu",
+      "/usr/lib64",
+      "/usr/lib",
+  };
+  for (const char *dir : kDirs) {
+    auto p = std::filesystem::path(dir) / name;
+    if (std::filesystem::exists(p)) {
+      return p.string();
+    }
+  }
+  return {};
+}
+
+/// Link in-process with liblld (ELF). Returns false if the link cannot be
+/// attempted (missing CRT objects) so the caller can fall back to the
+/// external linker; a real link failure prints lld's errors and exits
+/// non-zero like the external path would.
+bool tryLinkWithLLD(const std::vector<std::string> &objFiles,
+                    const std::string &outFile, const std::string &runtimePath,
+                    bool &attempted) {
+  attempted = false;
+
+  std::string crt1 = findCRTObject("crt1.o");
+  std::string crti = findCRTObject("crti.o");
+  std::string crtn = findCRTObject("crtn.o");
+  if (crt1.empty() || crti.empty() || crtn.empty()) {
+    return false;
+  }
+
+  std::vector<const char *> args;
+  args.push_back("ld.lld");
+  args.push_back("-o");
+  args.push_back(outFile.c_str());
+  args.push_back("--dynamic-linker");
+#if defined(__aarch64__)
+  args.push_back("/lib/ld-linux-aarch64.so.1");
+#else
+  args.push_back("/lib64/ld-linux-x86-64.so.2");
+#endif
+  args.push_back(crt1.c_str());
+  args.push_back(crti.c_str());
+  for (const auto &obj : objFiles) {
+    args.push_back(obj.c_str());
+  }
+  if (!runtimePath.empty()) {
+    args.push_back(runtimePath.c_str());
+  }
+  args.push_back("-L/usr/lib/x86_64-linux-gnu");
+  args.push_back("-L/usr/lib/aarch64-linux-gnu");
+  args.push_back("-L/usr/lib64");
+  args.push_back("-L/usr/lib");
+  args.push_back("-lstdc++");
+  args.push_back("-lm");
+  args.push_back("-lc");
+  args.push_back(crtn.c_str());
+
+  attempted = true;
+  return lld::elf::link(args, llvm::outs(), llvm::errs(),
+                        /*exitEarly=*/false, /*disableOutput=*/false);
+}
+
+#endif // FLUX_HAVE_LLD && __linux__
+
+/// Link object files into an executable, pulling in the Flux runtime.
+/// Prefers in-process liblld (no subprocess spawn); falls back to the
+/// system clang++ driver when lld is unavailable or the CRT objects
+/// cannot be located.
+bool linkExecutable(const std::vector<std::string> &objFiles,
+                    const std::string &outFile,
+                    const std::string &extraLinkArgs = {}) {
+  std::string runtimeLib = findRuntimeLibrary();
+
+#if defined(FLUX_HAVE_LLD) && defined(__linux__)
+  bool attempted = false;
+  // Extra driver-level args (e.g. the PGO profile runtime) need the
+  // full compiler driver; skip the bare in-process link for those
+  bool ok = !extraLinkArgs.empty()
+                ? false
+                : tryLinkWithLLD(objFiles, outFile, runtimeLib, attempted);
+  if (attempted) {
+    if (!ok) {
+      std::cerr << "error: in-process linking failed\n";
+    }
+    return ok;
+  }
+  // Fall through to the external linker
+#endif
+
+  std::string linker = "clang++"; // Use clang++ for C++ runtime compatibility
+
+  std::stringstream linkCmd;
+  linkCmd << linker;
+  for (const auto &obj : objFiles) {
+    linkCmd << " " << obj;
+  }
+  linkCmd << " -o " << outFile << " -v";
+  if (!extraLinkArgs.empty()) {
+    linkCmd << " " << extraLinkArgs;
+  }
+
+  if (!runtimeLib.empty()) {
+    linkCmd << " " << "\"" << runtimeLib << "\"";
+  } else {
+    // Fallback: try to link assuming it's in the library search path
+    auto exeDir = getExecutablePath().parent_path();
+    linkCmd << " -L" << "\"" << exeDir.string() << "\"" << " -lFluxRuntime";
+  }
+
+  // Explicitly target MinGW to avoid MSVC library search
+#ifdef _WIN32
+  linkCmd << " --target=x86_64-w64-windows-gnu";
+#endif
+
+  int ret = std::system(linkCmd.str().c_str());
+  if (ret != 0) {
+    std::cerr << "error: linking failed with exit code " << ret << "\n";
+    return false;
+  }
+  return true;
+}
+
+/// Compile one .fl file to an object file. Runs the full front end with
+/// engines local to the calling worker; CodeGen owns its own LLVMContext,
+/// so workers never share LLVM state.
+bool compileToObject(const std::string &path, const DriverOptions &opts,
+                     const std::string &objFile, std::mutex &outputMutex,
+                     const std::string &interfacePath = {}) {
+  flux::SourceManager srcMgr;
+  uint32_t fileId;
+  try {
+    fileId = srcMgr.loadFile(path);
+  } catch (const std::exception &) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::cerr << "error: could not open file '" << path << "'\n";
+    return false;
+  }
+
+  uint64_t cacheKey = objectCacheKey(srcMgr.getSource(fileId), opts);
+  if (!opts.noCache && objectCacheLookup(cacheKey, objFile)) {
+    return true;
+  }
+
+  flux::DiagnosticEngine diag;
+  diag.setSourceManager(&srcMgr);
+  flux::Lexer lexer(srcMgr.getSource(fileId), path, diag,
+                    srcMgr.fileBase(fileId));
+  flux::Parser parser(lexer, diag);
+  auto module = parser.parseModule();
+
+  flux::Sema sema(diag);
+  if (diag.getErrorCount() == 0) {
+    sema.analyze(*module);
+  }
+
+  if (diag.getErrorCount() == 0 && !interfacePath.empty()) {
+    flux::ModuleInterface::write(interfacePath, sema.getGlobalScope());
+  }
+
+  if (diag.getErrorCount() == 0) {
+    flux::CodeGenOptions cgOpts = makeCodeGenOptions(opts);
+    // LTO defers optimization to the combined link; workers emit bitcode
+    cgOpts.outputFormat =
+        opts.lto ? flux::OutputFormat::Bitcode : flux::OutputFormat::Object;
+    if (opts.lto) {
+      cgOpts.optimizationLevel = 0;
+    }
+
+    flux::CodeGen codegen(diag, cgOpts);
+    if (codegen.generate(*module) && codegen.writeOutput(objFile)) {
+      if (!opts.noCache) {
+        objectCacheStore(cacheKey, objFile);
+      }
+      return true;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(outputMutex);
+  std::cerr << path << ": " << diag.getErrorCount()
+            << " error(s) generated.\n";
+  return false;
+}
+
+// ============================================================================
+// Incremental build state (flux build --watch)
+// ============================================================================
+//
+// Per-source content hashes and interface hashes persist in
+// .flux-build-state. A file recompiles when its own content changed or
+// when an imported module's *interface* hash changed — signature-level
+// cutoff, so edits to a function body don't ripple through dependents.
+
+struct BuildState {
+  std::map<std::string, uint64_t> contentHash;   // source path -> hash
+  std::map<std::string, uint64_t> interfaceHash; // source path -> hash
+
+  static constexpr const char *kStateFile = ".flux-build-state";
+
+  void load() {
+    std::ifstream in(kStateFile);
+    std::string path;
+    uint64_t content, interface;
+    while (in >> path >> content >> interface) {
+      contentHash[path] = content;
+      interfaceHash[path] = interface;
+    }
+  }
+
+  void save() const {
+    std::ofstream out(kStateFile, std::ios::trunc);
+    for (const auto &[path, hash] : contentHash) {
+      auto it = interfaceHash.find(path);
+      out << path << " " << hash << " "
+          << (it != interfaceHash.end() ? it->second : 0) << "\n";
+    }
+  }
+};
+
+uint64_t hashFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream buffer;
+  buffer << in.rdbuf();
+  std::string data = buffer.str();
+  return fnv1aHash(14695981039346656037ull, data);
+}
+
+/// Module names imported by `path` (cheap token scan via the parser's
+/// pre-scan; no full parse).
+std::vector<std::string> scanImports(const std::string &path) {
+  std::vector<std::string> imports;
+  flux::SourceManager srcMgr;
+  try {
+    uint32_t fileId = srcMgr.loadFile(path);
+    flux::DiagnosticEngine diag;
+    diag.setHandler([](const flux::Diagnostic &) {});
+    flux::Lexer lexer(srcMgr.getSource(fileId), path, diag);
+    flux::Parser parser(lexer, diag);
+    for (auto &name : parser.preScanTopLevelNames()) {
+      if (name.keyword == flux::TokenKind::KwImport) {
+        imports.push_back(name.name);
+      }
+    }
+  } catch (const std::exception &) {
+  }
+  return imports;
+}
+
+/// One incremental build pass over `sources`. Returns 0 on success and
+/// sets `anyWork` when something was recompiled or relinked.
+int runBuildPass(const DriverOptions &opts,
+                 const std::vector<std::string> &sources,
+                 const std::vector<std::string> &objFiles, BuildState &state,
+                 bool &anyWork) {
+  namespace fs = std::filesystem;
+
+  // Map module name (file stem) -> index for import-graph edges
+  std::map<std::string, size_t> stemIndex;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    stemIndex[fs::path(sources[i]).stem().string()] = i;
+  }
+
+  std::vector<uint64_t> newContentHash(sources.size());
+  std::vector<bool> contentChanged(sources.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    newContentHash[i] = hashFile(sources[i]);
+    auto it = state.contentHash.find(sources[i]);
+    contentChanged[i] =
+        it == state.contentHash.end() || it->second != newContentHash[i] ||
+        !fs::exists(objFiles[i]);
+  }
+
+  // Phase 1: recompile files whose own content changed (emitting fresh
+  // interfaces)
+  std::mutex outputMutex;
+  bool failed = false;
+  std::vector<bool> rebuilt(sources.size());
+  auto compileOne = [&](size_t i) {
+    std::string fli = flux::ModuleInterface::interfacePathFor(sources[i]);
+    if (!compileToObject(sources[i], opts, objFiles[i], outputMutex, fli)) {
+      failed = true;
+      return;
+    }
+    rebuilt[i] = true;
+    state.contentHash[sources[i]] = newContentHash[i];
+    state.interfaceHash[sources[i]] = hashFile(fli);
+  };
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (contentChanged[i]) {
+      compileOne(i);
+    }
+  }
+
+  // Phase 2: recompile dependents whose imported interfaces changed.
+  // Interface hashes were refreshed above, so a body-only edit leaves
+  // them identical and the ripple stops here.
+  for (size_t i = 0; i < sources.size() && !failed; ++i) {
+    if (rebuilt[i]) {
+      continue;
+    }
+    for (const auto &import : scanImports(sources[i])) {
+      auto dep = stemIndex.find(import);
+      if (dep == stemIndex.end()) {
+        continue;
+      }
+      const std::string &depSource = sources[dep->second];
+      std::string depFli = flux::ModuleInterface::interfacePathFor(depSource);
+      uint64_t current = fs::exists(depFli) ? hashFile(depFli) : 0;
+      auto recorded = state.interfaceHash.find(depSource);
+      if (recorded == state.interfaceHash.end() ||
+          recorded->second != current) {
+        compileOne(i);
+        break;
+      }
+    }
+  }
+
+  if (failed) {
+    return 1;
+  }
+
+  anyWork = false;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (rebuilt[i]) {
+      anyWork = true;
+    }
+  }
+  if (!anyWork) {
+    return 0;
+  }
+
+#ifdef _WIN32
+  std::string outFile = opts.outputFile.empty() ? "app.exe" : opts.outputFile;
+#else
+  std::string outFile = opts.outputFile.empty() ? "app" : opts.outputFile;
+#endif
+  if (!linkExecutable(objFiles, outFile,
+                      opts.profileGenerate ? "-fprofile-generate" : "")) {
+    return 1;
+  }
+  state.save();
+  std::cout << "Output written to " << outFile << "\n";
+  return 0;
+}
+
+/// `flux build --watch`: incremental passes driven by mtime polling.
+int runWatch(const DriverOptions &opts,
+             const std::vector<std::string> &sources,
+             const std::vector<std::string> &objFiles) {
+  namespace fs = std::filesystem;
+
+  BuildState state;
+  state.load();
+
+  bool anyWork = false;
+  runBuildPass(opts, sources, objFiles, state, anyWork);
+  std::cout << "watching " << sources.size() << " files...\n";
+
+  std::map<std::string, fs::file_time_type> mtimes;
+  for (const auto &path : sources) {
+    std::error_code ec;
+    mtimes[path] = fs::last_write_time(path, ec);
+  }
+
+  for (;;) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    bool dirty = false;
+    for (const auto &path : sources) {
+      std::error_code ec;
+      auto mtime = fs::last_write_time(path, ec);
+      if (!ec && mtime != mtimes[path]) {
+        mtimes[path] = mtime;
+        dirty = true;
+      }
+    }
+    if (dirty) {
+      if (runBuildPass(opts, sources, objFiles, state, anyWork) == 0 &&
+          anyWork) {
+        std::cout << "rebuild complete\n";
+      }
+    }
+  }
+}
+
+// ============================================================================
+// Distributed compilation (POSIX)
+// ============================================================================
+//
+// distcc-style: a job blob (source bytes + the CodeGenOptions that can
+// change the object) travels to a worker over a length-prefixed TCP
+// protocol; object bytes stream back. The content-hash cache is always
+// consulted first and any failure falls back to a local compile, so a
+// dead worker costs latency, never correctness.
+
+#ifndef _WIN32
+
+#include <netdb.h>
+#include <netinet/in.h>
+
+// Shared with the daemon transport below
+bool writeAll(int fd, const void *data, size_t size) {
+  const char *pos = static_cast<const char *>(data);
+  while (size > 0) {
+    ssize_t written = write(fd, pos, size);
+    if (written <= 0) {
+      return false;
+    }
+    pos += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+bool readExact(int fd, void *data, size_t size) {
+  char *pos = static_cast<char *>(data);
+  while (size > 0) {
+    ssize_t got = read(fd, pos, size);
+    if (got <= 0) {
+      return false;
+    }
+    pos += got;
+    size -= static_cast<size_t>(got);
+  }
+  return true;
+}
+
+bool sendBlob(int fd, const std::string &blob) {
+  uint32_t size = static_cast<uint32_t>(blob.size());
+  return writeAll(fd, &size, sizeof(size)) &&
+         writeAll(fd, blob.data(), blob.size());
+}
+
+bool recvBlob(int fd, std::string &blob) {
+  uint32_t size;
+  if (!readExact(fd, &size, sizeof(size)) || size > (256u << 20)) {
+    return false;
+  }
+  blob.resize(size);
+  return size == 0 || readExact(fd, blob.data(), size);
+}
+
+/// Serialize everything that determines the object bytes.
+std::string makeJobBlob(const std::string &source,
+                        const DriverOptions &opts) {
+  std::ostringstream out;
+  auto field = [&](const std::string &value) {
+    uint32_t size = static_cast<uint32_t>(value.size());
+    out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+  };
+  field(source);
+  field(opts.targetTriple);
+  field(opts.features);
+  field(std::to_string(opts.optimizationLevel));
+  field(opts.lto ? "bitcode" : "object");
+  return out.str();
+}
+
+/// Run one compile job received from the wire. Returns object bytes.
+bool runCompileJob(const std::string &blob, std::string &objectBytes) {
+  size_t pos = 0;
+  auto field = [&](std::string &value) {
+    if (blob.size() - pos < 4) {
+      return false;
+    }
+    uint32_t size;
+    std::memcpy(&size, blob.data() + pos, 4);
+    pos += 4;
+    if (blob.size() - pos < size) {
+      return false;
+    }
+    value.assign(blob.data() + pos, size);
+    pos += size;
+    return true;
+  };
+
+  std::string source, triple, features, optLevel, format;
+  if (!field(source) || !field(triple) || !field(features) ||
+      !field(optLevel) || !field(format)) {
+    return false;
+  }
+
+  DriverOptions jobOpts;
+  jobOpts.targetTriple = triple;
+  jobOpts.features = features;
+  jobOpts.optimizationLevel = std::atoi(optLevel.c_str());
+  jobOpts.lto = format == "bitcode";
+  jobOpts.noCache = true; // the client consulted the cache already
+
+  // The compile pipeline works on files; stage the source in a temp
+  char sourcePath[] = "/tmp/flux-dist-src-XXXXXX";
+  int sourceFd = mkstemp(sourcePath);
+  if (sourceFd < 0) {
+    return false;
+  }
+  writeAll(sourceFd, source.data(), source.size());
+  close(sourceFd);
+  std::string objPath = std::string(sourcePath) + (jobOpts.lto ? ".bc" : ".o");
+
+  std::mutex outputMutex;
+  bool ok = compileToObject(sourcePath, jobOpts, objPath, outputMutex);
+  unlink(sourcePath);
+  if (ok) {
+    std::ifstream in(objPath, std::ios::binary);
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    objectBytes = buffer.str();
+  }
+  std::filesystem::remove(objPath);
+  return ok && !objectBytes.empty();
+}
+
+/// `flux --dist-worker=<port>`: accept jobs forever.
+int runDistWorker(const std::string &port) {
+  int server = socket(AF_INET, SOCK_STREAM, 0);
+  if (server < 0) {
+    std::cerr << "error: could not create worker socket\n";
+    return 1;
+  }
+  int enable = 1;
+  setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = INADDR_ANY;
+  addr.sin_port = htons(static_cast<uint16_t>(std::atoi(port.c_str())));
+  if (bind(server, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+      listen(server, 16) != 0) {
+    std::cerr << "error: could not listen on port " << port << "\n";
+    return 1;
+  }
+  std::cout << "flux dist worker listening on port " << port << "\n";
+
+  for (;;) {
+    int client = accept(server, nullptr, nullptr);
+    if (client < 0) {
+      continue;
+    }
+    std::string blob, objectBytes;
+    if (recvBlob(client, blob) && runCompileJob(blob, objectBytes)) {
+      sendBlob(client, objectBytes);
+    } else {
+      sendBlob(client, ""); // empty reply = failure; client compiles locally
+    }
+    close(client);
+  }
+}
+
+/// Dispatch one source to `hostPort`. Returns false on any failure.
+bool compileRemotely(const std::string &hostPort, const std::string &path,
+                     const DriverOptions &opts, const std::string &objFile) {
+  auto colon = hostPort.rfind(':');
+  if (colon == std::string::npos) {
+    return false;
+  }
+  std::string host = hostPort.substr(0, colon);
+  std::string port = hostPort.substr(colon + 1);
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::ostringstream sourceBuffer;
+  sourceBuffer << in.rdbuf();
+
+  addrinfo hints{};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *result = nullptr;
+  if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0) {
+    return false;
+  }
+  int fd = socket(result->ai_family, result->ai_socktype,
+                  result->ai_protocol);
+  bool connected =
+      fd >= 0 && connect(fd, result->ai_addr, result->ai_addrlen) == 0;
+  freeaddrinfo(result);
+  if (!connected) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+
+  std::string objectBytes;
+  bool ok = sendBlob(fd, makeJobBlob(sourceBuffer.str(), opts)) &&
+            recvBlob(fd, objectBytes) && !objectBytes.empty();
+  close(fd);
+  if (!ok) {
+    return false;
+  }
+
+  std::ofstream out(objFile, std::ios::binary | std::ios::trunc);
+  out.write(objectBytes.data(),
+            static_cast<std::streamsize>(objectBytes.size()));
+  return out.good();
+}
+
+#endif // !_WIN32
+
+/// `flux build`: compile every input module concurrently, then link once.
+int runBuild(const DriverOptions &opts) {
+  namespace fs = std::filesystem;
+
+  // Expand directories into their .fl files
+  std::vector<std::string> sources;
+  for (const auto &input : opts.inputs) {
+    if (fs::is_directory(input)) {
+      for (const auto &entry : fs::recursive_directory_iterator(input)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".fl") {
+          sources.push_back(entry.path().string());
+        }
+      }
+    } else {
+      sources.push_back(input);
+    }
+  }
+  if (sources.empty()) {
+    std::cerr << "error: no .fl input files\n";
+    return 1;
+  }
+
+  // Warm the page cache for every input (and any interfaces already on
+  // disk) while the first compiles run; on network filesystems this
+  // removes the serial read latency per file
+  flux::FilePrefetcher prefetcher;
+  for (const auto &source : sources) {
+    prefetcher.prefetch(source);
+    prefetcher.prefetch(flux::ModuleInterface::interfacePathFor(source));
+  }
+
+  unsigned jobs = opts.jobs ? opts.jobs : std::thread::hardware_concurrency();
+  if (jobs == 0) {
+    jobs = 1;
+  }
+  if (jobs > sources.size()) {
+    jobs = static_cast<unsigned>(sources.size());
+  }
+
+  std::vector<std::string> objFiles(sources.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    objFiles[i] =
+        fs::path(sources[i]).stem().string() + (opts.lto ? ".bc" : ".o");
+  }
+
+  // Hash-guided incremental modes (import graph + interface cutoff)
+  if (opts.watch) {
+    return runWatch(opts, sources, objFiles);
+  }
+  if (opts.incremental) {
+    BuildState state;
+    state.load();
+    bool anyWork = false;
+    int result = runBuildPass(opts, sources, objFiles, state, anyWork);
+    if (result == 0 && !anyWork) {
+      std::cout << "nothing to do\n";
+    }
+    return result;
+  }
+
+  // Worker pool: each worker pulls the next un-compiled source
+  std::atomic<size_t> nextSource{0};
+  std::atomic<bool> failed{false};
+  std::mutex outputMutex;
+
+  std::atomic<size_t> nextHost{0};
+  auto worker = [&] {
+    for (;;) {
+      size_t i = nextSource.fetch_add(1);
+      if (i >= sources.size()) {
+        return;
+      }
+#ifndef _WIN32
+      // Remote dispatch (round-robin) with local fallback; the content
+      // cache inside compileToObject still short-circuits local work
+      if (!opts.distHosts.empty()) {
+        const std::string &host =
+            opts.distHosts[nextHost.fetch_add(1) % opts.distHosts.size()];
+        if (compileRemotely(host, sources[i], opts, objFiles[i])) {
+          continue;
+        }
+      }
+#endif
+      if (!compileToObject(sources[i], opts, objFiles[i], outputMutex)) {
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned i = 0; i < jobs; ++i) {
+    pool.emplace_back(worker);
+  }
+  for (auto &t : pool) {
+    t.join();
+  }
+
+  if (failed) {
+    for (const auto &obj : objFiles) {
+      fs::remove(obj);
+    }
+    return 1;
+  }
+
+  // Link once
+#ifdef _WIN32
+  std::string outFile = opts.outputFile.empty() ? "app.exe" : opts.outputFile;
+#else
+  std::string outFile = opts.outputFile.empty() ? "app" : opts.outputFile;
+#endif
+
+  std::vector<std::string> linkInputs = objFiles;
+  std::string ltoObject;
+  if (opts.lto) {
+    // Combine all module bitcode, optimize as one unit, emit one object
+    flux::DiagnosticEngine diag;
+    flux::CodeGenOptions cgOpts = makeCodeGenOptions(opts);
+    cgOpts.optimizationLevel =
+        opts.optimizationLevel > 0 ? opts.optimizationLevel : 2;
+    cgOpts.outputFormat = flux::OutputFormat::Object;
+
+    flux::CodeGen ltoCodegen(diag, cgOpts);
+    ltoObject = outFile + ".lto.o";
+    if (!ltoCodegen.linkAndOptimizeBitcode(objFiles) ||
+        !ltoCodegen.writeOutput(ltoObject)) {
+      std::cerr << "error: LTO link failed\n";
+      for (const auto &obj : objFiles) {
+        fs::remove(obj);
+      }
+      return 1;
+    }
+    linkInputs = {ltoObject};
+  }
+
+  bool linked = linkExecutable(
+      linkInputs, outFile,
+      opts.profileGenerate ? "-fprofile-generate" : "");
+  for (const auto &obj : objFiles) {
+    fs::remove(obj);
+  }
+  if (!ltoObject.empty()) {
+    fs::remove(ltoObject);
+  }
+  if (!linked) {
+    return 1;
+  }
+  std::cout << "Output written to " << outFile << "\n";
+  return 0;
+}
+
 } // anonymous namespace
 
-int main(int argc, char *argv[]) {
-  auto opts = parseArgs(argc, argv);
+// ============================================================================
+// REPL: incremental JIT with cross-line state
+// ============================================================================
+//
+// Each input (a declaration, or statements wrapped into a synthetic
+// function) is parsed, checked by a persistent Sema whose global scope
+// accumulates across lines, compiled into a tiny module, and added to
+// one long-lived ORC session — prior lines are never recompiled.
 
+int runRepl() {
+  flux::DiagnosticEngine diag;
+  flux::Sema sema(diag);
+  auto jit = flux::CodeGen::createJITSession(diag);
+  if (!jit) {
+    return 1;
+  }
+
+  std::cout << "Flux REPL — declarations and statements; Ctrl-D to exit\n";
+
+  unsigned lineCounter = 0;
+  std::string pending;
+  std::string line;
+  while (true) {
+    std::cout << (pending.empty() ? "flux> " : "  ... ") << std::flush;
+    if (!std::getline(std::cin, line)) {
+      break;
+    }
+    pending += line;
+    pending += "\n";
+
+    // Wait for balanced braces before evaluating
+    int depth = 0;
+    for (char c : pending) {
+      if (c == '{') ++depth;
+      if (c == '}') --depth;
+    }
+    if (depth > 0) {
+      continue;
+    }
+
+    std::string snippet = pending;
+    pending.clear();
+    if (snippet.find_first_not_of(" \t\n") == std::string::npos) {
+      continue;
+    }
+
+    // Bare statements wrap into a synthetic entry we invoke after add.
+    // Classify by the first lexed token — a string prefix test would
+    // misread identifiers like `funcs()` or `structure.print()` as
+    // declarations.
+    bool isDecl = false;
+    {
+      flux::DiagnosticEngine probeDiag;
+      probeDiag.setHandler([](const flux::Diagnostic &) {});
+      flux::Lexer probeLexer(snippet, "<repl>", probeDiag);
+      switch (probeLexer.nextToken().kind) {
+      case flux::TokenKind::KwFunc:
+      case flux::TokenKind::KwAsync:
+      case flux::TokenKind::KwStruct:
+      case flux::TokenKind::KwClass:
+      case flux::TokenKind::KwEnum:
+      case flux::TokenKind::KwTrait:
+      case flux::TokenKind::KwImpl:
+      case flux::TokenKind::KwType:
+      case flux::TokenKind::KwImport:
+      case flux::TokenKind::KwModule:
+      case flux::TokenKind::KwPub:
+      case flux::TokenKind::KwPublic:
+      case flux::TokenKind::At:
+        isDecl = true;
+        break;
+      default:
+        break;
+      }
+    }
+    std::string entryName;
+    if (!isDecl) {
+      entryName = "__repl_" + std::to_string(lineCounter++);
+      snippet = "func " + entryName + "() -> Void {\n" + snippet + "}\n";
+    }
+
+    uint32_t errorsBefore = diag.errorCount();
+    flux::Lexer lexer(snippet, "<repl>", diag);
+    flux::Parser parser(lexer, diag);
+    auto module = parser.parseModule();
+    if (diag.errorCount() > errorsBefore) {
+      continue;
+    }
+
+    sema.analyze(*module);
+    if (diag.errorCount() > errorsBefore) {
+      continue;
+    }
+
+    flux::CodeGenOptions cgOpts;
+    cgOpts.outputFormat = flux::OutputFormat::Object;
+    flux::CodeGen codegen(diag, cgOpts);
+    if (!codegen.generate(*module) || !codegen.addToJIT(*jit)) {
+      continue;
+    }
+
+    if (!entryName.empty()) {
+      auto entry = jit->lookup(entryName);
+      if (!entry) {
+        diag.emitError({}, "lookup failed: " +
+                               llvm::toString(entry.takeError()));
+        continue;
+      }
+#if LLVM_VERSION_MAJOR >= 15
+      auto *fn = entry->toPtr<void (*)()>();
+#else
+      auto *fn = reinterpret_cast<void (*)()>(
+          static_cast<uintptr_t>(entry->getAddress()));
+#endif
+      fn();
+      flux_flush();
+    }
+  }
+  std::cout << "\n";
+  return 0;
+}
+
+/// Everything after argument parsing; shared by the normal entry point
+/// and daemon-served requests.
+int runDriver(const DriverOptions &opts) {
   if (opts.showHelp) {
     printUsage();
     return 0;
@@ -197,42 +1457,119 @@ int main(int argc, char *argv[]) {
     printVersion();
     return 0;
   }
+  if (opts.buildMode) {
+    return runBuild(opts);
+  }
+  if (opts.replMode) {
+    return runRepl();
+  }
   if (opts.inputFile.empty()) {
     std::cerr << "error: no input file\n";
     printUsage();
     return 1;
   }
 
-  // Read input
-  std::string source = readFile(opts.inputFile);
-
   // Set up diagnostics
   flux::DiagnosticEngine diag;
 
-  // Source manager
+  // Source manager (memory-maps regular files; no copy of the source bytes)
   flux::SourceManager srcMgr;
-  srcMgr.loadFromString(opts.inputFile, source);
+  uint32_t fileId;
+  try {
+    fileId = srcMgr.loadFile(opts.inputFile);
+  } catch (const std::exception &) {
+    std::cerr << "error: could not open file '" << opts.inputFile << "'\n";
+    return 1;
+  }
+  std::string_view source = srcMgr.getSource(fileId);
+  diag.setSourceManager(&srcMgr);
+  diag.setErrorLimit(opts.errorLimit);
+
+  flux::CompilationStats stats;
+  if (opts.timeTrace) {
+    // LLVM's pass managers emit into the same profiler, so the trace
+    // covers our phases and the optimization pipeline together.
+    llvm::timeTraceProfilerInitialize(/*TimeTraceGranularity=*/0, "flux");
+  }
+
+  // Determine output filename
+  std::string outFile =
+      opts.outputFile.empty()
+          ? deriveOutputFilename(opts.inputFile, opts.outputFormat)
+          : opts.outputFile;
+
+  // Object cache: a content-hash hit skips the whole pipeline
+  uint64_t cacheKey = objectCacheKey(source, opts);
+  bool cacheEligible =
+      !opts.noCache && !opts.runMode && !opts.dumpAST && !opts.dumpTokens &&
+      (opts.outputFormat == flux::OutputFormat::Object ||
+       opts.outputFormat == flux::OutputFormat::Executable);
+  if (cacheEligible) {
+    if (opts.outputFormat == flux::OutputFormat::Object) {
+      if (objectCacheLookup(cacheKey, outFile)) {
+        return 0;
+      }
+    } else {
+      std::string objFile = outFile + ".o";
+      if (objectCacheLookup(cacheKey, objFile)) {
+        bool linked = linkExecutable({objFile}, outFile);
+        std::filesystem::remove(objFile);
+        if (!linked) {
+          return 1;
+        }
+        std::cout << "Output written to " << outFile << "\n";
+        return 0;
+      }
+    }
+  }
 
   // === Phase 1: Lexical analysis ===
-  auto lexer = std::make_unique<flux::Lexer>(source, opts.inputFile, diag);
+  auto lexer = std::make_unique<flux::Lexer>(source, opts.inputFile, diag,
+                                             srcMgr.fileBase(fileId));
 
   if (opts.dumpTokens) {
     auto tokens = lexer->lexAll();
-    for (auto &tok : tokens) {
-      std::cout << flux::Token::kindToString(tok.kind) << " '" << tok.text
-                << "'"
-                << " @ " << tok.location.line << ":" << tok.location.column
-                << "\n";
+    if (opts.dumpBinary) {
+      // Fixed-width records an indexer can mmap; no re-parsing needed
+      flux::BinaryDump::writeTokens(std::cout, tokens);
+    } else {
+      for (auto &tok : tokens) {
+        auto loc = srcMgr.decode(tok.location);
+        std::cout << flux::Token::kindToString(tok.kind) << " '"
+                  << lexer->tokenText(tok) << "'"
+                  << " @ " << loc.line << ":" << loc.column << "\n";
+      }
     }
     if (diag.getErrorCount() > 0)
       return 1;
     // Re-create lexer for further processing
-    lexer = std::make_unique<flux::Lexer>(source, opts.inputFile, diag);
+    lexer = std::make_unique<flux::Lexer>(source, opts.inputFile, diag,
+                                          srcMgr.fileBase(fileId));
   }
 
-  // === Phase 2: Parsing ===
+  // === Phase 2 (+3 when pipelined): Parsing / semantic analysis ===
   flux::Parser parser(*lexer, diag);
-  auto module = parser.parseModule();
+  flux::Sema sema(diag);
+  flux::DeclTimer declTimer;
+  if (opts.timePerDecl) {
+    sema.setDeclTimer(&declTimer);
+  }
+  std::unique_ptr<flux::ast::Module> module;
+  {
+    flux::CompilationStats::PhaseTimer timer(
+        stats, opts.pipeline ? "lex+parse+sema" : "lex+parse");
+    llvm::TimeTraceScope timeScope("lex+parse");
+    if (opts.pipeline) {
+      module = sema.analyzePipelined(parser, opts.jobs);
+    } else {
+      module = parser.parseModule();
+    }
+  }
+  stats.setCounter("tokens", parser.tokenCount());
+  if (module->context) {
+    stats.setCounter("AST nodes", module->context->nodeCount());
+    stats.setCounter("AST arena bytes", module->context->bytesAllocated());
+  }
 
   if (diag.getErrorCount() > 0) {
     std::cerr << diag.getErrorCount() << " error(s) generated.\n";
@@ -240,41 +1577,158 @@ int main(int argc, char *argv[]) {
   }
 
   if (opts.dumpAST) {
-    // TODO: pretty-print the AST
-    std::cout << "Module: " << module->name << "\n";
-    std::cout << "  Declarations: " << module->declarations.size() << "\n";
+    if (opts.dumpBinary) {
+      flux::BinaryDump::writeModule(std::cout, *module);
+    } else {
+      // TODO: pretty-print the AST
+      std::cout << "Module: " << module->name << "\n";
+      std::cout << "  Declarations: " << module->declarations.size() << "\n";
+    }
     if (diag.getErrorCount() > 0)
       return 1;
   }
 
-  // === Phase 3: Semantic analysis ===
-  flux::Sema sema(diag);
-  if (!sema.analyze(*module)) {
+  // === Phase 3: Semantic analysis (already done when pipelined) ===
+  if (!opts.pipeline) {
+    flux::CompilationStats::PhaseTimer timer(stats, "sema");
+    llvm::TimeTraceScope timeScope("sema");
+    if (!sema.analyze(*module)) {
+      std::cerr << diag.getErrorCount() << " error(s) generated.\n";
+      return 1;
+    }
+  } else if (diag.getErrorCount() > 0) {
     std::cerr << diag.getErrorCount() << " error(s) generated.\n";
     return 1;
   }
 
+  if (opts.memStats) {
+    auto astStats = flux::ASTStatistics::collect(*module);
+    std::ostream &out = std::cout;
+    out << "{\n  \"nodes\": {";
+    bool first = true;
+    for (const auto &[name, count] : astStats.nodeCounts) {
+      out << (first ? "\n" : ",\n") << "    \"" << name << "\": " << count;
+      first = false;
+    }
+    out << "\n  },\n";
+    out << "  \"totalNodes\": " << astStats.totalNodes << ",\n";
+    out << "  \"shallowBytes\": {\n"
+        << "    \"decls\": " << astStats.declBytes << ",\n"
+        << "    \"stmts\": " << astStats.stmtBytes << ",\n"
+        << "    \"exprs\": " << astStats.exprBytes << ",\n"
+        << "    \"patterns\": " << astStats.patternBytes << "\n  },\n";
+    if (module->context) {
+      out << "  \"arena\": {\n"
+          << "    \"allocatedBytes\": " << module->context->bytesAllocated()
+          << ",\n"
+          << "    \"reservedBytes\": " << module->context->bytesReserved()
+          << ",\n"
+          << "    \"nodes\": " << module->context->nodeCount()
+          << "\n  },\n";
+    }
+    out << "  \"stringInterner\": {\n"
+        << "    \"symbols\": " << flux::globalInterner().size() << ",\n"
+        << "    \"storageBytes\": " << flux::globalInterner().storageBytes()
+        << "\n  },\n";
+    out << "  \"sourceBuffers\": " << srcMgr.totalBufferBytes() << "\n}\n";
+  }
+
+  if (opts.emitInterface) {
+    std::string fliFile = flux::ModuleInterface::interfacePathFor(
+        opts.inputFile);
+    if (!flux::ModuleInterface::write(fliFile, sema.getGlobalScope())) {
+      std::cerr << "warning: failed to write module interface '" << fliFile
+                << "'\n";
+    }
+  }
+
   // === Phase 4: Code generation ===
-  flux::CodeGenOptions cgOpts;
-  cgOpts.targetTriple = opts.targetTriple;
-  cgOpts.optimizationLevel = opts.optimizationLevel;
+  flux::CodeGenOptions cgOpts = makeCodeGenOptions(opts);
   cgOpts.outputFormat = opts.outputFormat;
 
+  // Sharded backend: emit/optimize/select per shard concurrently, then
+  // link the shard objects straight into the executable
+  if (opts.parallelCodegen &&
+      opts.outputFormat == flux::OutputFormat::Executable && !opts.runMode) {
+    flux::CompilationStats::PhaseTimer timer(stats, "codegen (parallel)");
+    llvm::TimeTraceScope timeScope("codegen");
+
+    std::vector<std::string> shardObjs;
+    if (!flux::CodeGen::generateParallel(*module, diag, cgOpts, opts.jobs,
+                                         outFile, shardObjs)) {
+      std::cerr << diag.getErrorCount() << " error(s) generated.\n";
+      return 1;
+    }
+    bool linked = linkExecutable(
+        shardObjs, outFile,
+        opts.profileGenerate ? "-fprofile-generate" : "");
+    for (const auto &obj : shardObjs) {
+      std::filesystem::remove(obj);
+    }
+    if (!linked) {
+      return 1;
+    }
+    std::cout << "Output written to " << outFile << "\n";
+    if (opts.timePerDecl) {
+      declTimer.report(std::cerr, &srcMgr);
+    }
+    if (opts.stats) {
+      stats.report(std::cerr);
+    }
+    return 0;
+  }
+
   flux::CodeGen codegen(diag, cgOpts);
-  if (!codegen.generate(*module)) {
-    std::cerr << diag.getErrorCount() << " error(s) generated.\n";
-    return 1;
+  if (opts.timePerDecl) {
+    codegen.setDeclTimer(&declTimer);
+  }
+  {
+    flux::CompilationStats::PhaseTimer timer(stats, "codegen");
+    llvm::TimeTraceScope timeScope("codegen");
+    if (!codegen.generate(*module)) {
+      std::cerr << diag.getErrorCount() << " error(s) generated.\n";
+      return 1;
+    }
   }
 
-  // Determine output filename
-  std::string outFile =
-      opts.outputFile.empty()
-          ? deriveOutputFilename(opts.inputFile, opts.outputFormat)
-          : opts.outputFile;
+  // Flush instrumentation before handing control to the program
+  auto finishInstrumentation = [&] {
+    if (opts.timeTrace) {
+      std::string traceFile = opts.timeTraceFile.empty()
+                                  ? opts.inputFile + ".time-trace.json"
+                                  : opts.timeTraceFile;
+      std::error_code ec;
+      llvm::raw_fd_ostream out(traceFile, ec);
+      if (!ec) {
+        llvm::timeTraceProfilerWrite(out);
+      }
+      llvm::timeTraceProfilerCleanup();
+    }
+    if (opts.timePerDecl) {
+      declTimer.report(std::cerr, &srcMgr);
+    }
+    if (opts.stats) {
+      stats.report(std::cerr);
+    }
+  };
 
-  if (!codegen.writeOutput(outFile)) {
-    std::cerr << "error: failed to write output to '" << outFile << "'\n";
-    return 1;
+  // JIT execution mode: run in-process, produce no output files
+  if (opts.runMode) {
+    finishInstrumentation();
+    return codegen.runJIT();
+  }
+
+  {
+    flux::CompilationStats::PhaseTimer timer(stats, "write output");
+    llvm::TimeTraceScope timeScope("write output");
+    if (!codegen.writeOutput(outFile)) {
+      std::cerr << "error: failed to write output to '" << outFile << "'\n";
+      return 1;
+    }
+  }
+
+  if (cacheEligible && opts.outputFormat == flux::OutputFormat::Object) {
+    objectCacheStore(cacheKey, outFile);
   }
 
   if (opts.outputFormat == flux::OutputFormat::Executable) {
@@ -288,55 +1742,23 @@ int main(int argc, char *argv[]) {
       return 1;
     }
 
-    // Link the object file into an executable
-    std::string linker = "clang++"; // Use clang++ for C++ runtime compatibility
-#ifdef _WIN32
-    linker = "clang++";
-#endif
-
-    std::stringstream linkCmd;
-    linkCmd << linker << " " << objFile << " -o " << outFile << " -v";
-
-    // Find the runtime library path
-    // We search:
-    // 1. Adjacent to executable (Build dir / Windows bundle)
-    // 2. ../lib relative to executable (Unix install / Windows install
-    // structure)
-    auto exePath = getExecutablePath();
-    auto exeDir = exePath.parent_path();
-    std::string runtimePath;
-
-    std::vector<std::filesystem::path> searchDirs = {exeDir, exeDir / "../lib",
-                                                     exeDir / "lib"};
-
-    std::vector<std::string> libNames = {"libFluxRuntime.a", "FluxRuntime.lib"};
-
-    for (const auto &dir : searchDirs) {
-      for (const auto &name : libNames) {
-        auto p = dir / name;
-        if (std::filesystem::exists(p)) {
-          runtimePath = p.string();
-          goto found_runtime; // Break out of double loop
-        }
-      }
+    if (cacheEligible) {
+      objectCacheStore(cacheKey, objFile);
     }
-  found_runtime:;
 
-    if (!runtimePath.empty()) {
-      linkCmd << " " << "\"" << runtimePath << "\"";
-    } else {
-      // Fallback: try to link assuming it's in the library search path
-      linkCmd << " -L" << "\"" << exeDir.string() << "\"" << " -lFluxRuntime";
+    // Instrumented binaries need compiler-rt's profile runtime
+    std::string extraLinkArgs =
+        opts.profileGenerate ? "-fprofile-generate" : "";
+    if (!opts.orderFile.empty()) {
+      // lld consumes symbol ordering files directly
+      extraLinkArgs += " -fuse-ld=lld -Wl,--symbol-ordering-file=" +
+                       opts.orderFile;
     }
-
-    // Explicitly target MinGW to avoid MSVC library search
-#ifdef _WIN32
-    linkCmd << " --target=x86_64-w64-windows-gnu";
-#endif
-
-    int ret = std::system(linkCmd.str().c_str());
-    if (ret != 0) {
-      std::cerr << "error: linking failed with exit code " << ret << "\n";
+    if (opts.stripDead) {
+      // Backstop for anything the AST-level reachability kept
+      extraLinkArgs += " -Wl,--gc-sections";
+    }
+    if (!linkExecutable({objFile}, outFile, extraLinkArgs)) {
       std::filesystem::remove(objFile);
       return 1;
     }
@@ -346,5 +1768,206 @@ int main(int argc, char *argv[]) {
     std::cout << "Output written to " << outFile << "\n";
   }
 
+  finishInstrumentation();
   return 0;
 }
+
+// ============================================================================
+// Daemon mode (POSIX)
+// ============================================================================
+//
+// `flux --daemon` listens on a per-user unix socket. A client invocation
+// with --use-daemon sends its working directory and argv; the server
+// forks a worker per request, so target registration, pass pipeline
+// setup, and dynamic-loader work done once in the parent are inherited
+// warm by every compile. The worker's stdout/stderr go straight to the
+// client socket, followed by a 4-byte exit code trailer.
+
+#ifndef _WIN32
+
+std::string daemonSocketPath() {
+  if (const char *runtimeDir = std::getenv("XDG_RUNTIME_DIR")) {
+    return std::string(runtimeDir) + "/flux-daemon.sock";
+  }
+  return "/tmp/flux-daemon-" + std::to_string(getuid()) + ".sock";
+}
+
+void sendString(int fd, const std::string &text) {
+  uint32_t size = static_cast<uint32_t>(text.size());
+  writeAll(fd, &size, sizeof(size));
+  writeAll(fd, text.data(), text.size());
+}
+
+bool recvString(int fd, std::string &text) {
+  uint32_t size;
+  if (!readExact(fd, &size, sizeof(size)) || size > (64u << 20)) {
+    return false;
+  }
+  text.resize(size);
+  return size == 0 || readExact(fd, text.data(), size);
+}
+
+/// Serve one request on `client` (already accepted). Forks a worker
+/// whose stdout/stderr are the socket; the parent appends the exit code.
+void serveRequest(int client) {
+  uint32_t count;
+  if (!readExact(client, &count, sizeof(count)) || count == 0 ||
+      count > 1024) {
+    close(client);
+    return;
+  }
+
+  std::vector<std::string> fields(count);
+  for (auto &field : fields) {
+    if (!recvString(client, field)) {
+      close(client);
+      return;
+    }
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    // Worker: become the request
+    if (chdir(fields[0].c_str()) != 0) {
+      _exit(127);
+    }
+    dup2(client, STDOUT_FILENO);
+    dup2(client, STDERR_FILENO);
+
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>("flux"));
+    for (size_t i = 1; i < fields.size(); ++i) {
+      if (fields[i] != "--use-daemon") {
+        argv.push_back(const_cast<char *>(fields[i].c_str()));
+      }
+    }
+    auto opts = parseArgs(static_cast<int>(argv.size()), argv.data());
+    _exit(runDriver(opts));
+  }
+
+  int status = 0;
+  if (pid > 0) {
+    waitpid(pid, &status, 0);
+  }
+  int32_t exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+  writeAll(client, &exitCode, sizeof(exitCode));
+  close(client);
+}
+
+int runDaemon() {
+  std::string path = daemonSocketPath();
+  unlink(path.c_str());
+
+  int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0) {
+    std::cerr << "error: could not create daemon socket\n";
+    return 1;
+  }
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  if (bind(server, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+      listen(server, 16) != 0) {
+    std::cerr << "error: could not listen on '" << path << "'\n";
+    close(server);
+    return 1;
+  }
+
+  // Reap workers without blocking the accept loop
+  signal(SIGCHLD, SIG_IGN);
+  std::cout << "flux daemon listening on " << path << "\n";
+
+  for (;;) {
+    int client = accept(server, nullptr, nullptr);
+    if (client < 0) {
+      continue;
+    }
+    serveRequest(client);
+  }
+}
+
+/// Forward this invocation to a running daemon. Returns the exit code,
+/// or -1 when no daemon is reachable (caller compiles locally).
+int tryDaemonClient(int argc, char *argv[]) {
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::string path = daemonSocketPath();
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+
+  char cwd[PATH_MAX];
+  if (!getcwd(cwd, sizeof(cwd))) {
+    close(fd);
+    return -1;
+  }
+
+  uint32_t count = static_cast<uint32_t>(argc); // cwd + argv[1..]
+  writeAll(fd, &count, sizeof(count));
+  sendString(fd, cwd);
+  for (int i = 1; i < argc; ++i) {
+    sendString(fd, argv[i]);
+  }
+
+  // Stream output; the final 4 bytes before close are the exit code
+  std::string tail;
+  char buffer[4096];
+  for (;;) {
+    ssize_t got = read(fd, buffer, sizeof(buffer));
+    if (got <= 0) {
+      break;
+    }
+    tail.append(buffer, static_cast<size_t>(got));
+    if (tail.size() > sizeof(int32_t)) {
+      size_t flushable = tail.size() - sizeof(int32_t);
+      std::fwrite(tail.data(), 1, flushable, stdout);
+      tail.erase(0, flushable);
+    }
+  }
+  close(fd);
+  std::fflush(stdout);
+
+  if (tail.size() != sizeof(int32_t)) {
+    return 1;
+  }
+  int32_t exitCode;
+  std::memcpy(&exitCode, tail.data(), sizeof(exitCode));
+  return exitCode;
+}
+
+#endif // !_WIN32
+
+int main(int argc, char *argv[]) {
+  auto opts = parseArgs(argc, argv);
+
+#ifndef _WIN32
+  if (!opts.distWorkerPort.empty()) {
+    return runDistWorker(opts.distWorkerPort);
+  }
+  if (opts.daemonMode) {
+    return runDaemon();
+  }
+  if (opts.useDaemon) {
+    int result = tryDaemonClient(argc, argv);
+    if (result >= 0) {
+      return result;
+    }
+    // No daemon running; compile locally
+  }
+#else
+  if (opts.daemonMode || opts.useDaemon) {
+    std::cerr << "error: daemon mode is not supported on Windows yet\n";
+    return 1;
+  }
+#endif
+
+  return runDriver(opts);
+}